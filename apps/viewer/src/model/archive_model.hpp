@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "archive/ar_archive.hpp"
+
+namespace viewer {
+
+    struct ArchiveMemberInfo {
+        std::string name;
+        std::uint64_t offset = 0;       // of the member header
+        std::uint64_t size = 0;
+        std::string kind;               // "ELF", "COFF", "Import", ...
+        std::string arch;
+        std::size_t defined = 0;
+        std::size_t undefined = 0;
+        std::string error;              // why the member could not be decoded
+    };
+
+    class ArchiveModel {
+    public:
+        peelf::ArFlavor flavor = peelf::ArFlavor::Gnu;
+        std::vector<ArchiveMemberInfo> members;
+
+        // Definitions of every decoded member, sorted by name. The names
+        // point into the file bytes held by BinaryModel, or into
+        // owned_names for the "__imp_" names of import objects.
+        std::vector<peelf::ArSymbol> symbols;
+        std::vector<std::shared_ptr<const std::string>> owned_names;
+        // Entries in the archive's own (ranlib / linker member) index
+        std::size_t indexed_symbols = 0;
+    };
+
+} // namespace viewer
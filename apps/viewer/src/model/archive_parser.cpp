@@ -0,0 +1,112 @@
+#include "archive_parser.hpp"
+
+#include <cstdio>
+#include <string>
+
+#include "elf/elf_structures.hpp"
+#include "pe/pe_structures.hpp"
+
+namespace viewer {
+
+static const char* kind_name(peelf::ArMemberKind kind) {
+    switch (kind) {
+        case peelf::ArMemberKind::Elf:          return "ELF";
+        case peelf::ArMemberKind::Coff:         return "COFF";
+        case peelf::ArMemberKind::ImportObject: return "Import";
+        case peelf::ArMemberKind::BigObj:       return "COFF (bigobj)";
+        case peelf::ArMemberKind::Bitcode:      return "LLVM bitcode";
+        default:                                return "Unknown";
+    }
+}
+
+static std::string member_arch(peelf::ArMemberKind kind, std::uint16_t machine) {
+    if (kind == peelf::ArMemberKind::Elf) {
+        switch (machine) {
+            case peelf::EM_386:     return "x86";
+            case peelf::EM_X86_64:  return "x64";
+            case peelf::EM_ARM:     return "ARM32";
+            case peelf::EM_AARCH64: return "ARM64";
+            case peelf::EM_RISCV:   return "RISC-V";
+            default:                return "EM_" + std::to_string(machine);
+        }
+    }
+    if (kind == peelf::ArMemberKind::Coff || kind == peelf::ArMemberKind::ImportObject) {
+        switch (machine) {
+            case peelf::IMAGE_FILE_MACHINE_I386:    return "x86";
+            case peelf::IMAGE_FILE_MACHINE_AMD64:   return "x64";
+            case peelf::IMAGE_FILE_MACHINE_ARMNT:   return "ARM32";
+            case peelf::IMAGE_FILE_MACHINE_ARM64:   return "ARM64";
+            case peelf::IMAGE_FILE_MACHINE_ARM64EC: return "ARM64EC";
+            default: {
+                char buf[16];
+                std::snprintf(buf, sizeof(buf), "0x%04X", machine);
+                return buf;
+            }
+        }
+    }
+    return {};
+}
+
+ArchiveParseResult ArchiveParser::parse(std::span<const std::uint8_t> data, ArchiveModel& out) {
+    ArchiveParseResult result;
+
+    auto ar = peelf::ArArchive::parse(data);
+    if (!ar) {
+        result.error = ar.error().message;
+        return result;
+    }
+
+    const auto analysis = peelf::analyze_members(*ar);
+
+    out = ArchiveModel{};
+    out.flavor = ar->flavor();
+    out.indexed_symbols = ar->symbols().size();
+    out.members.reserve(ar->members().size());
+
+    std::size_t failed = 0;
+    for (std::size_t i = 0; i < analysis.size(); ++i) {
+        const auto& m = ar->members()[i];
+        ArchiveMemberInfo info;
+        info.name = std::string(m.name);
+        info.offset = m.header_offset;
+        info.size = m.data.size();
+        if (analysis[i]) {
+            info.kind = kind_name(analysis[i]->kind);
+            info.arch = member_arch(analysis[i]->kind, analysis[i]->machine);
+            info.defined = analysis[i]->defined.size();
+            info.undefined = analysis[i]->undefined;
+            if (analysis[i]->owned_names)
+                out.owned_names.push_back(analysis[i]->owned_names);
+        } else {
+            info.kind = kind_name(peelf::member_kind(m.data));
+            info.error = analysis[i].error().message;
+            ++failed;
+        }
+
+        if (!info.arch.empty()) {
+            if (result.arch.empty())
+                result.arch = info.arch;
+            else if (result.arch != info.arch)
+                result.arch = "mixed";
+        }
+        out.members.push_back(std::move(info));
+    }
+    out.symbols = peelf::build_symbol_index(analysis);
+
+    switch (out.flavor) {
+        case peelf::ArFlavor::Msvc: result.format = "MSVC library"; break;
+        case peelf::ArFlavor::Bsd:  result.format = "ar archive (BSD)"; break;
+        default:                    result.format = "ar archive"; break;
+    }
+    result.flags.push_back(std::to_string(out.members.size()) + " members");
+    result.flags.push_back(std::to_string(out.symbols.size()) + " definitions");
+    if (out.indexed_symbols == 0)
+        result.flags.push_back("No symbol index");
+    if (failed != 0)
+        result.flags.push_back(std::to_string(failed) + " members unreadable");
+
+    result.success = true;
+    return result;
+}
+
+} // namespace viewer
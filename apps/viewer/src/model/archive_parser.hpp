@@ -0,0 +1,25 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+#include "archive_model.hpp"
+
+namespace viewer {
+
+    struct ArchiveParseResult {
+        bool success = false;
+        std::string format;             // "ar archive", "MSVC library", ...
+        std::string arch;               // of the members; "mixed" when they differ
+        std::vector<std::string> flags;
+        std::string error;
+    };
+
+    // Thin adapter over peelf::ArArchive: members are decoded on every
+    // core and only their summaries and definitions are kept.
+    class ArchiveParser {
+    public:
+        static ArchiveParseResult parse(std::span<const std::uint8_t> data, ArchiveModel& out);
+    };
+
+} // namespace viewer
@@ -1,24 +1,70 @@
 #include "binary_model.hpp"
 #include "pe_model.hpp"
 #include "pe_parser.hpp"
+#include "elf_model.hpp"
+#include "elf_parser.hpp"
+#include "archive_parser.hpp"
+#include "macho_parser.hpp"
+#include "minidump_parser.hpp"
+#include "elf/elf_core.hpp"
+#include "elf/elf_debuginfo.hpp"
+#include "elf/elf_view.hpp"
+#include "macho/macho_view.hpp"
+#include "minidump/minidump.hpp"
 
+#include <algorithm>
 #include <fstream>
 
 namespace viewer {
 
+    namespace {
+        // One resolver for the session, so reopening a binary reuses the
+        // build-id lookup instead of CRC-checking its debug file again
+        const peelf::DebugFileResolver& debug_file_resolver() {
+            static const peelf::DebugFileResolver resolver;
+            return resolver;
+        }
+    }
+
     bool BinaryModel::load_file(const std::string& path) {
         std::ifstream f(path, std::ios::binary);
         if (!f) return false;
+        pyramid_ = {};
+
+        // Core dumps can be far larger than memory: they are read through
+        // mapped windows rather than loaded whole. e_type follows e_ident.
+        std::uint8_t header[18] = {};
+        f.read(reinterpret_cast<char*>(header), sizeof(header));
+        if (f.gcount() == sizeof(header) && header[0] == 0x7F && header[1] == 'E' &&
+            header[2] == 'L' && header[3] == 'F') {
+            const bool big_endian = header[peelf::EI_DATA] == peelf::ELFDATA2MSB;
+            const auto type = static_cast<std::uint16_t>(big_endian ? (header[16] << 8) | header[17]
+                                                                     : (header[17] << 8) | header[16]);
+            if (type == peelf::ET_CORE)
+                return load_core(path);
+        }
+        // Windows minidumps, likewise
+        if (f.gcount() >= 4 && header[0] == 'M' && header[1] == 'D' && header[2] == 'M' && header[3] == 'P')
+            return load_minidump(path);
+        f.clear();
+        f.seekg(0);
 
         bytes_ = std::vector<std::uint8_t>(
             std::istreambuf_iterator<char>(f),
             std::istreambuf_iterator<char>()
         );
 
+        if (!load_bytes(path))
+            return false;
+
+        // Built once per load; the hex view's overview only reads it per frame
+        pyramid_ = peelf::BytePyramid::build(bytes_);
+        return true;
+    }
+
+    bool BinaryModel::load_bytes(const std::string& path) {
         if (bytes_.size() < 2) {
-            format_ = BinaryFormat::None;
-            pe_.reset();
-            sections_.clear();
+            reset();
             return false;
         }
 
@@ -27,24 +73,52 @@ namespace viewer {
             return load_pe(path);
         }
 
+        // ELF magic: 0x7F 'E' 'L' 'F'
+        if (bytes_.size() >= 4 && bytes_[0] == 0x7F && bytes_[1] == 'E' &&
+            bytes_[2] == 'L' && bytes_[3] == 'F') {
+            return load_elf(path);
+        }
+
+        // Mach-O: thin (0xFEEDFACE / 0xFEEDFACF) or fat (0xCAFEBABE)
+        if (peelf::is_macho(bytes_)) {
+            return load_macho(path);
+        }
+
+        // Static library: "!<arch>\n"
+        static constexpr char ar_magic[] = "!<arch>\n";
+        if (bytes_.size() >= 8 && std::equal(ar_magic, ar_magic + 8, bytes_.begin())) {
+            return load_archive(path);
+        }
+
+        reset();
+        return false;
+    }
+
+    void BinaryModel::reset() {
         format_ = BinaryFormat::None;
         pe_.reset();
+        elf_.reset();
+        archive_.reset();
+        macho_.reset();
+        minidump_.reset();
         sections_.clear();
-        return false;
+        pyramid_ = {};
     }
 
     bool BinaryModel::load_pe(const std::string& path) {
         PeModel pe_model;
         PeParseResult result = PeParser::parse(bytes_, pe_model);
         if (!result.success) {
-            format_ = BinaryFormat::None;
-            pe_.reset();
-            sections_.clear();
+            reset();
             return false;
         }
 
         format_ = BinaryFormat::PE;
         pe_ = std::make_unique<PeModel>(std::move(pe_model));
+        elf_.reset();
+        archive_.reset();
+        macho_.reset();
+        minidump_.reset();
 
         file_info_.path = path;
         file_info_.format_str = "PE";
@@ -66,4 +140,221 @@ namespace viewer {
         return true;
     }
 
-} // namespace viewer
\ No newline at end of file
+    bool BinaryModel::load_elf(const std::string& path) {
+        ElfModel elf_model;
+        ElfParseResult result = ElfParser::parse(bytes_, elf_model);
+        if (!result.success) {
+            reset();
+            return false;
+        }
+
+        // Stripped binaries: look for the separate debug file installed
+        // under /usr/lib/debug or named by .gnu_debuglink
+        const bool has_symtab = std::any_of(elf_model.symbols.begin(), elf_model.symbols.end(),
+                                            [](const ElfSymbol& s) { return !s.dynamic; });
+        if (!has_symtab || !elf_model.debug_info) {
+            auto view = peelf::ElfView::parse(bytes_);
+            auto match = view ? debug_file_resolver().resolve(path, *view) : std::nullopt;
+            if (match && ElfParser::merge_debug_file(match->path, elf_model, result)) {
+                result.flags.push_back(match->source == peelf::DebugFileSource::BuildId
+                                           ? "Debug file (build-id)" : "Debug file (debuglink)");
+            }
+        }
+
+        format_ = BinaryFormat::ELF;
+        elf_ = std::make_unique<ElfModel>(std::move(elf_model));
+        pe_.reset();
+        archive_.reset();
+        macho_.reset();
+        minidump_.reset();
+
+        file_info_.path = path;
+        file_info_.format_str = result.is_64 ? "ELF64" : "ELF32";
+        file_info_.arch_str = result.arch;
+        file_info_.size_bytes = bytes_.size();
+        file_info_.entry_point = result.entry_point;
+        file_info_.flags = result.flags;
+
+        // Skip the null section at index 0
+        sections_.clear();
+        for (std::size_t i = 1; i < elf_->sections.size(); ++i) {
+            const auto& s = elf_->sections[i];
+            sections_.push_back(SectionInfo{
+                .name = s.name,
+                .address = s.address,
+                .size = s.size,
+                .flags = static_cast<std::uint32_t>(s.flags)
+            });
+        }
+
+        return true;
+    }
+
+    bool BinaryModel::load_core(const std::string& path) {
+        auto core = peelf::ElfCore::open(path);
+        if (!core) {
+            reset();
+            return false;
+        }
+
+        auto shared = std::make_shared<const peelf::ElfCore>(std::move(*core));
+        ElfModel elf_model;
+        ElfParseResult result = ElfParser::parse_core(shared, elf_model);
+        if (!result.success) {
+            reset();
+            return false;
+        }
+
+        format_ = BinaryFormat::ELF;
+        elf_ = std::make_unique<ElfModel>(std::move(elf_model));
+        pe_.reset();
+        archive_.reset();
+        macho_.reset();
+        minidump_.reset();
+        bytes_.clear();
+
+        file_info_.path = path;
+        file_info_.format_str = result.is_64 ? "ELF64 core" : "ELF32 core";
+        file_info_.arch_str = result.arch;
+        file_info_.size_bytes = shared->file_size();
+        file_info_.entry_point = result.entry_point;
+        file_info_.flags = result.flags;
+
+        // Cores have no sections worth listing; show the memory segments,
+        // named after the file mapped there when NT_FILE says
+        sections_.clear();
+        for (const auto& s : shared->segments()) {
+            const auto* mapped = shared->mapped_file_at(s.vaddr);
+            sections_.push_back(SectionInfo{
+                .name = mapped ? mapped->path : std::string("[anon]"),
+                .address = s.vaddr,
+                .size = s.mem_size,
+                .flags = s.flags
+            });
+        }
+
+        return true;
+    }
+
+    bool BinaryModel::load_archive(const std::string& path) {
+        ArchiveModel archive_model;
+        ArchiveParseResult result = ArchiveParser::parse(bytes_, archive_model);
+        if (!result.success) {
+            reset();
+            return false;
+        }
+
+        format_ = BinaryFormat::Archive;
+        archive_ = std::make_unique<ArchiveModel>(std::move(archive_model));
+        pe_.reset();
+        elf_.reset();
+        macho_.reset();
+        minidump_.reset();
+
+        file_info_.path = path;
+        file_info_.format_str = result.format;
+        file_info_.arch_str = result.arch;
+        file_info_.size_bytes = bytes_.size();
+        file_info_.entry_point = 0;
+        file_info_.flags = result.flags;
+
+        // Members stand in for sections, at their file offsets
+        sections_.clear();
+        for (const auto& m : archive_->members) {
+            sections_.push_back(SectionInfo{
+                .name = m.name,
+                .address = m.offset,
+                .size = m.size,
+                .flags = 0
+            });
+        }
+
+        return true;
+    }
+
+    bool BinaryModel::load_macho(const std::string& path) {
+        MachOModel macho_model;
+        MachOParseResult result = MachOParser::parse(bytes_, macho_model);
+        if (!result.success) {
+            reset();
+            return false;
+        }
+
+        format_ = BinaryFormat::MachO;
+        macho_ = std::make_unique<MachOModel>(std::move(macho_model));
+        pe_.reset();
+        elf_.reset();
+        archive_.reset();
+        minidump_.reset();
+
+        file_info_.path = path;
+        file_info_.format_str = result.format;
+        file_info_.arch_str = result.arch;
+        file_info_.size_bytes = bytes_.size();
+        file_info_.entry_point = result.entry_point;
+        file_info_.flags = result.flags;
+
+        // Sections of the first readable slice, as the parser reports it
+        sections_.clear();
+        for (const auto& slice : macho_->slices) {
+            if (!slice.readable)
+                continue;
+            for (const auto& s : slice.sections) {
+                sections_.push_back(SectionInfo{
+                    .name = s.segment + "," + s.name,
+                    .address = s.addr,
+                    .size = s.size,
+                    .flags = s.flags
+                });
+            }
+            break;
+        }
+
+        return true;
+    }
+
+    bool BinaryModel::load_minidump(const std::string& path) {
+        auto dump = peelf::Minidump::open(path);
+        if (!dump) {
+            reset();
+            return false;
+        }
+
+        auto shared = std::make_shared<const peelf::Minidump>(std::move(*dump));
+        MinidumpModel minidump_model;
+        MinidumpParseResult result = MinidumpParser::parse(shared, minidump_model);
+        if (!result.success) {
+            reset();
+            return false;
+        }
+
+        format_ = BinaryFormat::Minidump;
+        minidump_ = std::make_unique<MinidumpModel>(std::move(minidump_model));
+        pe_.reset();
+        elf_.reset();
+        archive_.reset();
+        macho_.reset();
+        bytes_.clear();
+
+        file_info_.path = path;
+        file_info_.format_str = "Minidump";
+        file_info_.arch_str = result.arch;
+        file_info_.size_bytes = shared->file_size();
+        file_info_.entry_point = result.entry_point;
+        file_info_.flags = result.flags;
+
+        // Loaded modules stand in for sections, at their image bases
+        sections_.clear();
+        for (const auto& m : minidump_->modules) {
+            sections_.push_back(SectionInfo{
+                .name = m.path,
+                .address = m.base,
+                .size = m.size,
+                .flags = 0
+            });
+        }
+
+        return true;
+    }
+
+} // namespace viewer
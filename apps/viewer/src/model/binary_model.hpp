@@ -4,13 +4,21 @@
 #include <vector>
 #include <memory>
 #include "pe_model.hpp"
+#include "elf_model.hpp"
+#include "archive_model.hpp"
+#include "macho_model.hpp"
+#include "minidump_model.hpp"
+#include "peelf/byte_pyramid.hpp"
 
 namespace viewer {
 
     enum class BinaryFormat {
         None,
         PE,
-        ELF
+        ELF,
+        Archive,
+        MachO,
+        Minidump
     };
 
     struct SectionInfo {
@@ -44,17 +52,35 @@ namespace viewer {
         const FileInfo& file_info() const { return file_info_; }
         const std::vector<std::uint8_t>& bytes() const { return bytes_; }
         const std::vector<SectionInfo>& sections() const { return sections_; }
+        // Entropy and byte classes of bytes(); empty for cores and dumps
+        const peelf::BytePyramid& byte_pyramid() const { return pyramid_; }
 
         const PeModel* pe() const { return pe_.get(); }
+        const ElfModel* elf() const { return elf_.get(); }
+        const ArchiveModel* archive() const { return archive_.get(); }
+        const MachOModel* macho() const { return macho_.get(); }
+        const MinidumpModel* minidump() const { return minidump_.get(); }
 
     private:
         BinaryFormat format_ = BinaryFormat::None;
         FileInfo file_info_;
         std::vector<std::uint8_t> bytes_;
         std::vector<SectionInfo> sections_;
+        peelf::BytePyramid pyramid_;
         std::unique_ptr<PeModel> pe_;
+        std::unique_ptr<ElfModel> elf_;
+        std::unique_ptr<ArchiveModel> archive_;
+        std::unique_ptr<MachOModel> macho_;
+        std::unique_ptr<MinidumpModel> minidump_;
 
+        void reset();
+        bool load_bytes(const std::string& path);
         bool load_pe(const std::string& path);
+        bool load_elf(const std::string& path);
+        bool load_core(const std::string& path);
+        bool load_archive(const std::string& path);
+        bool load_macho(const std::string& path);
+        bool load_minidump(const std::string& path);
     };
 
 } // namespace viewer
\ No newline at end of file
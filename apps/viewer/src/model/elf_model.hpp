@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace peelf {
+    class DwarfInfo;
+    class DwarfLineIndex;
+    class ElfCore;
+}
+
+namespace viewer {
+
+    struct ElfSectionHeader {
+        std::string name;
+        std::uint32_t type = 0;
+        std::uint64_t flags = 0;
+        std::uint64_t address = 0;
+        std::uint64_t offset = 0;
+        std::uint64_t size = 0;
+        std::uint32_t link = 0;
+        std::uint32_t info = 0;
+        std::uint64_t alignment = 0;
+        std::uint64_t entry_size = 0;
+    };
+
+    struct ElfProgramHeader {
+        std::uint32_t type = 0;
+        std::uint32_t flags = 0;
+        std::uint64_t offset = 0;
+        std::uint64_t vaddr = 0;
+        std::uint64_t paddr = 0;
+        std::uint64_t file_size = 0;
+        std::uint64_t mem_size = 0;
+        std::uint64_t alignment = 0;
+    };
+
+    struct ElfSymbol {
+        std::string name;
+        std::uint64_t value = 0;
+        std::uint64_t size = 0;
+        std::uint8_t type = 0;          // STT_*
+        std::uint8_t binding = 0;       // STB_*
+        std::uint32_t section_index = 0;
+        bool dynamic = false;           // from .dynsym rather than .symtab
+        std::string version;            // e.g. "GLIBC_2.34", dynamic symbols only
+        bool default_version = false;   // defined here and not hidden (name@@version)
+    };
+
+    class ElfModel {
+    public:
+        // ELF header fields
+        bool is_64 = false;
+        bool is_big_endian = false;
+        std::uint8_t os_abi = 0;
+        std::uint16_t type = 0;
+        std::uint16_t machine = 0;
+        std::uint64_t entry = 0;
+        std::uint32_t flags = 0;
+
+        // Parsed structures
+        std::vector<ElfSectionHeader> sections;
+        std::vector<ElfProgramHeader> segments;
+        std::vector<ElfSymbol> symbols;
+
+        // PT_DYNAMIC
+        std::vector<std::string> needed;
+        std::string soname;
+        std::string rpath;
+        std::string runpath;
+        bool bind_now = false;
+        std::size_t relocation_count = 0;
+        std::size_t relr_count = 0;             // of which packed RELR
+
+        // .eh_frame
+        std::size_t unwind_function_count = 0;
+        bool unwind_search_table = false;       // .eh_frame_hdr present and usable
+
+        // DWARF address -> file:line; null without .debug_line
+        std::shared_ptr<const peelf::DwarfLineIndex> line_index;
+        // Lazy .debug_info view (unit headers only); null without one
+        std::shared_ptr<const peelf::DwarfInfo> debug_info;
+
+        // Separate debug file the symbols and DWARF above were merged from;
+        // empty when none was found. debug_file_data keeps it mapped while
+        // the DWARF views point into it
+        std::string debug_file;
+        std::shared_ptr<const void> debug_file_data;
+
+        // GNU notes
+        std::string build_id;                   // hex, empty when absent
+
+        // Highest required versions, e.g. "2.34"; empty when not required
+        std::string max_glibc;
+        std::string max_glibcxx;
+
+        // ET_CORE opened through mapped windows; raw_data is then null and
+        // memory is read through the core by virtual address
+        std::shared_ptr<const peelf::ElfCore> core;
+
+        // Raw data reference (set by parser)
+        const std::uint8_t* raw_data = nullptr;
+        std::size_t raw_size = 0;
+
+        [[nodiscard]] const ElfSectionHeader* section_by_name(const std::string& name) const {
+            for (const auto& section : sections) {
+                if (section.name == name) {
+                    return &section;
+                }
+            }
+            return nullptr;
+        }
+
+        // Virtual address -> file offset through the PT_LOAD segments
+        [[nodiscard]] std::optional<std::size_t> vaddr_to_offset(std::uint64_t vaddr) const {
+            for (const auto& seg : segments) {
+                if (seg.type != 1)  // PT_LOAD
+                    continue;
+                if (vaddr >= seg.vaddr && vaddr - seg.vaddr < seg.file_size) {
+                    return static_cast<std::size_t>(seg.offset + (vaddr - seg.vaddr));
+                }
+            }
+            return std::nullopt;
+        }
+
+        [[nodiscard]] bool is_shared_object() const { return type == 3; }   // ET_DYN
+        [[nodiscard]] bool is_executable() const { return type == 2; }      // ET_EXEC
+        [[nodiscard]] bool is_relocatable() const { return type == 1; }     // ET_REL
+        [[nodiscard]] bool is_core() const { return type == 4; }            // ET_CORE
+    };
+
+} // namespace viewer
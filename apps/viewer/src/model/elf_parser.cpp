@@ -0,0 +1,298 @@
+#include "elf_parser.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "dwarf/dwarf_info.hpp"
+#include "dwarf/dwarf_line.hpp"
+#include "elf/elf_core.hpp"
+#include "elf/elf_dynamic.hpp"
+#include "elf/elf_notes.hpp"
+#include "elf/elf_relocations.hpp"
+#include "elf/elf_symbols.hpp"
+#include "elf/elf_unwind.hpp"
+#include "elf/elf_versions.hpp"
+#include "elf/elf_view.hpp"
+#include "mapping/file_mapping.hpp"
+
+namespace viewer {
+
+static std::string machine_name(std::uint16_t machine, bool is_64) {
+    switch (machine) {
+        case peelf::EM_386:       return "x86";
+        case peelf::EM_X86_64:    return "x64";
+        case peelf::EM_ARM:       return "ARM32";
+        case peelf::EM_AARCH64:   return "ARM64";
+        case peelf::EM_RISCV:     return is_64 ? "RISC-V 64" : "RISC-V 32";
+        case peelf::EM_MIPS:      return is_64 ? "MIPS64" : "MIPS";
+        case peelf::EM_PPC:       return "PowerPC";
+        case peelf::EM_PPC64:     return "PowerPC64";
+        case peelf::EM_S390:      return "s390x";
+        case peelf::EM_SPARCV9:   return "SPARC V9";
+        case peelf::EM_LOONGARCH: return "LoongArch";
+        default:                  return "EM_" + std::to_string(machine);
+    }
+}
+
+static const char* type_name(std::uint16_t type) {
+    switch (type) {
+        case peelf::ET_REL:  return "Relocatable";
+        case peelf::ET_EXEC: return "Executable";
+        case peelf::ET_DYN:  return "Shared object / PIE";
+        case peelf::ET_CORE: return "Core dump";
+        default:             return nullptr;
+    }
+}
+
+static void append_symbols(const peelf::ElfSymbolTable& table, bool dynamic,
+                           const peelf::ElfSymbolVersions* versions, std::vector<ElfSymbol>& out) {
+    for (std::size_t i = 1; i < table.size(); ++i) {
+        out.push_back(ElfSymbol{
+            .name = std::string(table.name(i)),
+            .value = table.value(i),
+            .size = table.symbol_size(i),
+            .type = table.type(i),
+            .binding = table.binding(i),
+            .section_index = table.section_index(i),
+            .dynamic = dynamic,
+            .version = versions ? std::string(versions->name(i)) : std::string(),
+            .default_version = versions && table.is_defined(i) && !versions->is_hidden(i)
+                               && versions->file(i).empty(),
+        });
+    }
+}
+
+static void load_dwarf(const peelf::ElfView& elf, ElfModel& out, ElfParseResult& result) {
+    const auto dwarf = peelf::DwarfSections::from_elf(elf);
+    if (!dwarf) {
+        result.flags.push_back("Debug info unreadable: " + dwarf.error().message);
+        return;
+    }
+    if (dwarf->empty())
+        return;
+
+    bool readable = true;
+    if (!dwarf->line.empty()) {
+        if (auto index = peelf::DwarfLineIndex::build(*dwarf))
+            out.line_index = std::make_shared<const peelf::DwarfLineIndex>(std::move(*index));
+        else
+            readable = false;
+    }
+    if (!dwarf->info.empty()) {
+        if (auto info = peelf::DwarfInfo::load(*dwarf))
+            out.debug_info = std::make_shared<const peelf::DwarfInfo>(std::move(*info));
+        else
+            readable = false;
+    }
+    result.flags.push_back(readable ? "DebugInfo" : "Debug info unreadable");
+    if (dwarf->decompressed())
+        result.flags.push_back("CompressedDebug");
+}
+
+ElfParseResult ElfParser::parse(std::span<const std::uint8_t> data, ElfModel& out) {
+    ElfParseResult result;
+
+    auto elf = peelf::ElfView::parse(data);
+    if (!elf) {
+        result.error = elf.error().message;
+        return result;
+    }
+
+    out.is_64 = elf->is_64();
+    out.is_big_endian = elf->data_encoding() == peelf::ELFDATA2MSB;
+    out.os_abi = elf->os_abi();
+    out.type = elf->type();
+    out.machine = elf->machine();
+    out.entry = elf->entry();
+    out.flags = elf->flags();
+
+    out.raw_data = data.data();
+    out.raw_size = data.size();
+
+    out.sections.clear();
+    out.sections.reserve(elf->section_count());
+    for (std::size_t i = 0; i < elf->section_count(); ++i) {
+        const auto s = elf->section(i);
+        out.sections.push_back(ElfSectionHeader{
+            .name = std::string(elf->section_name(i)),
+            .type = s.type,
+            .flags = s.flags,
+            .address = s.addr,
+            .offset = s.offset,
+            .size = s.size,
+            .link = s.link,
+            .info = s.info,
+            .alignment = s.addralign,
+            .entry_size = s.entsize,
+        });
+    }
+
+    out.segments.clear();
+    out.segments.reserve(elf->segment_count());
+    for (std::size_t i = 0; i < elf->segment_count(); ++i) {
+        const auto p = elf->segment(i);
+        out.segments.push_back(ElfProgramHeader{
+            .type = p.type,
+            .flags = p.flags,
+            .offset = p.offset,
+            .vaddr = p.vaddr,
+            .paddr = p.paddr,
+            .file_size = p.filesz,
+            .mem_size = p.memsz,
+            .alignment = p.align,
+        });
+    }
+
+    auto versions = peelf::ElfSymbolVersions::load(*elf);
+    if (!versions)
+        result.flags.push_back("Symbol versions unreadable");
+
+    out.symbols.clear();
+    for (bool dynamic : {true, false}) {
+        auto table = dynamic ? peelf::read_dynsym(*elf) : peelf::read_symtab(*elf);
+        if (!table) {
+            result.flags.push_back(std::string(dynamic ? ".dynsym" : ".symtab") + " unreadable");
+            continue;
+        }
+        if (!dynamic && table->empty())
+            result.flags.push_back("Stripped");
+        append_symbols(*table, dynamic, dynamic && versions ? &*versions : nullptr, out.symbols);
+    }
+
+    out.needed.clear();
+    if (auto dyn = peelf::read_dynamic(*elf)) {
+        for (auto n : dyn->needed)
+            out.needed.emplace_back(n);
+        out.soname = std::string(dyn->soname);
+        out.rpath = std::string(dyn->rpath);
+        out.runpath = std::string(dyn->runpath);
+        out.bind_now = dyn->bind_now;
+
+        if (auto relocs = peelf::ElfRelocationTable::load(*elf, *dyn)) {
+            out.relocation_count = relocs->size();
+            out.relr_count = relocs->relr_count();
+        } else {
+            result.flags.push_back("Relocations unreadable");
+        }
+    } else {
+        result.flags.push_back("Dynamic section unreadable");
+    }
+
+    out.unwind_function_count = 0;
+    out.unwind_search_table = false;
+    if (auto unwind = peelf::ElfUnwindTable::load(*elf)) {
+        out.unwind_function_count = unwind->fde_count();
+        out.unwind_search_table = unwind->has_search_table();
+    } else {
+        result.flags.push_back("Unwind info unreadable");
+    }
+
+    out.line_index.reset();
+    out.debug_info.reset();
+    out.debug_file.clear();
+    out.debug_file_data.reset();
+    load_dwarf(*elf, out, result);
+
+    out.build_id.clear();
+    if (auto info = peelf::read_build_info(data)) {
+        out.build_id = info->build_id_hex();
+        if (info->x86_features & peelf::GNU_PROPERTY_X86_FEATURE_1_IBT)
+            result.flags.push_back("IBT");
+        if (info->x86_features & peelf::GNU_PROPERTY_X86_FEATURE_1_SHSTK)
+            result.flags.push_back("SHSTK");
+        if (info->aarch64_features & peelf::GNU_PROPERTY_AARCH64_FEATURE_1_BTI)
+            result.flags.push_back("BTI");
+        if (info->aarch64_features & peelf::GNU_PROPERTY_AARCH64_FEATURE_1_PAC)
+            result.flags.push_back("PAC");
+    }
+
+    if (auto required = peelf::read_required_versions(*elf)) {
+        out.max_glibc = required->glibc ? required->glibc->to_string() : std::string();
+        out.max_glibcxx = required->glibcxx ? required->glibcxx->to_string() : std::string();
+    }
+
+    if (const char* t = type_name(out.type))
+        result.flags.push_back(t);
+    if (out.is_big_endian)
+        result.flags.push_back("BigEndian");
+    if (out.bind_now)
+        result.flags.push_back("BindNow");
+
+    result.success = true;
+    result.is_64 = out.is_64;
+    result.arch = machine_name(out.machine, out.is_64);
+    result.entry_point = out.entry;
+    return result;
+}
+
+ElfParseResult ElfParser::parse_core(std::shared_ptr<const peelf::ElfCore> core, ElfModel& out) {
+    ElfParseResult result;
+
+    out = ElfModel{};
+    out.is_64 = core->is_64();
+    out.is_big_endian = core->is_big_endian();
+    out.type = peelf::ET_CORE;
+    out.machine = core->machine();
+    // The crashed program's entry point, from its auxiliary vector
+    out.entry = core->auxv_value(peelf::AT_ENTRY).value_or(0);
+
+    out.segments.reserve(core->segments().size());
+    for (const auto& s : core->segments()) {
+        out.segments.push_back(ElfProgramHeader{
+            .type = peelf::PT_LOAD,
+            .flags = s.flags,
+            .offset = s.offset,
+            .vaddr = s.vaddr,
+            .file_size = s.file_size,
+            .mem_size = s.mem_size,
+        });
+    }
+
+    result.flags.push_back(type_name(peelf::ET_CORE));
+    if (out.is_big_endian)
+        result.flags.push_back("BigEndian");
+    result.flags.push_back(std::to_string(core->threads().size()) + " threads");
+    if (const auto& sig = core->signal()) {
+        char buf[64];
+        if (sig->fault_address)
+            std::snprintf(buf, sizeof(buf), "Signal %d at 0x%llx", sig->signo,
+                          static_cast<unsigned long long>(*sig->fault_address));
+        else
+            std::snprintf(buf, sizeof(buf), "Signal %d", sig->signo);
+        result.flags.push_back(buf);
+    }
+
+    out.core = std::move(core);
+    result.success = true;
+    result.is_64 = out.is_64;
+    result.arch = machine_name(out.machine, out.is_64);
+    result.entry_point = out.entry;
+    return result;
+}
+
+bool ElfParser::merge_debug_file(const std::filesystem::path& path, ElfModel& out, ElfParseResult& result) {
+    // Mapped rather than read: debug files are often many times the binary
+    auto map = std::make_shared<peelf::FileMapping<std::uint8_t, peelf::NativeFileMappingBackend>>();
+    if (map->open(path.string()))
+        return false;
+    auto elf = peelf::ElfView::parse(map->view());
+    if (!elf || elf->machine() != out.machine || elf->is_64() != out.is_64)
+        return false;
+
+    const bool has_symtab = std::any_of(out.symbols.begin(), out.symbols.end(),
+                                        [](const ElfSymbol& s) { return !s.dynamic; });
+    if (!has_symtab) {
+        if (auto table = peelf::read_symtab(*elf))
+            append_symbols(*table, false, nullptr, out.symbols);
+    }
+    if (!out.line_index && !out.debug_info)
+        load_dwarf(*elf, out, result);
+
+    out.debug_file = path.string();
+    out.debug_file_data = std::move(map);
+    return true;
+}
+
+} // namespace viewer
@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+#include "elf_model.hpp"
+
+namespace viewer {
+
+    struct ElfParseResult {
+        bool success = false;
+        bool is_64 = false;
+        std::string arch;
+        std::uint64_t entry_point = 0;
+        std::vector<std::string> flags;
+        std::string error;
+    };
+
+    // Thin adapter: parsing is done by peelf::ElfView, this only copies the
+    // pieces the panels display into an ElfModel.
+    class ElfParser {
+    public:
+        static ElfParseResult parse(std::span<const std::uint8_t> data, ElfModel& out);
+        // Core dumps are not loaded whole: only the headers and notes have
+        // been read, and the model keeps the core for memory access
+        static ElfParseResult parse_core(std::shared_ptr<const peelf::ElfCore> core, ElfModel& out);
+        // Fills in what a stripped binary lacks from its separate debug file:
+        // .symtab symbols and DWARF. Returns false if the file is unusable
+        static bool merge_debug_file(const std::filesystem::path& path, ElfModel& out, ElfParseResult& result);
+    };
+
+} // namespace viewer
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace viewer {
+
+    struct MachOLoadCommandInfo {
+        std::uint32_t cmd = 0;
+        std::uint32_t size = 0;
+        std::uint64_t offset = 0;       // in the slice
+    };
+
+    struct MachOSegmentInfo {
+        std::string name;
+        std::uint64_t vmaddr = 0;
+        std::uint64_t vmsize = 0;
+        std::uint64_t fileoff = 0;
+        std::uint64_t filesize = 0;
+        std::uint32_t initprot = 0;
+    };
+
+    struct MachOSectionInfo {
+        std::string segment;
+        std::string name;
+        std::uint64_t addr = 0;
+        std::uint64_t size = 0;
+        std::uint32_t offset = 0;
+        std::uint32_t flags = 0;
+    };
+
+    struct MachOSymbolInfo {
+        std::string name;
+        std::uint64_t value = 0;
+        std::uint8_t type = 0;          // N_*
+        std::uint8_t section = 0;
+        bool external = false;
+        bool defined = false;
+    };
+
+    struct MachOExportInfo {
+        std::string name;
+        std::uint64_t address = 0;      // vmaddr; 0 for re-exports
+        std::uint64_t flags = 0;        // EXPORT_SYMBOL_FLAGS_*
+    };
+
+    // One architecture; a thin file has a single slice at offset 0
+    struct MachOSliceModel {
+        std::string arch;
+        std::uint32_t cpu_type = 0;
+        std::uint32_t cpu_subtype = 0;
+        std::uint64_t offset = 0;       // in the file
+        std::uint64_t size = 0;
+        bool readable = false;          // header and load commands parsed
+        std::string error;              // why the slice, or its first bad table, could not be read
+
+        bool is_64 = false;
+        std::uint32_t file_type = 0;
+        std::uint32_t flags = 0;
+        std::optional<std::uint64_t> entry_point;
+        std::string uuid;
+        std::string install_name;
+        std::vector<std::string> dylibs;
+        std::vector<std::string> rpaths;
+
+        std::vector<MachOLoadCommandInfo> commands;
+        std::vector<MachOSegmentInfo> segments;
+        std::vector<MachOSectionInfo> sections;
+        std::vector<MachOSymbolInfo> symbols;
+        std::vector<MachOExportInfo> exports;
+
+        // LC_DYLD_CHAINED_FIXUPS
+        std::uint16_t pointer_format = 0;
+        std::size_t chained_imports = 0;
+        std::size_t rebases = 0;
+        std::size_t binds = 0;
+    };
+
+    class MachOModel {
+    public:
+        bool fat = false;
+        std::vector<MachOSliceModel> slices;
+    };
+
+} // namespace viewer
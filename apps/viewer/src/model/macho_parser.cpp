@@ -0,0 +1,211 @@
+#include "macho_parser.hpp"
+
+#include <array>
+#include <cstdio>
+#include <string>
+
+#include "macho/macho_fixups.hpp"
+#include "macho/macho_symbols.hpp"
+#include "macho/macho_view.hpp"
+#include "peelf/parallel.hpp"
+
+namespace viewer {
+
+static std::string cpu_name(std::uint32_t cpu_type, std::uint32_t cpu_subtype) {
+    switch (cpu_type) {
+        case peelf::CPU_TYPE_X86:      return "x86";
+        case peelf::CPU_TYPE_X86_64:   return "x64";
+        case peelf::CPU_TYPE_ARM:      return "ARM32";
+        case peelf::CPU_TYPE_ARM64:
+            return (cpu_subtype & ~peelf::CPU_SUBTYPE_MASK) == peelf::CPU_SUBTYPE_ARM64E ? "ARM64e" : "ARM64";
+        case peelf::CPU_TYPE_ARM64_32: return "ARM64_32";
+        case peelf::CPU_TYPE_POWERPC:  return "PowerPC";
+        default: {
+            char buf[16];
+            std::snprintf(buf, sizeof(buf), "0x%X", cpu_type);
+            return buf;
+        }
+    }
+}
+
+static const char* file_type_name(std::uint32_t type) {
+    switch (type) {
+        case peelf::MH_OBJECT:      return "Object";
+        case peelf::MH_EXECUTE:     return "Executable";
+        case peelf::MH_DYLIB:       return "Dynamic library";
+        case peelf::MH_DYLINKER:    return "Dynamic linker";
+        case peelf::MH_BUNDLE:      return "Bundle";
+        case peelf::MH_DSYM:        return "dSYM companion";
+        case peelf::MH_KEXT_BUNDLE: return "Kernel extension";
+        case peelf::MH_FILESET:     return "Fileset";
+        default:                    return nullptr;
+    }
+}
+
+static std::string uuid_string(const std::array<std::uint8_t, 16>& u) {
+    char buf[40];
+    std::snprintf(buf, sizeof(buf),
+                  "%02X%02X%02X%02X-%02X%02X-%02X%02X-%02X%02X-%02X%02X%02X%02X%02X%02X",
+                  u[0], u[1], u[2], u[3], u[4], u[5], u[6], u[7],
+                  u[8], u[9], u[10], u[11], u[12], u[13], u[14], u[15]);
+    return buf;
+}
+
+static void fill_slice(const peelf::MachOView& m, MachOSliceModel& out) {
+    out.readable = true;
+    out.cpu_type = m.cpu_type();
+    out.cpu_subtype = m.cpu_subtype();
+    out.arch = cpu_name(out.cpu_type, out.cpu_subtype);
+    out.is_64 = m.is_64();
+    out.file_type = m.file_type();
+    out.flags = m.flags();
+    out.entry_point = m.entry_point();
+    if (const auto uuid = m.uuid())
+        out.uuid = uuid_string(*uuid);
+    out.install_name = std::string(m.install_name());
+    for (const auto& d : m.dylibs())
+        out.dylibs.emplace_back(d.name);
+    for (auto r : m.rpaths())
+        out.rpaths.emplace_back(r);
+
+    for (const auto& c : m.commands())
+        out.commands.push_back(MachOLoadCommandInfo{.cmd = c.cmd, .size = c.size, .offset = c.offset});
+
+    for (std::size_t i = 0; i < m.segment_count(); ++i) {
+        const auto s = m.segment(i);
+        out.segments.push_back(MachOSegmentInfo{
+            .name = std::string(s.name),
+            .vmaddr = s.vmaddr,
+            .vmsize = s.vmsize,
+            .fileoff = s.fileoff,
+            .filesize = s.filesize,
+            .initprot = s.initprot,
+        });
+    }
+    for (std::size_t i = 1; i <= m.section_count(); ++i) {
+        const auto s = m.section(i);
+        out.sections.push_back(MachOSectionInfo{
+            .segment = std::string(s.segment_name),
+            .name = std::string(s.name),
+            .addr = s.addr,
+            .size = s.size,
+            .offset = s.offset,
+            .flags = s.flags,
+        });
+    }
+
+    // Each table is optional: a bad one is reported, the rest still shown
+    if (auto symbols = peelf::read_symbols(m)) {
+        out.symbols.reserve(symbols->size());
+        for (const auto& s : *symbols) {
+            if (s.is_debug())
+                continue;
+            out.symbols.push_back(MachOSymbolInfo{
+                .name = std::string(s.name),
+                .value = s.value,
+                .type = s.type,
+                .section = s.section,
+                .external = s.is_external(),
+                .defined = s.is_defined(),
+            });
+        }
+    } else if (out.error.empty()) {
+        out.error = symbols.error().message;
+    }
+
+    if (auto exports = peelf::read_exports(m)) {
+        const std::uint64_t base = m.image_base();
+        out.exports.reserve(exports->size());
+        for (auto& e : *exports) {
+            out.exports.push_back(MachOExportInfo{
+                .name = std::move(e.name),
+                .address = e.is_reexport() ? 0 : base + e.address,
+                .flags = e.flags,
+            });
+        }
+    } else if (out.error.empty()) {
+        out.error = exports.error().message;
+    }
+
+    if (auto fixups = peelf::read_chained_fixups(m)) {
+        out.pointer_format = fixups->pointer_format;
+        out.chained_imports = fixups->imports.size();
+        for (const auto& f : fixups->fixups)
+            ++(f.bind ? out.binds : out.rebases);
+    } else if (out.error.empty()) {
+        out.error = fixups.error().message;
+    }
+}
+
+MachOParseResult MachOParser::parse(std::span<const std::uint8_t> data, MachOModel& out) {
+    MachOParseResult result;
+    out = MachOModel{};
+
+    std::vector<peelf::MachOSlice> slices;
+    if (peelf::is_fat_macho(data)) {
+        auto fat = peelf::read_fat_slices(data);
+        if (!fat) {
+            result.error = fat.error().message;
+            return result;
+        }
+        slices = std::move(*fat);
+        out.fat = true;
+    } else {
+        slices.push_back(peelf::MachOSlice{.data = data});
+    }
+
+    out.slices.resize(slices.size());
+    peelf::parallel_for(slices.size(), [&](std::size_t i) {
+        auto& slice = out.slices[i];
+        slice.cpu_type = slices[i].cpu_type;
+        slice.cpu_subtype = slices[i].cpu_subtype;
+        slice.arch = cpu_name(slice.cpu_type, slice.cpu_subtype);
+        slice.offset = slices[i].offset;
+        slice.size = slices[i].data.size();
+
+        auto m = peelf::MachOView::parse(slices[i].data);
+        if (!m) {
+            slice.error = m.error().message;
+            return;
+        }
+        fill_slice(*m, slice);
+    });
+
+    // The first readable slice stands for the file
+    const MachOSliceModel* primary = nullptr;
+    for (const auto& s : out.slices) {
+        if (!result.arch.empty())
+            result.arch += " + ";
+        result.arch += s.arch;
+        if (!primary && s.readable)
+            primary = &s;
+    }
+    if (!primary) {
+        result.error = out.slices.empty() ? "Fat file without slices" : out.slices.front().error;
+        return result;
+    }
+
+    result.is_64 = primary->is_64;
+    result.format = out.fat ? "Mach-O universal" : primary->is_64 ? "Mach-O 64" : "Mach-O";
+    result.entry_point = primary->entry_point.value_or(0);
+
+    if (const char* type = file_type_name(primary->file_type))
+        result.flags.push_back(type);
+    if (primary->flags & peelf::MH_PIE)
+        result.flags.push_back("PIE");
+    if (primary->flags & peelf::MH_TWOLEVEL)
+        result.flags.push_back("Two-level namespace");
+    if (primary->pointer_format != 0)
+        result.flags.push_back("Chained fixups");
+    if (out.fat)
+        result.flags.push_back(std::to_string(out.slices.size()) + " slices");
+    for (const auto& s : out.slices) {
+        if (!s.error.empty())
+            result.flags.push_back(s.arch + ": " + s.error);
+    }
+
+    result.success = true;
+    return result;
+}
+
+} // namespace viewer
@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+#include "macho_model.hpp"
+
+namespace viewer {
+
+    struct MachOParseResult {
+        bool success = false;
+        bool is_64 = false;             // of the first slice
+        std::string format;             // "Mach-O 64", "Mach-O universal", ...
+        std::string arch;               // of every slice, e.g. "x64 + ARM64"
+        std::uint64_t entry_point = 0;
+        std::vector<std::string> flags;
+        std::string error;
+    };
+
+    // Thin adapter over peelf::MachOView: every slice of a fat binary is
+    // parsed and copied into its MachOSliceModel on its own worker.
+    class MachOParser {
+    public:
+        static MachOParseResult parse(std::span<const std::uint8_t> data, MachOModel& out);
+    };
+
+} // namespace viewer
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace peelf {
+    class Minidump;
+}
+
+namespace viewer {
+
+    struct MinidumpModuleInfo {
+        std::string path;
+        std::uint64_t base = 0;
+        std::uint32_t size = 0;
+        std::uint32_t timestamp = 0;
+        std::string version;            // "10.0.19041.1", empty without VS_FIXEDFILEINFO
+        std::string pdb;                // CodeView path, empty when absent
+
+        // The embedded image, parsed in loaded layout
+        bool image_dumped = false;      // headers present in the dump
+        std::string image_error;        // why PeView rejected it
+        std::uint16_t machine = 0;
+        std::size_t imports = 0;
+        std::size_t exports = 0;
+    };
+
+    struct MinidumpThreadInfo {
+        std::uint32_t tid = 0;
+        std::optional<std::uint64_t> pc;
+        std::optional<std::uint64_t> sp;
+        std::uint64_t stack_start = 0;
+        std::uint64_t stack_size = 0;
+        std::uint64_t teb = 0;
+    };
+
+    class MinidumpModel {
+    public:
+        std::vector<MinidumpModuleInfo> modules;            // by base
+        std::vector<MinidumpThreadInfo> threads;
+
+        // Exception stream, when the dump was written for a crash
+        bool has_exception = false;
+        std::uint32_t exception_thread = 0;
+        std::uint32_t exception_code = 0;
+        std::uint64_t exception_address = 0;
+        std::vector<std::uint64_t> exception_parameters;
+
+        std::string os;                 // "Windows 10.0.19045", empty without SystemInfo
+        std::size_t memory_ranges = 0;
+        std::uint64_t memory_bytes = 0;
+
+        // Opened through mapped windows; process memory and module images
+        // are read through it
+        std::shared_ptr<const peelf::Minidump> dump;
+    };
+
+} // namespace viewer
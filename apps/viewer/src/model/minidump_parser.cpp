@@ -0,0 +1,117 @@
+#include "minidump_parser.hpp"
+
+#include <cstdio>
+#include <string>
+
+#include "minidump/minidump.hpp"
+#include "pe/pe_view.hpp"
+#include "peelf/parallel.hpp"
+
+namespace viewer {
+
+static const char* arch_name(std::uint16_t architecture) {
+    switch (architecture) {
+        case peelf::PROCESSOR_ARCHITECTURE_INTEL: return "x86";
+        case peelf::PROCESSOR_ARCHITECTURE_AMD64: return "x64";
+        case peelf::PROCESSOR_ARCHITECTURE_ARM:   return "ARM32";
+        case peelf::PROCESSOR_ARCHITECTURE_ARM64: return "ARM64";
+        case peelf::PROCESSOR_ARCHITECTURE_IA64:  return "IA-64";
+        default:                                  return "Unknown";
+    }
+}
+
+static void fill_module(const peelf::Minidump& dump, const peelf::MinidumpModule& m, MinidumpModuleInfo& out) {
+    out.path = m.path;
+    out.base = m.base;
+    out.size = m.size;
+    out.timestamp = m.timestamp;
+    if (m.version)
+        out.version = m.version->file_version();
+    if (m.codeview)
+        out.pdb = m.codeview->pdb_path;
+
+    // The view (or gathered copy) only has to live while it is parsed
+    const auto image = dump.module_image(m);
+    if (image.bytes.empty())
+        return;
+    out.image_dumped = true;
+
+    auto pe = peelf::PeView::parse(image.bytes, {}, peelf::PeLayout::Image);
+    if (!pe) {
+        out.image_error = pe.error().message;
+        return;
+    }
+    out.machine = pe->machine();
+    if (auto imports = pe->imports())
+        out.imports = imports->size();
+    else
+        out.image_error = imports.error().message;
+    if (auto exports = pe->exports())
+        out.exports = exports->size();
+    else if (out.image_error.empty())
+        out.image_error = exports.error().message;
+}
+
+MinidumpParseResult MinidumpParser::parse(std::shared_ptr<const peelf::Minidump> dump, MinidumpModel& out) {
+    MinidumpParseResult result;
+    out = MinidumpModel{};
+
+    const auto modules = dump->modules();
+    out.modules.resize(modules.size());
+    peelf::parallel_for(modules.size(), [&](std::size_t i) {
+        fill_module(*dump, modules[i], out.modules[i]);
+    });
+
+    out.threads.reserve(dump->threads().size());
+    for (const auto& t : dump->threads()) {
+        out.threads.push_back(MinidumpThreadInfo{
+            .tid = t.tid,
+            .pc = t.pc,
+            .sp = t.sp,
+            .stack_start = t.stack_start,
+            .stack_size = t.stack_size,
+            .teb = t.teb,
+        });
+    }
+
+    if (const auto& e = dump->exception()) {
+        out.has_exception = true;
+        out.exception_thread = e->thread_id;
+        out.exception_code = e->code;
+        out.exception_address = e->address;
+        out.exception_parameters = e->parameters;
+    }
+
+    out.memory_ranges = dump->memory_ranges().size();
+    for (const auto& r : dump->memory_ranges())
+        out.memory_bytes += r.size;
+
+    result.arch = "Unknown";
+    if (const auto& si = dump->system_info()) {
+        result.arch = arch_name(si->architecture);
+        result.is_64 = si->architecture == peelf::PROCESSOR_ARCHITECTURE_AMD64 ||
+                       si->architecture == peelf::PROCESSOR_ARCHITECTURE_ARM64 ||
+                       si->architecture == peelf::PROCESSOR_ARCHITECTURE_IA64;
+        out.os = "Windows " + std::to_string(si->major_version) + "." + std::to_string(si->minor_version) +
+                 "." + std::to_string(si->build_number);
+        if (!si->service_pack.empty())
+            out.os += " " + si->service_pack;
+    }
+
+    result.flags.push_back(dump->has_full_memory() ? "Full memory" : "Partial memory");
+    result.flags.push_back(std::to_string(out.modules.size()) + " modules");
+    result.flags.push_back(std::to_string(out.threads.size()) + " threads");
+    if (out.has_exception) {
+        char buf[64];
+        std::snprintf(buf, sizeof(buf), "Exception 0x%08X at 0x%llx", out.exception_code,
+                      static_cast<unsigned long long>(out.exception_address));
+        result.flags.push_back(buf);
+        result.entry_point = out.exception_address;
+    }
+
+    out.dump = std::move(dump);
+    result.success = true;
+    return result;
+}
+
+} // namespace viewer
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "minidump_model.hpp"
+
+namespace viewer {
+
+    struct MinidumpParseResult {
+        bool success = false;
+        bool is_64 = false;
+        std::string arch;
+        std::uint64_t entry_point = 0;  // faulting address, when there is one
+        std::vector<std::string> flags;
+        std::string error;
+    };
+
+    // Thin adapter over peelf::Minidump. Every module whose image was
+    // dumped is parsed in place as a mapped PE, on its own worker.
+    class MinidumpParser {
+    public:
+        static MinidumpParseResult parse(std::shared_ptr<const peelf::Minidump> dump, MinidumpModel& out);
+    };
+
+} // namespace viewer
@@ -7,6 +7,8 @@
 #include <algorithm>
 #include <cstring>
 
+#include "peelf/interval_tree.hpp"
+
 namespace viewer {
 
     struct PeDataDirectory {
@@ -36,6 +38,24 @@ namespace viewer {
         std::uint32_t raw_offset = 0;
         std::uint32_t raw_size = 0;
         std::uint32_t characteristics = 0;
+        double entropy = 0.0;        // Shannon entropy of the raw data, bits per byte
+    };
+
+    // On-disk layout, or the loaded layout of a module dump where RVA == offset
+    enum class PeLayout {
+        File,
+        Image
+    };
+
+    // One finding of peelf::analyze_section_layout
+    struct PeSectionIssueInfo {
+        std::size_t section = 0;
+        std::string description;
+    };
+
+    struct PeVersionEntry {
+        std::string key;
+        std::string value;
     };
 
     class PeModel {
@@ -57,6 +77,7 @@ namespace viewer {
         std::uint16_t dll_characteristics = 0;
         std::uint32_t checksum = 0;
         bool is_pe32_plus = false;
+        PeLayout layout = PeLayout::File;
 
         // Parsed structures
         std::vector<PeDataDirectory> data_directories;
@@ -64,6 +85,18 @@ namespace viewer {
         std::vector<PeImportEntry> imports;
         std::vector<PeExportEntry> exports;
 
+        // Section table layout check; empty issues for a well-formed table
+        std::vector<PeSectionIssueInfo> section_issues;     // by section
+        std::uint64_t overlay_offset = 0;                   // data past the last section's raw end
+        std::uint64_t overlay_size = 0;
+        double headers_entropy = 0.0;
+        double overlay_entropy = 0.0;
+
+        // VS_VERSIONINFO (empty when the image has no RT_VERSION resource)
+        std::string file_version;
+        std::string product_version;
+        std::vector<PeVersionEntry> version_strings;
+
         // Raw data reference (set by parser)
         const std::uint8_t* raw_data = nullptr;
         std::size_t raw_size = 0;
@@ -72,21 +105,25 @@ namespace viewer {
         // Address Conversion
         // =====================================================================
 
+        [[nodiscard]] bool is_mapped_image() const {
+            return layout == PeLayout::Image;
+        }
+
         // Convert RVA to file offset
         [[nodiscard]] std::optional<std::size_t> rva_to_offset(std::uint32_t rva) const {
-            for (const auto& section : sections) {
-                std::uint32_t section_end = section.virtual_address +
-                    std::max(section.virtual_size, section.raw_size);
+            if (is_mapped_image()) {
+                if (rva < raw_size) return static_cast<std::size_t>(rva);
+                return std::nullopt;
+            }
 
-                if (rva >= section.virtual_address && rva < section_end) {
-                    std::uint32_t offset_in_section = rva - section.virtual_address;
+            if (const auto* section = section_from_rva(rva)) {
+                std::uint32_t offset_in_section = rva - section->virtual_address;
 
-                    // Ensure within raw data bounds
-                    if (offset_in_section < section.raw_size) {
-                        return section.raw_offset + offset_in_section;
-                    }
-                    return std::nullopt;  // In virtual padding (uninitialized data)
+                // Ensure within raw data bounds
+                if (offset_in_section < section->raw_size) {
+                    return section->raw_offset + offset_in_section;
                 }
+                return std::nullopt;  // In virtual padding (uninitialized data)
             }
 
             // RVA might be in headers (before first section)
@@ -99,12 +136,14 @@ namespace viewer {
 
         // Convert file offset to RVA
         [[nodiscard]] std::optional<std::uint32_t> offset_to_rva(std::size_t offset) const {
-            for (const auto& section : sections) {
-                if (offset >= section.raw_offset &&
-                    offset < section.raw_offset + section.raw_size) {
-                    std::uint32_t offset_in_section = static_cast<std::uint32_t>(offset - section.raw_offset);
-                    return section.virtual_address + offset_in_section;
-                }
+            if (is_mapped_image()) {
+                if (offset < raw_size && offset <= 0xFFFFFFFF) return static_cast<std::uint32_t>(offset);
+                return std::nullopt;
+            }
+
+            if (const auto* section = first_containing(raw_index_, offset)) {
+                std::uint32_t offset_in_section = static_cast<std::uint32_t>(offset - section->raw_offset);
+                return section->virtual_address + offset_in_section;
             }
 
             // Check if in headers
@@ -163,16 +202,10 @@ namespace viewer {
         // Section Utilities
         // =====================================================================
 
+        // First section in table order whose [virtual_address,
+        // virtual_address + max(virtual_size, raw_size)) contains rva
         [[nodiscard]] const PeSectionHeader* section_from_rva(std::uint32_t rva) const {
-            for (const auto& section : sections) {
-                std::uint32_t section_end = section.virtual_address +
-                    std::max(section.virtual_size, section.raw_size);
-
-                if (rva >= section.virtual_address && rva < section_end) {
-                    return &section;
-                }
-            }
-            return nullptr;
+            return first_containing(virtual_index_, rva);
         }
 
         [[nodiscard]] const PeSectionHeader* section_from_va(std::uint64_t va) const {
@@ -182,13 +215,17 @@ namespace viewer {
         }
 
         [[nodiscard]] const PeSectionHeader* section_from_offset(std::size_t offset) const {
-            for (const auto& section : sections) {
-                if (offset >= section.raw_offset &&
-                    offset < section.raw_offset + section.raw_size) {
-                    return &section;
-                }
+            if (is_mapped_image()) {
+                auto rva = offset_to_rva(offset);
+                return rva ? section_from_rva(*rva) : nullptr;
             }
-            return nullptr;
+
+            return first_containing(raw_index_, offset);
+        }
+
+        // Where the section's data starts in raw_data
+        [[nodiscard]] std::size_t section_offset(const PeSectionHeader& section) const {
+            return is_mapped_image() ? section.virtual_address : section.raw_offset;
         }
 
         [[nodiscard]] const PeSectionHeader* section_by_name(const std::string& name) const {
@@ -362,6 +399,41 @@ namespace viewer {
         [[nodiscard]] bool has_exports() const {
             return !exports.empty();
         }
+
+        // Rebuilds the trees behind the section lookups; call after
+        // filling sections. Crafted files carry up to 65535 sections,
+        // so lookups must not scan the table.
+        void build_section_index() {
+            std::vector<SectionTree::Interval> virtual_ranges;
+            std::vector<SectionTree::Interval> raw_ranges;
+            virtual_ranges.reserve(sections.size());
+            raw_ranges.reserve(sections.size());
+            for (std::uint32_t i = 0; i < sections.size(); ++i) {
+                const auto& s = sections[i];
+                virtual_ranges.push_back({s.virtual_address,
+                                          std::uint64_t{s.virtual_address} + std::max(s.virtual_size, s.raw_size), i});
+                raw_ranges.push_back({s.raw_offset, std::uint64_t{s.raw_offset} + s.raw_size, i});
+            }
+            virtual_index_ = SectionTree(std::move(virtual_ranges));
+            raw_index_ = SectionTree(std::move(raw_ranges));
+        }
+
+    private:
+        using SectionTree = peelf::IntervalTree<std::uint32_t>;
+
+        // Overlapping sections resolve to the first one in table order,
+        // as the linear scans this replaces did
+        [[nodiscard]] const PeSectionHeader* first_containing(const SectionTree& tree, std::uint64_t key) const {
+            std::uint32_t first = UINT32_MAX;
+            tree.containing(key, [&](const SectionTree::Interval& range) {
+                first = std::min(first, range.value);
+                return true;
+            });
+            return first < sections.size() ? &sections[first] : nullptr;
+        }
+
+        SectionTree virtual_index_;
+        SectionTree raw_index_;
     };
 
 } // namespace viewer
\ No newline at end of file
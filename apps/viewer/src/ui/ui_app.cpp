@@ -15,6 +15,10 @@ UiApp::UiApp(BinaryModel& model)
     , pe_headers_panel_(model)
     , pe_imports_panel_(model)
     , pe_exports_panel_(model)
+    , elf_symbols_panel_(model)
+    , archive_panel_(model)
+    , macho_panel_(model)
+    , minidump_panel_(model)
 {}
 
 void UiApp::render() {
@@ -28,6 +32,10 @@ void UiApp::render() {
     pe_headers_panel_.draw();
     pe_imports_panel_.draw();
     pe_exports_panel_.draw();
+    elf_symbols_panel_.draw();
+    archive_panel_.draw();
+    macho_panel_.draw();
+    minidump_panel_.draw();
     log_panel_.draw();
 
     disasm_panel_.current_instructions_= current_instructions_;
@@ -72,6 +80,30 @@ void UiApp::render_main_menu() {
                 pe_exports_panel_.set_visible(v);
         }
 
+        {
+            bool v = elf_symbols_panel_.visible();
+            if (ImGui::MenuItem(elf_symbols_panel_.name().c_str(), nullptr, &v))
+                elf_symbols_panel_.set_visible(v);
+        }
+
+        {
+            bool v = archive_panel_.visible();
+            if (ImGui::MenuItem(archive_panel_.name().c_str(), nullptr, &v))
+                archive_panel_.set_visible(v);
+        }
+
+        {
+            bool v = macho_panel_.visible();
+            if (ImGui::MenuItem(macho_panel_.name().c_str(), nullptr, &v))
+                macho_panel_.set_visible(v);
+        }
+
+        {
+            bool v = minidump_panel_.visible();
+            if (ImGui::MenuItem(minidump_panel_.name().c_str(), nullptr, &v))
+                minidump_panel_.set_visible(v);
+        }
+
         ImGui::EndMenu();
     }
 
@@ -162,6 +194,13 @@ void UiApp::render_dockspace() {
 }
     // After loading a PE file
     void UiApp::on_file_loaded() {
+        // Disassembly is only wired up for PE images so far
+        if (!model_.pe()) {
+            file_loaded_ = false;
+            current_instructions_.clear();
+            return;
+        }
+
         // Get machine type from PE header
         pe_model_ = *model_.pe();
         auto machine = pe_model_.machine;
@@ -204,7 +243,7 @@ void UiApp::render_dockspace() {
         }
 
         size_t size = std::min(max_size, static_cast<size_t>(section->raw_size));
-        const uint8_t* code = pe_model_.data_at_offset(section->raw_offset, size);
+        const uint8_t* code = pe_model_.data_at_offset(pe_model_.section_offset(*section), size);
         if (!code) {
             fprintf(stderr, "Failed to read section data\n");
             return;
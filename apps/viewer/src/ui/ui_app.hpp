@@ -45,6 +45,10 @@ namespace viewer {
         PeHeadersPanel  pe_headers_panel_;
         PeImportsPanel  pe_imports_panel_;
         PeExportsPanel  pe_exports_panel_;
+        ElfSymbolsPanel elf_symbols_panel_;
+        ArchivePanel    archive_panel_;
+        MachOPanel      macho_panel_;
+        MinidumpPanel   minidump_panel_;
 
         std::function<void()> on_open_file_;
 
@@ -3,11 +3,23 @@
 
 #include "ui_panel.hpp"
 #include "model/binary_model.hpp"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
 #include <vector>
 #include <string>
 
 #include "dissassembler/dissassembler.hpp"
 
+namespace peelf {
+    class BytePyramid;
+    class DwarfInfo;
+    class DwarfNameIndex;
+    class ElfCore;
+}
+
 namespace viewer {
 
     enum class LogLevel {
@@ -41,9 +53,26 @@ namespace viewer {
     protected:
         void draw_contents() override;
     private:
+        // Fills a row from the current space; returns the bytes available
+        using RowReader = std::function<size_t(uint64_t, std::span<uint8_t>)>;
+
+        // overview draws an entropy strip beside the rows; its pyramid must
+        // cover [base, base + total)
+        void draw_rows(uint64_t base, uint64_t total, const RowReader& read,
+                       const peelf::BytePyramid* overview = nullptr);
+        void draw_overview(const peelf::BytePyramid& pyramid, uint64_t visible_begin, uint64_t visible_end);
+        void draw_memory(const peelf::ElfCore& core);
+
         BinaryModel& model_;
         size_t selected_offset_ = 0;
         size_t bytes_per_row_ = 16;
+
+        // Core dumps can also be browsed by virtual address, one dumped
+        // PT_LOAD segment at a time
+        bool virtual_addresses_ = false;
+        size_t segment_ = 0;
+        char goto_buf_[32] = {};
+        std::optional<uint64_t> scroll_to_;
     };
 
     class DisassemblyPanel : public UiPanel {
@@ -58,7 +87,11 @@ namespace viewer {
         BinaryModel& model_;
         size_t selected_instr_ = 0;
 
-
+        // "file:line" per instruction where the location changes; rebuilt
+        // when the listing changes
+        void refresh_source_notes();
+        std::vector<std::string> source_notes_;
+        uint64_t notes_first_address_ = 0;
     };
 
     class LogPanel : public UiPanel {
@@ -115,4 +148,63 @@ namespace viewer {
         char filter_buf_[128] = {};
     };
 
+    // ELF-specific panels
+    class ElfSymbolsPanel : public UiPanel {
+    public:
+        explicit ElfSymbolsPanel(BinaryModel& model);
+    protected:
+        void draw_contents() override;
+    private:
+        void find_in_debug_info(const std::string& name);
+
+        BinaryModel& model_;
+        char filter_buf_[128] = {};
+
+        // Name index over the current file's DWARF, built on the first search
+        std::shared_ptr<const peelf::DwarfInfo> indexed_info_;
+        std::shared_ptr<const peelf::DwarfNameIndex> name_index_;
+        std::vector<std::string> dwarf_matches_;
+    };
+
+    // Static library panel
+    class ArchivePanel : public UiPanel {
+    public:
+        explicit ArchivePanel(BinaryModel& model);
+    protected:
+        void draw_contents() override;
+    private:
+        BinaryModel& model_;
+        char filter_buf_[128] = {};
+
+        // Indices into ArchiveModel::symbols whose names contain the
+        // filter; rebuilt only when the filter or the file changes, as a
+        // large library holds millions of definitions
+        std::string matched_filter_;
+        const ArchiveModel* matched_archive_ = nullptr;
+        std::vector<uint32_t> matches_;
+    };
+
+    // Mach-O panel: one slice of a fat binary at a time
+    class MachOPanel : public UiPanel {
+    public:
+        explicit MachOPanel(BinaryModel& model);
+    protected:
+        void draw_contents() override;
+    private:
+        BinaryModel& model_;
+        int slice_ = 0;
+        char filter_buf_[128] = {};
+    };
+
+    // Windows minidump: exception, threads and the loaded modules
+    class MinidumpPanel : public UiPanel {
+    public:
+        explicit MinidumpPanel(BinaryModel& model);
+    protected:
+        void draw_contents() override;
+    private:
+        BinaryModel& model_;
+        char filter_buf_[128] = {};
+    };
+
 } // namespace viewer
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include "ui_panels.hpp"
+#include <imgui.h>
+#include "model/archive_model.hpp"
+
+namespace viewer {
+
+    ArchivePanel::ArchivePanel(BinaryModel& model)
+        : UiPanel("Archive")
+        , model_(model)
+    {
+        filter_buf_[0] = '\0';
+    }
+
+    void ArchivePanel::draw_contents() {
+        const ArchiveModel* archive = model_.archive();
+        if (!archive) {
+            ImGui::TextUnformatted("No static library loaded.");
+            return;
+        }
+
+        ImGui::Text("%zu members, %zu definitions (%zu in the archive index)", archive->members.size(),
+                    archive->symbols.size(), archive->indexed_symbols);
+        ImGui::Separator();
+
+        if (ImGui::CollapsingHeader("Members", ImGuiTreeNodeFlags_DefaultOpen)) {
+            ImGui::BeginChild("MembersList", ImVec2(0, 240), false);
+            ImGui::Columns(6, nullptr, true);
+            ImGui::Text("Name"); ImGui::NextColumn();
+            ImGui::Text("Offset"); ImGui::NextColumn();
+            ImGui::Text("Size"); ImGui::NextColumn();
+            ImGui::Text("Kind"); ImGui::NextColumn();
+            ImGui::Text("Arch"); ImGui::NextColumn();
+            ImGui::Text("Defined / Undefined"); ImGui::NextColumn();
+            ImGui::Separator();
+
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(archive->members.size()));
+            while (clipper.Step()) {
+                for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                    const auto& m = archive->members[static_cast<size_t>(row)];
+                    ImGui::TextUnformatted(m.name.c_str()); ImGui::NextColumn();
+                    ImGui::Text("0x%llX", static_cast<unsigned long long>(m.offset)); ImGui::NextColumn();
+                    ImGui::Text("%llu", static_cast<unsigned long long>(m.size)); ImGui::NextColumn();
+                    ImGui::TextUnformatted(m.kind.c_str()); ImGui::NextColumn();
+                    ImGui::TextUnformatted(m.arch.c_str()); ImGui::NextColumn();
+                    if (m.error.empty())
+                        ImGui::Text("%zu / %zu", m.defined, m.undefined);
+                    else
+                        ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%s", m.error.c_str());
+                    ImGui::NextColumn();
+                }
+            }
+            clipper.End();
+            ImGui::Columns(1);
+            ImGui::EndChild();
+        }
+
+        if (ImGui::CollapsingHeader("Symbols", ImGuiTreeNodeFlags_DefaultOpen)) {
+            ImGui::InputTextWithHint("Filter", "Symbol name...", filter_buf_, sizeof(filter_buf_));
+            if (matched_archive_ != archive || matched_filter_ != filter_buf_) {
+                matched_archive_ = archive;
+                matched_filter_ = filter_buf_;
+                matches_.clear();
+                for (size_t i = 0; i < archive->symbols.size(); ++i) {
+                    if (matched_filter_.empty() || archive->symbols[i].name.find(matched_filter_) != std::string_view::npos)
+                        matches_.push_back(static_cast<uint32_t>(i));
+                }
+            }
+            ImGui::Text("%zu matching", matches_.size());
+
+            ImGui::BeginChild("ArchiveSymbols", ImVec2(0, 0), false);
+            ImGui::Columns(2, nullptr, true);
+            ImGui::Text("Name"); ImGui::NextColumn();
+            ImGui::Text("Member"); ImGui::NextColumn();
+            ImGui::Separator();
+
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(matches_.size()));
+            while (clipper.Step()) {
+                for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                    const auto& s = archive->symbols[matches_[static_cast<size_t>(row)]];
+                    ImGui::TextUnformatted(s.name.data(), s.name.data() + s.name.size()); ImGui::NextColumn();
+                    ImGui::TextUnformatted(archive->members[s.member].name.c_str()); ImGui::NextColumn();
+                }
+            }
+            clipper.End();
+            ImGui::Columns(1);
+            ImGui::EndChild();
+        }
+    }
+
+} // namespace viewer
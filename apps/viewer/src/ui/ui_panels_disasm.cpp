@@ -2,6 +2,8 @@
 // Created by wsoll on 12/23/2025.
 //
 #include "ui_panels.hpp"
+#include "dwarf/dwarf_line.hpp"
+#include "model/elf_model.hpp"
 #include <imgui.h>
 
 namespace viewer {
@@ -10,6 +12,30 @@ namespace viewer {
         : UiPanel("Disassembly"), model_(model), current_instructions_(instructions)
     {}
 
+    void DisassemblyPanel::refresh_source_notes() {
+        const uint64_t first = current_instructions_.empty() ? 0 : current_instructions_.front().address;
+        if (source_notes_.size() == current_instructions_.size() && notes_first_address_ == first)
+            return;
+        notes_first_address_ = first;
+        source_notes_.assign(current_instructions_.size(), {});
+
+        const ElfModel* elf = model_.elf();
+        if (!elf || !elf->line_index)
+            return;
+
+        std::string previous;
+        for (size_t i = 0; i < current_instructions_.size(); ++i) {
+            const auto location = elf->line_index->lookup(current_instructions_[i].address);
+            if (!location)
+                continue;
+            std::string note = location->file + ":" + std::to_string(location->line);
+            if (note != previous) {
+                previous = note;
+                source_notes_[i] = std::move(note);
+            }
+        }
+    }
+
     void DisassemblyPanel::draw_contents() {
 
         if (current_instructions_.empty()) {
@@ -17,10 +43,16 @@ namespace viewer {
             return;
         }
 
+        refresh_source_notes();
+
         ImGui::BeginChild("InstructionsScroll", ImVec2(0,0), false, ImGuiWindowFlags_HorizontalScrollbar);
 
         // Display current instructions
-        for (const auto& instruction : current_instructions_) {
+        for (size_t i = 0; i < current_instructions_.size(); ++i) {
+            const auto& instruction = current_instructions_[i];
+            if (!source_notes_[i].empty())
+                ImGui::TextColored(ImVec4(0.45f, 0.6f, 0.45f, 1.0f), "%s", source_notes_[i].c_str());
+
             char addr[32];
             std::snprintf(addr, sizeof(addr), "%08" PRIx64 ": ", instruction.address);
             ImGui::TextUnformatted(addr);
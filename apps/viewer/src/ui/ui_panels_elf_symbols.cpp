@@ -0,0 +1,140 @@
+#include "ui_panels.hpp"
+#include <imgui.h>
+#include "model/elf_model.hpp"
+#include "dwarf/dwarf_names.hpp"
+
+namespace viewer {
+
+    static const char* symbol_type_name(std::uint8_t type) {
+        switch (type) {
+            case 0:  return "NOTYPE";
+            case 1:  return "OBJECT";
+            case 2:  return "FUNC";
+            case 3:  return "SECTION";
+            case 4:  return "FILE";
+            case 5:  return "COMMON";
+            case 6:  return "TLS";
+            case 10: return "IFUNC";
+            default: return "?";
+        }
+    }
+
+    static const char* symbol_binding_name(std::uint8_t binding) {
+        switch (binding) {
+            case 0:  return "LOCAL";
+            case 1:  return "GLOBAL";
+            case 2:  return "WEAK";
+            case 10: return "UNIQUE";
+            default: return "?";
+        }
+    }
+
+    static const char* dwarf_kind_name(std::uint16_t tag) {
+        switch (tag) {
+            case peelf::DW_TAG_subprogram:       return "function";
+            case peelf::DW_TAG_variable:         return "variable";
+            case peelf::DW_TAG_namespace:        return "namespace";
+            case peelf::DW_TAG_enumerator:       return "enumerator";
+            case peelf::DW_TAG_typedef:          return "typedef";
+            case peelf::DW_TAG_class_type:
+            case peelf::DW_TAG_structure_type:
+            case peelf::DW_TAG_union_type:
+            case peelf::DW_TAG_enumeration_type:
+            case peelf::DW_TAG_base_type:        return "type";
+            default:                             return "entry";
+        }
+    }
+
+    ElfSymbolsPanel::ElfSymbolsPanel(BinaryModel& model)
+        : UiPanel("ELF Symbols")
+        , model_(model)
+    {
+        filter_buf_[0] = '\0';
+    }
+
+    void ElfSymbolsPanel::find_in_debug_info(const std::string& name) {
+        dwarf_matches_.clear();
+        const ElfModel* elf = model_.elf();
+        if (!elf || !elf->debug_info)
+            return;
+
+        if (indexed_info_ != elf->debug_info) {
+            name_index_.reset();
+            auto index = peelf::DwarfNameIndex::build(*elf->debug_info);
+            if (!index) {
+                dwarf_matches_.push_back("Name index failed: " + index.error().message);
+                return;
+            }
+            indexed_info_ = elf->debug_info;
+            name_index_ = std::make_shared<const peelf::DwarfNameIndex>(std::move(*index));
+        }
+
+        auto dies = name_index_->find(name);
+        if (!dies) {
+            dwarf_matches_.push_back("Lookup failed: " + dies.error().message);
+            return;
+        }
+        for (const auto& die : *dies) {
+            char line[96];
+            std::snprintf(line, sizeof(line), "%s  DIE 0x%llx  unit %u", dwarf_kind_name(die.tag()),
+                          static_cast<unsigned long long>(die.offset), die.unit);
+            dwarf_matches_.emplace_back(line);
+        }
+        if (dwarf_matches_.empty())
+            dwarf_matches_.push_back("No DWARF definitions named \"" + name + "\"");
+    }
+
+    void ElfSymbolsPanel::draw_contents() {
+        const ElfModel* elf = model_.elf();
+        if (!elf) {
+            ImGui::TextUnformatted("No ELF file loaded.");
+            return;
+        }
+
+        ImGui::InputTextWithHint("Filter", "Symbol name...", filter_buf_, sizeof(filter_buf_));
+        std::string filter = filter_buf_;
+        bool has_filter = !filter.empty();
+
+        if (elf->debug_info) {
+            ImGui::SameLine();
+            if (ImGui::Button("Find in DWARF") && has_filter)
+                find_in_debug_info(filter);
+        }
+
+        ImGui::Text("%zu symbols", elf->symbols.size());
+        for (const auto& match : dwarf_matches_)
+            ImGui::BulletText("%s", match.c_str());
+        ImGui::Separator();
+        ImGui::BeginChild("SymbolsList", ImVec2(0, 0), false);
+
+        ImGui::Columns(6, nullptr, true);
+        ImGui::Text("Value"); ImGui::NextColumn();
+        ImGui::Text("Size"); ImGui::NextColumn();
+        ImGui::Text("Type"); ImGui::NextColumn();
+        ImGui::Text("Bind"); ImGui::NextColumn();
+        ImGui::Text("Table"); ImGui::NextColumn();
+        ImGui::Text("Name"); ImGui::NextColumn();
+        ImGui::Separator();
+
+        for (const auto& s : elf->symbols) {
+            if (has_filter) {
+                if (s.name.find(filter) == std::string::npos) continue;
+            }
+
+            ImGui::Text("0x%016llX", static_cast<unsigned long long>(s.value)); ImGui::NextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(s.size)); ImGui::NextColumn();
+            ImGui::TextUnformatted(symbol_type_name(s.type)); ImGui::NextColumn();
+            ImGui::TextUnformatted(symbol_binding_name(s.binding)); ImGui::NextColumn();
+            ImGui::TextUnformatted(s.dynamic ? ".dynsym" : ".symtab"); ImGui::NextColumn();
+            if (s.version.empty())
+                ImGui::TextUnformatted(s.name.c_str());
+            else
+                ImGui::Text("%s%s%s", s.name.c_str(), s.default_version ? "@@" : "@", s.version.c_str());
+            ImGui::NextColumn();
+        }
+
+        ImGui::Columns(1);
+        ImGui::EndChild();
+    }
+
+} // namespace viewer
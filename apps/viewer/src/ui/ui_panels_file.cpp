@@ -1,4 +1,6 @@
 #include "ui_panels.hpp"
+#include "dwarf/dwarf_info.hpp"
+#include "elf/elf_core.hpp"
 #include <imgui.h>
 
 namespace viewer {
@@ -12,7 +14,7 @@ namespace viewer {
         if (!model_.has_file()) {
             ImGui::TextUnformatted("No file loaded.");
             ImGui::Separator();
-            ImGui::TextUnformatted("Drag and drop a PE file to analyze.");
+            ImGui::TextUnformatted("Drag and drop a PE, ELF, Mach-O or static library file to analyze.");
             return;
         }
 
@@ -33,6 +35,84 @@ namespace viewer {
                 ImGui::BulletText("%s", f.c_str());
             }
         }
+
+        const auto* pe = model_.pe();
+        if (pe && (!pe->file_version.empty() || !pe->version_strings.empty())) {
+            ImGui::Separator();
+            ImGui::TextUnformatted("Version Info:");
+            if (!pe->file_version.empty())
+                ImGui::BulletText("File version: %s", pe->file_version.c_str());
+            if (!pe->product_version.empty())
+                ImGui::BulletText("Product version: %s", pe->product_version.c_str());
+            for (const auto& v : pe->version_strings) {
+                ImGui::BulletText("%s: %s", v.key.c_str(), v.value.c_str());
+            }
+        }
+
+        const auto* elf = model_.elf();
+        if (elf && !elf->build_id.empty()) {
+            ImGui::Separator();
+            ImGui::Text("Build ID: %s", elf->build_id.c_str());
+        }
+        if (elf && !elf->debug_file.empty())
+            ImGui::Text("Debug file: %s", elf->debug_file.c_str());
+
+        if (elf && elf->core) {
+            const auto& core = *elf->core;
+            ImGui::Separator();
+            ImGui::TextUnformatted("Core dump:");
+            if (const auto& p = core.process())
+                ImGui::BulletText("Process %u: %s (%s)", p->pid, p->name.c_str(), p->args.c_str());
+            if (const auto& sig = core.signal()) {
+                if (sig->fault_address)
+                    ImGui::BulletText("Signal %d, code %d, address 0x%llX", sig->signo, sig->code,
+                                      static_cast<unsigned long long>(*sig->fault_address));
+                else
+                    ImGui::BulletText("Signal %d, code %d", sig->signo, sig->code);
+            }
+            ImGui::BulletText("Segments: %zu, mapped files: %zu", core.segments().size(),
+                              core.mapped_files().size());
+            for (const auto& t : core.threads()) {
+                ImGui::BulletText("Thread %u: pc 0x%llX sp 0x%llX", t.tid,
+                                  static_cast<unsigned long long>(t.pc.value_or(0)),
+                                  static_cast<unsigned long long>(t.sp.value_or(0)));
+            }
+        }
+
+        if (elf && elf->unwind_function_count != 0) {
+            ImGui::Separator();
+            ImGui::Text("Unwind: %zu FDEs%s", elf->unwind_function_count,
+                        elf->unwind_search_table ? " (.eh_frame_hdr)" : "");
+        }
+
+        if (elf && elf->debug_info) {
+            ImGui::Separator();
+            const auto units = elf->debug_info->units();
+            const bool has_index = !elf->debug_info->sections().names.empty() ||
+                                   !elf->debug_info->sections().gdb_index.empty();
+            ImGui::Text("DWARF: %zu units, DWARF %u%s", units.size(),
+                        units.empty() ? 0u : static_cast<unsigned>(units.front().version),
+                        has_index ? ", name index" : "");
+        }
+
+        if (elf && (!elf->needed.empty() || !elf->soname.empty() || elf->relocation_count != 0)) {
+            ImGui::Separator();
+            ImGui::TextUnformatted("Dynamic:");
+            if (!elf->soname.empty())
+                ImGui::BulletText("SONAME: %s", elf->soname.c_str());
+            for (const auto& n : elf->needed) {
+                ImGui::BulletText("NEEDED: %s", n.c_str());
+            }
+            if (!elf->rpath.empty())
+                ImGui::BulletText("RPATH: %s", elf->rpath.c_str());
+            if (!elf->runpath.empty())
+                ImGui::BulletText("RUNPATH: %s", elf->runpath.c_str());
+            ImGui::BulletText("Relocations: %zu (%zu RELR)", elf->relocation_count, elf->relr_count);
+            if (!elf->max_glibc.empty())
+                ImGui::BulletText("Requires GLIBC %s", elf->max_glibc.c_str());
+            if (!elf->max_glibcxx.empty())
+                ImGui::BulletText("Requires GLIBCXX %s", elf->max_glibcxx.c_str());
+        }
     }
 
 } // namespace viewer
\ No newline at end of file
@@ -2,70 +2,266 @@
 // Created by wsoll on 12/23/2025.
 //
 #include "ui_panels.hpp"
+#include "elf/elf_core.hpp"
+#include "minidump/minidump.hpp"
+#include "peelf/byte_pyramid.hpp"
 #include <imgui.h>
+#include <algorithm>
+#include <climits>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
 namespace viewer {
 
+namespace {
+    constexpr float OVERVIEW_WIDTH = 24.0f;
+    // Same threshold as the sections panel: packed or encrypted
+    constexpr float HIGH_ENTROPY = 7.2f;
+}
+
 HexViewPanel::HexViewPanel(BinaryModel& model)
     : UiPanel("Hex View"), model_(model)
 {}
 
 void HexViewPanel::draw_contents() {
     const auto& bytes = model_.bytes();
-    if (bytes.empty()) {
+    const auto* elf = model_.elf();
+    const peelf::ElfCore* core = elf ? elf->core.get() : nullptr;
+    const auto* minidump = model_.minidump();
+    const peelf::Minidump* dump = minidump ? minidump->dump.get() : nullptr;
+    if (bytes.empty() && !core && !dump) {
         ImGui::TextUnformatted("No data loaded.");
         return;
     }
 
-    ImGui::BeginChild("HexScroll", ImVec2(0,0), false, ImGuiWindowFlags_HorizontalScrollbar);
+    if (core) {
+        if (ImGui::RadioButton("File offsets", !virtual_addresses_) && virtual_addresses_) {
+            virtual_addresses_ = false;
+            selected_offset_ = 0;
+        }
+        ImGui::SameLine();
+        if (ImGui::RadioButton("Virtual addresses", virtual_addresses_) && !virtual_addresses_) {
+            virtual_addresses_ = true;
+            selected_offset_ = 0;
+        }
+        if (virtual_addresses_) {
+            draw_memory(*core);
+            return;
+        }
+    }
+
+    // Dumps are never loaded whole; their file bytes come through the mapping
+    if (dump) {
+        draw_rows(0, dump->file_size(), [dump](uint64_t offset, std::span<uint8_t> out) {
+            return dump->read_file(offset, out);
+        });
+        return;
+    }
+    if (bytes.empty()) {
+        draw_rows(0, core->file_size(), [core](uint64_t offset, std::span<uint8_t> out) {
+            return core->read_file(offset, out);
+        });
+        return;
+    }
+    draw_rows(0, bytes.size(), [&bytes](uint64_t offset, std::span<uint8_t> out) {
+        const size_t n = std::min<size_t>(out.size(), bytes.size() - offset);
+        std::memcpy(out.data(), bytes.data() + offset, n);
+        return n;
+    }, &model_.byte_pyramid());
+}
+
+void HexViewPanel::draw_memory(const peelf::ElfCore& core) {
+    // Only dumped segments have bytes to show
+    std::vector<size_t> dumped;
+    for (size_t i = 0; i < core.segments().size(); ++i) {
+        if (core.segments()[i].file_size != 0)
+            dumped.push_back(i);
+    }
+    if (dumped.empty()) {
+        ImGui::TextUnformatted("The core holds no process memory.");
+        return;
+    }
+    if (std::find(dumped.begin(), dumped.end(), segment_) == dumped.end())
+        segment_ = dumped.front();
+
+    auto label = [&core](size_t index) {
+        const auto& s = core.segments()[index];
+        const auto* mapped = core.mapped_file_at(s.vaddr);
+        char buf[512];
+        std::snprintf(buf, sizeof(buf), "0x%llx-0x%llx %c%c%c %s",
+                      (unsigned long long)s.vaddr, (unsigned long long)(s.vaddr + s.file_size),
+                      (s.flags & peelf::PF_R) ? 'r' : '-', (s.flags & peelf::PF_W) ? 'w' : '-',
+                      (s.flags & peelf::PF_X) ? 'x' : '-', mapped ? mapped->path.c_str() : "[anon]");
+        return std::string(buf);
+    };
+
+    ImGui::SetNextItemWidth(420.0f);
+    if (ImGui::BeginCombo("Segment", label(segment_).c_str())) {
+        for (size_t index : dumped) {
+            if (ImGui::Selectable(label(index).c_str(), index == segment_)) {
+                segment_ = index;
+                selected_offset_ = 0;
+            }
+        }
+        ImGui::EndCombo();
+    }
+
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(160.0f);
+    if (ImGui::InputTextWithHint("Go to", "address (hex)", goto_buf_, sizeof(goto_buf_),
+                                 ImGuiInputTextFlags_EnterReturnsTrue | ImGuiInputTextFlags_CharsHexadecimal)) {
+        const uint64_t address = std::strtoull(goto_buf_, nullptr, 16);
+        const auto* s = core.segment_at(address);
+        if (s && address - s->vaddr < s->file_size) {
+            segment_ = static_cast<size_t>(s - core.segments().data());
+            selected_offset_ = address;
+            scroll_to_ = address;
+        }
+    }
+
+    const auto& s = core.segments()[segment_];
+    draw_rows(s.vaddr, s.file_size, [&core](uint64_t address, std::span<uint8_t> out) {
+        return core.read_memory(address, out);
+    });
+}
+
+void HexViewPanel::draw_rows(uint64_t base, uint64_t total, const RowReader& read,
+                             const peelf::BytePyramid* overview) {
+    if (overview && (overview->empty() || overview->data_size() != total))
+        overview = nullptr;
+    const float overview_width = overview ? OVERVIEW_WIDTH + ImGui::GetStyle().ItemSpacing.x : 0.0f;
+    ImGui::BeginChild("HexScroll", ImVec2(-overview_width, 0), false, ImGuiWindowFlags_HorizontalScrollbar);
 
-    const size_t total = bytes.size();
     const size_t row_bytes = bytes_per_row_;
-    const size_t rows = (total + row_bytes - 1) / row_bytes;
+    // ImGuiListClipper counts rows in an int
+    const size_t rows = static_cast<size_t>(std::min<uint64_t>((total + row_bytes - 1) / row_bytes, INT_MAX));
+
+    if (scroll_to_) {
+        if (*scroll_to_ >= base && *scroll_to_ - base < total)
+            ImGui::SetScrollY(static_cast<float>((*scroll_to_ - base) / row_bytes) * ImGui::GetTextLineHeightWithSpacing());
+        scroll_to_.reset();
+    }
 
+    std::vector<uint8_t> row_data(row_bytes);
     ImGuiListClipper clipper;
     clipper.Begin((int)rows);
     while (clipper.Step()) {
         for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
-            size_t start = row * row_bytes;
-            size_t end = std::min(start + row_bytes, total);
+            const uint64_t start = base + static_cast<uint64_t>(row) * row_bytes;
+            const size_t count = static_cast<size_t>(std::min<uint64_t>(row_bytes, base + total - start));
+            const size_t available = read(start, std::span<uint8_t>(row_data.data(), count));
 
             char addr[32];
-            std::snprintf(addr, sizeof(addr), "%08zx: ", start);
+            std::snprintf(addr, sizeof(addr), "%08llx: ", (unsigned long long)start);
             ImGui::TextUnformatted(addr);
             ImGui::SameLine();
 
             float hex_start = ImGui::GetCursorPosX();
 
-            for (size_t i = start; i < end; ++i) {
+            for (size_t i = 0; i < count; ++i) {
                 char buf[4];
-                std::snprintf(buf, sizeof(buf), "%02X", bytes[i]);
+                if (i < available)
+                    std::snprintf(buf, sizeof(buf), "%02X", row_data[i]);
+                else
+                    std::snprintf(buf, sizeof(buf), "??");
 
-                bool selected = (i == selected_offset_);
+                bool selected = (start + i == selected_offset_);
                 if (ImGui::Selectable(buf, selected, ImGuiSelectableFlags_AllowDoubleClick)) {
-                    selected_offset_ = i;
+                    selected_offset_ = static_cast<size_t>(start + i);
                 }
 
-                if (i + 1 < end)
+                if (i + 1 < count)
                     ImGui::SameLine(0.0f, 4.0f);
             }
 
             float ascii_start = hex_start + ImGui::CalcTextSize("00 ").x * row_bytes + 20.0f;
             ImGui::SameLine(ascii_start);
 
-            for (size_t i = start; i < end; ++i) {
-                unsigned char c = bytes[i];
+            for (size_t i = 0; i < count; ++i) {
+                unsigned char c = i < available ? row_data[i] : ' ';
                 char ch = (c >= 32 && c < 127) ? (char)c : '.';
                 ImGui::TextUnformatted(&ch, &ch + 1);
-                if (i + 1 < end)
+                if (i + 1 < count)
                     ImGui::SameLine(0.0f, 0.0f);
             }
         }
     }
     clipper.End();
 
+    const float line_height = ImGui::GetTextLineHeightWithSpacing();
+    const uint64_t visible_begin = static_cast<uint64_t>(ImGui::GetScrollY() / line_height) * row_bytes;
+    const uint64_t visible_end = visible_begin + static_cast<uint64_t>(ImGui::GetWindowHeight() / line_height + 1.0f) * row_bytes;
+    ImGui::EndChild();
+
+    if (overview) {
+        ImGui::SameLine();
+        draw_overview(*overview, visible_begin, std::min(visible_end, total));
+    }
+}
+
+// One column per pixel row at most: the pyramid level is picked by the strip
+// height, so drawing never depends on the file size. The left part shows
+// entropy from blue (0) to red (8 bits per byte), with a notch where some
+// window under the cell is packed or encrypted; the right part mixes high
+// bytes (red), ASCII (green) and other control bytes (blue), so runs of
+// zeros stay dark.
+void HexViewPanel::draw_overview(const peelf::BytePyramid& pyramid, uint64_t visible_begin, uint64_t visible_end) {
+    ImGui::BeginChild("HexOverview", ImVec2(OVERVIEW_WIDTH, 0), false,
+                      ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoScrollWithMouse);
+
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    const ImVec2 size = ImGui::GetContentRegionAvail();
+    if (size.x < 1.0f || size.y < 1.0f) {
+        ImGui::EndChild();
+        return;
+    }
+
+    const auto total = static_cast<double>(pyramid.data_size());
+    const auto y_of = [&](uint64_t offset) {
+        return origin.y + static_cast<float>(static_cast<double>(offset) / total * size.y);
+    };
+
+    const size_t level = pyramid.level_for(static_cast<size_t>(size.y));
+    const auto cells = pyramid.level(level);
+    const uint64_t cell_bytes = pyramid.cell_bytes(level);
+    const float split = origin.x + size.x * 0.6f;
+    ImDrawList* draw = ImGui::GetWindowDrawList();
+    for (size_t i = 0; i < cells.size(); ++i) {
+        const auto& c = cells[i];
+        const float y0 = y_of(i * cell_bytes);
+        const float y1 = std::max(y0 + 1.0f, y_of(std::min<uint64_t>((i + 1) * cell_bytes, pyramid.data_size())));
+
+        const float t = c.entropy_bits() / 8.0f;
+        draw->AddRectFilled(ImVec2(origin.x, y0), ImVec2(split, y1),
+                            ImGui::GetColorU32(ImVec4(t, 0.25f * t, 1.0f - t, 1.0f)));
+        if (c.entropy_max_bits() > HIGH_ENTROPY)
+            draw->AddRectFilled(ImVec2(origin.x, y0), ImVec2(origin.x + 3.0f, y1),
+                                ImGui::GetColorU32(ImVec4(1.0f, 0.7f, 0.2f, 1.0f)));
+
+        const float other = std::max(0.0f, 1.0f - c.zero_ratio() - c.ascii_ratio() - c.high_ratio());
+        draw->AddRectFilled(ImVec2(split, y0), ImVec2(origin.x + size.x, y1),
+                            ImGui::GetColorU32(ImVec4(c.high_ratio(), c.ascii_ratio(), other, 1.0f)));
+    }
+    draw->AddRect(ImVec2(origin.x, y_of(visible_begin)), ImVec2(origin.x + size.x, y_of(visible_end) + 1.0f),
+                  ImGui::GetColorU32(ImVec4(1.0f, 1.0f, 1.0f, 1.0f)));
+
+    ImGui::InvisibleButton("##overview", size);
+    if (ImGui::IsItemHovered() || ImGui::IsItemActive()) {
+        const float mouse_y = std::clamp(ImGui::GetIO().MousePos.y - origin.y, 0.0f, size.y - 1.0f);
+        const auto offset = std::min(static_cast<uint64_t>(mouse_y / size.y * total), pyramid.data_size() - 1);
+        if (ImGui::IsItemActive()) {
+            selected_offset_ = static_cast<size_t>(offset);
+            scroll_to_ = offset;
+        }
+        // The window under the cursor, straight from level 0
+        const auto& w = pyramid.level(0)[offset / pyramid.window()];
+        ImGui::SetTooltip("0x%llX\nEntropy %.2f\nZero %.0f%%  ASCII %.0f%%  High %.0f%%",
+                          (unsigned long long)offset, w.entropy_bits(), w.zero_ratio() * 100.0f,
+                          w.ascii_ratio() * 100.0f, w.high_ratio() * 100.0f);
+    }
+
     ImGui::EndChild();
 }
 
-} // namespace viewer
\ No newline at end of file
+} // namespace viewer
@@ -0,0 +1,164 @@
+#include "ui_panels.hpp"
+#include <imgui.h>
+#include <cstdio>
+#include <string>
+#include "model/macho_model.hpp"
+#include "macho/macho_structures.hpp"
+
+namespace viewer {
+
+    static const char* load_command_name(std::uint32_t cmd) {
+        switch (cmd) {
+            case peelf::LC_SEGMENT:             return "LC_SEGMENT";
+            case peelf::LC_SEGMENT_64:          return "LC_SEGMENT_64";
+            case peelf::LC_SYMTAB:              return "LC_SYMTAB";
+            case peelf::LC_DYSYMTAB:            return "LC_DYSYMTAB";
+            case peelf::LC_UNIXTHREAD:          return "LC_UNIXTHREAD";
+            case peelf::LC_LOAD_DYLIB:          return "LC_LOAD_DYLIB";
+            case peelf::LC_ID_DYLIB:            return "LC_ID_DYLIB";
+            case peelf::LC_LOAD_DYLINKER:       return "LC_LOAD_DYLINKER";
+            case peelf::LC_LOAD_WEAK_DYLIB:     return "LC_LOAD_WEAK_DYLIB";
+            case peelf::LC_UUID:                return "LC_UUID";
+            case peelf::LC_RPATH:               return "LC_RPATH";
+            case peelf::LC_CODE_SIGNATURE:      return "LC_CODE_SIGNATURE";
+            case peelf::LC_REEXPORT_DYLIB:      return "LC_REEXPORT_DYLIB";
+            case peelf::LC_LAZY_LOAD_DYLIB:     return "LC_LAZY_LOAD_DYLIB";
+            case peelf::LC_ENCRYPTION_INFO:     return "LC_ENCRYPTION_INFO";
+            case peelf::LC_ENCRYPTION_INFO_64:  return "LC_ENCRYPTION_INFO_64";
+            case peelf::LC_DYLD_INFO:           return "LC_DYLD_INFO";
+            case peelf::LC_DYLD_INFO_ONLY:      return "LC_DYLD_INFO_ONLY";
+            case peelf::LC_LOAD_UPWARD_DYLIB:   return "LC_LOAD_UPWARD_DYLIB";
+            case peelf::LC_VERSION_MIN_MACOSX:  return "LC_VERSION_MIN_MACOSX";
+            case peelf::LC_FUNCTION_STARTS:     return "LC_FUNCTION_STARTS";
+            case peelf::LC_MAIN:                return "LC_MAIN";
+            case peelf::LC_DATA_IN_CODE:        return "LC_DATA_IN_CODE";
+            case peelf::LC_SOURCE_VERSION:      return "LC_SOURCE_VERSION";
+            case peelf::LC_BUILD_VERSION:       return "LC_BUILD_VERSION";
+            case peelf::LC_DYLD_EXPORTS_TRIE:   return "LC_DYLD_EXPORTS_TRIE";
+            case peelf::LC_DYLD_CHAINED_FIXUPS: return "LC_DYLD_CHAINED_FIXUPS";
+            default:                            return nullptr;
+        }
+    }
+
+    MachOPanel::MachOPanel(BinaryModel& model)
+        : UiPanel("Mach-O")
+        , model_(model)
+    {
+        filter_buf_[0] = '\0';
+    }
+
+    void MachOPanel::draw_contents() {
+        const MachOModel* macho = model_.macho();
+        if (!macho || macho->slices.empty()) {
+            ImGui::TextUnformatted("No Mach-O file loaded.");
+            return;
+        }
+
+        if (slice_ < 0 || static_cast<size_t>(slice_) >= macho->slices.size())
+            slice_ = 0;
+        if (macho->fat) {
+            const auto& current = macho->slices[static_cast<size_t>(slice_)];
+            if (ImGui::BeginCombo("Slice", current.arch.c_str())) {
+                for (size_t i = 0; i < macho->slices.size(); ++i) {
+                    const auto& s = macho->slices[i];
+                    char label[64];
+                    std::snprintf(label, sizeof(label), "%s @ 0x%llX##%zu", s.arch.c_str(),
+                                  static_cast<unsigned long long>(s.offset), i);
+                    if (ImGui::Selectable(label, static_cast<int>(i) == slice_))
+                        slice_ = static_cast<int>(i);
+                }
+                ImGui::EndCombo();
+            }
+        }
+
+        const auto& slice = macho->slices[static_cast<size_t>(slice_)];
+        if (!slice.error.empty())
+            ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%s", slice.error.c_str());
+        if (!slice.readable)
+            return;
+
+        ImGui::Text("%s, %zu load commands, %zu segments, %zu sections", slice.arch.c_str(),
+                    slice.commands.size(), slice.segments.size(), slice.sections.size());
+        if (!slice.uuid.empty())
+            ImGui::Text("UUID: %s", slice.uuid.c_str());
+        if (!slice.install_name.empty())
+            ImGui::Text("Install name: %s", slice.install_name.c_str());
+        if (slice.pointer_format != 0)
+            ImGui::Text("Chained fixups: format %u, %zu imports, %zu binds, %zu rebases", slice.pointer_format,
+                        slice.chained_imports, slice.binds, slice.rebases);
+        ImGui::Separator();
+
+        if (ImGui::CollapsingHeader("Load Commands")) {
+            for (const auto& c : slice.commands) {
+                const char* name = load_command_name(c.cmd);
+                if (name)
+                    ImGui::BulletText("0x%llX  %s (%u bytes)", static_cast<unsigned long long>(c.offset), name, c.size);
+                else
+                    ImGui::BulletText("0x%llX  0x%X (%u bytes)", static_cast<unsigned long long>(c.offset), c.cmd, c.size);
+            }
+        }
+
+        if (ImGui::CollapsingHeader("Segments")) {
+            for (const auto& s : slice.segments) {
+                ImGui::BulletText("%-16s vm 0x%llX+0x%llX  file 0x%llX+0x%llX  %c%c%c", s.name.c_str(),
+                                  static_cast<unsigned long long>(s.vmaddr), static_cast<unsigned long long>(s.vmsize),
+                                  static_cast<unsigned long long>(s.fileoff), static_cast<unsigned long long>(s.filesize),
+                                  (s.initprot & 1) ? 'r' : '-', (s.initprot & 2) ? 'w' : '-', (s.initprot & 4) ? 'x' : '-');
+            }
+        }
+
+        if (!slice.dylibs.empty() && ImGui::CollapsingHeader("Libraries")) {
+            // Listed in ordinal order, as binds refer to them
+            for (size_t i = 0; i < slice.dylibs.size(); ++i)
+                ImGui::BulletText("%zu  %s", i + 1, slice.dylibs[i].c_str());
+            for (const auto& r : slice.rpaths)
+                ImGui::BulletText("RPATH %s", r.c_str());
+        }
+
+        ImGui::InputTextWithHint("Filter", "Symbol name...", filter_buf_, sizeof(filter_buf_));
+        const std::string filter = filter_buf_;
+
+        if (ImGui::CollapsingHeader("Symbols", ImGuiTreeNodeFlags_DefaultOpen)) {
+            ImGui::BeginChild("MachOSymbols", ImVec2(0, 300), false);
+            ImGui::Columns(3, nullptr, true);
+            ImGui::Text("Name"); ImGui::NextColumn();
+            ImGui::Text("Value"); ImGui::NextColumn();
+            ImGui::Text("Kind"); ImGui::NextColumn();
+            ImGui::Separator();
+            for (const auto& s : slice.symbols) {
+                if (!filter.empty() && s.name.find(filter) == std::string::npos)
+                    continue;
+                ImGui::TextUnformatted(s.name.c_str()); ImGui::NextColumn();
+                ImGui::Text("0x%llX", static_cast<unsigned long long>(s.value)); ImGui::NextColumn();
+                ImGui::TextUnformatted(!s.defined ? "undefined" : s.external ? "external" : "local"); ImGui::NextColumn();
+            }
+            ImGui::Columns(1);
+            ImGui::EndChild();
+        }
+
+        if (!slice.exports.empty() && ImGui::CollapsingHeader("Exports", ImGuiTreeNodeFlags_DefaultOpen)) {
+            ImGui::BeginChild("MachOExports", ImVec2(0, 0), false);
+            ImGui::Columns(3, nullptr, true);
+            ImGui::Text("Name"); ImGui::NextColumn();
+            ImGui::Text("Address"); ImGui::NextColumn();
+            ImGui::Text("Flags"); ImGui::NextColumn();
+            ImGui::Separator();
+            for (const auto& e : slice.exports) {
+                if (!filter.empty() && e.name.find(filter) == std::string::npos)
+                    continue;
+                ImGui::TextUnformatted(e.name.c_str()); ImGui::NextColumn();
+                ImGui::Text("0x%llX", static_cast<unsigned long long>(e.address)); ImGui::NextColumn();
+                std::string flags;
+                if (e.flags & peelf::EXPORT_SYMBOL_FLAGS_REEXPORT) flags += "re-export ";
+                if (e.flags & peelf::EXPORT_SYMBOL_FLAGS_WEAK_DEFINITION) flags += "weak ";
+                if (e.flags & peelf::EXPORT_SYMBOL_FLAGS_STUB_AND_RESOLVER) flags += "resolver ";
+                if ((e.flags & peelf::EXPORT_SYMBOL_FLAGS_KIND_MASK) == peelf::EXPORT_SYMBOL_FLAGS_KIND_THREAD_LOCAL)
+                    flags += "TLV";
+                ImGui::TextUnformatted(flags.c_str()); ImGui::NextColumn();
+            }
+            ImGui::Columns(1);
+            ImGui::EndChild();
+        }
+    }
+
+} // namespace viewer
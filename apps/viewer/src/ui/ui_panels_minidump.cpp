@@ -0,0 +1,89 @@
+#include "ui_panels.hpp"
+#include <imgui.h>
+#include <cstdio>
+#include <string>
+#include "model/minidump_model.hpp"
+
+namespace viewer {
+
+    MinidumpPanel::MinidumpPanel(BinaryModel& model)
+        : UiPanel("Minidump")
+        , model_(model)
+    {
+        filter_buf_[0] = '\0';
+    }
+
+    void MinidumpPanel::draw_contents() {
+        const MinidumpModel* dump = model_.minidump();
+        if (!dump) {
+            ImGui::TextUnformatted("No minidump loaded.");
+            return;
+        }
+
+        if (!dump->os.empty())
+            ImGui::Text("%s", dump->os.c_str());
+        ImGui::Text("%zu modules, %zu threads, %zu memory ranges (%.1f MB)", dump->modules.size(),
+                    dump->threads.size(), dump->memory_ranges,
+                    static_cast<double>(dump->memory_bytes) / (1024.0 * 1024.0));
+
+        if (dump->has_exception) {
+            ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "Exception 0x%08X at 0x%llX in thread %u",
+                               dump->exception_code, static_cast<unsigned long long>(dump->exception_address),
+                               dump->exception_thread);
+            for (size_t i = 0; i < dump->exception_parameters.size(); ++i)
+                ImGui::BulletText("Parameter %zu: 0x%llX", i,
+                                  static_cast<unsigned long long>(dump->exception_parameters[i]));
+        }
+        ImGui::Separator();
+
+        if (ImGui::CollapsingHeader("Threads")) {
+            for (const auto& t : dump->threads) {
+                char pc[24] = "?";
+                char sp[24] = "?";
+                if (t.pc)
+                    std::snprintf(pc, sizeof(pc), "0x%llX", static_cast<unsigned long long>(*t.pc));
+                if (t.sp)
+                    std::snprintf(sp, sizeof(sp), "0x%llX", static_cast<unsigned long long>(*t.sp));
+                ImGui::BulletText("%u  pc %s  sp %s  stack 0x%llX+0x%llX%s", t.tid, pc, sp,
+                                  static_cast<unsigned long long>(t.stack_start),
+                                  static_cast<unsigned long long>(t.stack_size),
+                                  dump->has_exception && t.tid == dump->exception_thread ? "  (faulting)" : "");
+            }
+        }
+
+        ImGui::InputTextWithHint("Filter", "Module path...", filter_buf_, sizeof(filter_buf_));
+        const std::string filter = filter_buf_;
+
+        if (ImGui::CollapsingHeader("Modules", ImGuiTreeNodeFlags_DefaultOpen)) {
+            ImGui::BeginChild("MinidumpModules", ImVec2(0, 0), false);
+            ImGui::Columns(5, nullptr, true);
+            ImGui::Text("Base"); ImGui::NextColumn();
+            ImGui::Text("Size"); ImGui::NextColumn();
+            ImGui::Text("Path"); ImGui::NextColumn();
+            ImGui::Text("Version"); ImGui::NextColumn();
+            ImGui::Text("Image"); ImGui::NextColumn();
+            ImGui::Separator();
+            for (const auto& m : dump->modules) {
+                if (!filter.empty() && m.path.find(filter) == std::string::npos)
+                    continue;
+                ImGui::Text("0x%llX", static_cast<unsigned long long>(m.base)); ImGui::NextColumn();
+                ImGui::Text("0x%X", m.size); ImGui::NextColumn();
+                ImGui::TextUnformatted(m.path.c_str());
+                if (!m.pdb.empty() && ImGui::IsItemHovered())
+                    ImGui::SetTooltip("%s", m.pdb.c_str());
+                ImGui::NextColumn();
+                ImGui::TextUnformatted(m.version.c_str()); ImGui::NextColumn();
+                if (!m.image_dumped)
+                    ImGui::TextDisabled("not dumped");
+                else if (!m.image_error.empty())
+                    ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%s", m.image_error.c_str());
+                else
+                    ImGui::Text("%zu imports, %zu exports", m.imports, m.exports);
+                ImGui::NextColumn();
+            }
+            ImGui::Columns(1);
+            ImGui::EndChild();
+        }
+    }
+
+} // namespace viewer
@@ -3,6 +3,7 @@
 //
 #include "ui_panels.hpp"
 #include <imgui.h>
+#include "model/pe_model.hpp"
 
 namespace viewer {
 
@@ -19,6 +20,19 @@ namespace viewer {
             return;
         }
 
+        // PE sections are listed in table order, so per-section results line up by index
+        const PeModel* pe = model_.pe();
+        const bool pe_columns = pe && pe->sections.size() == secs.size();
+        if (pe_columns) {
+            ImGui::Text("Headers: entropy %.2f", pe->headers_entropy);
+            if (pe->overlay_size)
+                ImGui::Text("Overlay: 0x%llX bytes at 0x%llX, entropy %.2f", (unsigned long long)pe->overlay_size,
+                            (unsigned long long)pe->overlay_offset, pe->overlay_entropy);
+            if (!pe->section_issues.empty())
+                ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%zu section layout issues",
+                                   pe->section_issues.size());
+        }
+
         ImGui::InputTextWithHint("Filter", "Name...", filter_buf_, sizeof(filter_buf_));
         std::string filter = filter_buf_;
         bool has_filter = !filter.empty();
@@ -26,14 +40,26 @@ namespace viewer {
         ImGui::Separator();
         ImGui::BeginChild("SectionsList", ImVec2(0,0), false);
 
-        ImGui::Columns(4, nullptr, true);
+        ImGui::Columns(pe_columns ? 6 : 4, nullptr, true);
         ImGui::Text("Name"); ImGui::NextColumn();
         ImGui::Text("Address"); ImGui::NextColumn();
         ImGui::Text("Size"); ImGui::NextColumn();
         ImGui::Text("Flags"); ImGui::NextColumn();
+        if (pe_columns) {
+            ImGui::Text("Entropy"); ImGui::NextColumn();
+            ImGui::Text("Layout"); ImGui::NextColumn();
+        }
         ImGui::Separator();
 
-        for (const auto& s : secs) {
+        std::size_t next_issue = 0;
+        for (std::size_t i = 0; i < secs.size(); ++i) {
+            const auto& s = secs[i];
+
+            // Issues of this section: [first_issue, next_issue)
+            const std::size_t first_issue = next_issue;
+            while (pe_columns && next_issue < pe->section_issues.size() && pe->section_issues[next_issue].section == i)
+                ++next_issue;
+
             if (has_filter && s.name.find(filter) == std::string::npos)
                 continue;
 
@@ -41,6 +67,32 @@ namespace viewer {
             ImGui::Text("0x%llX", (unsigned long long)s.address); ImGui::NextColumn();
             ImGui::Text("0x%llX", (unsigned long long)s.size); ImGui::NextColumn();
             ImGui::Text("0x%08X", s.flags); ImGui::NextColumn();
+            if (pe_columns) {
+                // Above ~7.2 bits per byte a section is almost always packed or encrypted
+                const double entropy = pe->sections[i].entropy;
+                if (entropy > 7.2)
+                    ImGui::TextColored(ImVec4(1.0f, 0.7f, 0.2f, 1.0f), "%.2f", entropy);
+                else
+                    ImGui::Text("%.2f", entropy);
+                ImGui::NextColumn();
+
+                if (first_issue == next_issue) {
+                    ImGui::TextDisabled("ok");
+                } else {
+                    ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%zu issue%s", next_issue - first_issue,
+                                       next_issue - first_issue == 1 ? "" : "s");
+                    if (ImGui::IsItemHovered()) {
+                        std::string text;
+                        for (std::size_t k = first_issue; k < next_issue; ++k) {
+                            if (!text.empty())
+                                text += '\n';
+                            text += pe->section_issues[k].description;
+                        }
+                        ImGui::SetTooltip("%s", text.c_str());
+                    }
+                }
+                ImGui::NextColumn();
+            }
         }
 
         ImGui::Columns(1);
@@ -0,0 +1,42 @@
+// libFuzzer harness for parse_elf_bytes, ElfView::parse and the tables read
+// from a parsed file
+#include "dwarf/dwarf_sections.hpp"
+#include "elf/elf_debuginfo.hpp"
+#include "elf/elf_dynamic.hpp"
+#include "elf/elf_notes.hpp"
+#include "elf/elf_parser.h"
+#include "elf/elf_relocations.hpp"
+#include "elf/elf_symbols.hpp"
+#include "elf/elf_versions.hpp"
+#include "elf/elf_view.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size) {
+    const std::span<const std::uint8_t> bytes(data, size);
+    (void)peelf::parse_elf_bytes(bytes);
+
+    auto elf = peelf::ElfView::parse(bytes);
+    if (!elf)
+        return 0;
+
+    for (std::size_t i = 0; i < elf->section_count(); ++i) {
+        (void)elf->section_name(i);
+        (void)elf->section_data(i);
+    }
+    for (std::size_t i = 0; i < elf->segment_count(); ++i)
+        (void)elf->segment_data(i);
+
+    (void)peelf::read_symtab(*elf);
+    (void)peelf::read_dynsym(*elf);
+    (void)peelf::read_required_versions(*elf);
+    (void)peelf::read_debuglink(*elf);
+    (void)peelf::read_build_info(bytes);
+    if (auto dynamic = peelf::read_dynamic(*elf))
+        (void)peelf::ElfRelocationTable::load(*elf, *dynamic);
+    // Decompresses the debug sections and, for ET_REL, relocates them
+    (void)peelf::DwarfSections::from_elf(*elf);
+    return 0;
+}
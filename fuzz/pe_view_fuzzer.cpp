@@ -0,0 +1,50 @@
+// libFuzzer harness for parse_pe_bytes, PeView::parse and the walks run over
+// a parsed file
+#include "pe/pe_authenticode.hpp"
+#include "pe/pe_byte_stats.hpp"
+#include "pe/pe_loaded_image.hpp"
+#include "pe/pe_parser.h"
+#include "pe/pe_relocations.hpp"
+#include "pe/pe_section_layout.hpp"
+#include "pe/pe_version_info.hpp"
+#include "pe/pe_view.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace {
+
+// Images above this are not built; SizeOfImage alone would exhaust the
+// fuzzer's memory limit
+constexpr std::uint32_t MAX_LOADED_IMAGE = 64u << 20;
+
+void walk(const peelf::PeView& pe) {
+    (void)pe.imports();
+    (void)pe.exports();
+    (void)pe.checksum_valid();
+    (void)peelf::read_base_relocations(pe);
+    (void)peelf::analyze_section_layout(pe);
+    (void)peelf::compute_byte_stats(pe, 1);
+    (void)peelf::read_version_info(pe);
+    if (auto certs = peelf::read_certificates(pe)) {
+        for (const auto& cert : *certs)
+            (void)peelf::read_embedded_digest(cert);
+    }
+    if (pe.size_of_image() <= MAX_LOADED_IMAGE)
+        (void)peelf::PeLoadedImage::build(pe, pe.image_base() + 0x10000, 1);
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size) {
+    const std::span<const std::uint8_t> bytes(data, size);
+    (void)peelf::parse_pe_bytes(bytes);
+
+    // Both layouts, so the mapped-image paths are reached from any input
+    for (const auto layout : {peelf::PeLayout::File, peelf::PeLayout::Image}) {
+        if (auto pe = peelf::PeView::parse(bytes, {}, layout))
+            walk(*pe);
+    }
+    return 0;
+}
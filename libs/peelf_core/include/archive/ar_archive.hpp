@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "peelf/peelf.hpp"
+#include "peelf/work_budget.hpp"
+
+namespace peelf {
+
+// Which tool wrote the archive, as told by its special members
+enum class ArFlavor {
+    Gnu,        // "/" (or "/SYM64/") symbol table, "//" long names
+    Bsd,        // "__.SYMDEF" symbol table, "#1/len" inline names
+    Msvc,       // two "/" linker members, the second sorted and little-endian
+};
+
+enum class ArMemberKind {
+    Unknown,
+    Elf,
+    Coff,
+    ImportObject,   // short import library entry
+    BigObj,         // /bigobj COFF, not decoded
+    Bitcode,        // LLVM bitcode (-flto), not decoded
+};
+
+struct ArMember {
+    std::string_view name;              // long and inline names resolved
+    std::uint64_t header_offset = 0;    // what the symbol tables refer to
+    std::span<const std::uint8_t> data;
+    std::uint64_t mtime = 0;
+    std::uint32_t mode = 0;
+};
+
+struct ArSymbol {
+    std::string_view name;
+    std::uint32_t member = 0;           // index into ArArchive::members()
+};
+
+// Symbols named `name` in an index sorted by name
+[[nodiscard]] std::span<const ArSymbol> find_symbols(std::span<const ArSymbol> sorted, std::string_view name);
+
+// Zero-copy view over a static library: System V / GNU (.a, including
+// the 64-bit symbol table), BSD and MSVC (.lib) `!<arch>` archives. The
+// special members (symbol tables, long-name table) are decoded in
+// parse() and hidden from members(); member data are sub-spans of the
+// archive bytes, which must outlive the view. Thin archives are rejected.
+class ArArchive {
+public:
+    static std::expected<ArArchive, Error> parse(std::span<const std::uint8_t> bytes,
+                                                 const ParseLimits& limits = {});
+
+    [[nodiscard]] std::span<const std::uint8_t> bytes() const { return bytes_; }
+    [[nodiscard]] ArFlavor flavor() const { return flavor_; }
+    [[nodiscard]] std::span<const ArMember> members() const { return members_; }
+
+    // The archive's own symbol index (the linker member), sorted by name;
+    // empty when the archive was written without one
+    [[nodiscard]] std::span<const ArSymbol> symbols() const { return symbols_; }
+    [[nodiscard]] std::span<const ArSymbol> find_symbol(std::string_view name) const {
+        return find_symbols(symbols_, name);
+    }
+
+    [[nodiscard]] std::optional<std::size_t> member_at_offset(std::uint64_t header_offset) const;
+
+private:
+    explicit ArArchive(std::span<const std::uint8_t> bytes) : bytes_(bytes) {}
+
+    std::expected<void, Error> read_symbol_table(std::span<const std::uint8_t> table, bool wide);
+    std::expected<void, Error> read_msvc_symbol_table(std::span<const std::uint8_t> table);
+    std::expected<void, Error> read_bsd_symbol_table(std::span<const std::uint8_t> table);
+    std::expected<void, Error> add_symbol(std::string_view name, std::uint64_t header_offset);
+
+    std::span<const std::uint8_t> bytes_;
+    ParseLimits limits_{};
+    ArFlavor flavor_ = ArFlavor::Gnu;
+    std::vector<ArMember> members_;     // in file order, so by header offset
+    std::vector<ArSymbol> symbols_;
+};
+
+[[nodiscard]] ArMemberKind member_kind(std::span<const std::uint8_t> data);
+
+// What a member defines and needs, from its own symbol table
+struct ArMemberSymbols {
+    ArMemberKind kind = ArMemberKind::Unknown;
+    std::uint16_t machine = 0;              // EM_* for ELF, IMAGE_FILE_MACHINE_* otherwise
+    std::vector<std::string_view> defined;  // global and weak definitions
+    std::size_t undefined = 0;              // global references
+    // Backs names that are not in the member bytes: the "__imp_" name an
+    // import object defines. Shared so `defined` survives copies and moves.
+    std::shared_ptr<const std::string> owned_names;
+};
+
+// Decodes every member as an ELF or COFF object on `threads` workers
+// (0 = one per hardware thread). Results are in the order of members();
+// members of kinds that are not decoded yield an empty result, not an
+// error.
+[[nodiscard]] std::vector<std::expected<ArMemberSymbols, Error>>
+analyze_members(const ArArchive& archive, std::size_t threads = 0);
+
+// Every definition found by analyze_members(), sorted by name. Unlike
+// ArArchive::symbols() this does not depend on the archive having been
+// indexed by ranlib. Names of import objects point into owned_names,
+// which must be kept alive alongside the index.
+[[nodiscard]] std::vector<ArSymbol>
+build_symbol_index(std::span<const std::expected<ArMemberSymbols, Error>> analysis);
+
+} // namespace peelf
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace peelf {
+
+// Streaming CRC-32 (IEEE 802.3, reflected, as zlib and .gnu_debuglink use
+// it). Large inputs are folded 64 bytes at a time with PCLMULQDQ when the
+// CPU has it; everything else goes through slice-by-8 tables.
+class Crc32 {
+public:
+    void reset() { state_ = ~std::uint32_t{0}; }
+    void update(std::span<const std::uint8_t> data);
+    [[nodiscard]] std::uint32_t value() const { return ~state_; }
+
+    [[nodiscard]] static std::uint32_t hash(std::span<const std::uint8_t> data) {
+        Crc32 c;
+        c.update(data);
+        return c.value();
+    }
+
+private:
+    std::uint32_t state_ = ~std::uint32_t{0};
+};
+
+} // namespace peelf
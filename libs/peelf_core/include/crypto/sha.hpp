@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace peelf {
+
+// Streaming SHA-1 / SHA-256. Input is compressed straight out of the
+// caller's buffer in whole 64-byte blocks; only a partial trailing block is
+// copied. The block function is picked once at runtime: SHA-NI when the
+// CPU has it, portable C++ otherwise.
+
+class Sha1 {
+public:
+    static constexpr std::size_t digest_size = 20;
+    using digest_type = std::array<std::uint8_t, digest_size>;
+
+    Sha1() { reset(); }
+
+    void reset();
+    void update(std::span<const std::uint8_t> data);
+    [[nodiscard]] digest_type finish();
+
+    [[nodiscard]] static digest_type hash(std::span<const std::uint8_t> data) {
+        Sha1 h;
+        h.update(data);
+        return h.finish();
+    }
+
+private:
+    std::array<std::uint32_t, 5> state_{};
+    std::array<std::uint8_t, 64> buffer_{};
+    std::size_t buffered_ = 0;
+    std::uint64_t total_ = 0;
+};
+
+class Sha256 {
+public:
+    static constexpr std::size_t digest_size = 32;
+    using digest_type = std::array<std::uint8_t, digest_size>;
+
+    Sha256() { reset(); }
+
+    void reset();
+    void update(std::span<const std::uint8_t> data);
+    [[nodiscard]] digest_type finish();
+
+    [[nodiscard]] static digest_type hash(std::span<const std::uint8_t> data) {
+        Sha256 h;
+        h.update(data);
+        return h.finish();
+    }
+
+private:
+    std::array<std::uint32_t, 8> state_{};
+    std::array<std::uint8_t, 64> buffer_{};
+    std::size_t buffered_ = 0;
+    std::uint64_t total_ = 0;
+};
+
+} // namespace peelf
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstdint>
+
+namespace peelf {
+
+// Unit types (DWARF 5 unit header)
+static constexpr std::uint8_t DW_UT_compile       = 0x01;
+static constexpr std::uint8_t DW_UT_type          = 0x02;
+static constexpr std::uint8_t DW_UT_partial       = 0x03;
+static constexpr std::uint8_t DW_UT_skeleton      = 0x04;
+static constexpr std::uint8_t DW_UT_split_compile = 0x05;
+static constexpr std::uint8_t DW_UT_split_type    = 0x06;
+
+// Tags the readers look at
+static constexpr std::uint16_t DW_TAG_class_type         = 0x02;
+static constexpr std::uint16_t DW_TAG_enumeration_type   = 0x04;
+static constexpr std::uint16_t DW_TAG_lexical_block      = 0x0B;
+static constexpr std::uint16_t DW_TAG_compile_unit       = 0x11;
+static constexpr std::uint16_t DW_TAG_structure_type     = 0x13;
+static constexpr std::uint16_t DW_TAG_typedef            = 0x16;
+static constexpr std::uint16_t DW_TAG_union_type         = 0x17;
+static constexpr std::uint16_t DW_TAG_inlined_subroutine = 0x1D;
+static constexpr std::uint16_t DW_TAG_base_type          = 0x24;
+static constexpr std::uint16_t DW_TAG_enumerator         = 0x28;
+static constexpr std::uint16_t DW_TAG_subprogram         = 0x2E;
+static constexpr std::uint16_t DW_TAG_variable           = 0x34;
+static constexpr std::uint16_t DW_TAG_namespace          = 0x39;
+static constexpr std::uint16_t DW_TAG_partial_unit       = 0x3C;
+static constexpr std::uint16_t DW_TAG_type_unit          = 0x41;
+static constexpr std::uint16_t DW_TAG_skeleton_unit      = 0x4A;
+
+// Attributes the readers look at
+static constexpr std::uint16_t DW_AT_sibling           = 0x01;
+static constexpr std::uint16_t DW_AT_name              = 0x03;
+static constexpr std::uint16_t DW_AT_stmt_list         = 0x10;
+static constexpr std::uint16_t DW_AT_low_pc            = 0x11;
+static constexpr std::uint16_t DW_AT_high_pc           = 0x12;
+static constexpr std::uint16_t DW_AT_language          = 0x13;
+static constexpr std::uint16_t DW_AT_comp_dir          = 0x1B;
+static constexpr std::uint16_t DW_AT_producer          = 0x25;
+static constexpr std::uint16_t DW_AT_abstract_origin   = 0x31;
+static constexpr std::uint16_t DW_AT_declaration       = 0x3C;
+static constexpr std::uint16_t DW_AT_external          = 0x3F;
+static constexpr std::uint16_t DW_AT_specification     = 0x47;
+static constexpr std::uint16_t DW_AT_ranges            = 0x55;
+static constexpr std::uint16_t DW_AT_linkage_name      = 0x6E;
+static constexpr std::uint16_t DW_AT_str_offsets_base  = 0x72;
+static constexpr std::uint16_t DW_AT_addr_base         = 0x73;
+static constexpr std::uint16_t DW_AT_rnglists_base     = 0x74;
+static constexpr std::uint16_t DW_AT_dwo_name          = 0x76;
+static constexpr std::uint16_t DW_AT_MIPS_linkage_name = 0x2007;
+static constexpr std::uint16_t DW_AT_GNU_dwo_name      = 0x2130;
+static constexpr std::uint16_t DW_AT_GNU_ranges_base   = 0x2132;
+static constexpr std::uint16_t DW_AT_GNU_addr_base     = 0x2133;
+
+// Attribute forms
+static constexpr std::uint16_t DW_FORM_addr           = 0x01;
+static constexpr std::uint16_t DW_FORM_block2         = 0x03;
+static constexpr std::uint16_t DW_FORM_block4         = 0x04;
+static constexpr std::uint16_t DW_FORM_data2          = 0x05;
+static constexpr std::uint16_t DW_FORM_data4          = 0x06;
+static constexpr std::uint16_t DW_FORM_data8          = 0x07;
+static constexpr std::uint16_t DW_FORM_string         = 0x08;
+static constexpr std::uint16_t DW_FORM_block          = 0x09;
+static constexpr std::uint16_t DW_FORM_block1         = 0x0A;
+static constexpr std::uint16_t DW_FORM_data1          = 0x0B;
+static constexpr std::uint16_t DW_FORM_flag           = 0x0C;
+static constexpr std::uint16_t DW_FORM_sdata          = 0x0D;
+static constexpr std::uint16_t DW_FORM_strp           = 0x0E;
+static constexpr std::uint16_t DW_FORM_udata          = 0x0F;
+static constexpr std::uint16_t DW_FORM_ref_addr       = 0x10;
+static constexpr std::uint16_t DW_FORM_ref1           = 0x11;
+static constexpr std::uint16_t DW_FORM_ref2           = 0x12;
+static constexpr std::uint16_t DW_FORM_ref4           = 0x13;
+static constexpr std::uint16_t DW_FORM_ref8           = 0x14;
+static constexpr std::uint16_t DW_FORM_ref_udata      = 0x15;
+static constexpr std::uint16_t DW_FORM_indirect       = 0x16;
+static constexpr std::uint16_t DW_FORM_sec_offset     = 0x17;
+static constexpr std::uint16_t DW_FORM_exprloc        = 0x18;
+static constexpr std::uint16_t DW_FORM_flag_present   = 0x19;
+static constexpr std::uint16_t DW_FORM_strx           = 0x1A;
+static constexpr std::uint16_t DW_FORM_addrx          = 0x1B;
+static constexpr std::uint16_t DW_FORM_ref_sup4       = 0x1C;
+static constexpr std::uint16_t DW_FORM_strp_sup       = 0x1D;
+static constexpr std::uint16_t DW_FORM_data16         = 0x1E;
+static constexpr std::uint16_t DW_FORM_line_strp      = 0x1F;
+static constexpr std::uint16_t DW_FORM_ref_sig8       = 0x20;
+static constexpr std::uint16_t DW_FORM_implicit_const = 0x21;
+static constexpr std::uint16_t DW_FORM_loclistx       = 0x22;
+static constexpr std::uint16_t DW_FORM_rnglistx       = 0x23;
+static constexpr std::uint16_t DW_FORM_ref_sup8       = 0x24;
+static constexpr std::uint16_t DW_FORM_strx1          = 0x25;
+static constexpr std::uint16_t DW_FORM_strx2          = 0x26;
+static constexpr std::uint16_t DW_FORM_strx3          = 0x27;
+static constexpr std::uint16_t DW_FORM_strx4          = 0x28;
+static constexpr std::uint16_t DW_FORM_addrx1         = 0x29;
+static constexpr std::uint16_t DW_FORM_addrx2         = 0x2A;
+static constexpr std::uint16_t DW_FORM_addrx3         = 0x2B;
+static constexpr std::uint16_t DW_FORM_addrx4         = 0x2C;
+static constexpr std::uint16_t DW_FORM_GNU_addr_index = 0x1F01;
+static constexpr std::uint16_t DW_FORM_GNU_str_index  = 0x1F02;
+static constexpr std::uint16_t DW_FORM_GNU_ref_alt    = 0x1F20;
+static constexpr std::uint16_t DW_FORM_GNU_strp_alt   = 0x1F21;
+
+// Line number program: standard opcodes
+static constexpr std::uint8_t DW_LNS_copy               = 0x01;
+static constexpr std::uint8_t DW_LNS_advance_pc         = 0x02;
+static constexpr std::uint8_t DW_LNS_advance_line       = 0x03;
+static constexpr std::uint8_t DW_LNS_set_file           = 0x04;
+static constexpr std::uint8_t DW_LNS_set_column         = 0x05;
+static constexpr std::uint8_t DW_LNS_negate_stmt        = 0x06;
+static constexpr std::uint8_t DW_LNS_set_basic_block    = 0x07;
+static constexpr std::uint8_t DW_LNS_const_add_pc       = 0x08;
+static constexpr std::uint8_t DW_LNS_fixed_advance_pc   = 0x09;
+static constexpr std::uint8_t DW_LNS_set_prologue_end   = 0x0A;
+static constexpr std::uint8_t DW_LNS_set_epilogue_begin = 0x0B;
+static constexpr std::uint8_t DW_LNS_set_isa            = 0x0C;
+
+// Line number program: extended opcodes
+static constexpr std::uint8_t DW_LNE_end_sequence      = 0x01;
+static constexpr std::uint8_t DW_LNE_set_address       = 0x02;
+static constexpr std::uint8_t DW_LNE_define_file       = 0x03;
+static constexpr std::uint8_t DW_LNE_set_discriminator = 0x04;
+
+// Line table header entry formats (DWARF 5)
+static constexpr std::uint16_t DW_LNCT_path            = 0x1;
+static constexpr std::uint16_t DW_LNCT_directory_index = 0x2;
+static constexpr std::uint16_t DW_LNCT_timestamp       = 0x3;
+static constexpr std::uint16_t DW_LNCT_size            = 0x4;
+static constexpr std::uint16_t DW_LNCT_MD5             = 0x5;
+
+// Range list entries (.debug_rnglists)
+static constexpr std::uint8_t DW_RLE_end_of_list   = 0x00;
+static constexpr std::uint8_t DW_RLE_base_addressx = 0x01;
+static constexpr std::uint8_t DW_RLE_startx_endx   = 0x02;
+static constexpr std::uint8_t DW_RLE_startx_length = 0x03;
+static constexpr std::uint8_t DW_RLE_offset_pair   = 0x04;
+static constexpr std::uint8_t DW_RLE_base_address  = 0x05;
+static constexpr std::uint8_t DW_RLE_start_end     = 0x06;
+static constexpr std::uint8_t DW_RLE_start_length  = 0x07;
+
+// Name index entry attributes (.debug_names)
+static constexpr std::uint16_t DW_IDX_compile_unit = 0x1;
+static constexpr std::uint16_t DW_IDX_type_unit    = 0x2;
+static constexpr std::uint16_t DW_IDX_die_offset   = 0x3;
+static constexpr std::uint16_t DW_IDX_parent       = 0x4;
+static constexpr std::uint16_t DW_IDX_type_hash    = 0x5;
+
+} // namespace peelf
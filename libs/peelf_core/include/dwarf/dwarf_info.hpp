@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "peelf/peelf.hpp"
+#include "peelf/byte_reader.hpp"
+#include "dwarf/dwarf_sections.hpp"
+#include "dwarf/dwarf_unit.hpp"
+
+namespace peelf {
+
+// A DIE located but not decoded: attributes are read on request
+struct DwarfDie {
+    std::uint64_t offset = 0;           // in .debug_info
+    std::uint32_t unit = 0;             // index into DwarfInfo::units()
+    const DwarfAbbrev* abbrev = nullptr;
+    std::uint64_t attributes_offset = 0;
+
+    [[nodiscard]] std::uint16_t tag() const { return abbrev->tag; }
+    [[nodiscard]] bool has_children() const { return abbrev->has_children; }
+};
+
+struct DwarfAttribute {
+    std::uint16_t attribute = 0;        // DW_AT_*
+    DwarfFormValue value;
+};
+
+// Lazy view of .debug_info. load() reads every unit header, its
+// abbreviation table (shared between units that point at the same one)
+// and the string/address/range bases from its root DIE, in parallel.
+// Nothing else is decoded until asked for. The sections must outlive this.
+class DwarfInfo {
+public:
+    DwarfInfo() = default;
+
+    static std::expected<DwarfInfo, Error> load(const DwarfSections& s, std::size_t max_units = SIZE_MAX);
+
+    [[nodiscard]] const DwarfSections& sections() const { return sections_; }
+    [[nodiscard]] std::span<const DwarfUnit> units() const { return units_; }
+    [[nodiscard]] const DwarfAbbrevTable& abbrevs(std::size_t unit) const { return abbrev_tables_[unit_abbrevs_[unit]]; }
+    [[nodiscard]] std::size_t abbrev_table_count() const { return abbrev_tables_.size(); }
+
+    // Unit containing a .debug_info offset
+    [[nodiscard]] std::optional<std::size_t> unit_at(std::uint64_t info_offset) const;
+
+    [[nodiscard]] std::expected<DwarfDie, Error> die_at(std::uint64_t info_offset) const;
+    [[nodiscard]] std::expected<DwarfDie, Error> root(std::size_t unit) const;
+
+    [[nodiscard]] std::expected<std::vector<DwarfAttribute>, Error> attributes(const DwarfDie& die) const;
+    [[nodiscard]] std::optional<DwarfFormValue> attribute(const DwarfDie& die, std::uint16_t attribute) const;
+
+    // DW_AT_name; DW_AT_linkage_name (or the MIPS spelling)
+    [[nodiscard]] std::string_view name(const DwarfDie& die) const;
+    [[nodiscard]] std::string_view linkage_name(const DwarfDie& die) const;
+    [[nodiscard]] std::string_view string(const DwarfDie& die, const DwarfFormValue& v) const {
+        return form_string(sections_, units_[die.unit], v);
+    }
+    // .debug_info offset a reference form points at; nullopt for other forms
+    // and for DW_FORM_ref_sig8, which names a type unit by signature
+    [[nodiscard]] std::optional<std::uint64_t> reference(const DwarfDie& die, const DwarfFormValue& v) const;
+
+    [[nodiscard]] std::expected<std::vector<DwarfDie>, Error> children(const DwarfDie& die) const;
+
+private:
+    DwarfSections sections_;
+    std::vector<DwarfUnit> units_;
+    std::vector<DwarfAbbrevTable> abbrev_tables_;
+    std::vector<std::uint32_t> unit_abbrevs_;   // per unit, into abbrev_tables_
+};
+
+// Pre-order walk over the DIEs of one unit for code that visits many of
+// them. Attributes of the current DIE are decoded only if asked for and
+// skipped otherwise, and skip_children() jumps over a subtree through
+// DW_AT_sibling when the producer left one.
+class DwarfUnitCursor {
+public:
+    DwarfUnitCursor(const DwarfInfo& info, std::size_t unit);
+
+    // Next DIE, or nullopt at the end of the unit or on malformed input
+    // (then ok() is false)
+    [[nodiscard]] std::optional<DwarfDie> next();
+    // Of the DIE last returned; the root is at depth 0
+    [[nodiscard]] std::size_t depth() const { return depth_; }
+    [[nodiscard]] bool ok() const { return ok_ && reader_.ok(); }
+
+    // Attributes of the DIE last returned; valid until next()
+    [[nodiscard]] std::span<const DwarfAttribute> attributes();
+    // Makes the following next() continue after the current DIE's subtree
+    void skip_children();
+
+private:
+    // Reads (or skips past) the current DIE's attributes, once
+    bool finish_attributes();
+
+    const DwarfUnit* unit_;
+    const DwarfAbbrevTable* abbrevs_;
+    ByteReader reader_;
+    std::uint32_t unit_index_;
+    std::optional<DwarfDie> current_;
+    bool attributes_read_ = true;
+    std::vector<DwarfAttribute> attributes_;
+    std::optional<std::uint64_t> sibling_;
+    std::size_t depth_ = 0;
+    std::size_t level_ = 0;             // depth of the next DIE
+    bool ok_ = true;
+};
+
+} // namespace peelf
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "peelf/peelf.hpp"
+#include "peelf/lru_cache.hpp"
+#include "dwarf/dwarf_sections.hpp"
+#include "dwarf/dwarf_unit.hpp"
+
+namespace peelf {
+
+// One row of the line number matrix
+struct DwarfLineRow {
+    std::uint64_t address = 0;
+    std::uint32_t file = 0;             // as in the program: 1-based before DWARF 5, 0-based from 5
+    std::uint32_t line = 0;
+    std::uint16_t column = 0;
+    bool is_stmt = false;
+    bool end_sequence = false;
+    bool prologue_end = false;
+    bool epilogue_begin = false;
+};
+
+// Decoded line table of one unit. Rows are kept as an address column plus
+// a 12-byte row column, with whole sequences sorted by start address, so
+// find() is a binary search over plain addresses. Names are views into
+// the DWARF sections.
+class DwarfLineTable {
+public:
+    DwarfLineTable() = default;
+
+    // Runs the line number program at offset in .debug_line. comp_dir is
+    // the unit's DW_AT_comp_dir (directory 0 before DWARF 5).
+    static std::expected<DwarfLineTable, Error> parse(const DwarfSections& s, std::uint64_t offset,
+                                                      std::string_view comp_dir = {},
+                                                      std::size_t max_rows = SIZE_MAX);
+
+    [[nodiscard]] std::uint16_t version() const { return version_; }
+    [[nodiscard]] std::size_t size() const { return addresses_.size(); }
+    [[nodiscard]] DwarfLineRow row(std::size_t i) const;
+
+    // Row covering address: the last row at or below it within a sequence
+    [[nodiscard]] std::optional<DwarfLineRow> find(std::uint64_t address) const;
+
+    [[nodiscard]] std::size_t file_count() const { return files_.size(); }
+    // File name as written in the table, for a row's file number
+    [[nodiscard]] std::string_view file_name(std::uint32_t file) const;
+    // comp_dir / include directory / name, joined as needed
+    [[nodiscard]] std::string file_path(std::uint32_t file) const;
+
+    // Approximate heap footprint, used as the cache weight
+    [[nodiscard]] std::size_t memory_usage() const;
+
+private:
+    struct Row {
+        std::uint32_t file;
+        std::uint32_t line;
+        std::uint16_t column;
+        std::uint8_t flags;
+    };
+    struct FileEntry {
+        std::string_view name;
+        std::uint64_t dir = 0;
+    };
+
+    static constexpr std::uint8_t flag_is_stmt = 1;
+    static constexpr std::uint8_t flag_end_sequence = 2;
+    static constexpr std::uint8_t flag_prologue_end = 4;
+    static constexpr std::uint8_t flag_epilogue_begin = 8;
+
+    [[nodiscard]] const FileEntry* file_entry(std::uint32_t file) const;
+
+    std::vector<std::uint64_t> addresses_;
+    std::vector<Row> rows_;
+    std::vector<std::string_view> dirs_;
+    std::vector<FileEntry> files_;
+    std::string_view comp_dir_;
+    std::uint16_t version_ = 0;
+};
+
+struct DwarfSourceLocation {
+    std::string file;                   // full path as far as the DWARF knows it
+    std::uint32_t line = 0;
+    std::uint16_t column = 0;
+};
+
+// address -> file:line over a whole object without decoding it all.
+// build() reads the unit headers and an address -> unit map, taken from
+// .debug_aranges where it covers a unit and from the unit's root DIE
+// ranges otherwise. A lookup decodes the line table of the one unit it
+// lands in; decoded tables are kept in a size-bounded LRU shared by all
+// threads, so annotating a disassembly listing decodes each unit once.
+class DwarfLineIndex {
+public:
+    static constexpr std::size_t default_cache_bytes = 64u << 20;
+
+    static std::expected<DwarfLineIndex, Error> build(const DwarfSections& s,
+                                                      std::size_t cache_bytes = default_cache_bytes);
+
+    [[nodiscard]] std::size_t unit_count() const { return units_.size(); }
+    [[nodiscard]] std::size_t range_count() const { return ranges_.size(); }
+
+    [[nodiscard]] std::optional<DwarfSourceLocation> lookup(std::uint64_t address) const;
+
+    // Unit whose ranges contain the address
+    [[nodiscard]] std::optional<std::size_t> unit_for_address(std::uint64_t address) const;
+
+    // Decoded line table of a unit, from the cache when possible; null
+    // when the unit has none
+    [[nodiscard]] std::expected<std::shared_ptr<const DwarfLineTable>, Error> line_table(std::size_t unit) const;
+
+    [[nodiscard]] const LruCache<std::uint64_t, DwarfLineTable>& cache() const { return *cache_; }
+
+private:
+    struct UnitRange {
+        std::uint64_t begin;
+        std::uint64_t end;
+        std::size_t unit;
+    };
+
+    std::expected<void, Error> read_aranges(std::vector<bool>& covered);
+
+    DwarfSections sections_;
+    std::vector<DwarfUnit> units_;
+    std::vector<UnitRange> ranges_;     // sorted by begin
+    std::unique_ptr<LruCache<std::uint64_t, DwarfLineTable>> cache_;   // keyed by unit index
+};
+
+} // namespace peelf
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "peelf/peelf.hpp"
+#include "dwarf/dwarf_info.hpp"
+
+namespace peelf {
+
+enum class DwarfNameSource {
+    DebugNames,     // DWARF 5 .debug_names
+    GdbIndex,       // .gdb_index version 7-9
+    Scan,           // built here by walking the units
+};
+
+// Name -> DIE lookup over a whole object. build() uses the accelerator
+// table the producer left (.debug_names, else .gdb_index) and walks only
+// the units that table does not cover, in parallel, recording a 64-bit
+// name hash per definition. find() is then a hash probe plus the decoding
+// of the few DIEs it lands on.
+//
+// Names are DW_AT_name and DW_AT_linkage_name, unqualified, as
+// .debug_names stores them. .gdb_index stores C++ names qualified
+// ("ns::func") and has no linkage names, so it only answers qualified
+// lookups; the first unqualified find() scans the units it covers like
+// any other. Declarations are not indexed. The DwarfInfo must outlive this.
+class DwarfNameIndex {
+public:
+    static std::expected<DwarfNameIndex, Error> build(const DwarfInfo& info, std::size_t threads = 0);
+
+    [[nodiscard]] DwarfNameSource source() const { return source_; }
+    [[nodiscard]] std::size_t scanned_unit_count() const { return scanned_units_; }
+    // Names in the accelerator table plus names recorded by the scan
+    [[nodiscard]] std::size_t name_count() const;
+
+    [[nodiscard]] std::expected<std::vector<DwarfDie>, Error> find(std::string_view name) const;
+
+    // Hashes of the two on-disk formats (case-folded DJB; gdb's
+    // mapped_index_string_hash from version 5 on)
+    [[nodiscard]] static std::uint32_t debug_names_hash(std::string_view name);
+    [[nodiscard]] static std::uint32_t gdb_index_hash(std::string_view name);
+
+private:
+    struct NamesAbbrev {
+        std::uint64_t code = 0;
+        std::uint16_t tag = 0;
+        std::uint32_t first_attr = 0;
+        std::uint32_t attr_count = 0;
+    };
+    struct NamesAttr {
+        std::uint16_t index = 0;        // DW_IDX_*
+        std::uint16_t form = 0;
+    };
+    // One name index unit of .debug_names; positions are section offsets
+    struct NamesTable {
+        std::uint8_t offset_size = 4;
+        std::uint32_t cu_count = 0;
+        std::uint32_t local_tu_count = 0;
+        std::uint32_t bucket_count = 0;
+        std::uint32_t name_count = 0;
+        std::size_t cu_list = 0;
+        std::size_t local_tu_list = 0;
+        std::size_t buckets = 0;
+        std::size_t hashes = 0;
+        std::size_t string_offsets = 0;
+        std::size_t entry_offsets = 0;
+        std::size_t entry_pool = 0;
+        std::size_t end = 0;
+        std::vector<NamesAbbrev> abbrevs;   // sorted by code
+        std::vector<NamesAttr> attrs;
+    };
+    struct GdbIndex {
+        std::span<const std::uint8_t> data;
+        std::uint32_t cu_list = 0;
+        std::uint32_t cu_count = 0;
+        std::uint32_t symbols = 0;
+        std::uint32_t slot_count = 0;   // power of two
+        std::uint32_t constant_pool = 0;
+        std::size_t used_slots = 0;
+    };
+    struct ScanEntry {
+        std::uint64_t hash;
+        std::uint64_t die_offset;
+    };
+    // Units .gdb_index covers, scanned on the first unqualified find().
+    // Shared so the index stays movable; copies share the one scan.
+    struct DeferredScan {
+        std::once_flag once;
+        std::vector<std::size_t> units;
+        std::size_t threads = 0;
+        std::vector<ScanEntry> entries;
+    };
+
+    std::expected<void, Error> load_debug_names(std::vector<bool>& covered);
+    std::expected<void, Error> load_gdb_index(std::vector<bool>& covered);
+    static std::vector<ScanEntry> scan(const DwarfInfo& info, std::span<const std::size_t> units, std::size_t threads);
+    void find_scanned(std::span<const ScanEntry> entries, std::string_view name, std::vector<DwarfDie>& out) const;
+
+    std::expected<void, Error> find_debug_names(const NamesTable& t, std::string_view name,
+                                                std::vector<DwarfDie>& out) const;
+    std::expected<void, Error> read_names_entries(const NamesTable& t, std::uint32_t name_index,
+                                                  std::vector<DwarfDie>& out) const;
+    std::expected<void, Error> find_gdb_index(std::string_view name, std::vector<DwarfDie>& out) const;
+
+    const DwarfInfo* info_ = nullptr;
+    DwarfNameSource source_ = DwarfNameSource::Scan;
+    std::vector<NamesTable> names_tables_;
+    GdbIndex gdb_;
+    std::vector<ScanEntry> entries_;    // sorted by hash, then offset
+    std::shared_ptr<DeferredScan> deferred_;
+    std::size_t scanned_units_ = 0;
+};
+
+} // namespace peelf
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "peelf/peelf.hpp"
+#include "elf/elf_view.hpp"
+
+namespace peelf {
+
+class ElfSectionCache;
+
+// The DWARF sections of one object, as raw bytes. Missing sections are
+// empty spans. Compressed sections (SHF_COMPRESSED or legacy .zdebug_*)
+// are decompressed, and the buffers are held in `storage`; the file bytes
+// must still outlive this.
+//
+// In an ET_REL object the string, line, range and address offsets are
+// left to the linker, so the .rel(a).debug_* relocations are applied to
+// copies of the sections they target. Addresses then come out relative to
+// the section they point into, as in llvm-dwarfdump. A relocation type
+// that has no place in a debug section is an error rather than a silently
+// wrong offset.
+struct DwarfSections {
+    std::span<const std::uint8_t> info;
+    std::span<const std::uint8_t> abbrev;
+    std::span<const std::uint8_t> line;
+    std::span<const std::uint8_t> line_str;
+    std::span<const std::uint8_t> str;
+    std::span<const std::uint8_t> str_offsets;
+    std::span<const std::uint8_t> addr;
+    std::span<const std::uint8_t> aranges;
+    std::span<const std::uint8_t> ranges;       // DWARF 2-4
+    std::span<const std::uint8_t> rnglists;     // DWARF 5
+    std::span<const std::uint8_t> names;        // .debug_names
+    std::span<const std::uint8_t> gdb_index;
+
+    bool big_endian = false;
+    std::uint8_t address_size = 8;              // of the file; units carry their own
+    bool compressed = false;                    // some sections were decompressed
+    bool relocated = false;                     // ET_REL relocations were applied
+
+    std::vector<std::shared_ptr<const std::vector<std::uint8_t>>> storage;
+
+    [[nodiscard]] bool empty() const { return info.empty() && line.empty(); }
+    [[nodiscard]] bool decompressed() const { return compressed; }
+
+    // Compressed sections are decoded in parallel through `cache`, or a
+    // private unbounded one when none is given
+    [[nodiscard]] static std::expected<DwarfSections, Error> from_elf(const ElfView& elf,
+                                                                      const ElfSectionCache* cache = nullptr);
+};
+
+} // namespace peelf
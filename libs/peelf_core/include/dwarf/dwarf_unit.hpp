@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "peelf/peelf.hpp"
+#include "peelf/byte_reader.hpp"
+#include "dwarf/dwarf_constants.hpp"
+#include "dwarf/dwarf_sections.hpp"
+
+namespace peelf {
+
+// One unit header in .debug_info (DWARF 2-5)
+struct DwarfUnit {
+    std::uint64_t offset = 0;           // of the header within .debug_info
+    std::uint64_t end = 0;              // one past the unit
+    std::uint64_t die_offset = 0;       // first (root) DIE
+    std::uint64_t abbrev_offset = 0;
+    std::uint16_t version = 0;
+    std::uint8_t unit_type = DW_UT_compile;
+    std::uint8_t address_size = 8;
+    std::uint8_t offset_size = 4;       // 8 in 64-bit DWARF
+    std::uint64_t id = 0;               // dwo_id or type signature, when the unit type has one
+
+    // Bases from the root DIE; only set once read_unit_root() has run
+    std::uint64_t str_offsets_base = 0;
+    std::uint64_t addr_base = 0;
+    std::uint64_t rnglists_base = 0;
+
+    [[nodiscard]] bool contains(std::uint64_t info_offset) const { return info_offset >= offset && info_offset < end; }
+};
+
+struct DwarfAttrSpec {
+    std::uint16_t attribute = 0;        // DW_AT_*
+    std::uint16_t form = 0;             // DW_FORM_*
+    std::int64_t implicit_const = 0;
+};
+
+struct DwarfAbbrev {
+    std::uint64_t code = 0;
+    std::uint16_t tag = 0;
+    bool has_children = false;
+    std::uint32_t first_spec = 0;       // into DwarfAbbrevTable's spec array
+    std::uint32_t spec_count = 0;
+};
+
+// One abbreviation table from .debug_abbrev. Codes are almost always
+// 1..n in order, in which case find() is an index; otherwise a binary
+// search over the sorted codes.
+class DwarfAbbrevTable {
+public:
+    DwarfAbbrevTable() = default;
+
+    static std::expected<DwarfAbbrevTable, Error> parse(std::span<const std::uint8_t> abbrev, std::uint64_t offset);
+
+    [[nodiscard]] const DwarfAbbrev* find(std::uint64_t code) const;
+    [[nodiscard]] std::span<const DwarfAttrSpec> attributes(const DwarfAbbrev& a) const {
+        return std::span<const DwarfAttrSpec>(specs_).subspan(a.first_spec, a.spec_count);
+    }
+    [[nodiscard]] std::size_t size() const { return abbrevs_.size(); }
+
+private:
+    std::vector<DwarfAbbrev> abbrevs_;  // sorted by code
+    std::vector<DwarfAttrSpec> specs_;
+    bool dense_ = true;                 // abbrevs_[i].code == i + 1
+};
+
+// One attribute value as stored; strings and indexed forms are resolved
+// separately because the bases they need come from the root DIE itself
+struct DwarfFormValue {
+    std::uint16_t form = 0;
+    std::uint64_t value = 0;            // constants, flags, offsets, indices, addresses
+    std::int64_t signed_value = 0;      // DW_FORM_sdata, DW_FORM_implicit_const
+    std::span<const std::uint8_t> block;    // blocks, exprloc, data16
+    std::string_view string;            // DW_FORM_string
+
+    // Constant class: data1/2/4/8, udata, sdata, implicit_const
+    [[nodiscard]] bool is_constant() const;
+};
+
+struct DwarfRange {
+    std::uint64_t begin = 0;
+    std::uint64_t end = 0;
+};
+
+// Summary of a unit's root DIE
+struct DwarfUnitRoot {
+    std::uint16_t tag = 0;
+    std::string_view name;
+    std::string_view comp_dir;
+    std::string_view producer;
+    std::optional<std::uint64_t> stmt_list;     // offset into .debug_line
+    std::vector<DwarfRange> ranges;             // from low/high_pc or DW_AT_ranges
+};
+
+// Every unit header in .debug_info. Only the headers are read: the walk
+// hops from length to length without touching DIEs.
+[[nodiscard]] std::expected<std::vector<DwarfUnit>, Error>
+read_units(const DwarfSections& s, std::size_t max_units = SIZE_MAX);
+
+// Reads one attribute value of `form` at the reader. Returns false for
+// forms this reader does not know (the rest of the DIE is then unreadable).
+bool read_form(ByteReader& r, std::uint16_t form, std::int64_t implicit_const,
+               const DwarfUnit& unit, DwarfFormValue& out);
+
+// String for DW_FORM_string / strp / line_strp / strx*; empty otherwise
+[[nodiscard]] std::string_view form_string(const DwarfSections& s, const DwarfUnit& unit, const DwarfFormValue& v);
+
+// Address for DW_FORM_addr / addrx*; nullopt otherwise
+[[nodiscard]] std::optional<std::uint64_t> form_address(const DwarfSections& s, const DwarfUnit& unit, const DwarfFormValue& v);
+
+// Decodes the DW_AT_ranges value (rnglistx or section offset) into out
+std::expected<void, Error> read_ranges(const DwarfSections& s, const DwarfUnit& unit, const DwarfFormValue& ranges,
+                                       std::uint64_t base_address, std::vector<DwarfRange>& out);
+
+// Reads the root DIE, storing the str_offsets / addr / rnglists bases in
+// the unit on the way
+[[nodiscard]] std::expected<DwarfUnitRoot, Error>
+read_unit_root(const DwarfSections& s, DwarfUnit& unit, const DwarfAbbrevTable& abbrevs);
+
+} // namespace peelf
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "peelf/peelf.hpp"
+#include "elf/elf_structures.hpp"
+#include "mapping/windowed_mapping.hpp"
+
+namespace peelf {
+
+// A PT_LOAD segment of a core file: process memory at vaddr. Only the
+// first file_size bytes were dumped; the rest of mem_size is unavailable.
+struct ElfCoreSegment {
+    std::uint64_t vaddr = 0;
+    std::uint64_t mem_size = 0;
+    std::uint64_t offset = 0;
+    std::uint64_t file_size = 0;
+    std::uint32_t flags = 0;            // PF_*
+};
+
+// One NT_PRSTATUS note, i.e. one thread
+struct ElfCoreThread {
+    std::uint32_t tid = 0;              // pr_pid
+    std::uint32_t ppid = 0;
+    std::uint32_t pgrp = 0;
+    std::uint32_t sid = 0;
+    std::uint16_t signal = 0;           // pr_cursig
+    std::vector<std::uint64_t> registers;   // pr_reg, in the kernel's order
+    std::optional<std::uint64_t> pc;
+    std::optional<std::uint64_t> sp;
+};
+
+// NT_PRPSINFO
+struct ElfCoreProcess {
+    std::uint32_t pid = 0;
+    std::uint32_t ppid = 0;
+    std::string name;                   // pr_fname, the executable's base name
+    std::string args;                   // pr_psargs, truncated by the kernel
+};
+
+// One NT_FILE entry: [start, end) maps path from file_offset
+struct ElfCoreMappedFile {
+    std::uint64_t start = 0;
+    std::uint64_t end = 0;
+    std::uint64_t file_offset = 0;      // in bytes
+    std::string path;
+};
+
+struct ElfAuxvEntry {
+    std::uint64_t type = 0;             // AT_*
+    std::uint64_t value = 0;
+};
+
+// NT_SIGINFO
+struct ElfCoreSignal {
+    std::int32_t signo = 0;
+    std::int32_t code = 0;
+    std::int32_t error = 0;
+    std::optional<std::uint64_t> fault_address;    // SIGSEGV, SIGBUS, SIGILL, SIGFPE
+};
+
+// pr_reg names for the machine, or empty when its layout is not known
+[[nodiscard]] std::span<const std::string_view> core_register_names(std::uint16_t machine);
+[[nodiscard]] const char* auxv_type_name(std::uint64_t type);
+
+// An ET_CORE file. open() never maps more than a few windows of the file:
+// the headers and notes are read once, and process memory is read on
+// demand through read_memory(). parse() works on bytes already in memory.
+// Copies share the underlying mapping.
+class ElfCore {
+public:
+    using Mapping = WindowedFileMapping<NativeFileMappingBackend>;
+
+    // Notes are read whole; a note segment bigger than this is refused
+    static constexpr std::uint64_t max_note_bytes = 256u << 20;
+
+    static std::expected<ElfCore, Error> parse(std::span<const std::uint8_t> file);
+    static std::expected<ElfCore, Error> open(const std::filesystem::path& path,
+                                              std::size_t window_size = Mapping::default_window_size);
+
+    [[nodiscard]] bool is_64() const { return is_64_; }
+    [[nodiscard]] bool is_big_endian() const { return big_endian_; }
+    [[nodiscard]] std::uint16_t machine() const { return machine_; }
+    [[nodiscard]] std::uint64_t file_size() const { return file_size_; }
+
+    [[nodiscard]] std::span<const ElfCoreSegment> segments() const { return segments_; }    // by vaddr
+    [[nodiscard]] std::span<const ElfCoreThread> threads() const { return threads_; }
+    [[nodiscard]] std::span<const ElfCoreMappedFile> mapped_files() const { return files_; }
+    [[nodiscard]] std::span<const ElfAuxvEntry> auxv() const { return auxv_; }
+    [[nodiscard]] const std::optional<ElfCoreProcess>& process() const { return process_; }
+    [[nodiscard]] const std::optional<ElfCoreSignal>& signal() const { return signal_; }
+
+    [[nodiscard]] std::optional<std::uint64_t> auxv_value(std::uint64_t type) const;
+    [[nodiscard]] const ElfCoreSegment* segment_at(std::uint64_t va) const;
+    [[nodiscard]] const ElfCoreMappedFile* mapped_file_at(std::uint64_t va) const;
+
+    // Copies process memory at va, continuing into adjacent segments.
+    // Returns the count copied; short where memory was not dumped.
+    std::size_t read_memory(std::uint64_t va, std::span<std::uint8_t> out) const;
+
+    // Copies raw file bytes; short only at the end of the file
+    std::size_t read_file(std::uint64_t offset, std::span<std::uint8_t> out) const;
+
+private:
+    std::expected<void, Error> load();
+    template<typename Traits>
+    std::expected<void, Error> load_headers();
+    template<typename T>
+    bool read_record(std::uint64_t offset, T& out) const;
+    void read_notes(std::span<const std::uint8_t> data);
+    void read_prstatus(std::span<const std::uint8_t> desc);
+    void read_prpsinfo(std::span<const std::uint8_t> desc);
+    void read_file_note(std::span<const std::uint8_t> desc);
+    void read_auxv(std::span<const std::uint8_t> desc);
+    void read_siginfo(std::span<const std::uint8_t> desc);
+
+    std::span<const std::uint8_t> bytes_;
+    std::shared_ptr<Mapping> mapping_;
+    std::uint64_t file_size_ = 0;
+    bool is_64_ = false;
+    bool big_endian_ = false;
+    std::uint16_t machine_ = 0;
+
+    std::vector<ElfCoreSegment> segments_;
+    std::vector<ElfCoreThread> threads_;
+    std::vector<ElfCoreMappedFile> files_;
+    std::vector<ElfAuxvEntry> auxv_;
+    std::optional<ElfCoreProcess> process_;
+    std::optional<ElfCoreSignal> signal_;
+};
+
+} // namespace peelf
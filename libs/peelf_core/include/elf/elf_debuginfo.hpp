@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "peelf/peelf.hpp"
+#include "elf/elf_view.hpp"
+
+namespace peelf {
+
+// .gnu_debuglink: file name of the separate debug file and the CRC-32 of
+// its whole contents
+struct ElfDebugLink {
+    std::string file;
+    std::uint32_t crc = 0;
+};
+
+[[nodiscard]] std::optional<ElfDebugLink> read_debuglink(const ElfView& elf);
+
+// CRC-32 of a whole file, streamed through a read-only mapping
+[[nodiscard]] std::expected<std::uint32_t, Error> file_crc32(const std::filesystem::path& path);
+
+enum class DebugFileSource {
+    BuildId,        // <root>/.build-id/xx/yyyy.debug
+    DebugLink,      // .gnu_debuglink, CRC-verified
+};
+
+struct DebugFileMatch {
+    std::filesystem::path path;
+    DebugFileSource source = DebugFileSource::BuildId;
+};
+
+// Locates the separate debug file of a stripped binary, looking where gdb
+// does: the build-id tree under each debug root first (the candidate's own
+// build-id must match), then the debuglink name next to the binary, in its
+// .debug/ directory and under each root mirroring its directory (the CRC
+// must match). Local filesystem only.
+//
+// Results, misses included, are cached by build-id (by debuglink name,
+// CRC and directory for binaries without one); clear_cache() forgets them
+// after debug packages change. Thread-safe.
+class DebugFileResolver {
+public:
+    explicit DebugFileResolver(std::vector<std::filesystem::path> roots = {"/usr/lib/debug"});
+
+    [[nodiscard]] std::optional<DebugFileMatch> resolve(const std::filesystem::path& binary, const ElfView& elf) const;
+    [[nodiscard]] std::optional<DebugFileMatch> resolve(const std::filesystem::path& binary,
+                                                        std::span<const std::uint8_t> build_id,
+                                                        const std::optional<ElfDebugLink>& link) const;
+
+    [[nodiscard]] std::span<const std::filesystem::path> roots() const { return roots_; }
+    [[nodiscard]] std::size_t cache_size() const;
+    void clear_cache();
+
+private:
+    std::optional<DebugFileMatch> search(const std::filesystem::path& binary, std::span<const std::uint8_t> build_id,
+                                         const std::optional<ElfDebugLink>& link) const;
+
+    std::vector<std::filesystem::path> roots_;
+    mutable std::mutex mutex_;
+    mutable std::unordered_map<std::string, std::optional<DebugFileMatch>> cache_;
+};
+
+} // namespace peelf
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "peelf/peelf.hpp"
+#include "elf/elf_view.hpp"
+
+namespace peelf {
+
+struct ElfDynamicEntry {
+    std::int64_t tag = 0;               // DT_*
+    std::uint64_t value = 0;
+};
+
+// Decoded PT_DYNAMIC. Strings are views into the file's DT_STRTAB, so
+// the file bytes must outlive this.
+struct ElfDynamicInfo {
+    std::vector<ElfDynamicEntry> entries;   // in file order, DT_NULL excluded
+
+    std::vector<std::string_view> needed;   // DT_NEEDED, in load order
+    std::string_view soname;
+    std::string_view rpath;
+    std::string_view runpath;
+    std::uint64_t flags = 0;                // DT_FLAGS
+    std::uint64_t flags_1 = 0;              // DT_FLAGS_1
+    bool bind_now = false;                  // DT_BIND_NOW, DF_BIND_NOW or DF_1_NOW
+
+    // First entry with this tag
+    [[nodiscard]] std::optional<std::uint64_t> value(std::int64_t tag) const;
+};
+
+// Reads the PT_DYNAMIC segment, falling back to the SHT_DYNAMIC section.
+// Files without either (static executables, ET_REL) yield an empty result.
+[[nodiscard]] std::expected<ElfDynamicInfo, Error> read_dynamic(const ElfView& elf);
+
+} // namespace peelf
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "peelf/peelf.hpp"
+#include "elf/elf_structures.hpp"
+
+namespace peelf {
+
+// One note; name and desc are views into the note data
+struct ElfNote {
+    std::string_view name;              // owner, without the trailing NUL
+    std::uint32_t type = 0;
+    std::span<const std::uint8_t> desc; // in the file's byte order
+};
+
+// Splits a PT_NOTE segment or SHT_NOTE section into notes. align is the
+// segment/section alignment (8 for GNU property notes, else 4). A note
+// running past the end stops the walk; what was read so far is returned.
+[[nodiscard]] std::vector<ElfNote> parse_notes(std::span<const std::uint8_t> data, std::size_t align, bool big_endian);
+
+struct ElfAbiTag {
+    std::uint32_t os = 0;               // ELF_NOTE_OS_*
+    std::uint32_t major = 0;
+    std::uint32_t minor = 0;
+    std::uint32_t patch = 0;
+};
+
+// What the debuginfo service keys on, gathered from the GNU notes
+struct ElfBuildInfo {
+    bool is_64 = false;
+    std::uint16_t machine = 0;
+    std::vector<std::uint8_t> build_id;
+    std::optional<ElfAbiTag> abi_tag;
+    std::uint32_t x86_features = 0;     // GNU_PROPERTY_X86_FEATURE_1_* (IBT, SHSTK)
+    std::uint32_t aarch64_features = 0; // GNU_PROPERTY_AARCH64_FEATURE_1_* (BTI, PAC)
+    std::uint32_t x86_isa_needed = 0;   // GNU_PROPERTY_X86_ISA_1_NEEDED bitmask
+
+    // Lower-case hex, the form used in .build-id/xx/yyyy paths
+    [[nodiscard]] std::string build_id_hex() const;
+};
+
+// Fast path: reads the ELF header, the program headers and the PT_NOTE
+// segments, nothing else. Section headers are only consulted when the
+// file has no PT_NOTE at all (ET_REL objects).
+[[nodiscard]] std::expected<ElfBuildInfo, Error> read_build_info(std::span<const std::uint8_t> file);
+
+// Maps the file; only the pages holding the headers and notes are read
+[[nodiscard]] std::expected<ElfBuildInfo, Error> read_build_info(const std::filesystem::path& path);
+
+// read_build_info() over many files on `threads` workers (0 = one per
+// hardware thread). Results are in the order of paths.
+[[nodiscard]] std::vector<std::expected<ElfBuildInfo, Error>>
+read_build_info_batch(std::span<const std::filesystem::path> paths, std::size_t threads = 0);
+
+} // namespace peelf
@@ -0,0 +1,9 @@
+#include "peelf/peelf.hpp"
+#include "elf/elf_definitions.h"
+
+#ifndef PEELF_EXPLORER_ELF_PARSER_H
+#define PEELF_EXPLORER_ELF_PARSER_H
+namespace peelf {
+    std::expected<FileInfo, Error> parse_elf_bytes(std::span<const std::uint8_t> bytes);
+}
+#endif //PEELF_EXPLORER_ELF_PARSER_H
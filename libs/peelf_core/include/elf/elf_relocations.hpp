@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "peelf/peelf.hpp"
+#include "elf/elf_dynamic.hpp"
+#include "elf/elf_view.hpp"
+
+namespace peelf {
+
+enum class ElfRelocationFormat : std::uint8_t {
+    Rel,                                // addend stored at the target
+    Rela,                               // explicit addend
+    Relr,                               // packed relative, addend stored at the target
+};
+
+// Every relocation of a file, merged and stored as columns sorted by
+// target section, then offset. Linked objects are read through the
+// DT_REL / DT_RELA / DT_JMPREL / DT_RELR tables of PT_DYNAMIC. Files
+// without a dynamic section (ET_REL, static executables) are read through
+// their relocation sections. Only ET_REL files have a target_section():
+// their offsets are relative to it, so lookups take the section they
+// search in. Everywhere else offsets are addresses and the section is 0.
+//
+// RELR entries are expanded into R_*_RELATIVE relocations with symbol 0.
+// r_info is split with the generic ELF32 / ELF64 layout; MIPS64, which
+// packs three types into r_info, is not special-cased.
+class ElfRelocationTable {
+public:
+    ElfRelocationTable() = default;
+
+    static std::expected<ElfRelocationTable, Error> load(const ElfView& elf, const ElfDynamicInfo& dynamic);
+
+    [[nodiscard]] std::size_t size() const { return offsets_.size(); }
+    [[nodiscard]] bool empty() const { return offsets_.empty(); }
+
+    [[nodiscard]] std::span<const std::uint64_t> offsets() const { return offsets_; }
+    [[nodiscard]] std::uint64_t offset(std::size_t i) const { return offsets_[i]; }
+    [[nodiscard]] std::int64_t addend(std::size_t i) const { return addends_[i]; }
+    [[nodiscard]] std::uint32_t type(std::size_t i) const { return types_[i]; }
+    [[nodiscard]] std::uint32_t symbol(std::size_t i) const { return symbols_[i]; }
+    [[nodiscard]] ElfRelocationFormat format(std::size_t i) const { return formats_[i]; }
+    [[nodiscard]] std::uint32_t target_section(std::size_t i) const { return target_sections_[i]; }
+
+    // Relocation against section whose r_offset is exactly addr
+    [[nodiscard]] std::optional<std::size_t> find(std::uint64_t addr, std::uint32_t section = 0) const;
+
+    // Relocation against section whose patched word (address size)
+    // contains addr
+    [[nodiscard]] std::optional<std::size_t> covering(std::uint64_t addr, std::uint32_t section = 0) const;
+
+    // Index range [first, last) of relocations against section with
+    // lo <= offset < hi
+    [[nodiscard]] std::pair<std::size_t, std::size_t> range(std::uint64_t lo, std::uint64_t hi,
+                                                            std::uint32_t section = 0) const;
+
+    // Index range [first, last) of all relocations against section
+    [[nodiscard]] std::pair<std::size_t, std::size_t> section_range(std::uint32_t section) const;
+
+    [[nodiscard]] std::size_t relr_count() const { return relr_count_; }
+
+    // Expands RELR entries (already in host order) into relocation offsets
+    // appended to out. word_size is 4 or 8.
+    static std::expected<void, Error> decode_relr(std::span<const std::uint64_t> entries, std::size_t word_size,
+                                                  std::size_t max_relocations, std::vector<std::uint64_t>& out);
+
+private:
+    std::vector<std::uint64_t> offsets_;
+    std::vector<std::int64_t> addends_;
+    std::vector<std::uint32_t> types_;
+    std::vector<std::uint32_t> symbols_;
+    std::vector<std::uint32_t> target_sections_;
+    std::vector<ElfRelocationFormat> formats_;
+    std::size_t word_size_ = 8;
+    std::size_t relr_count_ = 0;
+};
+
+// Name of a relocation type for EM_386, EM_X86_64 and EM_AARCH64; empty
+// for anything else.
+[[nodiscard]] std::string_view relocation_type_name(std::uint16_t machine, std::uint32_t type);
+
+// R_*_RELATIVE for the machine, or 0 when it has none we know of
+[[nodiscard]] std::uint32_t relative_relocation_type(std::uint16_t machine);
+
+} // namespace peelf
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "peelf/peelf.hpp"
+#include "peelf/lru_cache.hpp"
+#include "elf/elf_view.hpp"
+
+namespace peelf {
+
+enum class ElfCompression {
+    None,
+    Zlib,           // SHF_COMPRESSED, ELFCOMPRESS_ZLIB
+    Zstd,           // SHF_COMPRESSED, ELFCOMPRESS_ZSTD
+    ZdebugZlib,     // legacy .zdebug_*: "ZLIB", big-endian size, zlib stream
+};
+
+struct ElfCompressionInfo {
+    ElfCompression kind = ElfCompression::None;
+    std::uint64_t size = 0;             // uncompressed
+    std::uint64_t alignment = 0;
+    std::span<const std::uint8_t> stream;   // compressed payload after the header
+};
+
+// How a section is stored; ElfCompression::None with the plain bytes for
+// ordinary sections
+[[nodiscard]] std::expected<ElfCompressionInfo, Error> elf_compression_info(const ElfView& elf, std::size_t index);
+
+// Whether this build can decode the format (zlib and zstd are optional
+// dependencies)
+[[nodiscard]] bool compression_supported(ElfCompression kind);
+
+// Decodes a compressed payload of known uncompressed size. Output grows
+// in bounded chunks as the stream produces it, so a header claiming a
+// huge size costs nothing unless the data really expands that far.
+[[nodiscard]] std::expected<std::vector<std::uint8_t>, Error>
+decompress(ElfCompression kind, std::span<const std::uint8_t> stream, std::uint64_t size);
+
+// Section contents in their final form. Uncompressed sections are views
+// of the file bytes; decompressed ones are owned by `storage`, which
+// keeps them alive after the cache has dropped them.
+struct ElfSectionData {
+    std::span<const std::uint8_t> bytes;
+    std::shared_ptr<const std::vector<std::uint8_t>> storage;
+};
+
+// Transparent access to possibly compressed sections. A section is
+// decompressed on first access and kept in an LRU pool bounded by
+// capacity bytes; prefetch() decodes several independent sections in
+// parallel. Thread-safe. The ElfView (and its bytes) must outlive this.
+class ElfSectionCache {
+public:
+    static constexpr std::size_t default_capacity = 256u << 20;
+
+    explicit ElfSectionCache(const ElfView& elf, std::size_t capacity = default_capacity);
+
+    [[nodiscard]] const ElfView& elf() const { return *elf_; }
+
+    [[nodiscard]] std::expected<ElfSectionData, Error> data(std::size_t index) const;
+
+    // Decompresses the given sections ahead of use on up to `threads`
+    // workers (0 = one per hardware thread). Errors surface on data().
+    void prefetch(std::span<const std::size_t> indices, std::size_t threads = 0) const;
+
+    [[nodiscard]] bool is_compressed(std::size_t index) const;
+
+    [[nodiscard]] const LruCache<std::size_t, std::vector<std::uint8_t>>& cache() const { return *cache_; }
+
+private:
+    const ElfView* elf_;
+    std::unique_ptr<LruCache<std::size_t, std::vector<std::uint8_t>>> cache_;
+};
+
+} // namespace peelf
@@ -0,0 +1,607 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "peelf/byteswap.hpp"
+
+namespace peelf {
+
+// e_ident
+static constexpr std::size_t  EI_NIDENT     = 16;
+static constexpr std::size_t  EI_CLASS      = 4;
+static constexpr std::size_t  EI_DATA       = 5;
+static constexpr std::size_t  EI_VERSION    = 6;
+static constexpr std::size_t  EI_OSABI      = 7;
+static constexpr std::size_t  EI_ABIVERSION = 8;
+
+static constexpr std::uint8_t ELFCLASS32    = 1;
+static constexpr std::uint8_t ELFCLASS64    = 2;
+static constexpr std::uint8_t ELFDATA2LSB   = 1;
+static constexpr std::uint8_t ELFDATA2MSB   = 2;
+
+// e_type
+static constexpr std::uint16_t ET_NONE = 0;
+static constexpr std::uint16_t ET_REL  = 1;
+static constexpr std::uint16_t ET_EXEC = 2;
+static constexpr std::uint16_t ET_DYN  = 3;
+static constexpr std::uint16_t ET_CORE = 4;
+
+// e_machine (the ones the viewer names)
+static constexpr std::uint16_t EM_386       = 3;
+static constexpr std::uint16_t EM_MIPS      = 8;
+static constexpr std::uint16_t EM_PPC       = 20;
+static constexpr std::uint16_t EM_PPC64     = 21;
+static constexpr std::uint16_t EM_S390      = 22;
+static constexpr std::uint16_t EM_ARM       = 40;
+static constexpr std::uint16_t EM_SPARCV9   = 43;
+static constexpr std::uint16_t EM_X86_64    = 62;
+static constexpr std::uint16_t EM_AARCH64   = 183;
+static constexpr std::uint16_t EM_RISCV     = 243;
+static constexpr std::uint16_t EM_LOONGARCH = 258;
+
+// Special section indices
+static constexpr std::uint16_t SHN_UNDEF  = 0;
+static constexpr std::uint16_t SHN_LORESERVE = 0xFF00;
+static constexpr std::uint16_t SHN_ABS    = 0xFFF1;
+static constexpr std::uint16_t SHN_COMMON = 0xFFF2;
+static constexpr std::uint16_t SHN_XINDEX = 0xFFFF;   // real index lives in section 0
+static constexpr std::uint16_t PN_XNUM    = 0xFFFF;   // real e_phnum lives in section 0
+
+// sh_type
+static constexpr std::uint32_t SHT_NULL          = 0;
+static constexpr std::uint32_t SHT_PROGBITS      = 1;
+static constexpr std::uint32_t SHT_SYMTAB        = 2;
+static constexpr std::uint32_t SHT_STRTAB        = 3;
+static constexpr std::uint32_t SHT_RELA          = 4;
+static constexpr std::uint32_t SHT_HASH          = 5;
+static constexpr std::uint32_t SHT_DYNAMIC       = 6;
+static constexpr std::uint32_t SHT_NOTE          = 7;
+static constexpr std::uint32_t SHT_NOBITS        = 8;
+static constexpr std::uint32_t SHT_REL           = 9;
+static constexpr std::uint32_t SHT_DYNSYM        = 11;
+static constexpr std::uint32_t SHT_INIT_ARRAY    = 14;
+static constexpr std::uint32_t SHT_FINI_ARRAY    = 15;
+static constexpr std::uint32_t SHT_GROUP         = 17;
+static constexpr std::uint32_t SHT_SYMTAB_SHNDX  = 18;
+static constexpr std::uint32_t SHT_RELR          = 19;
+static constexpr std::uint32_t SHT_GNU_HASH      = 0x6FFFFFF6;
+static constexpr std::uint32_t SHT_GNU_VERDEF    = 0x6FFFFFFD;
+static constexpr std::uint32_t SHT_GNU_VERNEED   = 0x6FFFFFFE;
+static constexpr std::uint32_t SHT_GNU_VERSYM    = 0x6FFFFFFF;
+
+// sh_flags
+static constexpr std::uint64_t SHF_WRITE      = 0x1;
+static constexpr std::uint64_t SHF_ALLOC      = 0x2;
+static constexpr std::uint64_t SHF_EXECINSTR  = 0x4;
+static constexpr std::uint64_t SHF_MERGE      = 0x10;
+static constexpr std::uint64_t SHF_STRINGS    = 0x20;
+static constexpr std::uint64_t SHF_TLS        = 0x400;
+static constexpr std::uint64_t SHF_COMPRESSED = 0x800;
+
+// ch_type of a SHF_COMPRESSED section
+static constexpr std::uint32_t ELFCOMPRESS_ZLIB = 1;
+static constexpr std::uint32_t ELFCOMPRESS_ZSTD = 2;
+
+// p_type
+static constexpr std::uint32_t PT_NULL         = 0;
+static constexpr std::uint32_t PT_LOAD         = 1;
+static constexpr std::uint32_t PT_DYNAMIC      = 2;
+static constexpr std::uint32_t PT_INTERP       = 3;
+static constexpr std::uint32_t PT_NOTE         = 4;
+static constexpr std::uint32_t PT_PHDR         = 6;
+static constexpr std::uint32_t PT_TLS          = 7;
+static constexpr std::uint32_t PT_GNU_EH_FRAME = 0x6474E550;
+static constexpr std::uint32_t PT_GNU_STACK    = 0x6474E551;
+static constexpr std::uint32_t PT_GNU_RELRO    = 0x6474E552;
+static constexpr std::uint32_t PT_GNU_PROPERTY = 0x6474E553;
+
+// p_flags
+static constexpr std::uint32_t PF_X = 0x1;
+static constexpr std::uint32_t PF_W = 0x2;
+static constexpr std::uint32_t PF_R = 0x4;
+
+// st_info binding (high nibble)
+static constexpr std::uint8_t STB_LOCAL      = 0;
+static constexpr std::uint8_t STB_GLOBAL     = 1;
+static constexpr std::uint8_t STB_WEAK       = 2;
+static constexpr std::uint8_t STB_GNU_UNIQUE = 10;
+
+// st_info type (low nibble)
+static constexpr std::uint8_t STT_NOTYPE    = 0;
+static constexpr std::uint8_t STT_OBJECT    = 1;
+static constexpr std::uint8_t STT_FUNC      = 2;
+static constexpr std::uint8_t STT_SECTION   = 3;
+static constexpr std::uint8_t STT_FILE      = 4;
+static constexpr std::uint8_t STT_COMMON    = 5;
+static constexpr std::uint8_t STT_TLS       = 6;
+static constexpr std::uint8_t STT_GNU_IFUNC = 10;
+
+// st_other visibility (low two bits)
+static constexpr std::uint8_t STV_DEFAULT   = 0;
+static constexpr std::uint8_t STV_INTERNAL  = 1;
+static constexpr std::uint8_t STV_HIDDEN    = 2;
+static constexpr std::uint8_t STV_PROTECTED = 3;
+
+static constexpr std::uint32_t STN_UNDEF = 0;
+
+// Symbol versioning
+static constexpr std::uint16_t VER_NDX_LOCAL  = 0;
+static constexpr std::uint16_t VER_NDX_GLOBAL = 1;
+static constexpr std::uint16_t VERSYM_HIDDEN  = 0x8000;
+static constexpr std::uint16_t VERSYM_INDEX   = 0x7FFF;
+static constexpr std::uint16_t VER_FLG_BASE   = 0x1;
+static constexpr std::uint16_t VER_FLG_WEAK   = 0x2;
+
+// d_tag
+static constexpr std::int64_t DT_NULL         = 0;
+static constexpr std::int64_t DT_NEEDED       = 1;
+static constexpr std::int64_t DT_PLTRELSZ     = 2;
+static constexpr std::int64_t DT_PLTGOT       = 3;
+static constexpr std::int64_t DT_HASH         = 4;
+static constexpr std::int64_t DT_STRTAB       = 5;
+static constexpr std::int64_t DT_SYMTAB       = 6;
+static constexpr std::int64_t DT_RELA         = 7;
+static constexpr std::int64_t DT_RELASZ       = 8;
+static constexpr std::int64_t DT_RELAENT      = 9;
+static constexpr std::int64_t DT_STRSZ        = 10;
+static constexpr std::int64_t DT_SYMENT       = 11;
+static constexpr std::int64_t DT_SONAME       = 14;
+static constexpr std::int64_t DT_RPATH        = 15;
+static constexpr std::int64_t DT_REL          = 17;
+static constexpr std::int64_t DT_RELSZ        = 18;
+static constexpr std::int64_t DT_RELENT       = 19;
+static constexpr std::int64_t DT_PLTREL       = 20;
+static constexpr std::int64_t DT_TEXTREL      = 22;
+static constexpr std::int64_t DT_JMPREL       = 23;
+static constexpr std::int64_t DT_BIND_NOW     = 24;
+static constexpr std::int64_t DT_RUNPATH      = 29;
+static constexpr std::int64_t DT_FLAGS        = 30;
+static constexpr std::int64_t DT_RELRSZ       = 35;
+static constexpr std::int64_t DT_RELR         = 36;
+static constexpr std::int64_t DT_RELRENT      = 37;
+static constexpr std::int64_t DT_GNU_HASH     = 0x6FFFFEF5;
+static constexpr std::int64_t DT_VERSYM       = 0x6FFFFFF0;
+static constexpr std::int64_t DT_RELACOUNT    = 0x6FFFFFF9;
+static constexpr std::int64_t DT_RELCOUNT     = 0x6FFFFFFA;
+static constexpr std::int64_t DT_FLAGS_1      = 0x6FFFFFFB;
+static constexpr std::int64_t DT_VERDEF       = 0x6FFFFFFC;
+static constexpr std::int64_t DT_VERDEFNUM    = 0x6FFFFFFD;
+static constexpr std::int64_t DT_VERNEED      = 0x6FFFFFFE;
+static constexpr std::int64_t DT_VERNEEDNUM   = 0x6FFFFFFF;
+
+// DT_FLAGS / DT_FLAGS_1
+static constexpr std::uint64_t DF_ORIGIN     = 0x1;
+static constexpr std::uint64_t DF_SYMBOLIC   = 0x2;
+static constexpr std::uint64_t DF_TEXTREL    = 0x4;
+static constexpr std::uint64_t DF_BIND_NOW   = 0x8;
+static constexpr std::uint64_t DF_STATIC_TLS = 0x10;
+static constexpr std::uint64_t DF_1_NOW      = 0x1;
+static constexpr std::uint64_t DF_1_PIE      = 0x08000000;
+
+// Relocation types the relocation reader names
+static constexpr std::uint32_t R_386_32            = 1;
+static constexpr std::uint32_t R_386_PC32          = 2;
+static constexpr std::uint32_t R_386_GLOB_DAT      = 6;
+static constexpr std::uint32_t R_386_JMP_SLOT      = 7;
+static constexpr std::uint32_t R_386_RELATIVE      = 8;
+static constexpr std::uint32_t R_386_IRELATIVE     = 42;
+static constexpr std::uint32_t R_X86_64_64         = 1;
+static constexpr std::uint32_t R_X86_64_PC32       = 2;
+static constexpr std::uint32_t R_X86_64_COPY       = 5;
+static constexpr std::uint32_t R_X86_64_GLOB_DAT   = 6;
+static constexpr std::uint32_t R_X86_64_JUMP_SLOT  = 7;
+static constexpr std::uint32_t R_X86_64_RELATIVE   = 8;
+static constexpr std::uint32_t R_X86_64_DTPMOD64   = 16;
+static constexpr std::uint32_t R_X86_64_DTPOFF64   = 17;
+static constexpr std::uint32_t R_X86_64_TPOFF64    = 18;
+static constexpr std::uint32_t R_X86_64_IRELATIVE  = 37;
+static constexpr std::uint32_t R_AARCH64_ABS64     = 257;
+static constexpr std::uint32_t R_AARCH64_COPY      = 1024;
+static constexpr std::uint32_t R_AARCH64_GLOB_DAT  = 1025;
+static constexpr std::uint32_t R_AARCH64_JUMP_SLOT = 1026;
+static constexpr std::uint32_t R_AARCH64_RELATIVE  = 1027;
+static constexpr std::uint32_t R_AARCH64_TLS_TPREL = 1030;
+static constexpr std::uint32_t R_AARCH64_TLSDESC   = 1031;
+static constexpr std::uint32_t R_AARCH64_IRELATIVE = 1032;
+
+// Absolute and TLS-offset relocations compilers leave in ET_REL debug sections
+static constexpr std::uint32_t R_386_TLS_LDO_32     = 32;
+static constexpr std::uint32_t R_X86_64_32          = 10;
+static constexpr std::uint32_t R_X86_64_32S         = 11;
+static constexpr std::uint32_t R_X86_64_DTPOFF32    = 21;
+static constexpr std::uint32_t R_AARCH64_ABS32      = 258;
+static constexpr std::uint32_t R_AARCH64_TLS_DTPREL = 1029;
+static constexpr std::uint32_t R_ARM_ABS32          = 2;
+static constexpr std::uint32_t R_ARM_TLS_LDO32      = 106;
+static constexpr std::uint32_t R_RISCV_32           = 1;
+static constexpr std::uint32_t R_RISCV_64           = 2;
+static constexpr std::uint32_t R_RISCV_TLS_DTPREL32 = 8;
+static constexpr std::uint32_t R_RISCV_TLS_DTPREL64 = 9;
+static constexpr std::uint32_t R_PPC64_ADDR32       = 1;
+static constexpr std::uint32_t R_PPC64_ADDR64       = 38;
+static constexpr std::uint32_t R_PPC64_DTPREL64     = 78;
+
+// Note types (owner "GNU")
+static constexpr std::uint32_t NT_GNU_ABI_TAG         = 1;
+static constexpr std::uint32_t NT_GNU_HWCAP           = 2;
+static constexpr std::uint32_t NT_GNU_BUILD_ID        = 3;
+static constexpr std::uint32_t NT_GNU_GOLD_VERSION    = 4;
+static constexpr std::uint32_t NT_GNU_PROPERTY_TYPE_0 = 5;
+
+// Note types in core files (owners "CORE" and "LINUX")
+static constexpr std::uint32_t NT_PRSTATUS   = 1;
+static constexpr std::uint32_t NT_PRFPREG    = 2;
+static constexpr std::uint32_t NT_PRPSINFO   = 3;
+static constexpr std::uint32_t NT_AUXV       = 6;
+static constexpr std::uint32_t NT_SIGINFO    = 0x53494749;     // "SIGI"
+static constexpr std::uint32_t NT_FILE       = 0x46494C45;     // "FILE"
+
+// NT_AUXV entry types
+static constexpr std::uint64_t AT_NULL          = 0;
+static constexpr std::uint64_t AT_PHDR          = 3;
+static constexpr std::uint64_t AT_PHENT         = 4;
+static constexpr std::uint64_t AT_PHNUM         = 5;
+static constexpr std::uint64_t AT_PAGESZ        = 6;
+static constexpr std::uint64_t AT_BASE          = 7;
+static constexpr std::uint64_t AT_FLAGS         = 8;
+static constexpr std::uint64_t AT_ENTRY         = 9;
+static constexpr std::uint64_t AT_UID           = 11;
+static constexpr std::uint64_t AT_EUID          = 12;
+static constexpr std::uint64_t AT_GID           = 13;
+static constexpr std::uint64_t AT_EGID          = 14;
+static constexpr std::uint64_t AT_PLATFORM      = 15;
+static constexpr std::uint64_t AT_HWCAP         = 16;
+static constexpr std::uint64_t AT_CLKTCK        = 17;
+static constexpr std::uint64_t AT_SECURE        = 23;
+static constexpr std::uint64_t AT_BASE_PLATFORM = 24;
+static constexpr std::uint64_t AT_RANDOM        = 25;
+static constexpr std::uint64_t AT_HWCAP2        = 26;
+static constexpr std::uint64_t AT_EXECFN        = 31;
+static constexpr std::uint64_t AT_SYSINFO_EHDR  = 33;
+static constexpr std::uint64_t AT_MINSIGSTKSZ   = 51;
+
+// NT_GNU_ABI_TAG operating systems
+static constexpr std::uint32_t ELF_NOTE_OS_LINUX   = 0;
+static constexpr std::uint32_t ELF_NOTE_OS_GNU     = 1;
+static constexpr std::uint32_t ELF_NOTE_OS_SOLARIS = 2;
+static constexpr std::uint32_t ELF_NOTE_OS_FREEBSD = 3;
+
+// NT_GNU_PROPERTY_TYPE_0 properties
+static constexpr std::uint32_t GNU_PROPERTY_AARCH64_FEATURE_1_AND = 0xC0000000;
+static constexpr std::uint32_t GNU_PROPERTY_X86_FEATURE_1_AND     = 0xC0000002;
+static constexpr std::uint32_t GNU_PROPERTY_X86_ISA_1_NEEDED      = 0xC0008002;
+static constexpr std::uint32_t GNU_PROPERTY_X86_FEATURE_1_IBT     = 0x1;
+static constexpr std::uint32_t GNU_PROPERTY_X86_FEATURE_1_SHSTK   = 0x2;
+static constexpr std::uint32_t GNU_PROPERTY_AARCH64_FEATURE_1_BTI = 0x1;
+static constexpr std::uint32_t GNU_PROPERTY_AARCH64_FEATURE_1_PAC = 0x2;
+
+// .eh_frame pointer encodings: value format (low nibble) | application (high)
+static constexpr std::uint8_t DW_EH_PE_absptr   = 0x00;
+static constexpr std::uint8_t DW_EH_PE_uleb128  = 0x01;
+static constexpr std::uint8_t DW_EH_PE_udata2   = 0x02;
+static constexpr std::uint8_t DW_EH_PE_udata4   = 0x03;
+static constexpr std::uint8_t DW_EH_PE_udata8   = 0x04;
+static constexpr std::uint8_t DW_EH_PE_signed   = 0x08;
+static constexpr std::uint8_t DW_EH_PE_sleb128  = 0x09;
+static constexpr std::uint8_t DW_EH_PE_sdata2   = 0x0A;
+static constexpr std::uint8_t DW_EH_PE_sdata4   = 0x0B;
+static constexpr std::uint8_t DW_EH_PE_sdata8   = 0x0C;
+static constexpr std::uint8_t DW_EH_PE_pcrel    = 0x10;
+static constexpr std::uint8_t DW_EH_PE_textrel  = 0x20;
+static constexpr std::uint8_t DW_EH_PE_datarel  = 0x30;
+static constexpr std::uint8_t DW_EH_PE_funcrel  = 0x40;
+static constexpr std::uint8_t DW_EH_PE_aligned  = 0x50;
+static constexpr std::uint8_t DW_EH_PE_indirect = 0x80;
+static constexpr std::uint8_t DW_EH_PE_omit     = 0xFF;
+
+// Call frame instructions; the first three carry an operand in the low six bits
+static constexpr std::uint8_t DW_CFA_advance_loc        = 0x40;
+static constexpr std::uint8_t DW_CFA_offset             = 0x80;
+static constexpr std::uint8_t DW_CFA_restore            = 0xC0;
+static constexpr std::uint8_t DW_CFA_nop                = 0x00;
+static constexpr std::uint8_t DW_CFA_set_loc            = 0x01;
+static constexpr std::uint8_t DW_CFA_advance_loc1       = 0x02;
+static constexpr std::uint8_t DW_CFA_advance_loc2       = 0x03;
+static constexpr std::uint8_t DW_CFA_advance_loc4       = 0x04;
+static constexpr std::uint8_t DW_CFA_offset_extended    = 0x05;
+static constexpr std::uint8_t DW_CFA_restore_extended   = 0x06;
+static constexpr std::uint8_t DW_CFA_undefined          = 0x07;
+static constexpr std::uint8_t DW_CFA_same_value         = 0x08;
+static constexpr std::uint8_t DW_CFA_register           = 0x09;
+static constexpr std::uint8_t DW_CFA_remember_state     = 0x0A;
+static constexpr std::uint8_t DW_CFA_restore_state      = 0x0B;
+static constexpr std::uint8_t DW_CFA_def_cfa            = 0x0C;
+static constexpr std::uint8_t DW_CFA_def_cfa_register   = 0x0D;
+static constexpr std::uint8_t DW_CFA_def_cfa_offset     = 0x0E;
+static constexpr std::uint8_t DW_CFA_def_cfa_expression = 0x0F;
+static constexpr std::uint8_t DW_CFA_expression         = 0x10;
+static constexpr std::uint8_t DW_CFA_offset_extended_sf = 0x11;
+static constexpr std::uint8_t DW_CFA_def_cfa_sf         = 0x12;
+static constexpr std::uint8_t DW_CFA_def_cfa_offset_sf  = 0x13;
+static constexpr std::uint8_t DW_CFA_val_offset         = 0x14;
+static constexpr std::uint8_t DW_CFA_val_offset_sf      = 0x15;
+static constexpr std::uint8_t DW_CFA_val_expression     = 0x16;
+static constexpr std::uint8_t DW_CFA_GNU_window_save    = 0x2D;  // DW_CFA_AARCH64_negate_ra_state on AArch64
+static constexpr std::uint8_t DW_CFA_GNU_args_size      = 0x2E;
+static constexpr std::uint8_t DW_CFA_GNU_negative_offset_extended = 0x2F;
+
+// data structures (packed)
+#pragma pack(push, 1)
+
+struct Elf32_Ehdr_ {
+    std::uint8_t  e_ident[EI_NIDENT];   // Magic, class, data encoding, ...
+    std::uint16_t e_type;               // ET_*
+    std::uint16_t e_machine;            // EM_*
+    std::uint32_t e_version;            // EV_CURRENT
+    std::uint32_t e_entry;              // Entry point virtual address
+    std::uint32_t e_phoff;              // Program header table file offset
+    std::uint32_t e_shoff;              // Section header table file offset
+    std::uint32_t e_flags;              // Processor-specific flags
+    std::uint16_t e_ehsize;             // ELF header size
+    std::uint16_t e_phentsize;          // Program header entry size
+    std::uint16_t e_phnum;              // Program header count (PN_XNUM: see section 0)
+    std::uint16_t e_shentsize;          // Section header entry size
+    std::uint16_t e_shnum;              // Section header count (0: see section 0)
+    std::uint16_t e_shstrndx;           // Section name string table index
+};
+
+struct Elf64_Ehdr_ {
+    std::uint8_t  e_ident[EI_NIDENT];
+    std::uint16_t e_type;
+    std::uint16_t e_machine;
+    std::uint32_t e_version;
+    std::uint64_t e_entry;
+    std::uint64_t e_phoff;
+    std::uint64_t e_shoff;
+    std::uint32_t e_flags;
+    std::uint16_t e_ehsize;
+    std::uint16_t e_phentsize;
+    std::uint16_t e_phnum;
+    std::uint16_t e_shentsize;
+    std::uint16_t e_shnum;
+    std::uint16_t e_shstrndx;
+};
+
+struct Elf32_Shdr_ {
+    std::uint32_t sh_name;              // Offset into the section name string table
+    std::uint32_t sh_type;              // SHT_*
+    std::uint32_t sh_flags;             // SHF_*
+    std::uint32_t sh_addr;              // Virtual address when loaded
+    std::uint32_t sh_offset;            // File offset
+    std::uint32_t sh_size;              // Size in bytes
+    std::uint32_t sh_link;              // Type-dependent section link
+    std::uint32_t sh_info;              // Type-dependent extra info
+    std::uint32_t sh_addralign;         // Alignment
+    std::uint32_t sh_entsize;           // Entry size for table sections
+};
+
+struct Elf64_Shdr_ {
+    std::uint32_t sh_name;
+    std::uint32_t sh_type;
+    std::uint64_t sh_flags;
+    std::uint64_t sh_addr;
+    std::uint64_t sh_offset;
+    std::uint64_t sh_size;
+    std::uint32_t sh_link;
+    std::uint32_t sh_info;
+    std::uint64_t sh_addralign;
+    std::uint64_t sh_entsize;
+};
+
+// Note the different field order between the two classes (p_flags moves)
+struct Elf32_Phdr_ {
+    std::uint32_t p_type;               // PT_*
+    std::uint32_t p_offset;             // File offset
+    std::uint32_t p_vaddr;              // Virtual address
+    std::uint32_t p_paddr;              // Physical address
+    std::uint32_t p_filesz;             // Bytes in the file image
+    std::uint32_t p_memsz;              // Bytes in the memory image
+    std::uint32_t p_flags;              // PF_*
+    std::uint32_t p_align;              // Alignment
+};
+
+struct Elf64_Phdr_ {
+    std::uint32_t p_type;
+    std::uint32_t p_flags;
+    std::uint64_t p_offset;
+    std::uint64_t p_vaddr;
+    std::uint64_t p_paddr;
+    std::uint64_t p_filesz;
+    std::uint64_t p_memsz;
+    std::uint64_t p_align;
+};
+
+struct Elf32_Sym_ {
+    std::uint32_t st_name;              // Offset into the linked string table
+    std::uint32_t st_value;             // Symbol value (usually an address)
+    std::uint32_t st_size;              // Object size
+    std::uint8_t  st_info;              // Binding (high nibble) and type (low nibble)
+    std::uint8_t  st_other;             // Visibility
+    std::uint16_t st_shndx;             // Section index, or SHN_* special value
+};
+
+struct Elf64_Sym_ {
+    std::uint32_t st_name;
+    std::uint8_t  st_info;
+    std::uint8_t  st_other;
+    std::uint16_t st_shndx;
+    std::uint64_t st_value;
+    std::uint64_t st_size;
+};
+
+struct Elf32_Rel_ {
+    std::uint32_t r_offset;             // Location to patch
+    std::uint32_t r_info;               // Symbol index (high 24 bits) and type (low 8)
+};
+
+struct Elf64_Rel_ {
+    std::uint64_t r_offset;
+    std::uint64_t r_info;               // Symbol index (high 32 bits) and type (low 32)
+};
+
+struct Elf32_Rela_ {
+    std::uint32_t r_offset;
+    std::uint32_t r_info;
+    std::int32_t  r_addend;             // Constant addend
+};
+
+struct Elf64_Rela_ {
+    std::uint64_t r_offset;
+    std::uint64_t r_info;
+    std::int64_t  r_addend;
+};
+
+struct Elf32_Dyn_ {
+    std::int32_t  d_tag;                // DT_*
+    std::uint32_t d_val;                // Value or address, depending on the tag
+};
+
+struct Elf64_Dyn_ {
+    std::int64_t  d_tag;
+    std::uint64_t d_val;
+};
+// Compression header at the start of a SHF_COMPRESSED section
+struct Elf32_Chdr_ {
+    std::uint32_t ch_type;              // ELFCOMPRESS_*
+    std::uint32_t ch_size;              // Uncompressed size
+    std::uint32_t ch_addralign;         // Uncompressed alignment
+};
+
+struct Elf64_Chdr_ {
+    std::uint32_t ch_type;
+    std::uint32_t ch_reserved;
+    std::uint64_t ch_size;
+    std::uint64_t ch_addralign;
+};
+
+// Note header, followed by the name and the descriptor, each padded
+struct Elf_Nhdr_ {
+    std::uint32_t n_namesz;             // Includes the terminating NUL
+    std::uint32_t n_descsz;
+    std::uint32_t n_type;               // NT_*, meaning depends on the owner name
+};
+
+// Version records are the same in both classes
+struct Elf_Verdef_ {
+    std::uint16_t vd_version;
+    std::uint16_t vd_flags;             // VER_FLG_*
+    std::uint16_t vd_ndx;               // Version index referenced from .gnu.version
+    std::uint16_t vd_cnt;               // Number of Verdaux entries
+    std::uint32_t vd_hash;
+    std::uint32_t vd_aux;               // Offset to the first Verdaux, from this entry
+    std::uint32_t vd_next;              // Offset to the next Verdef, from this entry
+};
+
+struct Elf_Verdaux_ {
+    std::uint32_t vda_name;             // Offset into the linked string table
+    std::uint32_t vda_next;
+};
+
+struct Elf_Verneed_ {
+    std::uint16_t vn_version;
+    std::uint16_t vn_cnt;               // Number of Vernaux entries
+    std::uint32_t vn_file;              // Needed library, offset into the string table
+    std::uint32_t vn_aux;
+    std::uint32_t vn_next;
+};
+
+struct Elf_Vernaux_ {
+    std::uint32_t vna_hash;
+    std::uint16_t vna_flags;
+    std::uint16_t vna_other;            // Version index referenced from .gnu.version
+    std::uint32_t vna_name;
+    std::uint32_t vna_next;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(Elf32_Ehdr_) == 52);
+static_assert(sizeof(Elf64_Ehdr_) == 64);
+static_assert(sizeof(Elf32_Shdr_) == 40);
+static_assert(sizeof(Elf64_Shdr_) == 64);
+static_assert(sizeof(Elf32_Phdr_) == 32);
+static_assert(sizeof(Elf64_Phdr_) == 56);
+static_assert(sizeof(Elf32_Sym_) == 16);
+static_assert(sizeof(Elf64_Sym_) == 24);
+static_assert(sizeof(Elf32_Rel_) == 8);
+static_assert(sizeof(Elf64_Rel_) == 16);
+static_assert(sizeof(Elf32_Rela_) == 12);
+static_assert(sizeof(Elf64_Rela_) == 24);
+static_assert(sizeof(Elf32_Dyn_) == 8);
+static_assert(sizeof(Elf64_Dyn_) == 16);
+static_assert(sizeof(Elf32_Chdr_) == 12);
+static_assert(sizeof(Elf64_Chdr_) == 24);
+static_assert(sizeof(Elf_Nhdr_) == 12);
+static_assert(sizeof(Elf_Verdef_) == 20);
+static_assert(sizeof(Elf_Verdaux_) == 8);
+static_assert(sizeof(Elf_Verneed_) == 16);
+static_assert(sizeof(Elf_Vernaux_) == 16);
+
+// Field widths for converting big-endian files (see RecordSwapper)
+template<> struct record_layout<Elf32_Ehdr_> {
+    static constexpr std::uint8_t fields[] = {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+                                              2, 2, 4, 4, 4, 4, 4, 2, 2, 2, 2, 2, 2};
+};
+template<> struct record_layout<Elf64_Ehdr_> {
+    static constexpr std::uint8_t fields[] = {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+                                              2, 2, 4, 8, 8, 8, 4, 2, 2, 2, 2, 2, 2};
+};
+template<> struct record_layout<Elf32_Shdr_> {
+    static constexpr std::uint8_t fields[] = {4, 4, 4, 4, 4, 4, 4, 4, 4, 4};
+};
+template<> struct record_layout<Elf64_Shdr_> {
+    static constexpr std::uint8_t fields[] = {4, 4, 8, 8, 8, 8, 4, 4, 8, 8};
+};
+template<> struct record_layout<Elf32_Phdr_> {
+    static constexpr std::uint8_t fields[] = {4, 4, 4, 4, 4, 4, 4, 4};
+};
+template<> struct record_layout<Elf64_Phdr_> {
+    static constexpr std::uint8_t fields[] = {4, 4, 8, 8, 8, 8, 8, 8};
+};
+template<> struct record_layout<Elf32_Sym_> {
+    static constexpr std::uint8_t fields[] = {4, 4, 4, 1, 1, 2};
+};
+template<> struct record_layout<Elf64_Sym_> {
+    static constexpr std::uint8_t fields[] = {4, 1, 1, 2, 8, 8};
+};
+template<> struct record_layout<Elf32_Rel_> {
+    static constexpr std::uint8_t fields[] = {4, 4};
+};
+template<> struct record_layout<Elf64_Rel_> {
+    static constexpr std::uint8_t fields[] = {8, 8};
+};
+template<> struct record_layout<Elf32_Rela_> {
+    static constexpr std::uint8_t fields[] = {4, 4, 4};
+};
+template<> struct record_layout<Elf64_Rela_> {
+    static constexpr std::uint8_t fields[] = {8, 8, 8};
+};
+template<> struct record_layout<Elf32_Dyn_> {
+    static constexpr std::uint8_t fields[] = {4, 4};
+};
+template<> struct record_layout<Elf64_Dyn_> {
+    static constexpr std::uint8_t fields[] = {8, 8};
+};
+template<> struct record_layout<Elf32_Chdr_> {
+    static constexpr std::uint8_t fields[] = {4, 4, 4};
+};
+template<> struct record_layout<Elf64_Chdr_> {
+    static constexpr std::uint8_t fields[] = {4, 4, 8, 8};
+};
+template<> struct record_layout<Elf_Nhdr_> {
+    static constexpr std::uint8_t fields[] = {4, 4, 4};
+};
+template<> struct record_layout<Elf_Verdef_> {
+    static constexpr std::uint8_t fields[] = {2, 2, 2, 2, 4, 4, 4};
+};
+template<> struct record_layout<Elf_Verdaux_> {
+    static constexpr std::uint8_t fields[] = {4, 4};
+};
+template<> struct record_layout<Elf_Verneed_> {
+    static constexpr std::uint8_t fields[] = {2, 2, 4, 4, 4};
+};
+template<> struct record_layout<Elf_Vernaux_> {
+    static constexpr std::uint8_t fields[] = {4, 2, 2, 4, 4};
+};
+
+} // namespace peelf
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "peelf/peelf.hpp"
+#include "elf/elf_view.hpp"
+
+namespace peelf {
+
+// Result of an address -> symbol query
+struct ElfSymbolHit {
+    std::size_t index = 0;              // symbol index in the table
+    std::uint64_t offset = 0;           // address - symbol value
+};
+
+// .symtab or .dynsym decoded into columns. Names are views into the
+// linked string table, so the file bytes must outlive the table.
+//
+// Name lookups go through the section's SHT_GNU_HASH or SHT_HASH table
+// when it has one (dynsym in any linked object); otherwise an
+// unordered_map over the defined symbols is built once in load(). The
+// address index is sorted by value and built in load() as well, so a
+// loaded table is immutable and safe to query from several threads.
+//
+// For ET_REL files symbol values are section offsets, not addresses;
+// find_address() then only makes sense together with section_index().
+class ElfSymbolTable {
+public:
+    ElfSymbolTable() = default;
+
+    // Decodes the SHT_SYMTAB / SHT_DYNSYM section at section_index
+    static std::expected<ElfSymbolTable, Error> load(const ElfView& elf, std::size_t section_index);
+
+    [[nodiscard]] std::size_t size() const { return names_.size(); }
+    [[nodiscard]] bool empty() const { return names_.empty(); }
+    [[nodiscard]] std::uint32_t section_type() const { return section_type_; }
+
+    // Columns, indexed by symbol index (entry 0 is the null symbol)
+    [[nodiscard]] std::span<const std::string_view> names() const { return names_; }
+    [[nodiscard]] std::span<const std::uint64_t> values() const { return values_; }
+    [[nodiscard]] std::span<const std::uint64_t> sizes() const { return sizes_; }
+    [[nodiscard]] std::span<const std::uint8_t> infos() const { return info_; }
+    [[nodiscard]] std::span<const std::uint8_t> others() const { return other_; }
+
+    [[nodiscard]] std::string_view name(std::size_t i) const { return names_[i]; }
+    [[nodiscard]] std::uint64_t value(std::size_t i) const { return values_[i]; }
+    [[nodiscard]] std::uint64_t symbol_size(std::size_t i) const { return sizes_[i]; }
+    [[nodiscard]] std::uint8_t binding(std::size_t i) const { return static_cast<std::uint8_t>(info_[i] >> 4); }
+    [[nodiscard]] std::uint8_t type(std::size_t i) const { return static_cast<std::uint8_t>(info_[i] & 0xF); }
+    [[nodiscard]] std::uint8_t visibility(std::size_t i) const { return static_cast<std::uint8_t>(other_[i] & 0x3); }
+
+    // Section index with SHN_XINDEX already resolved through SHT_SYMTAB_SHNDX
+    [[nodiscard]] std::uint32_t section_index(std::size_t i) const { return shndx_[i]; }
+    [[nodiscard]] bool is_defined(std::size_t i) const { return shndx_[i] != SHN_UNDEF; }
+
+    // Defined symbol by name. Uses the ELF hash table when present. When
+    // several versions of the name exist (memcpy@GLIBC_2.2.5 and
+    // memcpy@@GLIBC_2.14), the default version wins, as it does for the
+    // dynamic linker; a hidden one is returned only when nothing else is.
+    [[nodiscard]] std::optional<std::size_t> find(std::string_view name) const;
+
+    // VERSYM_HIDDEN set in the linked SHT_GNU_VERSYM: a non-default
+    // version (sym@VER rather than sym@@VER). False without version info.
+    [[nodiscard]] bool is_hidden_version(std::size_t i) const;
+
+    // Symbol covering addr: the closest symbol at or below addr whose
+    // [value, value + size) contains it, or which has no size at all.
+    [[nodiscard]] std::optional<ElfSymbolHit> find_address(std::uint64_t addr) const;
+
+    // Defined code/data symbols in address order
+    [[nodiscard]] std::span<const std::uint32_t> by_address() const { return addr_index_; }
+
+    [[nodiscard]] bool has_gnu_hash() const { return !gnu_hash_.empty(); }
+    [[nodiscard]] bool has_sysv_hash() const { return !sysv_hash_.empty(); }
+
+    // Hash functions used by DT_GNU_HASH and DT_HASH
+    [[nodiscard]] static std::uint32_t gnu_hash(std::string_view name);
+    [[nodiscard]] static std::uint32_t sysv_hash(std::string_view name);
+
+private:
+    template<typename Traits>
+    std::expected<void, Error> decode(const ElfView& elf, const ElfSection& sec, std::size_t section_index);
+
+    // Hash tables and SHT_GNU_VERSYM, all linked to the dynsym section
+    void attach_hash_tables(const ElfView& elf, std::size_t section_index);
+    void build_address_index();
+    void build_name_index();
+
+    [[nodiscard]] std::uint32_t word(std::span<const std::uint8_t> table, std::size_t index) const;
+    [[nodiscard]] std::optional<std::size_t> find_gnu(std::string_view name) const;
+    [[nodiscard]] std::optional<std::size_t> find_sysv(std::string_view name) const;
+
+    std::uint32_t section_type_ = 0;
+    bool swap_ = false;                 // hash tables are in the file's byte order
+    bool is_64_ = false;
+
+    std::vector<std::string_view> names_;
+    std::vector<std::uint64_t> values_;
+    std::vector<std::uint64_t> sizes_;
+    std::vector<std::uint8_t> info_;
+    std::vector<std::uint8_t> other_;
+    std::vector<std::uint32_t> shndx_;
+
+    // Address index: symbol indices and their values, both sorted by value
+    std::vector<std::uint32_t> addr_index_;
+    std::vector<std::uint64_t> addr_values_;
+
+    // Raw SHT_GNU_HASH / SHT_HASH contents (views into the file)
+    std::span<const std::uint8_t> gnu_hash_;
+    std::span<const std::uint8_t> sysv_hash_;
+    // Raw SHT_GNU_VERSYM contents, one 16-bit entry per symbol
+    std::span<const std::uint8_t> versym_;
+
+    // Fallback name index when the section has no hash table
+    std::unordered_map<std::string_view, std::uint32_t> name_index_;
+};
+
+// The file's .symtab / .dynsym; an empty table when the section is absent
+[[nodiscard]] std::expected<ElfSymbolTable, Error> read_symtab(const ElfView& elf);
+[[nodiscard]] std::expected<ElfSymbolTable, Error> read_dynsym(const ElfView& elf);
+
+} // namespace peelf
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+
+#include "elf/elf_structures.hpp"
+
+namespace peelf {
+
+    // Compile-time description of an ELF class, mirroring Pe32Traits /
+    // Pe64Traits. ElfView::dispatch() instantiates table walkers once per
+    // class instead of branching on EI_CLASS per entry.
+
+    struct Elf32Traits {
+        using ehdr      = Elf32_Ehdr_;
+        using shdr      = Elf32_Shdr_;
+        using phdr      = Elf32_Phdr_;
+        using sym       = Elf32_Sym_;
+        using rel       = Elf32_Rel_;
+        using rela      = Elf32_Rela_;
+        using dyn       = Elf32_Dyn_;
+        using chdr      = Elf32_Chdr_;
+        using addr_type = std::uint32_t;
+        using word_type = std::uint32_t;   // natural word (Elf32_Word / Elf64_Xword)
+
+        static constexpr std::uint8_t elf_class = ELFCLASS32;
+        static constexpr bool         is_64     = false;
+    };
+
+    struct Elf64Traits {
+        using ehdr      = Elf64_Ehdr_;
+        using shdr      = Elf64_Shdr_;
+        using phdr      = Elf64_Phdr_;
+        using sym       = Elf64_Sym_;
+        using rel       = Elf64_Rel_;
+        using rela      = Elf64_Rela_;
+        using dyn       = Elf64_Dyn_;
+        using chdr      = Elf64_Chdr_;
+        using addr_type = std::uint64_t;
+        using word_type = std::uint64_t;
+
+        static constexpr std::uint8_t elf_class = ELFCLASS64;
+        static constexpr bool         is_64     = true;
+    };
+
+} // namespace peelf
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "peelf/peelf.hpp"
+#include "elf/elf_view.hpp"
+
+namespace peelf {
+
+// Common Information Entry. Spans point into the file bytes.
+struct ElfCie {
+    std::uint64_t offset = 0;           // of the record within .eh_frame
+    std::uint8_t version = 0;
+    std::string_view augmentation;      // e.g. "zR", "zPLR"
+    std::uint64_t code_alignment = 0;
+    std::int64_t data_alignment = 0;
+    std::uint64_t return_register = 0;
+    std::uint8_t fde_encoding = DW_EH_PE_absptr;
+    std::uint8_t lsda_encoding = DW_EH_PE_omit;
+    std::uint8_t personality_encoding = DW_EH_PE_omit;
+    std::uint64_t personality = 0;      // address of the pointer itself when DW_EH_PE_indirect
+    bool signal_frame = false;          // 'S'
+    std::span<const std::uint8_t> instructions;     // initial instructions
+};
+
+// Frame Description Entry: one function (or function fragment)
+struct ElfFde {
+    std::uint64_t offset = 0;           // of the record within .eh_frame
+    std::uint64_t cie_offset = 0;
+    std::uint64_t begin = 0;            // first code address covered
+    std::uint64_t end = 0;              // one past the last
+    std::optional<std::uint64_t> lsda;
+    std::span<const std::uint8_t> instructions;
+
+    [[nodiscard]] bool contains(std::uint64_t address) const { return address >= begin && address < end; }
+};
+
+struct ElfFunctionRange {
+    std::uint64_t begin = 0;
+    std::uint64_t end = 0;
+};
+
+// One decoded call frame instruction. Factored operands are already
+// multiplied by the CIE's code / data alignment factor.
+struct ElfCfaInstruction {
+    std::uint8_t opcode = 0;            // DW_CFA_*; primary opcodes without their operand bits
+    std::uint64_t location = 0;         // code address the instruction takes effect at
+    std::uint64_t reg = 0;
+    std::uint64_t reg2 = 0;             // DW_CFA_register
+    std::int64_t offset = 0;
+    std::span<const std::uint8_t> expression;   // DW_CFA_*expression
+};
+
+// How the canonical frame address is computed at one code address:
+// reg + offset, or a DWARF expression
+struct ElfCfaRule {
+    std::uint64_t reg = 0;
+    std::int64_t offset = 0;
+    std::span<const std::uint8_t> expression;
+
+    [[nodiscard]] bool is_expression() const { return !expression.empty(); }
+};
+
+// Name of a DW_CFA_* opcode, e.g. "DW_CFA_def_cfa_offset"
+[[nodiscard]] std::string_view cfa_opcode_name(std::uint8_t opcode);
+
+// .eh_frame plus its .eh_frame_hdr search table. load() only locates the
+// two; records are decoded when asked for. Lookups binary-search the
+// header's sorted table in place, so fde_for_address() touches O(log n)
+// table entries and one CIE/FDE pair. Without a usable header (ET_REL
+// objects, stripped headers, exotic encodings) a sorted (pc, offset) index
+// is built from one pass over .eh_frame instead.
+//
+// For stripped binaries this is the only reliable list of function
+// boundaries. In ET_REL objects the pc fields are still unrelocated, so
+// ranges there are section-relative at best. The file bytes must outlive
+// the table.
+class ElfUnwindTable {
+public:
+    ElfUnwindTable() = default;
+
+    static std::expected<ElfUnwindTable, Error> load(const ElfView& elf);
+
+    [[nodiscard]] bool empty() const { return eh_frame_.empty(); }
+    [[nodiscard]] bool has_search_table() const { return table_count_ != 0; }
+    [[nodiscard]] std::uint64_t eh_frame_address() const { return eh_frame_addr_; }
+    [[nodiscard]] std::size_t eh_frame_size() const { return eh_frame_.size(); }
+
+    // Number of FDEs in the search table or fallback index
+    [[nodiscard]] std::size_t fde_count() const { return has_search_table() ? table_count_ : index_.size(); }
+
+    // FDE covering the address, or nullopt
+    [[nodiscard]] std::optional<ElfFde> fde_for_address(std::uint64_t address) const;
+
+    // Records by .eh_frame offset
+    [[nodiscard]] std::expected<ElfCie, Error> cie(std::uint64_t offset) const;
+    [[nodiscard]] std::expected<ElfFde, Error> fde(std::uint64_t offset) const;
+
+    // Every FDE in .eh_frame, in file order
+    [[nodiscard]] std::expected<std::vector<ElfFde>, Error> fdes() const;
+
+    // Every covered code range, sorted by start address
+    [[nodiscard]] std::expected<std::vector<ElfFunctionRange>, Error> function_ranges() const;
+
+    // CIE initial instructions followed by the FDE's own, decoded
+    [[nodiscard]] std::expected<std::vector<ElfCfaInstruction>, Error> instructions(const ElfFde& fde) const;
+
+    // CFA rule in effect at address (which must lie inside fde)
+    [[nodiscard]] std::expected<ElfCfaRule, Error> cfa_at(const ElfFde& fde, std::uint64_t address) const;
+
+private:
+    struct IndexEntry {
+        std::uint64_t begin;
+        std::uint64_t offset;
+    };
+
+    std::expected<void, Error> build_index();
+    [[nodiscard]] std::optional<std::uint64_t> table_offset_for(std::uint64_t address) const;
+
+    std::span<const std::uint8_t> eh_frame_;
+    std::uint64_t eh_frame_addr_ = 0;
+
+    // .eh_frame_hdr search table: table_count_ pairs of (initial location,
+    // FDE address), each table_entry_size_ / 2 bytes, datarel to hdr_addr_
+    std::span<const std::uint8_t> table_;
+    std::uint64_t hdr_addr_ = 0;
+    std::size_t table_count_ = 0;
+    std::size_t table_entry_size_ = 0;
+    std::uint8_t table_encoding_ = DW_EH_PE_omit;
+
+    std::vector<IndexEntry> index_;     // fallback, sorted by begin
+
+    bool big_endian_ = false;
+    std::uint8_t address_size_ = 8;
+    std::size_t max_entries_ = 0;
+};
+
+} // namespace peelf
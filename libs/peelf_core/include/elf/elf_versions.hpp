@@ -0,0 +1,100 @@
+#pragma once
+
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "peelf/peelf.hpp"
+#include "elf/elf_view.hpp"
+
+namespace peelf {
+
+// Version defined by this object (.gnu.version_d)
+struct ElfVersionDefinition {
+    std::uint16_t index = 0;            // vd_ndx
+    std::uint16_t flags = 0;            // VER_FLG_*
+    std::string_view name;              // first Verdaux
+};
+
+// Version required from a dependency (.gnu.version_r)
+struct ElfVersionRequirement {
+    std::uint16_t index = 0;            // vna_other
+    std::uint16_t flags = 0;
+    std::string_view file;              // e.g. "libc.so.6"
+    std::string_view name;              // e.g. "GLIBC_2.34"
+};
+
+// Numeric part of a version node name: "GLIBC_2.3.4" -> {2, 3, 4}
+struct ElfVersionNumber {
+    std::array<std::uint32_t, 4> parts{};
+    std::uint8_t count = 0;
+
+    // Splits "PREFIX_a.b.c" into prefix and number; nullopt when the name
+    // has no '_' followed by a dotted number.
+    [[nodiscard]] static std::optional<ElfVersionNumber> parse(std::string_view name, std::string_view* prefix = nullptr);
+    [[nodiscard]] std::string to_string() const;
+
+    friend std::strong_ordering operator<=>(const ElfVersionNumber& a, const ElfVersionNumber& b) {
+        return a.parts <=> b.parts;
+    }
+    friend bool operator==(const ElfVersionNumber& a, const ElfVersionNumber& b) { return a.parts == b.parts; }
+};
+
+// Version of every .dynsym entry, decoded from .gnu.version plus the
+// definition and requirement tables. Per symbol only the 16-bit versym is
+// stored; names are resolved through a small table indexed by version
+// index. Views point into the file bytes.
+class ElfSymbolVersions {
+public:
+    ElfSymbolVersions() = default;
+
+    static std::expected<ElfSymbolVersions, Error> load(const ElfView& elf);
+
+    [[nodiscard]] bool empty() const { return versym_.empty(); }
+    [[nodiscard]] std::size_t size() const { return versym_.size(); }
+
+    [[nodiscard]] std::uint16_t index(std::size_t sym) const { return static_cast<std::uint16_t>(versym_[sym] & VERSYM_INDEX); }
+    [[nodiscard]] bool is_hidden(std::size_t sym) const { return (versym_[sym] & VERSYM_HIDDEN) != 0; }
+
+    // Version name of the symbol; empty for local / global / unknown
+    [[nodiscard]] std::string_view name(std::size_t sym) const;
+    // Library the version is required from; empty for defined versions
+    [[nodiscard]] std::string_view file(std::size_t sym) const;
+
+    [[nodiscard]] std::span<const ElfVersionDefinition> definitions() const { return definitions_; }
+    [[nodiscard]] std::span<const ElfVersionRequirement> requirements() const { return requirements_; }
+
+private:
+    struct Slot {
+        std::string_view name;
+        std::string_view file;
+    };
+
+    [[nodiscard]] const Slot* slot(std::size_t sym) const;
+
+    std::vector<std::uint16_t> versym_;
+    std::vector<Slot> by_index_;
+    std::vector<ElfVersionDefinition> definitions_;
+    std::vector<ElfVersionRequirement> requirements_;
+};
+
+// Highest GLIBC_ / GLIBCXX_ / CXXABI_ version the object requires
+struct ElfRequiredVersions {
+    std::optional<ElfVersionNumber> glibc;
+    std::optional<ElfVersionNumber> glibcxx;
+    std::optional<ElfVersionNumber> cxxabi;
+};
+
+// Single pass over .gnu.version_r only; symbols and definitions are never
+// touched and nothing is kept. Meant for ABI gates run over whole
+// repositories.
+[[nodiscard]] std::expected<ElfRequiredVersions, Error> read_required_versions(const ElfView& elf);
+
+} // namespace peelf
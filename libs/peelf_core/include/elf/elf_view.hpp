@@ -0,0 +1,209 @@
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "peelf/peelf.hpp"
+#include "peelf/byteswap.hpp"
+#include "peelf/work_budget.hpp"
+#include "elf/elf_structures.hpp"
+#include "elf/elf_traits.hpp"
+
+namespace peelf {
+
+// Class-independent copy of one section header
+struct ElfSection {
+    std::uint32_t name = 0;             // offset into shstrtab
+    std::uint32_t type = 0;
+    std::uint64_t flags = 0;
+    std::uint64_t addr = 0;
+    std::uint64_t offset = 0;
+    std::uint64_t size = 0;
+    std::uint32_t link = 0;
+    std::uint32_t info = 0;
+    std::uint64_t addralign = 0;
+    std::uint64_t entsize = 0;
+};
+
+// Class-independent copy of one program header
+struct ElfSegment {
+    std::uint32_t type = 0;
+    std::uint32_t flags = 0;
+    std::uint64_t offset = 0;
+    std::uint64_t vaddr = 0;
+    std::uint64_t paddr = 0;
+    std::uint64_t filesz = 0;
+    std::uint64_t memsz = 0;
+    std::uint64_t align = 0;
+};
+
+// Zero-copy view over an ELF32/ELF64 file held in memory. The ELF header
+// and both header tables are validated once in parse(); the tables are
+// exposed as spans over the file bytes, section names are looked up in
+// shstrtab only when asked for. The bytes must outlive the view.
+//
+// Files in the other byte order are handled by converting whole tables
+// with RecordSwapper: the header tables once in parse(), everything else
+// through table<T>() on request. Every struct handed out is in host order.
+class ElfView {
+public:
+    static std::expected<ElfView, Error> parse(std::span<const std::uint8_t> bytes,
+                                               const ParseLimits& limits = {});
+
+    [[nodiscard]] std::span<const std::uint8_t> bytes() const { return bytes_; }
+    [[nodiscard]] const ParseLimits& limits() const { return limits_; }
+
+    // -------------------------------------------------------------------
+    // ELF header
+    // -------------------------------------------------------------------
+    [[nodiscard]] bool is_64() const { return is_64_; }
+    [[nodiscard]] std::uint8_t elf_class() const { return bytes_[EI_CLASS]; }
+    [[nodiscard]] std::uint8_t data_encoding() const { return bytes_[EI_DATA]; }
+    [[nodiscard]] bool is_big_endian() const { return bytes_[EI_DATA] == ELFDATA2MSB; }
+    [[nodiscard]] std::uint8_t os_abi() const { return bytes_[EI_OSABI]; }
+    [[nodiscard]] std::uint8_t abi_version() const { return bytes_[EI_ABIVERSION]; }
+
+    [[nodiscard]] std::uint16_t type() const { return type_; }
+    [[nodiscard]] std::uint16_t machine() const { return machine_; }
+    [[nodiscard]] std::uint32_t version() const { return version_; }
+    [[nodiscard]] std::uint64_t entry() const { return entry_; }
+    [[nodiscard]] std::uint32_t flags() const { return flags_; }
+
+    // Typed access to the header tables. Only valid for the class reported
+    // by is_64(); prefer dispatch() or the normalized accessors below.
+    template<typename Traits>
+    [[nodiscard]] const typename Traits::ehdr& header() const {
+        return *reinterpret_cast<const typename Traits::ehdr*>(ehdr_.data());
+    }
+
+    template<typename Traits>
+    [[nodiscard]] std::span<const typename Traits::shdr> section_headers() const {
+        return {reinterpret_cast<const typename Traits::shdr*>(shdrs_.data()), section_count_};
+    }
+
+    template<typename Traits>
+    [[nodiscard]] std::span<const typename Traits::phdr> program_headers() const {
+        return {reinterpret_cast<const typename Traits::phdr*>(phdrs_.data()), segment_count_};
+    }
+
+    // Invokes f(Elf32Traits{}) or f(Elf64Traits{}) for this file
+    template<typename F>
+    decltype(auto) dispatch(F&& f) const {
+        if (is_64_)
+            return f(Elf64Traits{});
+        return f(Elf32Traits{});
+    }
+
+    // -------------------------------------------------------------------
+    // Sections
+    // -------------------------------------------------------------------
+    [[nodiscard]] std::size_t section_count() const { return section_count_; }
+    [[nodiscard]] ElfSection section(std::size_t index) const;
+    [[nodiscard]] std::string_view section_name(std::size_t index) const;
+    [[nodiscard]] std::optional<std::size_t> find_section(std::string_view name) const;
+    [[nodiscard]] std::optional<std::size_t> find_section_by_type(std::uint32_t type) const;
+
+    // File bytes of the section; empty for SHT_NOBITS or when out of range
+    [[nodiscard]] std::span<const std::uint8_t> section_data(std::size_t index) const;
+    [[nodiscard]] std::span<const std::uint8_t> section_data(const ElfSection& s) const;
+
+    // -------------------------------------------------------------------
+    // Segments
+    // -------------------------------------------------------------------
+    [[nodiscard]] std::size_t segment_count() const { return segment_count_; }
+    [[nodiscard]] ElfSegment segment(std::size_t index) const;
+    [[nodiscard]] std::span<const std::uint8_t> segment_data(std::size_t index) const;
+
+    // Virtual address -> file offset through the PT_LOAD segments
+    [[nodiscard]] std::optional<std::size_t> vaddr_to_offset(std::uint64_t vaddr) const;
+
+    // -------------------------------------------------------------------
+    // Raw access
+    // -------------------------------------------------------------------
+    [[nodiscard]] std::span<const std::uint8_t> file_span(std::uint64_t offset, std::uint64_t size) const;
+
+    // Table of packed records (Elf64_Sym_, Elf32_Rela_, ...) in host byte
+    // order. Zero-copy unless the file needs converting.
+    template<typename T>
+    [[nodiscard]] NativeTable<T> table(std::span<const std::uint8_t> raw) const {
+        return swap_ ? NativeTable<T>::swapped(raw) : NativeTable<T>::view(raw);
+    }
+
+    // Integer stored in the file's byte order -> host order
+    template<std::integral T>
+    [[nodiscard]] T to_native(T v) const {
+        return swap_ ? std::byteswap(v) : v;
+    }
+
+    template<std::integral T>
+    [[nodiscard]] bool read_int(std::size_t offset, T& out) const {
+        if (!read(offset, out))
+            return false;
+        out = to_native(out);
+        return true;
+    }
+
+    // Single packed record at offset, in host byte order
+    template<typename T>
+    [[nodiscard]] bool read_record(std::size_t offset, T& out) const {
+        if (!read(offset, out))
+            return false;
+        if (swap_) {
+            const std::span<std::uint8_t> rec{reinterpret_cast<std::uint8_t*>(&out), sizeof(T)};
+            RecordSwapper::for_type<T>().swap(rec, rec);
+        }
+        return true;
+    }
+
+    // NUL-terminated string at offset inside a string table section
+    [[nodiscard]] static std::string_view cstring_at(std::span<const std::uint8_t> table, std::size_t offset);
+
+    template<typename T>
+    [[nodiscard]] bool read(std::size_t offset, T& out) const {
+        if (offset > bytes_.size() || bytes_.size() - offset < sizeof(T))
+            return false;
+        std::memcpy(&out, bytes_.data() + offset, sizeof(T));
+        return true;
+    }
+
+private:
+    explicit ElfView(std::span<const std::uint8_t> bytes) : bytes_(bytes) {}
+
+    template<typename Traits>
+    std::expected<void, Error> parse_headers();
+
+    template<typename T>
+    std::span<const std::uint8_t> native_span(std::span<const std::uint8_t> raw);
+
+    std::span<const std::uint8_t> bytes_;
+    ParseLimits limits_{};
+    bool swap_ = false;                 // file byte order differs from the host
+
+    // Host-order header and tables: views of bytes_, or of native_ when
+    // the file had to be converted.
+    std::span<const std::uint8_t> ehdr_;
+    std::span<const std::uint8_t> shdrs_;
+    std::span<const std::uint8_t> phdrs_;
+    std::vector<std::shared_ptr<const std::vector<std::uint8_t>>> native_;
+    std::size_t section_count_ = 0;
+    std::size_t segment_count_ = 0;
+    std::size_t shstrndx_ = 0;
+    bool is_64_ = false;
+
+    std::uint16_t type_ = 0;
+    std::uint16_t machine_ = 0;
+    std::uint32_t version_ = 0;
+    std::uint64_t entry_ = 0;
+    std::uint32_t flags_ = 0;
+};
+
+} // namespace peelf
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <string_view>
+#include <vector>
+
+#include "peelf/peelf.hpp"
+#include "macho/macho_view.hpp"
+
+namespace peelf {
+
+// Special library ordinals of chained imports and two-level binds
+static constexpr std::int32_t BIND_SPECIAL_DYLIB_SELF            = 0;
+static constexpr std::int32_t BIND_SPECIAL_DYLIB_MAIN_EXECUTABLE = -1;
+static constexpr std::int32_t BIND_SPECIAL_DYLIB_FLAT_LOOKUP     = -2;
+static constexpr std::int32_t BIND_SPECIAL_DYLIB_WEAK_LOOKUP     = -3;
+
+struct MachOChainedImport {
+    std::string_view name;
+    std::int32_t library = 0;           // dylib ordinal, or BIND_SPECIAL_DYLIB_*
+    bool weak = false;
+    std::int64_t addend = 0;
+};
+
+// One pointer location in a chain
+struct MachOFixup {
+    std::uint64_t offset = 0;           // file offset in the image
+    std::uint64_t vmaddr = 0;           // of the location
+    bool bind = false;
+    bool auth = false;                  // arm64e signed pointer
+    std::uint32_t import = 0;           // bind: index into imports
+    std::int64_t addend = 0;            // bind: added to the import's address
+    std::uint64_t target = 0;           // rebase: vmaddr the pointer resolves to
+};
+
+struct MachOChainedFixups {
+    std::uint16_t pointer_format = 0;   // DYLD_CHAINED_PTR_* of the first segment with fixups
+    std::vector<MachOChainedImport> imports;
+    std::vector<MachOFixup> fixups;     // by segment, then in chain order
+};
+
+// Walks LC_DYLD_CHAINED_FIXUPS: the import table and every chain of every
+// page. Rebase targets are normalized to vmaddrs whichever form the
+// pointer format stores. Supports the userland formats (64, 64_OFFSET,
+// 32 and the arm64e family); kernel-cache and firmware formats are
+// reported as errors. Empty when the image has no chained fixups.
+[[nodiscard]] std::expected<MachOChainedFixups, Error> read_chained_fixups(const MachOView& macho);
+
+} // namespace peelf
@@ -0,0 +1,350 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace peelf {
+
+// mach_header magic, as read in host (little-endian) order
+static constexpr std::uint32_t MH_MAGIC    = 0xFEEDFACE;
+static constexpr std::uint32_t MH_CIGAM    = 0xCEFAEDFE;
+static constexpr std::uint32_t MH_MAGIC_64 = 0xFEEDFACF;
+static constexpr std::uint32_t MH_CIGAM_64 = 0xCFFAEDFE;
+
+// Fat headers are always big-endian
+static constexpr std::uint32_t FAT_MAGIC    = 0xCAFEBABE;
+static constexpr std::uint32_t FAT_MAGIC_64 = 0xCAFEBABF;
+
+// cputype
+static constexpr std::uint32_t CPU_ARCH_ABI64    = 0x01000000;
+static constexpr std::uint32_t CPU_ARCH_ABI64_32 = 0x02000000;
+static constexpr std::uint32_t CPU_TYPE_X86      = 7;
+static constexpr std::uint32_t CPU_TYPE_X86_64   = CPU_TYPE_X86 | CPU_ARCH_ABI64;
+static constexpr std::uint32_t CPU_TYPE_ARM      = 12;
+static constexpr std::uint32_t CPU_TYPE_ARM64    = CPU_TYPE_ARM | CPU_ARCH_ABI64;
+static constexpr std::uint32_t CPU_TYPE_ARM64_32 = CPU_TYPE_ARM | CPU_ARCH_ABI64_32;
+static constexpr std::uint32_t CPU_TYPE_POWERPC  = 18;
+static constexpr std::uint32_t CPU_SUBTYPE_MASK  = 0xFF000000;   // capability bits
+static constexpr std::uint32_t CPU_SUBTYPE_ARM64E = 2;
+
+// filetype
+static constexpr std::uint32_t MH_OBJECT  = 0x1;
+static constexpr std::uint32_t MH_EXECUTE = 0x2;
+static constexpr std::uint32_t MH_DYLIB   = 0x6;
+static constexpr std::uint32_t MH_DYLINKER = 0x7;
+static constexpr std::uint32_t MH_BUNDLE  = 0x8;
+static constexpr std::uint32_t MH_DSYM    = 0xA;
+static constexpr std::uint32_t MH_KEXT_BUNDLE = 0xB;
+static constexpr std::uint32_t MH_FILESET = 0xC;
+
+// flags (the ones the viewer names)
+static constexpr std::uint32_t MH_TWOLEVEL        = 0x00000080;
+static constexpr std::uint32_t MH_PIE             = 0x00200000;
+static constexpr std::uint32_t MH_HAS_TLV_DESCRIPTORS = 0x00800000;
+static constexpr std::uint32_t MH_APP_EXTENSION_SAFE  = 0x02000000;
+
+// Load commands
+static constexpr std::uint32_t LC_REQ_DYLD              = 0x80000000;
+static constexpr std::uint32_t LC_SEGMENT               = 0x1;
+static constexpr std::uint32_t LC_SYMTAB                = 0x2;
+static constexpr std::uint32_t LC_UNIXTHREAD            = 0x5;
+static constexpr std::uint32_t LC_DYSYMTAB              = 0xB;
+static constexpr std::uint32_t LC_LOAD_DYLIB            = 0xC;
+static constexpr std::uint32_t LC_ID_DYLIB              = 0xD;
+static constexpr std::uint32_t LC_LOAD_DYLINKER         = 0xE;
+static constexpr std::uint32_t LC_LOAD_WEAK_DYLIB       = 0x18 | LC_REQ_DYLD;
+static constexpr std::uint32_t LC_SEGMENT_64            = 0x19;
+static constexpr std::uint32_t LC_UUID                  = 0x1B;
+static constexpr std::uint32_t LC_RPATH                 = 0x1C | LC_REQ_DYLD;
+static constexpr std::uint32_t LC_CODE_SIGNATURE        = 0x1D;
+static constexpr std::uint32_t LC_REEXPORT_DYLIB        = 0x1F | LC_REQ_DYLD;
+static constexpr std::uint32_t LC_LAZY_LOAD_DYLIB       = 0x20;
+static constexpr std::uint32_t LC_ENCRYPTION_INFO       = 0x21;
+static constexpr std::uint32_t LC_DYLD_INFO             = 0x22;
+static constexpr std::uint32_t LC_DYLD_INFO_ONLY        = 0x22 | LC_REQ_DYLD;
+static constexpr std::uint32_t LC_LOAD_UPWARD_DYLIB     = 0x23 | LC_REQ_DYLD;
+static constexpr std::uint32_t LC_VERSION_MIN_MACOSX    = 0x24;
+static constexpr std::uint32_t LC_FUNCTION_STARTS       = 0x26;
+static constexpr std::uint32_t LC_MAIN                  = 0x28 | LC_REQ_DYLD;
+static constexpr std::uint32_t LC_DATA_IN_CODE          = 0x29;
+static constexpr std::uint32_t LC_SOURCE_VERSION        = 0x2A;
+static constexpr std::uint32_t LC_ENCRYPTION_INFO_64    = 0x2C;
+static constexpr std::uint32_t LC_BUILD_VERSION         = 0x32;
+static constexpr std::uint32_t LC_DYLD_EXPORTS_TRIE     = 0x33 | LC_REQ_DYLD;
+static constexpr std::uint32_t LC_DYLD_CHAINED_FIXUPS   = 0x34 | LC_REQ_DYLD;
+
+// nlist n_type
+static constexpr std::uint8_t N_STAB = 0xE0;
+static constexpr std::uint8_t N_PEXT = 0x10;
+static constexpr std::uint8_t N_TYPE = 0x0E;
+static constexpr std::uint8_t N_EXT  = 0x01;
+static constexpr std::uint8_t N_UNDF = 0x0;
+static constexpr std::uint8_t N_ABS  = 0x2;
+static constexpr std::uint8_t N_SECT = 0xE;
+static constexpr std::uint8_t N_INDR = 0xA;
+static constexpr std::uint16_t N_WEAK_REF = 0x0040;
+static constexpr std::uint16_t N_WEAK_DEF = 0x0080;
+
+// Export trie terminal flags
+static constexpr std::uint64_t EXPORT_SYMBOL_FLAGS_KIND_MASK         = 0x03;
+static constexpr std::uint64_t EXPORT_SYMBOL_FLAGS_KIND_REGULAR      = 0x00;
+static constexpr std::uint64_t EXPORT_SYMBOL_FLAGS_KIND_THREAD_LOCAL = 0x01;
+static constexpr std::uint64_t EXPORT_SYMBOL_FLAGS_KIND_ABSOLUTE     = 0x02;
+static constexpr std::uint64_t EXPORT_SYMBOL_FLAGS_WEAK_DEFINITION   = 0x04;
+static constexpr std::uint64_t EXPORT_SYMBOL_FLAGS_REEXPORT          = 0x08;
+static constexpr std::uint64_t EXPORT_SYMBOL_FLAGS_STUB_AND_RESOLVER = 0x10;
+
+// Chained fixups
+static constexpr std::uint32_t DYLD_CHAINED_IMPORT          = 1;
+static constexpr std::uint32_t DYLD_CHAINED_IMPORT_ADDEND   = 2;
+static constexpr std::uint32_t DYLD_CHAINED_IMPORT_ADDEND64 = 3;
+
+static constexpr std::uint16_t DYLD_CHAINED_PTR_ARM64E            = 1;
+static constexpr std::uint16_t DYLD_CHAINED_PTR_64                = 2;
+static constexpr std::uint16_t DYLD_CHAINED_PTR_32                = 3;
+static constexpr std::uint16_t DYLD_CHAINED_PTR_64_OFFSET         = 6;
+static constexpr std::uint16_t DYLD_CHAINED_PTR_ARM64E_USERLAND   = 9;
+static constexpr std::uint16_t DYLD_CHAINED_PTR_ARM64E_USERLAND24 = 12;
+
+static constexpr std::uint16_t DYLD_CHAINED_PTR_START_NONE  = 0xFFFF;
+static constexpr std::uint16_t DYLD_CHAINED_PTR_START_MULTI = 0x8000;  // 32-bit formats only
+static constexpr std::uint16_t DYLD_CHAINED_PTR_START_LAST  = 0x8000;
+
+#pragma pack(push, 1)
+
+struct fat_header_ {
+    std::uint32_t magic;                // FAT_MAGIC / FAT_MAGIC_64
+    std::uint32_t nfat_arch;
+};
+
+struct fat_arch_ {
+    std::uint32_t cputype;
+    std::uint32_t cpusubtype;
+    std::uint32_t offset;               // of the slice in the file
+    std::uint32_t size;
+    std::uint32_t align;                // power of two
+};
+
+struct fat_arch_64_ {
+    std::uint32_t cputype;
+    std::uint32_t cpusubtype;
+    std::uint64_t offset;
+    std::uint64_t size;
+    std::uint32_t align;
+    std::uint32_t reserved;
+};
+
+struct mach_header_ {
+    std::uint32_t magic;                // MH_MAGIC
+    std::uint32_t cputype;
+    std::uint32_t cpusubtype;
+    std::uint32_t filetype;             // MH_*
+    std::uint32_t ncmds;
+    std::uint32_t sizeofcmds;
+    std::uint32_t flags;
+};
+
+struct mach_header_64_ {
+    std::uint32_t magic;                // MH_MAGIC_64
+    std::uint32_t cputype;
+    std::uint32_t cpusubtype;
+    std::uint32_t filetype;
+    std::uint32_t ncmds;
+    std::uint32_t sizeofcmds;
+    std::uint32_t flags;
+    std::uint32_t reserved;
+};
+
+struct load_command_ {
+    std::uint32_t cmd;                  // LC_*
+    std::uint32_t cmdsize;              // includes this header
+};
+
+struct segment_command_ {
+    std::uint32_t cmd;                  // LC_SEGMENT
+    std::uint32_t cmdsize;
+    char          segname[16];
+    std::uint32_t vmaddr;
+    std::uint32_t vmsize;
+    std::uint32_t fileoff;
+    std::uint32_t filesize;
+    std::uint32_t maxprot;
+    std::uint32_t initprot;
+    std::uint32_t nsects;               // section_ records that follow
+    std::uint32_t flags;
+};
+
+struct segment_command_64_ {
+    std::uint32_t cmd;                  // LC_SEGMENT_64
+    std::uint32_t cmdsize;
+    char          segname[16];
+    std::uint64_t vmaddr;
+    std::uint64_t vmsize;
+    std::uint64_t fileoff;
+    std::uint64_t filesize;
+    std::uint32_t maxprot;
+    std::uint32_t initprot;
+    std::uint32_t nsects;               // section_64_ records that follow
+    std::uint32_t flags;
+};
+
+struct section_ {
+    char          sectname[16];
+    char          segname[16];
+    std::uint32_t addr;
+    std::uint32_t size;
+    std::uint32_t offset;
+    std::uint32_t align;                // power of two
+    std::uint32_t reloff;
+    std::uint32_t nreloc;
+    std::uint32_t flags;                // type in the low byte
+    std::uint32_t reserved1;
+    std::uint32_t reserved2;
+};
+
+struct section_64_ {
+    char          sectname[16];
+    char          segname[16];
+    std::uint64_t addr;
+    std::uint64_t size;
+    std::uint32_t offset;
+    std::uint32_t align;
+    std::uint32_t reloff;
+    std::uint32_t nreloc;
+    std::uint32_t flags;
+    std::uint32_t reserved1;
+    std::uint32_t reserved2;
+    std::uint32_t reserved3;
+};
+
+struct symtab_command_ {
+    std::uint32_t cmd;                  // LC_SYMTAB
+    std::uint32_t cmdsize;
+    std::uint32_t symoff;
+    std::uint32_t nsyms;
+    std::uint32_t stroff;
+    std::uint32_t strsize;
+};
+
+struct nlist_ {
+    std::uint32_t n_strx;
+    std::uint8_t  n_type;               // N_*
+    std::uint8_t  n_sect;               // 1-based section, or 0
+    std::uint16_t n_desc;               // N_WEAK_*, library ordinal in bits 8-15
+    std::uint32_t n_value;
+};
+
+struct nlist_64_ {
+    std::uint32_t n_strx;
+    std::uint8_t  n_type;
+    std::uint8_t  n_sect;
+    std::uint16_t n_desc;
+    std::uint64_t n_value;
+};
+
+struct dylib_command_ {
+    std::uint32_t cmd;                  // LC_LOAD_DYLIB, LC_ID_DYLIB, ...
+    std::uint32_t cmdsize;
+    std::uint32_t name_offset;          // from the start of the command
+    std::uint32_t timestamp;
+    std::uint32_t current_version;      // xxxx.yy.zz
+    std::uint32_t compatibility_version;
+};
+
+// LC_RPATH, LC_LOAD_DYLINKER and friends
+struct lc_str_command_ {
+    std::uint32_t cmd;
+    std::uint32_t cmdsize;
+    std::uint32_t offset;               // of the string, from the start of the command
+};
+
+struct uuid_command_ {
+    std::uint32_t cmd;                  // LC_UUID
+    std::uint32_t cmdsize;
+    std::uint8_t  uuid[16];
+};
+
+struct entry_point_command_ {
+    std::uint32_t cmd;                  // LC_MAIN
+    std::uint32_t cmdsize;
+    std::uint64_t entryoff;             // file offset of main()
+    std::uint64_t stacksize;
+};
+
+struct dyld_info_command_ {
+    std::uint32_t cmd;                  // LC_DYLD_INFO(_ONLY)
+    std::uint32_t cmdsize;
+    std::uint32_t rebase_off;
+    std::uint32_t rebase_size;
+    std::uint32_t bind_off;
+    std::uint32_t bind_size;
+    std::uint32_t weak_bind_off;
+    std::uint32_t weak_bind_size;
+    std::uint32_t lazy_bind_off;
+    std::uint32_t lazy_bind_size;
+    std::uint32_t export_off;
+    std::uint32_t export_size;
+};
+
+// LC_DYLD_CHAINED_FIXUPS, LC_DYLD_EXPORTS_TRIE, LC_FUNCTION_STARTS, ...
+struct linkedit_data_command_ {
+    std::uint32_t cmd;
+    std::uint32_t cmdsize;
+    std::uint32_t dataoff;              // in __LINKEDIT
+    std::uint32_t datasize;
+};
+
+struct build_version_command_ {
+    std::uint32_t cmd;                  // LC_BUILD_VERSION
+    std::uint32_t cmdsize;
+    std::uint32_t platform;             // 1 macOS, 2 iOS, ...
+    std::uint32_t minos;                // xxxx.yy.zz
+    std::uint32_t sdk;
+    std::uint32_t ntools;
+};
+
+struct dyld_chained_fixups_header_ {
+    std::uint32_t fixups_version;       // 0
+    std::uint32_t starts_offset;        // dyld_chained_starts_in_image
+    std::uint32_t imports_offset;
+    std::uint32_t symbols_offset;
+    std::uint32_t imports_count;
+    std::uint32_t imports_format;       // DYLD_CHAINED_IMPORT*
+    std::uint32_t symbols_format;       // 0 = uncompressed
+};
+
+// Followed by page_count u16 page starts
+struct dyld_chained_starts_in_segment_ {
+    std::uint32_t size;
+    std::uint16_t page_size;
+    std::uint16_t pointer_format;       // DYLD_CHAINED_PTR_*
+    std::uint64_t segment_offset;       // from the image base
+    std::uint32_t max_valid_pointer;    // 32-bit formats only
+    std::uint16_t page_count;
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(fat_header_) == 8);
+static_assert(sizeof(fat_arch_) == 20);
+static_assert(sizeof(fat_arch_64_) == 32);
+static_assert(sizeof(mach_header_) == 28);
+static_assert(sizeof(mach_header_64_) == 32);
+static_assert(sizeof(load_command_) == 8);
+static_assert(sizeof(segment_command_) == 56);
+static_assert(sizeof(segment_command_64_) == 72);
+static_assert(sizeof(section_) == 68);
+static_assert(sizeof(section_64_) == 80);
+static_assert(sizeof(symtab_command_) == 24);
+static_assert(sizeof(nlist_) == 12);
+static_assert(sizeof(nlist_64_) == 16);
+static_assert(sizeof(dylib_command_) == 24);
+static_assert(sizeof(uuid_command_) == 24);
+static_assert(sizeof(entry_point_command_) == 24);
+static_assert(sizeof(dyld_info_command_) == 48);
+static_assert(sizeof(linkedit_data_command_) == 16);
+static_assert(sizeof(build_version_command_) == 24);
+static_assert(sizeof(dyld_chained_fixups_header_) == 28);
+static_assert(sizeof(dyld_chained_starts_in_segment_) == 22);
+
+} // namespace peelf
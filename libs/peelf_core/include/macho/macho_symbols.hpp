@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "peelf/peelf.hpp"
+#include "macho/macho_view.hpp"
+
+namespace peelf {
+
+// One LC_SYMTAB entry. The name is a view into the string table, so the
+// image bytes must outlive it.
+struct MachOSymbol {
+    std::string_view name;
+    std::uint64_t value = 0;
+    std::uint8_t type = 0;              // N_*
+    std::uint8_t section = 0;           // 1-based ordinal, 0 = none
+    std::uint16_t desc = 0;
+
+    [[nodiscard]] bool is_debug() const { return (type & N_STAB) != 0; }
+    [[nodiscard]] bool is_external() const { return (type & N_EXT) != 0; }
+    [[nodiscard]] bool is_private_external() const { return (type & N_PEXT) != 0; }
+    // Undefined externals with a value are commons; those count as defined
+    [[nodiscard]] bool is_defined() const { return (type & N_TYPE) != N_UNDF || value != 0; }
+    [[nodiscard]] bool is_weak() const { return (desc & (N_WEAK_REF | N_WEAK_DEF)) != 0; }
+    // Two-level namespace: which dylib (1-based) an undefined symbol binds to
+    [[nodiscard]] std::uint8_t library_ordinal() const { return static_cast<std::uint8_t>(desc >> 8); }
+};
+
+// LC_SYMTAB in table order; empty when the image has none
+[[nodiscard]] std::expected<std::vector<MachOSymbol>, Error> read_symbols(const MachOView& macho);
+
+struct MachOExport {
+    std::string name;                   // assembled from the trie edges
+    std::uint64_t flags = 0;            // EXPORT_SYMBOL_FLAGS_*
+    std::uint64_t address = 0;          // from image_base(); 0 for re-exports
+    std::uint64_t resolver = 0;         // stub-and-resolver only, from image_base()
+    std::uint64_t library = 0;          // re-exports: dylib ordinal
+    std::string_view import_name;       // re-exports: name in that dylib, empty if the same
+
+    [[nodiscard]] bool is_reexport() const { return (flags & EXPORT_SYMBOL_FLAGS_REEXPORT) != 0; }
+    [[nodiscard]] bool is_weak() const { return (flags & EXPORT_SYMBOL_FLAGS_WEAK_DEFINITION) != 0; }
+};
+
+// Exported symbols from the export trie, found through
+// LC_DYLD_EXPORTS_TRIE or LC_DYLD_INFO(_ONLY). A node reached twice is
+// an error rather than walked again, so a trie whose edges loop back
+// cannot stall the walk; it also stops at limits().max_exports.
+[[nodiscard]] std::expected<std::vector<MachOExport>, Error> read_exports(const MachOView& macho);
+
+} // namespace peelf
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "peelf/peelf.hpp"
+#include "peelf/work_budget.hpp"
+#include "macho/macho_structures.hpp"
+
+namespace peelf {
+
+struct MachO32Traits {
+    static constexpr bool is_64 = false;
+    using header  = mach_header_;
+    using segment = segment_command_;
+    using section = section_;
+    using nlist   = nlist_;
+    static constexpr std::uint32_t segment_cmd = LC_SEGMENT;
+};
+
+struct MachO64Traits {
+    static constexpr bool is_64 = true;
+    using header  = mach_header_64_;
+    using segment = segment_command_64_;
+    using section = section_64_;
+    using nlist   = nlist_64_;
+    static constexpr std::uint32_t segment_cmd = LC_SEGMENT_64;
+};
+
+// Where one load command sits in the slice
+struct MachOLoadCommand {
+    std::uint32_t cmd = 0;              // LC_*
+    std::uint32_t size = 0;             // cmdsize
+    std::size_t offset = 0;
+};
+
+// Width-independent copy of one LC_SEGMENT(_64)
+struct MachOSegment {
+    std::string_view name;              // "__TEXT", ...
+    std::uint64_t vmaddr = 0;
+    std::uint64_t vmsize = 0;
+    std::uint64_t fileoff = 0;
+    std::uint64_t filesize = 0;
+    std::uint32_t maxprot = 0;
+    std::uint32_t initprot = 0;
+    std::uint32_t flags = 0;
+    std::uint32_t section_count = 0;
+};
+
+// Width-independent copy of one section record
+struct MachOSection {
+    std::string_view segment_name;
+    std::string_view name;              // "__text", ...
+    std::uint64_t addr = 0;
+    std::uint64_t size = 0;
+    std::uint32_t offset = 0;           // 0 for zero-fill sections
+    std::uint32_t align = 0;            // power of two
+    std::uint32_t reloff = 0;
+    std::uint32_t nreloc = 0;
+    std::uint32_t flags = 0;
+
+    [[nodiscard]] std::uint8_t type() const { return static_cast<std::uint8_t>(flags & 0xFF); }
+};
+
+// LC_LOAD_DYLIB and the other commands that add a library ordinal
+struct MachODylib {
+    std::uint32_t cmd = 0;
+    std::string_view name;
+    std::uint32_t current_version = 0;          // xxxx.yy.zz
+    std::uint32_t compatibility_version = 0;
+};
+
+// Zero-copy view over one Mach-O image (a thin file, or one slice of a fat
+// one). parse() validates the header and walks the load command headers
+// only; each command is decoded when something asks for it, so opening a
+// dylib does not touch __LINKEDIT. Like ElfView the bytes must outlive the
+// view. Big-endian (PowerPC) images are rejected.
+class MachOView {
+public:
+    static std::expected<MachOView, Error> parse(std::span<const std::uint8_t> bytes,
+                                                 const ParseLimits& limits = {});
+
+    [[nodiscard]] std::span<const std::uint8_t> bytes() const { return bytes_; }
+    [[nodiscard]] const ParseLimits& limits() const { return limits_; }
+
+    // -------------------------------------------------------------------
+    // Header
+    // -------------------------------------------------------------------
+    [[nodiscard]] bool is_64() const { return is_64_; }
+    [[nodiscard]] std::uint32_t cpu_type() const { return cpu_type_; }
+    [[nodiscard]] std::uint32_t cpu_subtype() const { return cpu_subtype_ & ~CPU_SUBTYPE_MASK; }
+    [[nodiscard]] std::uint32_t file_type() const { return file_type_; }
+    [[nodiscard]] std::uint32_t flags() const { return flags_; }
+
+    // Invokes f(MachO32Traits{}) or f(MachO64Traits{}) for this image
+    template<typename F>
+    decltype(auto) dispatch(F&& f) const {
+        if (is_64_)
+            return f(MachO64Traits{});
+        return f(MachO32Traits{});
+    }
+
+    // -------------------------------------------------------------------
+    // Load commands
+    // -------------------------------------------------------------------
+    [[nodiscard]] std::span<const MachOLoadCommand> commands() const { return commands_; }
+    [[nodiscard]] std::optional<std::size_t> find_command(std::uint32_t cmd) const;
+
+    // Fixed part of command `index` as T; nullopt when cmdsize is too small
+    template<typename T>
+    [[nodiscard]] std::optional<T> command(std::size_t index) const {
+        if (index >= commands_.size() || commands_[index].size < sizeof(T))
+            return std::nullopt;
+        T out;
+        std::memcpy(&out, bytes_.data() + commands_[index].offset, sizeof(T));
+        return out;
+    }
+
+    // lc_str at `str_offset` from the start of command `index`
+    [[nodiscard]] std::string_view command_string(std::size_t index, std::uint32_t str_offset) const;
+
+    // -------------------------------------------------------------------
+    // Segments and sections
+    // -------------------------------------------------------------------
+    [[nodiscard]] std::size_t segment_count() const { return segment_commands_.size(); }
+    [[nodiscard]] MachOSegment segment(std::size_t index) const;
+    [[nodiscard]] std::optional<std::size_t> find_segment(std::string_view name) const;
+    [[nodiscard]] std::span<const std::uint8_t> segment_data(std::size_t index) const;
+
+    // Sections are numbered from 1 across all segments, as nlist n_sect does
+    [[nodiscard]] std::size_t section_count() const { return section_count_; }
+    [[nodiscard]] MachOSection section(std::size_t ordinal) const;
+    [[nodiscard]] std::optional<std::size_t> find_section(std::string_view segment,
+                                                          std::string_view name) const;
+    // Empty for zero-fill sections or when out of range
+    [[nodiscard]] std::span<const std::uint8_t> section_data(std::size_t ordinal) const;
+
+    // vmaddr of __TEXT, which dyld info and chained fixups count from
+    [[nodiscard]] std::uint64_t image_base() const;
+    [[nodiscard]] std::optional<std::size_t> vmaddr_to_offset(std::uint64_t vmaddr) const;
+    [[nodiscard]] std::optional<std::uint64_t> offset_to_vmaddr(std::uint64_t offset) const;
+
+    // -------------------------------------------------------------------
+    // Other commands
+    // -------------------------------------------------------------------
+    // LC_MAIN as a vmaddr; nullopt for libraries and LC_UNIXTHREAD images
+    [[nodiscard]] std::optional<std::uint64_t> entry_point() const;
+    [[nodiscard]] std::optional<std::array<std::uint8_t, 16>> uuid() const;
+    [[nodiscard]] std::string_view install_name() const;        // LC_ID_DYLIB
+    // In command order, which is the order bind ordinals count in (from 1)
+    [[nodiscard]] std::vector<MachODylib> dylibs() const;
+    [[nodiscard]] std::vector<std::string_view> rpaths() const;
+
+    // Blob named by a linkedit_data_command_ (LC_DYLD_CHAINED_FIXUPS,
+    // LC_FUNCTION_STARTS, ...); empty when absent or out of range
+    [[nodiscard]] std::span<const std::uint8_t> linkedit_data(std::uint32_t cmd) const;
+
+    [[nodiscard]] std::span<const std::uint8_t> file_span(std::uint64_t offset, std::uint64_t size) const;
+
+private:
+    explicit MachOView(std::span<const std::uint8_t> bytes) : bytes_(bytes) {}
+
+    template<typename Traits>
+    std::expected<void, Error> parse_commands();
+
+    std::span<const std::uint8_t> bytes_;
+    ParseLimits limits_{};
+    bool is_64_ = false;
+    std::uint32_t cpu_type_ = 0;
+    std::uint32_t cpu_subtype_ = 0;
+    std::uint32_t file_type_ = 0;
+    std::uint32_t flags_ = 0;
+
+    std::vector<MachOLoadCommand> commands_;
+    std::vector<std::uint32_t> segment_commands_;   // indices into commands_
+    std::vector<std::uint32_t> first_section_;      // ordinal of each segment's first section
+    std::size_t section_count_ = 0;
+};
+
+// One architecture of a fat (universal) binary
+struct MachOSlice {
+    std::uint32_t cpu_type = 0;
+    std::uint32_t cpu_subtype = 0;
+    std::uint64_t offset = 0;
+    std::uint32_t align = 0;            // power of two
+    std::span<const std::uint8_t> data;
+};
+
+[[nodiscard]] bool is_macho(std::span<const std::uint8_t> bytes);
+// FAT_MAGIC is shared with Java class files; those are told apart by the
+// arch count, which for a class file is its (large) version number
+[[nodiscard]] bool is_fat_macho(std::span<const std::uint8_t> bytes);
+
+// The slices of a fat binary as sub-spans of `bytes`
+[[nodiscard]] std::expected<std::vector<MachOSlice>, Error>
+read_fat_slices(std::span<const std::uint8_t> bytes, const ParseLimits& limits = {});
+
+// Parses every slice on `threads` workers (0 = one per hardware thread).
+// Results are in slice order.
+[[nodiscard]] std::vector<std::expected<MachOView, Error>>
+parse_slices(std::span<const MachOSlice> slices, const ParseLimits& limits = {}, std::size_t threads = 0);
+
+} // namespace peelf
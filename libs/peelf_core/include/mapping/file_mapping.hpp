@@ -13,6 +13,7 @@
 #define NOMINMAX
 
 #include "file_mapping_win32.hpp"
+#include "file_mapping_posix.hpp"
 #include "mapping/file_mapping.hpp"
 #include "mapping/map_errors.hpp"
 
@@ -87,6 +88,7 @@ public:
         if (this != &other) {
             close();
             backend_ = std::exchange(other.backend_, {});
+            data_ = std::exchange(other.data_, nullptr);
             byte_size_ = std::exchange(other.byte_size_, 0);
             mode_ = other.mode_;
         }
@@ -5,6 +5,7 @@
 #include <Windows.h>
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <system_error>
 
@@ -29,6 +30,27 @@ namespace peelf {
         static std::error_code flush(Win32FileMappingBackend& self,
                                      void* ptr,
                                      std::size_t size) noexcept;
+
+        // Windowed access (WindowedFileMapping): open without mapping,
+        // then map and unmap views at offsets aligned to granularity()
+        static std::error_code open_file(Win32FileMappingBackend& self,
+                                         const std::string& path,
+                                         std::uint64_t* out_size) noexcept;
+
+        static std::error_code map_view(Win32FileMappingBackend& self,
+                                        std::uint64_t offset,
+                                        std::size_t size,
+                                        const void** out_ptr) noexcept;
+
+        static std::error_code unmap_view(const void* ptr, std::size_t size) noexcept;
+
+        static std::size_t granularity() noexcept;
+
+        // Private zero-filled memory (PeLoadedImage). The OS only commits
+        // a page when it is first written.
+        static std::error_code map_anonymous(std::size_t size, void** out_ptr) noexcept;
+
+        static std::error_code unmap_anonymous(void* ptr, std::size_t size) noexcept;
     };
 
 } // namespace ws::fs
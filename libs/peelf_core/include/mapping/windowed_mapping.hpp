@@ -0,0 +1,169 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <system_error>
+#include <vector>
+
+#include "mapping/file_mapping.hpp"
+
+namespace peelf {
+
+// Bytes from a WindowedFileMapping. `pin` keeps the window they live in
+// mapped, even after the mapping has evicted it or been closed.
+struct MappedBytes {
+    std::span<const std::uint8_t> bytes;
+    std::shared_ptr<const void> pin;
+};
+
+// Read-only access to a file of any size through a few fixed-size mapped
+// windows, so only the parts being looked at are ever mapped (a 40 GB
+// core dump costs window_size * window_count of address space). Windows
+// are recycled least recently used first. Thread-safe: every member,
+// including the size and the bounds checks, reads the state under the
+// mutex that open() and close() change it under.
+template <class Backend>
+class WindowedFileMapping {
+public:
+    static constexpr std::size_t default_window_size = 64u << 20;
+    static constexpr std::size_t default_window_count = 4;
+
+    WindowedFileMapping() = default;
+    ~WindowedFileMapping() { close(); }
+
+    WindowedFileMapping(const WindowedFileMapping&) = delete;
+    WindowedFileMapping& operator=(const WindowedFileMapping&) = delete;
+
+    std::error_code open(const std::filesystem::path& path,
+                         std::size_t window_size = default_window_size,
+                         std::size_t window_count = default_window_count)
+    {
+        close();
+        std::lock_guard lock(mutex_);
+        if (auto ec = Backend::open_file(backend_, path.string(), &size_); ec)
+            return ec;
+        // Windows start on multiples of their size, which must itself be a
+        // multiple of the backend's granularity
+        const std::size_t g = Backend::granularity();
+        window_size_ = std::max(g, (window_size + g - 1) / g * g);
+        window_count_ = std::max<std::size_t>(window_count, 1);
+        return {};
+    }
+
+    void close() noexcept
+    {
+        std::lock_guard lock(mutex_);
+        windows_.clear();
+        (void)Backend::unmap_and_close(backend_, nullptr, 0);
+        backend_ = {};
+        size_ = 0;
+    }
+
+    [[nodiscard]] bool is_open() const { return size() != 0; }
+
+    [[nodiscard]] std::uint64_t size() const
+    {
+        std::lock_guard lock(mutex_);
+        return size_;
+    }
+
+    [[nodiscard]] std::size_t window_size() const
+    {
+        std::lock_guard lock(mutex_);
+        return window_size_;
+    }
+
+    // The bytes [offset, offset + length), clamped to the end of the file.
+    // A range crossing a window boundary gets a window of its own.
+    [[nodiscard]] MappedBytes view(std::uint64_t offset, std::size_t length)
+    {
+        std::lock_guard lock(mutex_);
+        if (offset >= size_)
+            return {};
+        length = static_cast<std::size_t>(std::min<std::uint64_t>(length, size_ - offset));
+        if (length == 0)
+            return {};
+
+        for (std::size_t i = 0; i < windows_.size(); ++i) {
+            const auto& w = windows_[i];
+            if (offset >= w->offset && offset + length <= w->offset + w->size) {
+                // Most recently used at the back
+                std::rotate(windows_.begin() + static_cast<std::ptrdiff_t>(i),
+                            windows_.begin() + static_cast<std::ptrdiff_t>(i) + 1, windows_.end());
+                return slice(windows_.back(), offset, length);
+            }
+        }
+
+        const std::size_t g = Backend::granularity();
+        std::uint64_t start = offset / window_size_ * window_size_;
+        std::uint64_t end = start + window_size_;
+        if (offset + length > end) {
+            start = offset / g * g;
+            end = (offset + length + g - 1) / g * g;
+        }
+        end = std::min(end, size_);
+
+        auto w = std::make_shared<Window>();
+        w->offset = start;
+        w->size = static_cast<std::size_t>(end - start);
+        if (Backend::map_view(backend_, start, w->size, &w->data))
+            return {};
+        if (windows_.size() >= window_count_)
+            windows_.erase(windows_.begin());
+        windows_.push_back(w);
+        return slice(w, offset, length);
+    }
+
+    // Copies out up to out.size() bytes, crossing windows as needed.
+    // Returns the count copied; short only at the end of the file or when
+    // a window cannot be mapped.
+    std::size_t read(std::uint64_t offset, std::span<std::uint8_t> out)
+    {
+        const std::size_t window = window_size();
+        std::size_t done = 0;
+        while (done < out.size()) {
+            const std::uint64_t at = offset + done;
+            // Stay inside the window `at` falls in, so this never maps a
+            // straddling window
+            const std::uint64_t window_end = (at / window + 1) * window;
+            const std::size_t want = static_cast<std::size_t>(
+                std::min<std::uint64_t>(out.size() - done, window_end - at));
+            const auto piece = view(at, want);
+            if (piece.bytes.empty())
+                break;
+            std::memcpy(out.data() + done, piece.bytes.data(), piece.bytes.size());
+            done += piece.bytes.size();
+        }
+        return done;
+    }
+
+private:
+    struct Window {
+        std::uint64_t offset = 0;
+        std::size_t size = 0;
+        const void* data = nullptr;
+
+        ~Window() { (void)Backend::unmap_view(data, size); }
+    };
+
+    static MappedBytes slice(const std::shared_ptr<Window>& w, std::uint64_t offset, std::size_t length)
+    {
+        const auto* base = static_cast<const std::uint8_t*>(w->data);
+        return MappedBytes{{base + (offset - w->offset), length}, w};
+    }
+
+    mutable std::mutex mutex_;
+    Backend backend_{};
+    std::uint64_t size_ = 0;
+    std::size_t window_size_ = default_window_size;
+    std::size_t window_count_ = default_window_count;
+    std::vector<std::shared_ptr<Window>> windows_;      // least recently used first
+};
+
+} // namespace peelf
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "peelf/peelf.hpp"
+#include "minidump/minidump_structures.hpp"
+#include "mapping/windowed_mapping.hpp"
+#include "pe/pe_version_info.hpp"
+
+namespace peelf {
+
+struct MinidumpStream {
+    std::uint32_t type = 0;             // MINIDUMP_STREAM_TYPE
+    std::uint32_t size = 0;
+    std::uint32_t offset = 0;
+};
+
+// Process memory at va, stored at offset in the dump
+struct MinidumpMemoryRange {
+    std::uint64_t va = 0;
+    std::uint64_t size = 0;
+    std::uint64_t offset = 0;
+};
+
+// PDB the module was linked against, from its CodeView record
+struct MinidumpCodeView {
+    std::array<std::uint8_t, 16> guid{};
+    std::uint32_t age = 0;
+    std::string pdb_path;
+};
+
+struct MinidumpModule {
+    std::uint64_t base = 0;
+    std::uint32_t size = 0;             // SizeOfImage
+    std::uint32_t checksum = 0;
+    std::uint32_t timestamp = 0;
+    std::string path;
+    std::optional<PeFixedFileInfo> version;
+    std::optional<MinidumpCodeView> codeview;
+};
+
+struct MinidumpThread {
+    std::uint32_t tid = 0;
+    std::uint32_t suspend_count = 0;
+    std::uint32_t priority_class = 0;
+    std::uint32_t priority = 0;
+    std::uint64_t teb = 0;
+    std::uint64_t stack_start = 0;
+    std::uint64_t stack_size = 0;
+    MINIDUMP_LOCATION_DESCRIPTOR_ context{};
+    std::optional<std::uint64_t> pc;    // when the architecture's CONTEXT is known
+    std::optional<std::uint64_t> sp;
+};
+
+struct MinidumpException {
+    std::uint32_t thread_id = 0;
+    std::uint32_t code = 0;             // e.g. 0xC0000005 for an access violation
+    std::uint32_t flags = 0;
+    std::uint64_t address = 0;
+    std::uint64_t chained_record = 0;   // address of a nested EXCEPTION_RECORD, or 0
+    std::vector<std::uint64_t> parameters;
+    MINIDUMP_LOCATION_DESCRIPTOR_ context{};
+};
+
+struct MinidumpSystemInfo {
+    std::uint16_t architecture = 0;     // PROCESSOR_ARCHITECTURE_*
+    std::uint16_t processor_level = 0;
+    std::uint16_t processor_revision = 0;
+    std::uint8_t processors = 0;
+    std::uint8_t product_type = 0;
+    std::uint32_t major_version = 0;
+    std::uint32_t minor_version = 0;
+    std::uint32_t build_number = 0;
+    std::uint32_t platform_id = 0;
+    std::string service_pack;
+};
+
+[[nodiscard]] const char* minidump_stream_name(std::uint32_t type);
+
+// A Windows MINIDUMP file. Like ElfCore, open() reads the stream directory
+// and the lists once through a few mapped windows and leaves process
+// memory in the file, so full-memory dumps of tens of GB cost no more
+// than their metadata. parse() works on bytes already in memory. Copies
+// share the underlying mapping.
+//
+// Memory from MemoryList and Memory64List is merged into one range index
+// sorted by address. Modules that were dumped whole can be read through
+// module_image() and handed to PeView::parse with PeLayout::Image.
+class Minidump {
+public:
+    using Mapping = WindowedFileMapping<NativeFileMappingBackend>;
+
+    // Streams are read whole; a list bigger than this is refused
+    static constexpr std::uint64_t max_stream_bytes = 256u << 20;
+
+    static std::expected<Minidump, Error> parse(std::span<const std::uint8_t> file);
+    static std::expected<Minidump, Error> open(const std::filesystem::path& path,
+                                               std::size_t window_size = Mapping::default_window_size);
+
+    [[nodiscard]] std::uint64_t file_size() const { return file_size_; }
+    [[nodiscard]] std::uint32_t timestamp() const { return timestamp_; }
+    [[nodiscard]] std::uint64_t flags() const { return flags_; }   // MINIDUMP_TYPE
+    [[nodiscard]] bool has_full_memory() const { return full_memory_; }
+
+    [[nodiscard]] std::span<const MinidumpStream> streams() const { return streams_; }
+    [[nodiscard]] const MinidumpStream* find_stream(std::uint32_t type) const;
+
+    [[nodiscard]] const std::optional<MinidumpSystemInfo>& system_info() const { return system_; }
+    [[nodiscard]] std::span<const MinidumpModule> modules() const { return modules_; }     // by base
+    [[nodiscard]] std::span<const MinidumpThread> threads() const { return threads_; }
+    [[nodiscard]] const std::optional<MinidumpException>& exception() const { return exception_; }
+    [[nodiscard]] std::span<const MinidumpMemoryRange> memory_ranges() const { return ranges_; }   // by va
+
+    [[nodiscard]] const MinidumpMemoryRange* range_at(std::uint64_t va) const;
+    [[nodiscard]] const MinidumpModule* module_at(std::uint64_t va) const;
+
+    // Copies process memory at va, continuing into adjacent ranges.
+    // Returns the count copied; short where memory was not dumped.
+    std::size_t read_memory(std::uint64_t va, std::span<std::uint8_t> out) const;
+
+    // Copies raw file bytes; short only at the end of the file
+    std::size_t read_file(std::uint64_t offset, std::span<std::uint8_t> out) const;
+
+    // [va, va + size) without copying when the ranges covering it are
+    // adjacent both in memory and in the file, as full-memory dumps write
+    // them; empty otherwise
+    [[nodiscard]] MappedBytes memory_view(std::uint64_t va, std::size_t size) const;
+
+    // The module's SizeOfImage bytes in loaded layout: a view when they are
+    // contiguous in the file, otherwise a copy with undumped pages left
+    // zero. Empty when the module's headers were not dumped.
+    [[nodiscard]] MappedBytes module_image(const MinidumpModule& module) const;
+
+private:
+    std::expected<void, Error> load();
+    std::expected<std::vector<std::uint8_t>, Error> read_stream(const MinidumpStream& s) const;
+    std::string read_string(std::uint32_t offset) const;
+    std::optional<MinidumpCodeView> read_codeview(const MINIDUMP_LOCATION_DESCRIPTOR_& loc) const;
+    void read_context_pointers(MinidumpThread& t) const;
+
+    std::expected<void, Error> load_system_info(std::span<const std::uint8_t> data);
+    std::expected<void, Error> load_modules(std::span<const std::uint8_t> data);
+    std::expected<void, Error> load_threads(std::span<const std::uint8_t> data);
+    std::expected<void, Error> load_exception(std::span<const std::uint8_t> data);
+    std::expected<void, Error> load_memory_list(std::span<const std::uint8_t> data);
+    std::expected<void, Error> load_memory64_list(std::span<const std::uint8_t> data);
+
+    std::span<const std::uint8_t> bytes_;
+    std::shared_ptr<Mapping> mapping_;
+    std::uint64_t file_size_ = 0;
+    std::uint32_t timestamp_ = 0;
+    std::uint64_t flags_ = 0;
+    bool full_memory_ = false;
+
+    std::vector<MinidumpStream> streams_;
+    std::optional<MinidumpSystemInfo> system_;
+    std::vector<MinidumpModule> modules_;
+    std::vector<MinidumpThread> threads_;
+    std::optional<MinidumpException> exception_;
+    std::vector<MinidumpMemoryRange> ranges_;
+};
+
+} // namespace peelf
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "pe/pe_structures.hpp"
+
+namespace peelf {
+
+// 'MDMP'; the low word of Version is the format, the high word the
+// dbghelp build that wrote the dump
+static constexpr std::uint32_t MINIDUMP_SIGNATURE = 0x504D444D;
+static constexpr std::uint16_t MINIDUMP_VERSION   = 0xA793;
+
+// MINIDUMP_STREAM_TYPE
+static constexpr std::uint32_t UnusedStream             = 0;
+static constexpr std::uint32_t ThreadListStream         = 3;
+static constexpr std::uint32_t ModuleListStream         = 4;
+static constexpr std::uint32_t MemoryListStream         = 5;
+static constexpr std::uint32_t ExceptionStream          = 6;
+static constexpr std::uint32_t SystemInfoStream         = 7;
+static constexpr std::uint32_t ThreadExListStream       = 8;
+static constexpr std::uint32_t Memory64ListStream       = 9;
+static constexpr std::uint32_t CommentStreamA           = 10;
+static constexpr std::uint32_t CommentStreamW           = 11;
+static constexpr std::uint32_t HandleDataStream         = 12;
+static constexpr std::uint32_t FunctionTableStream      = 13;
+static constexpr std::uint32_t UnloadedModuleListStream = 14;
+static constexpr std::uint32_t MiscInfoStream           = 15;
+static constexpr std::uint32_t MemoryInfoListStream     = 16;
+static constexpr std::uint32_t ThreadInfoListStream     = 17;
+static constexpr std::uint32_t HandleOperationListStream = 18;
+static constexpr std::uint32_t TokenStream              = 19;
+static constexpr std::uint32_t SystemMemoryInfoStream   = 21;
+static constexpr std::uint32_t ProcessVmCountersStream  = 22;
+
+// MINIDUMP_TYPE flags in the header
+static constexpr std::uint64_t MiniDumpWithFullMemory     = 0x00000002;
+static constexpr std::uint64_t MiniDumpWithHandleData     = 0x00000004;
+static constexpr std::uint64_t MiniDumpWithUnloadedModules = 0x00000020;
+static constexpr std::uint64_t MiniDumpWithFullMemoryInfo = 0x00000800;
+static constexpr std::uint64_t MiniDumpWithThreadInfo     = 0x00001000;
+
+// MINIDUMP_SYSTEM_INFO::ProcessorArchitecture
+static constexpr std::uint16_t PROCESSOR_ARCHITECTURE_INTEL = 0;
+static constexpr std::uint16_t PROCESSOR_ARCHITECTURE_ARM   = 5;
+static constexpr std::uint16_t PROCESSOR_ARCHITECTURE_IA64  = 6;
+static constexpr std::uint16_t PROCESSOR_ARCHITECTURE_AMD64 = 9;
+static constexpr std::uint16_t PROCESSOR_ARCHITECTURE_ARM64 = 12;
+
+// CodeView record of a module ('RSDS', PDB 7.0)
+static constexpr std::uint32_t CV_SIGNATURE_RSDS = 0x53445352;
+
+// Offsets of the stack and instruction pointers in each CONTEXT flavour
+static constexpr std::size_t CONTEXT_AMD64_RSP = 0x98;
+static constexpr std::size_t CONTEXT_AMD64_RIP = 0xF8;
+static constexpr std::size_t CONTEXT_X86_EIP   = 0xB8;
+static constexpr std::size_t CONTEXT_X86_ESP   = 0xC4;
+static constexpr std::size_t CONTEXT_ARM_SP    = 0x38;
+static constexpr std::size_t CONTEXT_ARM_PC    = 0x40;
+static constexpr std::size_t CONTEXT_ARM64_SP  = 0x100;
+static constexpr std::size_t CONTEXT_ARM64_PC  = 0x108;
+
+static constexpr std::size_t EXCEPTION_MAXIMUM_PARAMETERS = 15;
+
+// dbghelp packs these to 4 bytes, so 64-bit fields may be misaligned
+#pragma pack(push, 4)
+struct MINIDUMP_HEADER_ {
+    std::uint32_t Signature;            // MINIDUMP_SIGNATURE
+    std::uint32_t Version;              // MINIDUMP_VERSION in the low word
+    std::uint32_t NumberOfStreams;
+    std::uint32_t StreamDirectoryRva;   // File offset of the MINIDUMP_DIRECTORY array
+    std::uint32_t CheckSum;
+    std::uint32_t TimeDateStamp;        // Seconds since 1970-01-01 00:00:00
+    std::uint64_t Flags;                // MINIDUMP_TYPE
+};
+
+// "Rva" is a file offset throughout the format
+struct MINIDUMP_LOCATION_DESCRIPTOR_ {
+    std::uint32_t DataSize;
+    std::uint32_t Rva;
+};
+
+struct MINIDUMP_DIRECTORY_ {
+    std::uint32_t StreamType;           // MINIDUMP_STREAM_TYPE
+    MINIDUMP_LOCATION_DESCRIPTOR_ Location;
+};
+
+struct MINIDUMP_MEMORY_DESCRIPTOR_ {
+    std::uint64_t StartOfMemoryRange;
+    MINIDUMP_LOCATION_DESCRIPTOR_ Memory;
+};
+
+// Memory64List: ranges are stored back to back from BaseRva, in list order
+struct MINIDUMP_MEMORY_DESCRIPTOR64_ {
+    std::uint64_t StartOfMemoryRange;
+    std::uint64_t DataSize;
+};
+
+struct MINIDUMP_MEMORY64_LIST_ {
+    std::uint64_t NumberOfMemoryRanges;
+    std::uint64_t BaseRva;
+    // MINIDUMP_MEMORY_DESCRIPTOR64_ MemoryRanges[]
+};
+
+struct MINIDUMP_THREAD_ {
+    std::uint32_t ThreadId;
+    std::uint32_t SuspendCount;
+    std::uint32_t PriorityClass;
+    std::uint32_t Priority;
+    std::uint64_t Teb;
+    MINIDUMP_MEMORY_DESCRIPTOR_ Stack;
+    MINIDUMP_LOCATION_DESCRIPTOR_ ThreadContext;    // CONTEXT of the architecture
+};
+
+struct MINIDUMP_MODULE_ {
+    std::uint64_t BaseOfImage;
+    std::uint32_t SizeOfImage;
+    std::uint32_t CheckSum;
+    std::uint32_t TimeDateStamp;
+    std::uint32_t ModuleNameRva;        // MINIDUMP_STRING
+    VS_FIXEDFILEINFO_ VersionInfo;
+    MINIDUMP_LOCATION_DESCRIPTOR_ CvRecord;
+    MINIDUMP_LOCATION_DESCRIPTOR_ MiscRecord;
+    std::uint64_t Reserved0;
+    std::uint64_t Reserved1;
+};
+
+struct MINIDUMP_EXCEPTION_ {
+    std::uint32_t ExceptionCode;
+    std::uint32_t ExceptionFlags;
+    std::uint64_t ExceptionRecord;      // Address of a chained EXCEPTION_RECORD
+    std::uint64_t ExceptionAddress;
+    std::uint32_t NumberParameters;
+    std::uint32_t __unusedAlignment;
+    std::uint64_t ExceptionInformation[EXCEPTION_MAXIMUM_PARAMETERS];
+};
+
+struct MINIDUMP_EXCEPTION_STREAM_ {
+    std::uint32_t ThreadId;
+    std::uint32_t __alignment;
+    MINIDUMP_EXCEPTION_ ExceptionRecord;
+    MINIDUMP_LOCATION_DESCRIPTOR_ ThreadContext;
+};
+
+struct MINIDUMP_SYSTEM_INFO_ {
+    std::uint16_t ProcessorArchitecture;    // PROCESSOR_ARCHITECTURE_*
+    std::uint16_t ProcessorLevel;
+    std::uint16_t ProcessorRevision;
+    std::uint8_t  NumberOfProcessors;
+    std::uint8_t  ProductType;          // VER_NT_WORKSTATION, ...
+    std::uint32_t MajorVersion;
+    std::uint32_t MinorVersion;
+    std::uint32_t BuildNumber;
+    std::uint32_t PlatformId;
+    std::uint32_t CSDVersionRva;        // MINIDUMP_STRING, service pack
+    std::uint16_t SuiteMask;
+    std::uint16_t Reserved2;
+    std::uint8_t  Cpu[24];              // CPUID vendor/features or processor features
+};
+#pragma pack(pop)
+
+static_assert(sizeof(MINIDUMP_HEADER_) == 32);
+static_assert(sizeof(MINIDUMP_DIRECTORY_) == 12);
+static_assert(sizeof(MINIDUMP_MEMORY_DESCRIPTOR_) == 16);
+static_assert(sizeof(MINIDUMP_MEMORY_DESCRIPTOR64_) == 16);
+static_assert(sizeof(MINIDUMP_MEMORY64_LIST_) == 16);
+static_assert(sizeof(MINIDUMP_THREAD_) == 48);
+static_assert(sizeof(MINIDUMP_MODULE_) == 108);
+static_assert(sizeof(MINIDUMP_EXCEPTION_) == 152);
+static_assert(sizeof(MINIDUMP_EXCEPTION_STREAM_) == 168);
+static_assert(sizeof(MINIDUMP_SYSTEM_INFO_) == 56);
+
+} // namespace peelf
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string_view>
+
+#include "peelf/peelf.hpp"
+#include "pe/pe_structures.hpp"
+
+namespace peelf {
+
+struct CoffSymbol {
+    std::string_view name;
+    std::uint32_t value = 0;
+    std::int16_t section_number = 0;    // 1-based, or IMAGE_SYM_*
+    std::uint16_t type = 0;
+    std::uint8_t storage_class = 0;     // IMAGE_SYM_CLASS_*
+    std::uint8_t aux_count = 0;
+
+    [[nodiscard]] bool is_external() const {
+        return storage_class == IMAGE_SYM_CLASS_EXTERNAL || storage_class == IMAGE_SYM_CLASS_WEAK_EXTERNAL;
+    }
+    // Undefined externals with a value are commons; those count as defined
+    [[nodiscard]] bool is_defined() const {
+        return section_number != IMAGE_SYM_UNDEFINED || value != 0;
+    }
+    [[nodiscard]] bool is_function() const { return ((type >> 4) & 3) == 2; }
+};
+
+// Zero-copy view over a COFF object file (.obj, or a .lib member): the
+// file header, the section table and the symbol table with its string
+// table. Like PeView, the bytes must outlive the view. Big-object COFF
+// (/bigobj) files are not handled.
+class CoffObject {
+public:
+    static std::expected<CoffObject, Error> parse(std::span<const std::uint8_t> bytes);
+
+    [[nodiscard]] std::span<const std::uint8_t> bytes() const { return bytes_; }
+    [[nodiscard]] const IMAGE_FILE_HEADER_& file_header() const { return header_; }
+    [[nodiscard]] std::uint16_t machine() const { return header_.Machine; }
+
+    [[nodiscard]] std::span<const IMAGE_SECTION_HEADER_> sections() const { return sections_; }
+    // Long names ("/123") are resolved through the string table
+    [[nodiscard]] std::string_view section_name(std::size_t index) const;
+    // Empty for uninitialised data or when out of range
+    [[nodiscard]] std::span<const std::uint8_t> section_data(std::size_t index) const;
+
+    // Raw record count, aux records included; symbol(i) is only meaningful
+    // at indices reached by stepping over each symbol's aux records
+    [[nodiscard]] std::size_t symbol_record_count() const { return symbols_.size(); }
+    [[nodiscard]] CoffSymbol symbol(std::size_t index) const;
+
+    // Calls f(index, symbol) for every symbol, aux records skipped
+    template<typename F>
+    void for_each_symbol(F&& f) const {
+        for (std::size_t i = 0; i < symbols_.size(); i += 1 + std::size_t{symbols_[i].NumberOfAuxSymbols})
+            f(i, symbol(i));
+    }
+
+private:
+    explicit CoffObject(std::span<const std::uint8_t> bytes) : bytes_(bytes) {}
+
+    std::span<const std::uint8_t> bytes_;
+    IMAGE_FILE_HEADER_ header_{};
+    std::span<const IMAGE_SECTION_HEADER_> sections_;
+    std::span<const IMAGE_SYMBOL_> symbols_;
+    std::span<const std::uint8_t> strings_;     // starts with its own u32 size
+};
+
+// Member of a short import library: one imported symbol, no code
+struct CoffImportObject {
+    std::uint16_t machine = 0;
+    std::uint16_t type = 0;             // IMPORT_OBJECT_CODE / DATA / CONST
+    std::uint16_t name_type = 0;        // IMPORT_OBJECT_ORDINAL, or how the name is decorated
+    std::uint16_t ordinal_or_hint = 0;
+    std::string_view symbol;
+    std::string_view dll;
+};
+
+// True when bytes start with an IMPORT_OBJECT_HEADER rather than a COFF
+// file header (both begin with a machine-sized field)
+[[nodiscard]] bool is_import_object(std::span<const std::uint8_t> bytes);
+
+[[nodiscard]] std::expected<CoffImportObject, Error> parse_import_object(std::span<const std::uint8_t> bytes);
+
+} // namespace peelf
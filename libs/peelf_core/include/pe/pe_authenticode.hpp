@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "peelf/peelf.hpp"
+#include "pe/pe_view.hpp"
+
+namespace peelf {
+
+enum class DigestAlgorithm : std::uint8_t {
+    Unknown,
+    Md5,
+    Sha1,
+    Sha256,
+    Sha384,
+    Sha512,
+};
+
+[[nodiscard]] std::string_view to_string(DigestAlgorithm alg);
+
+// One WIN_CERTIFICATE entry from the attribute certificate table
+struct PeCertificate {
+    std::size_t offset = 0;                 // file offset of the WIN_CERTIFICATE header
+    std::uint16_t revision = 0;
+    std::uint16_t type = 0;                 // WIN_CERT_TYPE_*
+    std::span<const std::uint8_t> data;     // bCertificate (PKCS#7 SignedData for type 2)
+};
+
+struct AuthenticodeDigest {
+    DigestAlgorithm algorithm = DigestAlgorithm::Unknown;
+    std::vector<std::uint8_t> digest;
+};
+
+struct FileRange {
+    std::size_t offset = 0;
+    std::size_t size = 0;
+};
+
+// File ranges covered by the Authenticode image hash, in hashing order: the
+// whole file except the optional header CheckSum, the security directory
+// entry and the certificate table itself.
+[[nodiscard]] std::expected<std::vector<FileRange>, Error> authenticode_ranges(const PeView& pe);
+
+// Hashes authenticode_ranges() straight out of the view. Only SHA-1 and
+// SHA-256 are supported.
+[[nodiscard]] std::expected<AuthenticodeDigest, Error>
+compute_authenticode_digest(const PeView& pe, DigestAlgorithm alg);
+
+// Walks the certificate table; empty when the image is not signed
+[[nodiscard]] std::expected<std::vector<PeCertificate>, Error> read_certificates(const PeView& pe);
+
+// Pulls the image digest (SpcIndirectDataContent.messageDigest) out of a
+// PKCS#7 certificate. This only locates the digest; it does not validate
+// the signature or the certificate chain.
+[[nodiscard]] std::expected<AuthenticodeDigest, Error> read_embedded_digest(const PeCertificate& cert);
+
+} // namespace peelf
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "peelf/byte_histogram.hpp"
+#include "pe/pe_view.hpp"
+
+namespace peelf {
+
+struct PeRegionStats {
+    std::uint64_t offset = 0;           // in PeView::bytes()
+    std::uint64_t size = 0;
+    ByteHistogram histogram{};
+    double entropy = 0.0;               // bits per byte
+};
+
+// Byte statistics of the parts of a PE that packed-sample triage looks
+// at. Sections cover their raw data (their mapped range in a mapped
+// image), clipped to the file. Entropy close to 8 in a code or data
+// section usually means compressed or encrypted content.
+struct PeByteStats {
+    PeRegionStats headers;
+    std::vector<PeRegionStats> sections;    // in table order
+    PeRegionStats overlay;                  // past raw_data_end(); empty when there is none
+};
+
+// All regions are counted in one parallel pass; see byte_histograms()
+[[nodiscard]] PeByteStats compute_byte_stats(const PeView& pe, std::size_t threads = 0);
+
+} // namespace peelf
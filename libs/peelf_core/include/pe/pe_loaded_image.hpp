@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+
+#include "peelf/peelf.hpp"
+#include "peelf/work_budget.hpp"
+#include "pe/pe_view.hpp"
+
+namespace peelf {
+
+// What the Windows loader would map for a PE: headers and sections laid
+// out at their RVAs in one SizeOfImage buffer, base relocations applied
+// for a chosen base and ImageBase in the optional header updated to match.
+// Imports are not bound. The result can be diffed byte for byte against
+// module_image() of a minidump taken at the same base.
+//
+// The buffer is private anonymous memory. Nothing is written to the
+// zero-fill parts of the image (uninitialised data, alignment padding,
+// all-zero pages of raw data), so they stay uncommitted until read.
+class PeLoadedImage {
+public:
+    PeLoadedImage() = default;
+    ~PeLoadedImage();
+
+    PeLoadedImage(const PeLoadedImage&) = delete;
+    PeLoadedImage& operator=(const PeLoadedImage&) = delete;
+    PeLoadedImage(PeLoadedImage&& other) noexcept;
+    PeLoadedImage& operator=(PeLoadedImage&& other) noexcept;
+
+    // Sections are copied on up to `threads` threads (0 = one per hardware
+    // thread) when they do not overlap; overlapping sections are copied in
+    // table order so that later ones win, as with the loader. Pass
+    // pe.image_base() to lay the image out without relocating it.
+    static std::expected<PeLoadedImage, Error> build(const PeView& pe, std::uint64_t base,
+                                                     std::size_t threads = 0);
+
+    [[nodiscard]] std::span<const std::uint8_t> bytes() const { return {data_, size_}; }
+    [[nodiscard]] std::uint64_t base() const { return base_; }
+    [[nodiscard]] std::int64_t delta() const { return delta_; }                     // base - preferred ImageBase
+    [[nodiscard]] std::size_t relocations_applied() const { return relocations_; }
+
+    // PeView over the image in PeLayout::Image
+    [[nodiscard]] std::expected<PeView, Error> view(const ParseLimits& limits = {}) const {
+        return PeView::parse(bytes(), limits, PeLayout::Image);
+    }
+
+private:
+    void release() noexcept;
+
+    std::uint8_t* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::uint64_t base_ = 0;
+    std::int64_t delta_ = 0;
+    std::size_t relocations_ = 0;
+};
+
+} // namespace peelf
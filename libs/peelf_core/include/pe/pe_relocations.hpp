@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <span>
+#include <vector>
+
+#include "peelf/peelf.hpp"
+#include "pe/pe_view.hpp"
+
+namespace peelf {
+
+// One IMAGE_BASE_RELOCATION block of the BASERELOC directory. Entries are
+// kept as raw bytes because the table is only WORD-aligned in crafted files.
+struct PeRelocationBlock {
+    std::uint32_t page_rva = 0;
+    std::span<const std::uint8_t> entries;      // (SizeOfBlock - 8) bytes
+
+    [[nodiscard]] std::size_t count() const { return entries.size() / 2; }
+    [[nodiscard]] std::uint16_t entry(std::size_t i) const {
+        std::uint16_t e;
+        std::memcpy(&e, entries.data() + i * 2, sizeof(e));
+        return e;
+    }
+};
+
+struct PeBaseRelocation {
+    std::uint32_t rva = 0;
+    std::uint8_t type = 0;          // IMAGE_REL_BASED_*
+    std::uint16_t param = 0;        // low half of the target for IMAGE_REL_BASED_HIGHADJ
+};
+
+// Blocks in table order. A zero SizeOfBlock ends the table, as it does for
+// the loader; a block that is shorter than its header or runs past the
+// directory is an error.
+[[nodiscard]] std::expected<std::vector<PeRelocationBlock>, Error> read_base_relocation_blocks(const PeView& pe);
+
+// Every entry except IMAGE_REL_BASED_ABSOLUTE padding, in table order
+[[nodiscard]] std::expected<std::vector<PeBaseRelocation>, Error> read_base_relocations(const PeView& pe);
+
+} // namespace peelf
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "pe/pe_view.hpp"
+
+namespace peelf {
+
+enum class PeSectionIssueKind : std::uint8_t {
+    VirtualOverlap,         // RVA range shared with another section
+    RawOverlap,             // raw data shared with another section
+    VirtualGap,             // unmapped RVAs before this section
+    RawGap,                 // file bytes no section or header covers before this section
+    VirtualInHeaders,       // mapped over the headers
+    RawInHeaders,           // raw data inside the headers
+    PastSizeOfImage,        // mapped range ends past SizeOfImage
+    PastEndOfFile,          // raw data ends past the end of the file
+    VirtualMisaligned,      // VirtualAddress not a multiple of SectionAlignment
+    RawMisaligned,          // PointerToRawData or SizeOfRawData not a multiple of FileAlignment
+};
+
+[[nodiscard]] std::string_view to_string(PeSectionIssueKind kind);
+
+struct PeSectionIssue {
+    PeSectionIssueKind kind{};
+    std::uint32_t section = 0;              // index in the section table
+    std::optional<std::uint32_t> other;     // for overlaps: one of the sections overlapped
+    std::uint64_t begin = 0;                // affected RVAs, or file offsets for Raw* / PastEndOfFile
+    std::uint64_t end = 0;
+};
+
+struct PeSectionLayout {
+    std::vector<PeSectionIssue> issues;     // by section, then kind
+    std::uint64_t raw_end = 0;              // end of the headers and all raw data, clipped to the file
+    std::uint64_t overlay_offset = 0;       // data past raw_end (certificates, installers, payloads)
+    std::uint64_t overlay_size = 0;
+};
+
+// End of the headers and of every section's raw data, clipped to the
+// file; where the overlay starts. The whole buffer for a mapped image.
+[[nodiscard]] std::uint64_t raw_data_end(const PeView& pe);
+
+// Checks the section table against the layout rules the loader and the
+// linker follow. Sections are placed in interval trees over their mapped
+// and raw ranges, so the whole check is O(n log n) even for 65535
+// overlapping sections. Each section reports at most one overlap of each
+// kind. Mapped images only get the virtual checks.
+[[nodiscard]] PeSectionLayout analyze_section_layout(const PeView& pe);
+
+} // namespace peelf
@@ -0,0 +1,299 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace peelf {
+
+static constexpr std::uint16_t IMAGE_DOS_SIGNATURE = 0x5A4D;     // 'MZ'
+static constexpr std::uint32_t IMAGE_NT_SIGNATURE  = 0x00004550; // 'PE\0\0'
+
+static constexpr std::uint32_t IMAGE_NUMBEROF_DIRECTORY_ENTRIES = 16;
+
+static constexpr std::uint32_t IMAGE_DIRECTORY_ENTRY_EXPORT         = 0;
+static constexpr std::uint32_t IMAGE_DIRECTORY_ENTRY_IMPORT         = 1;
+static constexpr std::uint32_t IMAGE_DIRECTORY_ENTRY_RESOURCE       = 2;
+static constexpr std::uint32_t IMAGE_DIRECTORY_ENTRY_EXCEPTION      = 3;
+static constexpr std::uint32_t IMAGE_DIRECTORY_ENTRY_SECURITY       = 4;
+static constexpr std::uint32_t IMAGE_DIRECTORY_ENTRY_BASERELOC      = 5;
+static constexpr std::uint32_t IMAGE_DIRECTORY_ENTRY_DEBUG          = 6;
+static constexpr std::uint32_t IMAGE_DIRECTORY_ENTRY_TLS            = 9;
+static constexpr std::uint32_t IMAGE_DIRECTORY_ENTRY_LOAD_CONFIG    = 10;
+static constexpr std::uint32_t IMAGE_DIRECTORY_ENTRY_DELAY_IMPORT   = 13;
+
+static constexpr std::uint16_t IMAGE_FILE_RELOCS_STRIPPED     = 0x0001;
+static constexpr std::uint16_t IMAGE_FILE_LARGE_ADDRESS_AWARE = 0x0020;
+static constexpr std::uint16_t IMAGE_FILE_DLL                 = 0x2000;
+
+// COFF object files (.obj, .lib members)
+static constexpr std::uint16_t IMAGE_FILE_MACHINE_UNKNOWN = 0x0000;
+static constexpr std::uint16_t IMAGE_FILE_MACHINE_I386    = 0x014C;
+static constexpr std::uint16_t IMAGE_FILE_MACHINE_ARMNT   = 0x01C4;
+static constexpr std::uint16_t IMAGE_FILE_MACHINE_AMD64   = 0x8664;
+static constexpr std::uint16_t IMAGE_FILE_MACHINE_ARM64   = 0xAA64;
+static constexpr std::uint16_t IMAGE_FILE_MACHINE_ARM64EC = 0xA641;
+
+static constexpr std::int16_t IMAGE_SYM_UNDEFINED = 0;
+static constexpr std::int16_t IMAGE_SYM_ABSOLUTE  = -1;
+static constexpr std::int16_t IMAGE_SYM_DEBUG     = -2;
+
+static constexpr std::uint8_t IMAGE_SYM_CLASS_EXTERNAL      = 2;
+static constexpr std::uint8_t IMAGE_SYM_CLASS_STATIC        = 3;
+static constexpr std::uint8_t IMAGE_SYM_CLASS_WEAK_EXTERNAL = 105;
+
+// Short import library members (IMPORT_OBJECT_HEADER)
+static constexpr std::uint16_t IMPORT_OBJECT_HDR_SIG2 = 0xFFFF;
+static constexpr std::uint16_t IMPORT_OBJECT_CODE     = 0;
+static constexpr std::uint16_t IMPORT_OBJECT_DATA     = 1;
+static constexpr std::uint16_t IMPORT_OBJECT_CONST    = 2;
+static constexpr std::uint16_t IMPORT_OBJECT_ORDINAL  = 0;     // name type: import by ordinal
+
+// Base relocation entries: type in the top 4 bits, page offset in the rest
+static constexpr std::uint8_t IMAGE_REL_BASED_ABSOLUTE    = 0;    // padding
+static constexpr std::uint8_t IMAGE_REL_BASED_HIGH        = 1;
+static constexpr std::uint8_t IMAGE_REL_BASED_LOW         = 2;
+static constexpr std::uint8_t IMAGE_REL_BASED_HIGHLOW     = 3;
+static constexpr std::uint8_t IMAGE_REL_BASED_HIGHADJ     = 4;    // low half in the next entry
+static constexpr std::uint8_t IMAGE_REL_BASED_ARM_MOV32   = 5;    // MIPS_JMPADDR on MIPS
+static constexpr std::uint8_t IMAGE_REL_BASED_THUMB_MOV32 = 7;
+static constexpr std::uint8_t IMAGE_REL_BASED_DIR64       = 10;
+
+static constexpr std::uint16_t WIN_CERT_REVISION_1_0          = 0x0100;
+static constexpr std::uint16_t WIN_CERT_REVISION_2_0          = 0x0200;
+static constexpr std::uint16_t WIN_CERT_TYPE_X509             = 0x0001;
+static constexpr std::uint16_t WIN_CERT_TYPE_PKCS_SIGNED_DATA = 0x0002;
+
+// data structures (packed)
+#pragma pack(push, 1)
+
+struct IMAGE_DOS_HEADER_ {
+    std::uint16_t e_magic;       // 0x00: Magic number ("MZ" = 0x5A4D)
+    std::uint16_t e_cblp;        // 0x02: Bytes on last page of file
+    std::uint16_t e_cp;          // 0x04: Pages in file
+    std::uint16_t e_crlc;        // 0x06: Relocations
+    std::uint16_t e_cparhdr;     // 0x08: Size of header in paragraphs
+    std::uint16_t e_minalloc;    // 0x0A: Minimum extra paragraphs needed
+    std::uint16_t e_maxalloc;    // 0x0C: Maximum extra paragraphs needed
+    std::uint16_t e_ss;          // 0x0E: Initial (relative) SS value
+    std::uint16_t e_sp;          // 0x10: Initial SP value
+    std::uint16_t e_csum;        // 0x12: Checksum
+    std::uint16_t e_ip;          // 0x14: Initial IP value
+    std::uint16_t e_cs;          // 0x16: Initial (relative) CS value
+    std::uint16_t e_lfarlc;      // 0x18: File address of relocation table
+    std::uint16_t e_ovno;        // 0x1A: Overlay number
+    std::uint16_t e_res[4];      // 0x1C: Reserved words
+    std::uint16_t e_oemid;       // 0x24: OEM identifier
+    std::uint16_t e_oeminfo;     // 0x26: OEM information
+    std::uint16_t e_res2[10];    // 0x28: Reserved words
+    std::int32_t  e_lfanew;      // 0x3C: File address of PE header
+};
+
+struct IMAGE_FILE_HEADER_ {
+    std::uint16_t Machine;              // Target CPU type (e.g., x86, x64, ARM)
+    std::uint16_t NumberOfSections;     // Number of section table entries
+    std::uint32_t TimeDateStamp;        // Seconds since 1970-01-01 00:00:00
+    std::uint32_t PointerToSymbolTable; // File offset to COFF symbol table
+    std::uint32_t NumberOfSymbols;      // Number of COFF symbol entries
+    std::uint16_t SizeOfOptionalHeader; // Size of optional header in bytes
+    std::uint16_t Characteristics;      // File attribute flags
+};
+
+struct IMAGE_DATA_DIRECTORY_ {
+    std::uint32_t VirtualAddress;       // RVA of the table
+    std::uint32_t Size;                 // Size of the table in bytes
+};
+
+struct IMAGE_OPTIONAL_HEADER32_ {
+    std::uint16_t Magic;                       // PE32 (0x10B) or PE32+ (0x20B)
+    std::uint8_t  MajorLinkerVersion;          // Linker major version
+    std::uint8_t  MinorLinkerVersion;          // Linker minor version
+    std::uint32_t SizeOfCode;                  // Sum of all code sections
+    std::uint32_t SizeOfInitializedData;       // Sum of all initialized data sections
+    std::uint32_t SizeOfUninitializedData;     // Sum of all BSS sections
+    std::uint32_t AddressOfEntryPoint;         // RVA of entry point function
+    std::uint32_t BaseOfCode;                  // RVA of code section start
+    std::uint32_t BaseOfData;                  // RVA of data section start (PE32 only)
+    std::uint32_t ImageBase;                   // Preferred load address
+    std::uint32_t SectionAlignment;            // Section alignment in memory (bytes)
+    std::uint32_t FileAlignment;               // Section alignment on disk (bytes)
+    std::uint16_t MajorOperatingSystemVersion; // Required OS major version
+    std::uint16_t MinorOperatingSystemVersion; // Required OS minor version
+    std::uint16_t MajorImageVersion;           // Image major version (user-defined)
+    std::uint16_t MinorImageVersion;           // Image minor version (user-defined)
+    std::uint16_t MajorSubsystemVersion;       // Required subsystem major version
+    std::uint16_t MinorSubsystemVersion;       // Required subsystem minor version
+    std::uint32_t Win32VersionValue;           // Reserved, must be zero
+    std::uint32_t SizeOfImage;                 // Total image size in memory (bytes)
+    std::uint32_t SizeOfHeaders;               // Size of all headers (bytes)
+    std::uint32_t CheckSum;                    // Image checksum (required for drivers)
+    std::uint16_t Subsystem;                   // Target subsystem (GUI, CUI, etc.)
+    std::uint16_t DllCharacteristics;          // Security flags (ASLR, DEP, CFG, etc.)
+    std::uint32_t SizeOfStackReserve;          // Stack reserve size (bytes)
+    std::uint32_t SizeOfStackCommit;           // Stack commit size (bytes)
+    std::uint32_t SizeOfHeapReserve;           // Heap reserve size (bytes)
+    std::uint32_t SizeOfHeapCommit;            // Heap commit size (bytes)
+    std::uint32_t LoaderFlags;                 // Reserved, must be zero
+    std::uint32_t NumberOfRvaAndSizes;         // Number of data directory entries
+    IMAGE_DATA_DIRECTORY_ DataDirectory[IMAGE_NUMBEROF_DIRECTORY_ENTRIES];
+};
+
+struct IMAGE_OPTIONAL_HEADER64_ {
+    std::uint16_t Magic;                       // PE32 (0x10B) or PE32+ (0x20B)
+    std::uint8_t  MajorLinkerVersion;          // Linker major version
+    std::uint8_t  MinorLinkerVersion;          // Linker minor version
+    std::uint32_t SizeOfCode;                  // Sum of all code sections
+    std::uint32_t SizeOfInitializedData;       // Sum of all initialized data sections
+    std::uint32_t SizeOfUninitializedData;     // Sum of all BSS sections
+    std::uint32_t AddressOfEntryPoint;         // RVA of entry point function
+    std::uint32_t BaseOfCode;                  // RVA of code section start
+    std::uint64_t ImageBase;                   // Preferred load address
+    std::uint32_t SectionAlignment;            // Section alignment in memory (bytes)
+    std::uint32_t FileAlignment;               // Section alignment on disk (bytes)
+    std::uint16_t MajorOperatingSystemVersion; // Required OS major version
+    std::uint16_t MinorOperatingSystemVersion; // Required OS minor version
+    std::uint16_t MajorImageVersion;           // Image major version (user-defined)
+    std::uint16_t MinorImageVersion;           // Image minor version (user-defined)
+    std::uint16_t MajorSubsystemVersion;       // Required subsystem major version
+    std::uint16_t MinorSubsystemVersion;       // Required subsystem minor version
+    std::uint32_t Win32VersionValue;           // Reserved, must be zero
+    std::uint32_t SizeOfImage;                 // Total image size in memory (bytes)
+    std::uint32_t SizeOfHeaders;               // Size of all headers (bytes)
+    std::uint32_t CheckSum;                    // Image checksum (required for drivers)
+    std::uint16_t Subsystem;                   // Target subsystem (GUI, CUI, etc.)
+    std::uint16_t DllCharacteristics;          // Security flags (ASLR, DEP, CFG, etc.)
+    std::uint64_t SizeOfStackReserve;          // Stack reserve size (bytes)
+    std::uint64_t SizeOfStackCommit;           // Stack commit size (bytes)
+    std::uint64_t SizeOfHeapReserve;           // Heap reserve size (bytes)
+    std::uint64_t SizeOfHeapCommit;            // Heap commit size (bytes)
+    std::uint32_t LoaderFlags;                 // Reserved, must be zero
+    std::uint32_t NumberOfRvaAndSizes;         // Number of data directory entries
+    IMAGE_DATA_DIRECTORY_ DataDirectory[IMAGE_NUMBEROF_DIRECTORY_ENTRIES];
+};
+
+struct IMAGE_SECTION_HEADER_ {
+    char          Name[8];              // Section name (null-padded, not null-terminated if 8 chars)
+    std::uint32_t VirtualSize;          // Size in memory (before padding)
+    std::uint32_t VirtualAddress;       // RVA of section start
+    std::uint32_t SizeOfRawData;        // Size on disk (aligned to FileAlignment)
+    std::uint32_t PointerToRawData;     // File offset to section data
+    std::uint32_t PointerToRelocations; // File offset to relocations (object files)
+    std::uint32_t PointerToLinenumbers; // File offset to line numbers (deprecated)
+    std::uint16_t NumberOfRelocations;  // Number of relocation entries
+    std::uint16_t NumberOfLinenumbers;  // Number of line number entries (deprecated)
+    std::uint32_t Characteristics;      // Section flags (RWX, code, data, etc.)
+};
+
+struct IMAGE_IMPORT_DESCRIPTOR_ {
+    std::uint32_t OriginalFirstThunk;   // RVA to Import Name Table (INT)
+    std::uint32_t TimeDateStamp;        // Timestamp if bound, 0 otherwise
+    std::uint32_t ForwarderChain;       // Index of first forwarder reference
+    std::uint32_t Name;                 // RVA to DLL name string
+    std::uint32_t FirstThunk;           // RVA to Import Address Table (IAT)
+};
+
+struct IMAGE_EXPORT_DIRECTORY_ {
+    std::uint32_t Characteristics;      // Reserved, must be zero
+    std::uint32_t TimeDateStamp;        // Export table creation time
+    std::uint16_t MajorVersion;         // User-defined major version
+    std::uint16_t MinorVersion;         // User-defined minor version
+    std::uint32_t Name;                 // RVA to DLL name string
+    std::uint32_t Base;                 // Starting ordinal number
+    std::uint32_t NumberOfFunctions;    // Number of entries in EAT
+    std::uint32_t NumberOfNames;        // Number of named exports
+    std::uint32_t AddressOfFunctions;   // RVA to Export Address Table (EAT)
+    std::uint32_t AddressOfNames;       // RVA to Export Name Table
+    std::uint32_t AddressOfNameOrdinals;// RVA to ordinal table
+};
+
+struct IMAGE_RESOURCE_DIRECTORY_ {
+    std::uint32_t Characteristics;      // Reserved, must be zero
+    std::uint32_t TimeDateStamp;        // Resource data creation time
+    std::uint16_t MajorVersion;         // User-defined major version
+    std::uint16_t MinorVersion;         // User-defined minor version
+    std::uint16_t NumberOfNamedEntries; // Entries identified by string (come first)
+    std::uint16_t NumberOfIdEntries;    // Entries identified by integer ID (sorted)
+};
+
+struct IMAGE_RESOURCE_DIRECTORY_ENTRY_ {
+    std::uint32_t Name;                 // Integer ID, or string offset when high bit set
+    std::uint32_t OffsetToData;         // Data entry, or subdirectory when high bit set
+};
+
+struct IMAGE_RESOURCE_DATA_ENTRY_ {
+    std::uint32_t OffsetToData;         // RVA of the resource data
+    std::uint32_t Size;                 // Size of the resource data
+    std::uint32_t CodePage;             // Code page used to decode code point values
+    std::uint32_t Reserved;             // Must be zero
+};
+
+struct VS_FIXEDFILEINFO_ {
+    std::uint32_t dwSignature;          // 0xFEEF04BD
+    std::uint32_t dwStrucVersion;       // Structure version
+    std::uint32_t dwFileVersionMS;      // File version, high 32 bits
+    std::uint32_t dwFileVersionLS;      // File version, low 32 bits
+    std::uint32_t dwProductVersionMS;   // Product version, high 32 bits
+    std::uint32_t dwProductVersionLS;   // Product version, low 32 bits
+    std::uint32_t dwFileFlagsMask;      // Valid bits in dwFileFlags
+    std::uint32_t dwFileFlags;          // VS_FF_DEBUG, VS_FF_PRERELEASE, ...
+    std::uint32_t dwFileOS;             // Target operating system
+    std::uint32_t dwFileType;           // VFT_APP, VFT_DLL, ...
+    std::uint32_t dwFileSubtype;        // Driver / font subtype
+    std::uint32_t dwFileDateMS;         // Creation date, high 32 bits
+    std::uint32_t dwFileDateLS;         // Creation date, low 32 bits
+};
+
+// Header of one entry in the attribute certificate table. The table lives
+// at the *file offset* named by the security directory, not at an RVA.
+// Followed by (SizeOfBlock - 8) / 2 WORD entries for the 4 KB page at VirtualAddress
+struct IMAGE_BASE_RELOCATION_ {
+    std::uint32_t VirtualAddress;
+    std::uint32_t SizeOfBlock;          // Including this header
+};
+
+struct WIN_CERTIFICATE_ {
+    std::uint32_t dwLength;             // Length of this entry including the header
+    std::uint16_t wRevision;            // WIN_CERT_REVISION_*
+    std::uint16_t wCertificateType;     // WIN_CERT_TYPE_*
+};
+
+// COFF symbol table record. Aux records share the size and follow their
+// symbol; NumberOfAuxSymbols says how many to skip.
+struct IMAGE_SYMBOL_ {
+    char          Name[8];              // Short name, or 0000 + string table offset
+    std::uint32_t Value;                // Section offset, or size for commons
+    std::int16_t  SectionNumber;        // 1-based section, or IMAGE_SYM_*
+    std::uint16_t Type;                 // Function flag in bits 4-5
+    std::uint8_t  StorageClass;         // IMAGE_SYM_CLASS_*
+    std::uint8_t  NumberOfAuxSymbols;   // Aux records that follow
+};
+
+// Short import library member: header, then "symbol\0dll\0"
+struct IMPORT_OBJECT_HEADER_ {
+    std::uint16_t Sig1;                 // IMAGE_FILE_MACHINE_UNKNOWN
+    std::uint16_t Sig2;                 // IMPORT_OBJECT_HDR_SIG2
+    std::uint16_t Version;              // 0
+    std::uint16_t Machine;              // IMAGE_FILE_MACHINE_*
+    std::uint32_t TimeDateStamp;        // Seconds since 1970-01-01 00:00:00
+    std::uint32_t SizeOfData;           // Bytes of names after the header
+    std::uint16_t OrdinalOrHint;        // Ordinal, or hint into the export table
+    std::uint16_t NameType;             // Bits 0-1 IMPORT_OBJECT_*, bits 2-4 name type
+};
+#pragma pack(pop)
+
+static_assert(sizeof(IMAGE_DOS_HEADER_) == 64);
+static_assert(sizeof(IMAGE_FILE_HEADER_) == 20);
+static_assert(sizeof(IMAGE_OPTIONAL_HEADER32_) == 224);
+static_assert(sizeof(IMAGE_OPTIONAL_HEADER64_) == 240);
+static_assert(sizeof(IMAGE_SECTION_HEADER_) == 40);
+static_assert(sizeof(IMAGE_IMPORT_DESCRIPTOR_) == 20);
+static_assert(sizeof(IMAGE_EXPORT_DIRECTORY_) == 40);
+static_assert(sizeof(IMAGE_RESOURCE_DIRECTORY_) == 16);
+static_assert(sizeof(IMAGE_RESOURCE_DIRECTORY_ENTRY_) == 8);
+static_assert(sizeof(IMAGE_RESOURCE_DATA_ENTRY_) == 16);
+static_assert(sizeof(VS_FIXEDFILEINFO_) == 52);
+static_assert(sizeof(IMAGE_BASE_RELOCATION_) == 8);
+static_assert(sizeof(WIN_CERTIFICATE_) == 8);
+static_assert(sizeof(IMAGE_SYMBOL_) == 18);
+static_assert(sizeof(IMPORT_OBJECT_HEADER_) == 20);
+
+} // namespace peelf
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+
+#include "pe/pe_structures.hpp"
+
+namespace peelf {
+
+    // Compile-time description of a PE image flavour. The parser is
+    // instantiated once per flavour and dispatched on the optional header
+    // magic, so loops over thunks / headers never test bitness per iteration.
+    //
+    // Directories whose layout depends on pointer width (TLS, load config,
+    // delay imports, ...) should be expressed in terms of these members.
+
+    struct Pe32Traits {
+        using optional_header = IMAGE_OPTIONAL_HEADER32_;
+        using thunk_type      = std::uint32_t;
+        using pointer_type    = std::uint32_t;
+
+        static constexpr std::uint16_t magic        = 0x10b;   // IMAGE_NT_OPTIONAL_HDR32_MAGIC
+        static constexpr thunk_type    ordinal_flag = 0x80000000u;
+        static constexpr bool          is_64        = false;
+    };
+
+    struct Pe64Traits {
+        using optional_header = IMAGE_OPTIONAL_HEADER64_;
+        using thunk_type      = std::uint64_t;
+        using pointer_type    = std::uint64_t;
+
+        static constexpr std::uint16_t magic        = 0x20b;   // IMAGE_NT_OPTIONAL_HDR64_MAGIC
+        static constexpr thunk_type    ordinal_flag = 0x8000000000000000ull;
+        static constexpr bool          is_64        = true;
+    };
+
+    // Hint/Name RVA stored in a non-ordinal thunk (bits 0..30)
+    template<typename Traits>
+    constexpr std::uint32_t thunk_hint_name_rva(typename Traits::thunk_type thunk) {
+        return static_cast<std::uint32_t>(thunk & 0x7FFFFFFFu);
+    }
+
+    template<typename Traits>
+    constexpr bool thunk_is_ordinal(typename Traits::thunk_type thunk) {
+        return (thunk & Traits::ordinal_flag) != 0;
+    }
+
+} // namespace peelf
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "peelf/peelf.hpp"
+#include "pe/pe_view.hpp"
+
+namespace peelf {
+
+struct PeFixedFileInfo {
+    std::uint32_t file_version_ms = 0;
+    std::uint32_t file_version_ls = 0;
+    std::uint32_t product_version_ms = 0;
+    std::uint32_t product_version_ls = 0;
+    std::uint32_t file_flags = 0;       // already masked with dwFileFlagsMask
+    std::uint32_t file_os = 0;
+    std::uint32_t file_type = 0;
+    std::uint32_t file_subtype = 0;
+
+    // "major.minor.build.revision"
+    [[nodiscard]] std::string file_version() const;
+    [[nodiscard]] std::string product_version() const;
+};
+
+struct PeVersionString {
+    std::string key;                    // e.g. "CompanyName"
+    std::string value;                  // UTF-8
+};
+
+struct PeVersionInfo {
+    std::optional<PeFixedFileInfo> fixed;
+    std::string string_table;           // StringTable key, e.g. "040904b0"
+    std::vector<PeVersionString> strings;
+
+    // Empty view when the key is not present
+    [[nodiscard]] std::string_view get(std::string_view key) const;
+};
+
+// Targeted RT_VERSION extractor. Follows only the
+// root -> RT_VERSION -> first name -> first language path of the resource
+// directory and decodes VS_VERSIONINFO in place; the rest of the resource
+// tree is never visited, so this is cheap enough for bulk inventory.
+[[nodiscard]] std::expected<PeVersionInfo, Error> read_version_info(const PeView& pe);
+
+} // namespace peelf
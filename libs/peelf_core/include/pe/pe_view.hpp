@@ -0,0 +1,207 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "peelf/peelf.hpp"
+#include "peelf/work_budget.hpp"
+#include "pe/pe_structures.hpp"
+#include "pe/pe_traits.hpp"
+
+namespace peelf {
+
+struct PeImport {
+    std::string_view dll;
+    std::string_view name;          // empty when imported by ordinal
+    std::uint16_t hint = 0;
+    std::uint16_t ordinal = 0;      // valid when by_ordinal
+    bool by_ordinal = false;
+    std::uint32_t iat_rva = 0;      // RVA of the IAT slot
+};
+
+struct PeExport {
+    std::string_view name;          // empty for ordinal-only exports
+    std::uint32_t ordinal = 0;
+    std::uint32_t rva = 0;
+    std::string_view forwarder;     // "DLL.Function" when forwarded
+};
+
+// How the bytes handed to PeView::parse are laid out. File is the on-disk
+// layout, where sections sit at PointerToRawData; Image is the loaded
+// layout found in module dumps and memory captures, where RVA == offset.
+// Auto picks one with PeView::detect_layout.
+enum class PeLayout : std::uint8_t {
+    Auto,
+    File,
+    Image,
+};
+
+// Zero-copy view over a PE image held in memory (usually a FileMapping).
+// Headers are validated once in parse(); everything else is decoded on
+// request and returned as views into the underlying bytes, which must
+// outlive the PeView. Header structs are copied when e_lfanew or
+// SizeOfOptionalHeader leaves them misaligned, so their fields can always
+// be bound to references.
+//
+// All walkers honour the ParseLimits given to parse(). The time budget is
+// per walk: each lazy decode gets the whole budget from when it starts.
+class PeView {
+public:
+    static std::expected<PeView, Error> parse(std::span<const std::uint8_t> bytes,
+                                              const ParseLimits& limits = {},
+                                              PeLayout layout = PeLayout::Auto);
+
+    [[nodiscard]] std::span<const std::uint8_t> bytes() const { return bytes_; }
+    [[nodiscard]] const ParseLimits& limits() const { return limits_; }
+    // A fresh deadline for one walk. Walks are lazy and may run long after
+    // parse(), so each one gets the whole time budget from when it starts.
+    [[nodiscard]] Deadline deadline() const { return Deadline(limits_.time_budget); }
+    // File or Image, never Auto
+    [[nodiscard]] PeLayout layout() const { return layout_; }
+    [[nodiscard]] bool is_mapped_image() const { return layout_ == PeLayout::Image; }
+
+    // -------------------------------------------------------------------
+    // Headers
+    // -------------------------------------------------------------------
+    [[nodiscard]] const IMAGE_DOS_HEADER_& dos_header() const { return dos_header_; }
+    [[nodiscard]] const IMAGE_FILE_HEADER_& file_header() const { return file_header_; }
+
+    [[nodiscard]] bool is_pe32_plus() const { return pe32_plus_; }
+    [[nodiscard]] std::uint16_t machine() const { return file_header().Machine; }
+    [[nodiscard]] std::uint16_t characteristics() const { return file_header().Characteristics; }
+
+    [[nodiscard]] std::uint64_t image_base() const { return image_base_; }
+    [[nodiscard]] std::uint32_t entry_point_rva() const { return entry_point_rva_; }
+    [[nodiscard]] std::uint32_t size_of_image() const { return size_of_image_; }
+    [[nodiscard]] std::uint32_t size_of_headers() const { return size_of_headers_; }
+    [[nodiscard]] std::uint32_t section_alignment() const { return section_alignment_; }
+    [[nodiscard]] std::uint32_t file_alignment() const { return file_alignment_; }
+    [[nodiscard]] std::uint16_t subsystem() const { return subsystem_; }
+    [[nodiscard]] std::uint16_t dll_characteristics() const { return dll_characteristics_; }
+    [[nodiscard]] std::uint32_t checksum() const { return checksum_; }
+
+    // File offsets of interesting header fields
+    [[nodiscard]] std::size_t nt_headers_offset() const { return nt_offset_; }
+    [[nodiscard]] std::size_t optional_header_offset() const { return opt_offset_; }
+    [[nodiscard]] std::size_t checksum_offset() const;
+    [[nodiscard]] std::size_t data_directory_offset(std::size_t index) const;
+
+    // Typed access to the optional header of the given flavour. Only valid
+    // for the flavour reported by is_pe32_plus(); prefer dispatch().
+    template<typename Traits>
+    [[nodiscard]] const typename Traits::optional_header& optional_header() const {
+        return *reinterpret_cast<const typename Traits::optional_header*>(nt_headers_.data() + (opt_offset_ - nt_offset_));
+    }
+
+    // Invokes f(Pe32Traits{}) or f(Pe64Traits{}) once for this image so that
+    // directory walkers can be written once against the traits interface.
+    template<typename F>
+    decltype(auto) dispatch(F&& f) const {
+        if (pe32_plus_)
+            return f(Pe64Traits{});
+        return f(Pe32Traits{});
+    }
+
+    [[nodiscard]] std::span<const IMAGE_DATA_DIRECTORY_> data_directories() const { return directories_; }
+    // nullptr when the directory is absent or empty
+    [[nodiscard]] const IMAGE_DATA_DIRECTORY_* directory(std::size_t index) const;
+
+    [[nodiscard]] std::span<const IMAGE_SECTION_HEADER_> sections() const { return sections_; }
+    [[nodiscard]] static std::string_view section_name(const IMAGE_SECTION_HEADER_& s);
+    [[nodiscard]] const IMAGE_SECTION_HEADER_* section_from_rva(std::uint32_t rva) const;
+    // No two sections share an RVA (counting max(VirtualSize, SizeOfRawData))
+    [[nodiscard]] bool sections_disjoint() const { return sections_disjoint_; }
+
+    // -------------------------------------------------------------------
+    // Address translation / raw access
+    // -------------------------------------------------------------------
+    // Offset into bytes(); follows the section table for the file layout
+    // and is the identity for a mapped image.
+    [[nodiscard]] std::optional<std::size_t> rva_to_offset(std::uint32_t rva) const;
+
+    // Guesses the layout of the parsed bytes. The loader zero-fills the
+    // gap between SizeOfHeaders and the first section, which is where the
+    // file layout keeps that section's raw data; when the gap says nothing
+    // a buffer of at least SizeOfImage bytes is taken to be a dump.
+    [[nodiscard]] PeLayout detect_layout() const;
+
+    // Bytes at [rva, rva + size); empty span when not backed by file data
+    [[nodiscard]] std::span<const std::uint8_t> rva_span(std::uint32_t rva, std::size_t size) const;
+
+    [[nodiscard]] std::string_view cstring_at_offset(std::size_t offset, std::size_t max_len = 4096) const;
+    [[nodiscard]] std::string_view cstring_at_rva(std::uint32_t rva, std::size_t max_len = 4096) const;
+
+    template<typename T>
+    [[nodiscard]] bool read(std::size_t offset, T& out) const {
+        if (offset > bytes_.size() || bytes_.size() - offset < sizeof(T))
+            return false;
+        std::memcpy(&out, bytes_.data() + offset, sizeof(T));
+        return true;
+    }
+
+    template<typename T>
+    [[nodiscard]] bool read_rva(std::uint32_t rva, T& out) const {
+        auto off = rva_to_offset(rva);
+        return off && read(*off, out);
+    }
+
+    // -------------------------------------------------------------------
+    // Directories (decoded lazily on each call)
+    // -------------------------------------------------------------------
+    [[nodiscard]] std::expected<std::vector<PeImport>, Error> imports() const;
+    [[nodiscard]] std::expected<std::vector<PeExport>, Error> exports() const;
+
+    // Same algorithm as CheckSumMappedFile; only meaningful for the file layout
+    [[nodiscard]] std::uint32_t compute_checksum() const;
+    [[nodiscard]] bool checksum_valid() const;
+
+private:
+    explicit PeView(std::span<const std::uint8_t> bytes) : bytes_(bytes) {}
+
+    template<typename Traits>
+    bool parse_optional_header();
+    void build_section_index();
+    // raw, or a copy of it when its address is not a multiple of align
+    std::span<const std::uint8_t> aligned_span(std::span<const std::uint8_t> raw, std::size_t align);
+
+    std::span<const std::uint8_t> bytes_;
+    ParseLimits limits_{};
+    PeLayout layout_ = PeLayout::File;
+
+    // Section indices sorted by VirtualAddress; binary-searchable when the
+    // sections do not overlap, otherwise rva_to_offset falls back to a scan.
+    std::vector<std::uint32_t> va_order_;
+    bool sections_disjoint_ = true;
+
+    alignas(8) IMAGE_DOS_HEADER_ dos_header_{};
+    alignas(8) IMAGE_FILE_HEADER_ file_header_{};
+    // Signature through the optional header, and the section table: views
+    // of bytes_, or of aligned_ when the file placed them at odd offsets
+    std::span<const std::uint8_t> nt_headers_;
+    std::span<const IMAGE_DATA_DIRECTORY_> directories_;
+    std::span<const IMAGE_SECTION_HEADER_> sections_;
+    std::vector<std::shared_ptr<const std::vector<std::uint64_t>>> aligned_;
+
+    std::size_t nt_offset_ = 0;
+    std::size_t opt_offset_ = 0;
+    bool pe32_plus_ = false;
+
+    std::uint64_t image_base_ = 0;
+    std::uint32_t entry_point_rva_ = 0;
+    std::uint32_t size_of_image_ = 0;
+    std::uint32_t size_of_headers_ = 0;
+    std::uint32_t section_alignment_ = 0;
+    std::uint32_t file_alignment_ = 0;
+    std::uint16_t subsystem_ = 0;
+    std::uint16_t dll_characteristics_ = 0;
+    std::uint32_t checksum_ = 0;
+};
+
+} // namespace peelf
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace peelf {
+
+using ByteHistogram = std::array<std::uint64_t, 256>;
+
+// Adds the byte counts of data to out. Counting goes through four
+// partial tables fed from 64-bit loads, so runs of one byte value do not
+// serialise on a single counter (each increment would otherwise wait for
+// the store of the previous one). 32-byte blocks of a single value, the
+// padding that fills most sections, are recognised with one AVX2 or NEON
+// compare and counted at once.
+void accumulate_histogram(std::span<const std::uint8_t> data, ByteHistogram& out);
+
+[[nodiscard]] inline ByteHistogram byte_histogram(std::span<const std::uint8_t> data) {
+    ByteHistogram h{};
+    accumulate_histogram(data, h);
+    return h;
+}
+
+// Histograms of several regions, usually of one file. Regions larger than
+// a chunk are split so that one big section still spreads over up to
+// `threads` threads (0 = one per hardware thread).
+[[nodiscard]] std::vector<ByteHistogram> byte_histograms(std::span<const std::span<const std::uint8_t>> regions,
+                                                         std::size_t threads = 0);
+
+// Shannon entropy in bits per byte, from 0 (one value) to 8 (uniform)
+[[nodiscard]] double shannon_entropy(const ByteHistogram& histogram);
+
+} // namespace peelf
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace peelf {
+
+// Statistics of one cell of a BytePyramid, in fixed point so that a cell
+// costs 10 bytes
+struct ByteWindowStats {
+    static constexpr float entropy_scale = 4096.0f;    // 8 bits per byte = 32768
+    static constexpr float ratio_scale = 65535.0f;
+
+    std::uint16_t entropy = 0;          // mean window entropy under the cell
+    std::uint16_t entropy_max = 0;      // highest window entropy under the cell
+    std::uint16_t zero = 0;             // share of 0x00 bytes
+    std::uint16_t ascii = 0;            // share of printable ASCII, tab, CR and LF
+    std::uint16_t high = 0;             // share of bytes >= 0x80
+
+    [[nodiscard]] float entropy_bits() const { return entropy / entropy_scale; }
+    [[nodiscard]] float entropy_max_bits() const { return entropy_max / entropy_scale; }
+    [[nodiscard]] float zero_ratio() const { return zero / ratio_scale; }
+    [[nodiscard]] float ascii_ratio() const { return ascii / ratio_scale; }
+    [[nodiscard]] float high_ratio() const { return high / ratio_scale; }
+};
+
+// Entropy and byte-class ratios over fixed windows of a buffer, stored as
+// a mip-mapped pyramid. Level 0 has one cell per window; every level above
+// halves the cell count down to a single cell for the whole buffer, so any
+// zoom level can be drawn from at most as many cells as there are pixels.
+//
+// Only level 0 is computed from the bytes (in parallel, a group of windows
+// per task); higher cells average their two children and keep the larger
+// maximum. A zoomed-out cell therefore shows the mean local entropy of its
+// range, and entropy_max still reveals one encrypted window inside it.
+class BytePyramid {
+public:
+    static constexpr std::size_t default_window = 256;
+    static constexpr std::size_t max_window = 65536;
+
+    BytePyramid() = default;
+
+    // window is clamped to [16, max_window]; threads = 0 uses one per
+    // hardware thread
+    [[nodiscard]] static BytePyramid build(std::span<const std::uint8_t> data,
+                                           std::size_t window = default_window, std::size_t threads = 0);
+
+    // Recomputes the windows overlapping [offset, offset + size) after the
+    // bytes there were patched, and their ancestors. data must be the
+    // buffer the pyramid was built from; a buffer of another size is
+    // rebuilt whole.
+    void update(std::span<const std::uint8_t> data, std::uint64_t offset, std::uint64_t size,
+                std::size_t threads = 0);
+
+    [[nodiscard]] bool empty() const { return levels_.empty(); }
+    [[nodiscard]] std::uint64_t data_size() const { return data_size_; }
+    [[nodiscard]] std::size_t window() const { return window_; }
+
+    [[nodiscard]] std::size_t level_count() const { return levels_.size(); }
+    [[nodiscard]] std::span<const ByteWindowStats> level(std::size_t index) const { return levels_[index]; }
+    // Bytes covered by one cell of the level (the last cell may cover fewer)
+    [[nodiscard]] std::uint64_t cell_bytes(std::size_t index) const { return std::uint64_t{window_} << index; }
+
+    // Finest level with at most max_cells cells; level_count() - 1 when
+    // none is that coarse
+    [[nodiscard]] std::size_t level_for(std::size_t max_cells) const;
+
+private:
+    void compute_windows(std::span<const std::uint8_t> data, std::size_t first, std::size_t last,
+                         std::size_t threads);
+    void compute_parents(std::size_t level, std::size_t first, std::size_t last);
+
+    std::uint64_t data_size_ = 0;
+    std::size_t window_ = default_window;
+    std::vector<std::vector<ByteWindowStats>> levels_;
+};
+
+} // namespace peelf
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+
+namespace peelf {
+
+// Forward cursor over a byte range in a known byte order, for the
+// variable-length formats (.eh_frame, DWARF) that cannot be mapped onto
+// packed structs. Reads past the end return zero and latch ok() to false,
+// so a decoder can read a whole record and check once at the end.
+class ByteReader {
+public:
+    ByteReader() = default;
+    ByteReader(std::span<const std::uint8_t> data, bool big_endian, std::size_t pos = 0)
+        : data_(data), pos_(pos), swap_(big_endian != (std::endian::native == std::endian::big)) {
+        if (pos_ > data_.size()) {
+            pos_ = data_.size();
+            ok_ = false;
+        }
+    }
+
+    [[nodiscard]] bool ok() const { return ok_; }
+    [[nodiscard]] bool big_endian() const { return swap_ != (std::endian::native == std::endian::big); }
+    void fail() { ok_ = false; }
+    [[nodiscard]] std::size_t pos() const { return pos_; }
+    [[nodiscard]] std::size_t remaining() const { return data_.size() - pos_; }
+    [[nodiscard]] bool at_end() const { return pos_ == data_.size(); }
+    [[nodiscard]] std::span<const std::uint8_t> data() const { return data_; }
+
+    void seek(std::size_t pos) {
+        if (pos > data_.size()) {
+            ok_ = false;
+            pos = data_.size();
+        }
+        pos_ = pos;
+    }
+
+    void skip(std::size_t n) {
+        if (n > remaining()) {
+            ok_ = false;
+            n = remaining();
+        }
+        pos_ += n;
+    }
+
+    template<std::integral T>
+    T read() {
+        T v{};
+        if (remaining() < sizeof(T)) {
+            ok_ = false;
+            pos_ = data_.size();
+            return v;
+        }
+        std::memcpy(&v, data_.data() + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        if constexpr (sizeof(T) > 1) {
+            if (swap_)
+                v = std::byteswap(v);
+        }
+        return v;
+    }
+
+    std::uint8_t u8() { return read<std::uint8_t>(); }
+    std::uint16_t u16() { return read<std::uint16_t>(); }
+    std::uint32_t u32() { return read<std::uint32_t>(); }
+    std::uint64_t u64() { return read<std::uint64_t>(); }
+
+    // Unsigned integer of 1, 2, 3, 4 or 8 bytes (address and offset sizes,
+    // DWARF 5 strx3 / addrx3)
+    std::uint64_t unsigned_of(std::size_t size) {
+        switch (size) {
+            case 1: return u8();
+            case 2: return u16();
+            case 3: {
+                const auto b = bytes(3);
+                if (b.empty())
+                    return 0;
+                return big_endian() ? (std::uint64_t{b[0]} << 16) | (std::uint64_t{b[1]} << 8) | b[2]
+                                    : (std::uint64_t{b[2]} << 16) | (std::uint64_t{b[1]} << 8) | b[0];
+            }
+            case 4: return u32();
+            case 8: return u64();
+            default: ok_ = false; return 0;
+        }
+    }
+
+    // LEB128. Bits beyond 64 are dropped; a value running off the end
+    // clears ok().
+    std::uint64_t uleb128() {
+        std::uint64_t v = 0;
+        unsigned shift = 0;
+        while (pos_ < data_.size()) {
+            const std::uint8_t b = data_[pos_++];
+            if (shift < 64)
+                v |= std::uint64_t{b & 0x7Fu} << shift;
+            shift += 7;
+            if (!(b & 0x80))
+                return v;
+        }
+        ok_ = false;
+        return v;
+    }
+
+    std::int64_t sleb128() {
+        std::uint64_t v = 0;
+        unsigned shift = 0;
+        while (pos_ < data_.size()) {
+            const std::uint8_t b = data_[pos_++];
+            if (shift < 64)
+                v |= std::uint64_t{b & 0x7Fu} << shift;
+            shift += 7;
+            if (!(b & 0x80)) {
+                if (shift < 64 && (b & 0x40))
+                    v |= ~std::uint64_t{0} << shift;
+                return static_cast<std::int64_t>(v);
+            }
+        }
+        ok_ = false;
+        return static_cast<std::int64_t>(v);
+    }
+
+    // NUL-terminated string; the terminator is consumed but not returned
+    std::string_view cstring() {
+        if (at_end()) {
+            ok_ = false;
+            return {};
+        }
+        const auto* begin = reinterpret_cast<const char*>(data_.data() + pos_);
+        const void* nul = std::memchr(begin, 0, remaining());
+        if (!nul) {
+            ok_ = false;
+            pos_ = data_.size();
+            return {};
+        }
+        const auto len = static_cast<std::size_t>(static_cast<const char*>(nul) - begin);
+        pos_ += len + 1;
+        return {begin, len};
+    }
+
+    std::span<const std::uint8_t> bytes(std::size_t n) {
+        if (n > remaining()) {
+            ok_ = false;
+            pos_ = data_.size();
+            return {};
+        }
+        const auto s = data_.subspan(pos_, n);
+        pos_ += n;
+        return s;
+    }
+
+private:
+    std::span<const std::uint8_t> data_;
+    std::size_t pos_ = 0;
+    bool swap_ = false;
+    bool ok_ = true;
+};
+
+} // namespace peelf
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace peelf {
+
+// Field widths (1, 2, 4 or 8 bytes) of a fixed-size on-disk record, in
+// declaration order. Specialised next to each packed struct that may have
+// to be converted from a foreign byte order:
+//
+//   template<> struct record_layout<Elf64_Sym_> {
+//       static constexpr std::uint8_t fields[] = {4, 1, 1, 2, 8, 8};
+//   };
+template<typename T>
+struct record_layout;
+
+// Converts whole tables of records between byte orders in bulk. The
+// per-record byte permutation is expanded into one shuffle mask per
+// 16-byte lane over a period of lcm(record size, 16) bytes, so the hot
+// loop is a load / shuffle / store with no per-field work. Uses AVX2 or
+// SSSE3 (PSHUFB) or NEON (TBL) when available, a table-driven byte
+// permutation otherwise.
+class RecordSwapper {
+public:
+    explicit RecordSwapper(std::span<const std::uint8_t> field_widths);
+
+    [[nodiscard]] std::size_t record_size() const { return record_size_; }
+
+    // Swaps every complete record of src into dst (dst.size() >= src.size();
+    // the two may alias exactly). Trailing bytes of a partial record are
+    // copied unchanged.
+    void swap(std::span<const std::uint8_t> src, std::span<std::uint8_t> dst) const;
+
+    // Shared swapper for a struct with a record_layout<T> specialisation
+    template<typename T>
+    [[nodiscard]] static const RecordSwapper& for_type() {
+        static_assert(sizeof(T) < 256);
+        static_assert(layout_size<T>() == sizeof(T), "record_layout does not match the struct");
+        static const RecordSwapper swapper(record_layout<T>::fields);
+        return swapper;
+    }
+
+private:
+    template<typename T>
+    static consteval std::size_t layout_size() {
+        std::size_t total = 0;
+        for (auto w : record_layout<T>::fields)
+            total += w;
+        return total;
+    }
+
+    void swap_scalar(const std::uint8_t* src, std::uint8_t* dst, std::size_t begin, std::size_t end) const;
+
+    std::vector<std::uint8_t> perm_;    // output byte i of a record comes from input byte perm_[i]
+    std::vector<std::uint8_t> masks_;   // 2 * period_ lane masks, so a 32-byte load never wraps
+    std::size_t record_size_ = 0;
+    std::size_t period_ = 0;            // lcm(record_size_, 16) / 16
+    bool vectorizable_ = false;         // no field straddles a 16-byte lane
+};
+
+// Table of packed records in host byte order: a view straight into the
+// file for native-endian input, an owned converted copy otherwise. Cheap
+// to copy; copies share the converted buffer.
+template<typename T>
+class NativeTable {
+    static_assert(alignof(T) == 1, "records must be packed structs");
+
+public:
+    NativeTable() = default;
+
+    [[nodiscard]] static NativeTable view(std::span<const std::uint8_t> raw) {
+        NativeTable t;
+        t.items_ = {reinterpret_cast<const T*>(raw.data()), raw.size() / sizeof(T)};
+        return t;
+    }
+
+    [[nodiscard]] static NativeTable swapped(std::span<const std::uint8_t> raw) {
+        const std::size_t bytes = raw.size() - raw.size() % sizeof(T);
+        auto buf = std::make_shared<std::vector<std::uint8_t>>(bytes);
+        RecordSwapper::for_type<T>().swap(raw.first(bytes), *buf);
+        NativeTable t;
+        t.items_ = {reinterpret_cast<const T*>(buf->data()), bytes / sizeof(T)};
+        t.owned_ = std::move(buf);
+        return t;
+    }
+
+    [[nodiscard]] std::span<const T> span() const { return items_; }
+    [[nodiscard]] std::size_t size() const { return items_.size(); }
+    [[nodiscard]] bool empty() const { return items_.empty(); }
+    [[nodiscard]] const T& operator[](std::size_t i) const { return items_[i]; }
+    [[nodiscard]] auto begin() const { return items_.begin(); }
+    [[nodiscard]] auto end() const { return items_.end(); }
+
+private:
+    std::span<const T> items_;
+    std::shared_ptr<const std::vector<std::uint8_t>> owned_;
+};
+
+} // namespace peelf
@@ -0,0 +1,18 @@
+#pragma once
+
+namespace peelf {
+
+// Instruction-set extensions usable by the optimised kernels. Detected once
+// (CPUID plus OS support for the wider register files) and cached.
+struct CpuFeatures {
+    bool ssse3 = false;
+    bool sse41 = false;
+    bool avx2 = false;
+    bool sha = false;       // SHA-NI (SHA-1 / SHA-256)
+    bool pclmul = false;    // carry-less multiply (CRC-32 folding)
+    bool neon = false;
+};
+
+[[nodiscard]] const CpuFeatures& cpu_features();
+
+} // namespace peelf
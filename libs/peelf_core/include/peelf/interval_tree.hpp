@@ -0,0 +1,90 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace peelf {
+
+// Static interval tree over half-open [begin, end) ranges. Intervals are
+// kept sorted by begin in one array that doubles as an implicit balanced
+// tree (each subrange is rooted at its middle element), augmented with the
+// largest end in every subtree. Building is O(n log n); a query costs
+// O(log n + k) for k hits, and the visitor can stop it early.
+//
+// Empty intervals are stored but never reported.
+template<typename T>
+class IntervalTree {
+public:
+    struct Interval {
+        std::uint64_t begin = 0;
+        std::uint64_t end = 0;
+        T value{};
+    };
+
+    IntervalTree() = default;
+
+    explicit IntervalTree(std::vector<Interval> intervals) : items_(std::move(intervals)) {
+        std::stable_sort(items_.begin(), items_.end(), [](const Interval& a, const Interval& b) {
+            return a.begin < b.begin;
+        });
+        max_end_.resize(items_.size());
+        build(0, items_.size());
+    }
+
+    [[nodiscard]] std::size_t size() const { return items_.size(); }
+    [[nodiscard]] bool empty() const { return items_.empty(); }
+
+    // Sorted by begin; ties keep their input order
+    [[nodiscard]] std::span<const Interval> intervals() const { return items_; }
+
+    // Calls f(interval) for each interval overlapping [begin, end), in
+    // begin order, until f returns false. Returns false when stopped.
+    template<typename F>
+    bool overlapping(std::uint64_t begin, std::uint64_t end, F&& f) const {
+        if (begin >= end)
+            return true;
+        return visit(0, items_.size(), begin, end, f);
+    }
+
+    template<typename F>
+    bool containing(std::uint64_t point, F&& f) const {
+        return point == UINT64_MAX || overlapping(point, point + 1, std::forward<F>(f));
+    }
+
+private:
+    std::uint64_t build(std::size_t lo, std::size_t hi) {
+        if (lo >= hi)
+            return 0;
+        const std::size_t mid = lo + (hi - lo) / 2;
+        max_end_[mid] = std::max({items_[mid].end, build(lo, mid), build(mid + 1, hi)});
+        return max_end_[mid];
+    }
+
+    template<typename F>
+    bool visit(std::size_t lo, std::size_t hi, std::uint64_t begin, std::uint64_t end, F& f) const {
+        while (lo < hi) {
+            const std::size_t mid = lo + (hi - lo) / 2;
+            // Nothing in this subtree reaches begin
+            if (max_end_[mid] <= begin)
+                return true;
+            if (!visit(lo, mid, begin, end, f))
+                return false;
+            // Neither mid nor anything after it starts before end
+            if (items_[mid].begin >= end)
+                return true;
+            if (items_[mid].end > begin && items_[mid].begin < items_[mid].end && !f(items_[mid]))
+                return false;
+            lo = mid + 1;
+        }
+        return true;
+    }
+
+    std::vector<Interval> items_;
+    std::vector<std::uint64_t> max_end_;
+};
+
+} // namespace peelf
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace peelf {
+
+// Thread-safe least-recently-used cache of shared, immutable values. Every
+// entry carries a caller-defined weight (usually its size in bytes); the
+// oldest entries are dropped once the total exceeds the capacity. Values
+// are handed out as shared_ptr, so an evicted entry stays alive for as
+// long as a reader still holds it.
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+class LruCache {
+public:
+    explicit LruCache(std::size_t capacity) : capacity_(capacity) {}
+
+    LruCache(const LruCache&) = delete;
+    LruCache& operator=(const LruCache&) = delete;
+
+    [[nodiscard]] std::shared_ptr<const Value> get(const Key& key) {
+        std::lock_guard lock(mutex_);
+        auto it = map_.find(key);
+        if (it == map_.end()) {
+            ++misses_;
+            return nullptr;
+        }
+        ++hits_;
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return it->second->value;
+    }
+
+    // Inserts or replaces. A value heavier than the whole capacity is
+    // still stored, alone, so that the caller's next lookup hits.
+    void put(const Key& key, std::shared_ptr<const Value> value, std::size_t weight) {
+        std::lock_guard lock(mutex_);
+        if (auto it = map_.find(key); it != map_.end()) {
+            weight_ -= it->second->weight;
+            entries_.erase(it->second);
+            map_.erase(it);
+        }
+        entries_.push_front(Entry{key, std::move(value), weight});
+        map_.emplace(key, entries_.begin());
+        weight_ += weight;
+        while (weight_ > capacity_ && entries_.size() > 1) {
+            const Entry& last = entries_.back();
+            weight_ -= last.weight;
+            map_.erase(last.key);
+            entries_.pop_back();
+        }
+    }
+
+    void clear() {
+        std::lock_guard lock(mutex_);
+        entries_.clear();
+        map_.clear();
+        weight_ = 0;
+    }
+
+    [[nodiscard]] std::size_t capacity() const { return capacity_; }
+    [[nodiscard]] std::size_t size() const { std::lock_guard lock(mutex_); return entries_.size(); }
+    [[nodiscard]] std::size_t weight() const { std::lock_guard lock(mutex_); return weight_; }
+    [[nodiscard]] std::size_t hits() const { std::lock_guard lock(mutex_); return hits_; }
+    [[nodiscard]] std::size_t misses() const { std::lock_guard lock(mutex_); return misses_; }
+
+private:
+    struct Entry {
+        Key key;
+        std::shared_ptr<const Value> value;
+        std::size_t weight;
+    };
+
+    mutable std::mutex mutex_;
+    std::list<Entry> entries_;          // most recently used first
+    std::unordered_map<Key, typename std::list<Entry>::iterator, Hash> map_;
+    std::size_t capacity_;
+    std::size_t weight_ = 0;
+    std::size_t hits_ = 0;
+    std::size_t misses_ = 0;
+};
+
+} // namespace peelf
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace peelf {
+
+// Worker count to use when the caller passes 0
+[[nodiscard]] inline std::size_t default_thread_count() {
+    return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+}
+
+// Runs f(i) for every i in [0, count) on up to `threads` threads, the
+// calling thread included (0 = one per hardware thread). Indices are
+// handed out in chunks through a shared counter, so uneven items (small
+// and huge files in one batch) balance themselves. f must not throw;
+// library code reports errors through std::expected instead.
+template<typename F>
+void parallel_for(std::size_t count, F&& f, std::size_t threads = 0, std::size_t chunk = 1) {
+    if (count == 0)
+        return;
+    if (threads == 0)
+        threads = default_thread_count();
+    chunk = std::max<std::size_t>(chunk, 1);
+    threads = std::min(threads, (count + chunk - 1) / chunk);
+
+    std::atomic<std::size_t> next{0};
+    const auto worker = [&] {
+        for (;;) {
+            const std::size_t begin = next.fetch_add(chunk, std::memory_order_relaxed);
+            if (begin >= count)
+                return;
+            const std::size_t end = std::min(count, begin + chunk);
+            for (std::size_t i = begin; i < end; ++i)
+                f(i);
+        }
+    };
+
+    std::vector<std::jthread> pool;
+    pool.reserve(threads - 1);
+    for (std::size_t t = 1; t < threads; ++t)
+        pool.emplace_back(worker);
+    worker();
+}
+
+} // namespace peelf
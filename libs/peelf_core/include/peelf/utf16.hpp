@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace peelf {
+
+// UTF-16LE, up to the first NUL, to UTF-8. Unpaired surrogates are
+// encoded as they stand.
+[[nodiscard]] std::string utf16_to_utf8(std::span<const std::uint8_t> s);
+
+} // namespace peelf
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace peelf {
+
+// Upper bounds on the work a single file may cause. The defaults are far
+// above anything produced by a real toolchain; they exist so that crafted
+// inputs fail fast instead of stalling a scanning worker.
+struct ParseLimits {
+    std::size_t max_import_descriptors = 4096;
+    std::size_t max_thunks_per_descriptor = 65536;
+    std::size_t max_total_imports = 1u << 20;
+    std::size_t max_exports = 1u << 20;
+    std::size_t max_table_entries = 1u << 24;   // generic cap for other walkers
+    std::chrono::milliseconds time_budget{2000}; // per walk; zero disables the deadline
+
+    [[nodiscard]] static ParseLimits unlimited() {
+        ParseLimits l;
+        l.max_import_descriptors = SIZE_MAX;
+        l.max_thunks_per_descriptor = SIZE_MAX;
+        l.max_total_imports = SIZE_MAX;
+        l.max_exports = SIZE_MAX;
+        l.max_table_entries = SIZE_MAX;
+        l.time_budget = std::chrono::milliseconds::zero();
+        return l;
+    }
+};
+
+// Time limit for one walk over a file; arm a new one per walk rather than
+// copying one across walks, or the budget is spent before the walk starts.
+// Reading the clock is cheap but not free, so expired() only does it every
+// 1024 calls.
+class Deadline {
+public:
+    using clock = std::chrono::steady_clock;
+
+    Deadline() = default;
+    explicit Deadline(std::chrono::milliseconds budget) {
+        if (budget.count() > 0) {
+            at_ = clock::now() + budget;
+            armed_ = true;
+        }
+    }
+
+    [[nodiscard]] bool expired() {
+        if (!armed_)
+            return false;
+        if ((++ticks_ & 1023u) != 0)
+            return false;
+        return clock::now() >= at_;
+    }
+
+    [[nodiscard]] bool expired_now() const {
+        return armed_ && clock::now() >= at_;
+    }
+
+private:
+    clock::time_point at_{};
+    std::uint32_t ticks_ = 0;
+    bool armed_ = false;
+};
+
+} // namespace peelf
@@ -0,0 +1,391 @@
+#include "archive/ar_archive.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "elf/elf_symbols.hpp"
+#include "elf/elf_view.hpp"
+#include "pe/coff_object.hpp"
+#include "peelf/byte_reader.hpp"
+#include "peelf/parallel.hpp"
+
+namespace peelf {
+
+namespace {
+
+constexpr std::string_view ar_magic = "!<arch>\n";
+constexpr std::string_view thin_magic = "!<thin>\n";
+
+#pragma pack(push, 1)
+struct ar_header_ {
+    char name[16];
+    char mtime[12];
+    char uid[6];
+    char gid[6];
+    char mode[8];
+    char size[10];
+    char fmag[2];               // "`\n"
+};
+#pragma pack(pop)
+static_assert(sizeof(ar_header_) == 60);
+
+std::string_view field(const char* f, std::size_t n) {
+    std::string_view s(f, n);
+    const auto end = s.find_last_not_of(' ');
+    return end == std::string_view::npos ? std::string_view{} : s.substr(0, end + 1);
+}
+
+// Header numbers are space-padded ASCII; empty fields read as zero
+std::optional<std::uint64_t> parse_number(std::string_view s, unsigned base) {
+    std::uint64_t v = 0;
+    for (char c : s) {
+        const unsigned digit = static_cast<unsigned>(c - '0');
+        if (c < '0' || digit >= base || v > (UINT64_MAX - digit) / base)
+            return std::nullopt;
+        v = v * base + digit;
+    }
+    return v;
+}
+
+// GNU ends long names with "/\n", MSVC with NUL
+std::string_view long_name(std::span<const std::uint8_t> table, std::size_t offset) {
+    if (offset >= table.size())
+        return {};
+    const std::string_view rest(reinterpret_cast<const char*>(table.data() + offset), table.size() - offset);
+    auto name = rest.substr(0, rest.find_first_of(std::string_view("\n\0", 2)));
+    if (name.ends_with('/'))
+        name.remove_suffix(1);
+    return name;
+}
+
+} // namespace
+
+std::span<const ArSymbol> find_symbols(std::span<const ArSymbol> sorted, std::string_view name) {
+    const auto range = std::ranges::equal_range(sorted, name, {}, &ArSymbol::name);
+    return {range.begin(), range.end()};
+}
+
+std::expected<ArArchive, Error> ArArchive::parse(std::span<const std::uint8_t> bytes, const ParseLimits& limits) {
+    const std::string_view head(reinterpret_cast<const char*>(bytes.data()), std::min(bytes.size(), ar_magic.size()));
+    if (head == thin_magic)
+        return std::unexpected(Error{"Thin archive: members are stored in separate files"});
+    if (head != ar_magic)
+        return std::unexpected(Error{"Not an ar archive"});
+
+    ArArchive ar(bytes);
+    ar.limits_ = limits;
+
+    std::span<const std::uint8_t> long_names;
+    std::span<const std::uint8_t> first_linker;
+    std::span<const std::uint8_t> second_linker;
+    std::span<const std::uint8_t> sym64;
+    std::span<const std::uint8_t> symdef;
+
+    std::size_t pos = ar_magic.size();
+    while (bytes.size() - pos >= sizeof(ar_header_)) {
+        // Packed, so any offset will do; names below are views into it
+        const auto& h = *reinterpret_cast<const ar_header_*>(bytes.data() + pos);
+        if (h.fmag[0] != '`' || h.fmag[1] != '\n')
+            return std::unexpected(Error{"Bad ar member header"});
+        const auto size = parse_number(field(h.size, sizeof(h.size)), 10);
+        const std::size_t data_offset = pos + sizeof(h);
+        if (!size || *size > bytes.size() - data_offset)
+            return std::unexpected(Error{"ar member out of range"});
+
+        ArMember m;
+        m.header_offset = pos;
+        m.data = bytes.subspan(data_offset, static_cast<std::size_t>(*size));
+        m.mtime = parse_number(field(h.mtime, sizeof(h.mtime)), 10).value_or(0);
+        m.mode = static_cast<std::uint32_t>(parse_number(field(h.mode, sizeof(h.mode)), 8).value_or(0));
+        // Members start on even offsets
+        pos = data_offset + static_cast<std::size_t>(*size);
+        pos += pos & 1;
+        pos = std::min(pos, bytes.size());
+
+        const auto name = field(h.name, sizeof(h.name));
+        if (name == "/") {
+            // GNU has one; MSVC writes a second, sorted one after the first
+            (first_linker.data() ? second_linker : first_linker) = m.data;
+            continue;
+        }
+        if (name == "/SYM64/") {
+            sym64 = m.data;
+            continue;
+        }
+        if (name == "//") {
+            long_names = m.data;
+            continue;
+        }
+        // MSVC's "/<ECSYMBOLS>/" and similar tables are not indexed here
+        if (name.starts_with("/<"))
+            continue;
+
+        if (name.starts_with("#1/")) {
+            // BSD: the name is stored at the start of the data
+            const auto length = parse_number(name.substr(3), 10);
+            if (!length || *length > m.data.size())
+                return std::unexpected(Error{"Bad BSD member name length"});
+            const auto stored = m.data.first(static_cast<std::size_t>(*length));
+            const std::string_view raw(reinterpret_cast<const char*>(stored.data()), stored.size());
+            m.name = raw.substr(0, raw.find('\0'));
+            m.data = m.data.subspan(stored.size());
+            ar.flavor_ = ArFlavor::Bsd;
+        } else if (name.size() > 1 && name[0] == '/') {
+            const auto offset = parse_number(name.substr(1), 10);
+            if (!offset || *offset >= long_names.size())
+                return std::unexpected(Error{"ar long name out of range"});
+            m.name = long_name(long_names, static_cast<std::size_t>(*offset));
+        } else {
+            m.name = name.ends_with('/') ? name.substr(0, name.size() - 1) : name;
+        }
+
+        if (m.name == "__.SYMDEF" || m.name == "__.SYMDEF SORTED") {
+            symdef = m.data;
+            ar.flavor_ = ArFlavor::Bsd;
+            continue;
+        }
+
+        if (ar.members_.size() >= limits.max_table_entries)
+            return std::unexpected(Error{"ar archive exceeds member budget"});
+        ar.members_.push_back(m);
+    }
+
+    std::expected<void, Error> ok;
+    if (second_linker.data()) {
+        ar.flavor_ = ArFlavor::Msvc;
+        ok = ar.read_msvc_symbol_table(second_linker);
+    } else if (sym64.data()) {
+        ok = ar.read_symbol_table(sym64, true);
+    } else if (first_linker.data()) {
+        ok = ar.read_symbol_table(first_linker, false);
+    } else if (symdef.data()) {
+        ok = ar.read_bsd_symbol_table(symdef);
+    }
+    if (!ok)
+        return std::unexpected(ok.error());
+
+    std::ranges::sort(ar.symbols_, [](const ArSymbol& a, const ArSymbol& b) {
+        return a.name != b.name ? a.name < b.name : a.member < b.member;
+    });
+    return ar;
+}
+
+std::optional<std::size_t> ArArchive::member_at_offset(std::uint64_t header_offset) const {
+    const auto it = std::ranges::lower_bound(members_, header_offset, {}, &ArMember::header_offset);
+    if (it == members_.end() || it->header_offset != header_offset)
+        return std::nullopt;
+    return static_cast<std::size_t>(it - members_.begin());
+}
+
+std::expected<void, Error> ArArchive::add_symbol(std::string_view name, std::uint64_t header_offset) {
+    // Entries naming a member that is not there are dropped, not fatal:
+    // the rest of the index is still usable
+    if (const auto member = member_at_offset(header_offset))
+        symbols_.push_back(ArSymbol{name, static_cast<std::uint32_t>(*member)});
+    if (symbols_.size() > limits_.max_table_entries)
+        return std::unexpected(Error{"ar symbol table exceeds entry budget"});
+    return {};
+}
+
+// System V / GNU: big-endian count, member header offsets, then the names
+// back to back. /SYM64/ is the same with 64-bit fields.
+std::expected<void, Error> ArArchive::read_symbol_table(std::span<const std::uint8_t> table, bool wide) {
+    ByteReader r(table, true);
+    const std::uint64_t count = wide ? r.u64() : r.u32();
+    const std::size_t width = wide ? 8 : 4;
+    if (!r.ok() || count > r.remaining() / width)
+        return std::unexpected(Error{"ar symbol table out of range"});
+
+    ByteReader names(table, true, r.pos() + static_cast<std::size_t>(count) * width);
+    symbols_.reserve(static_cast<std::size_t>(count));
+    for (std::uint64_t i = 0; i < count; ++i) {
+        const std::uint64_t offset = wide ? r.u64() : r.u32();
+        const auto name = names.cstring();
+        if (!names.ok())
+            return std::unexpected(Error{"ar symbol names out of range"});
+        if (auto ok = add_symbol(name, offset); !ok)
+            return ok;
+    }
+    return {};
+}
+
+// MSVC second linker member: little-endian member offsets, then per
+// symbol a 1-based index into them, then the names in sorted order
+std::expected<void, Error> ArArchive::read_msvc_symbol_table(std::span<const std::uint8_t> table) {
+    ByteReader r(table, false);
+    const std::uint32_t member_count = r.u32();
+    if (!r.ok() || member_count > r.remaining() / 4)
+        return std::unexpected(Error{"ar linker member out of range"});
+    const std::size_t offsets = r.pos();
+    r.skip(std::size_t{member_count} * 4);
+    const std::uint32_t count = r.u32();
+    if (!r.ok() || count > r.remaining() / 2)
+        return std::unexpected(Error{"ar linker member out of range"});
+
+    ByteReader names(table, false, r.pos() + std::size_t{count} * 2);
+    ByteReader offset_reader(table, false);
+    symbols_.reserve(count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        const std::uint16_t index = r.u16();
+        const auto name = names.cstring();
+        if (!names.ok())
+            return std::unexpected(Error{"ar symbol names out of range"});
+        if (index == 0 || index > member_count)
+            continue;
+        offset_reader.seek(offsets + (std::size_t{index} - 1) * 4);
+        if (auto ok = add_symbol(name, offset_reader.u32()); !ok)
+            return ok;
+    }
+    return {};
+}
+
+// BSD __.SYMDEF: byte size of the ranlib array, {name offset, member
+// offset} pairs, byte size of the strings, the strings. Written in the
+// host's order by ranlib; every platform that still uses it is
+// little-endian.
+std::expected<void, Error> ArArchive::read_bsd_symbol_table(std::span<const std::uint8_t> table) {
+    ByteReader r(table, false);
+    const std::uint32_t ranlib_bytes = r.u32();
+    if (!r.ok() || ranlib_bytes > r.remaining())
+        return std::unexpected(Error{"__.SYMDEF out of range"});
+    ByteReader sizes(table, false, r.pos() + ranlib_bytes);
+    const std::uint32_t string_bytes = sizes.u32();
+    if (!sizes.ok() || string_bytes > sizes.remaining())
+        return std::unexpected(Error{"__.SYMDEF strings out of range"});
+    const auto strings = table.subspan(sizes.pos(), string_bytes);
+
+    const std::size_t count = ranlib_bytes / 8;
+    symbols_.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::uint32_t name = r.u32();
+        const std::uint32_t offset = r.u32();
+        if (auto ok = add_symbol(ElfView::cstring_at(strings, name), offset); !ok)
+            return ok;
+    }
+    return {};
+}
+
+ArMemberKind member_kind(std::span<const std::uint8_t> data) {
+    const auto starts_with = [&](std::string_view magic) {
+        return data.size() >= magic.size() && std::memcmp(data.data(), magic.data(), magic.size()) == 0;
+    };
+    if (starts_with("\x7F" "ELF"))
+        return ArMemberKind::Elf;
+    if (starts_with("BC\xC0\xDE"))
+        return ArMemberKind::Bitcode;
+    if (is_import_object(data))
+        return ArMemberKind::ImportObject;
+    // ANON_OBJECT_HEADER: the import object signature with version >= 2
+    if (starts_with(std::string_view("\0\0\xFF\xFF", 4)))
+        return ArMemberKind::BigObj;
+    if (CoffObject::parse(data))
+        return ArMemberKind::Coff;
+    return ArMemberKind::Unknown;
+}
+
+namespace {
+
+std::expected<ArMemberSymbols, Error> analyze_elf(std::span<const std::uint8_t> data) {
+    auto elf = ElfView::parse(data);
+    if (!elf)
+        return std::unexpected(elf.error());
+    auto table = read_symtab(*elf);
+    if (!table)
+        return std::unexpected(table.error());
+
+    ArMemberSymbols out;
+    out.kind = ArMemberKind::Elf;
+    out.machine = elf->machine();
+    for (std::size_t i = 1; i < table->size(); ++i) {
+        if (table->binding(i) == STB_LOCAL || table->name(i).empty())
+            continue;
+        if (!table->is_defined(i))
+            ++out.undefined;
+        else if (table->type(i) != STT_SECTION && table->type(i) != STT_FILE)
+            out.defined.push_back(table->name(i));
+    }
+    return out;
+}
+
+std::expected<ArMemberSymbols, Error> analyze_coff(std::span<const std::uint8_t> data) {
+    auto obj = CoffObject::parse(data);
+    if (!obj)
+        return std::unexpected(obj.error());
+
+    ArMemberSymbols out;
+    out.kind = ArMemberKind::Coff;
+    out.machine = obj->machine();
+    obj->for_each_symbol([&](std::size_t, const CoffSymbol& s) {
+        if (!s.is_external() || s.name.empty())
+            return;
+        if (s.is_defined())
+            out.defined.push_back(s.name);
+        else
+            ++out.undefined;
+    });
+    return out;
+}
+
+std::expected<ArMemberSymbols, Error> analyze_member(std::span<const std::uint8_t> data) {
+    const auto kind = member_kind(data);
+    switch (kind) {
+        case ArMemberKind::Elf:
+            return analyze_elf(data);
+        case ArMemberKind::Coff:
+            return analyze_coff(data);
+        case ArMemberKind::ImportObject: {
+            auto import = parse_import_object(data);
+            if (!import)
+                return std::unexpected(import.error());
+            // The linker member lists "__imp_<symbol>" for the IAT slot and,
+            // unless the import is DATA, <symbol> for the jump thunk
+            ArMemberSymbols out;
+            out.kind = kind;
+            out.machine = import->machine;
+            out.owned_names = std::make_shared<const std::string>("__imp_" + std::string(import->symbol));
+            out.defined.push_back(*out.owned_names);
+            if (import->type != IMPORT_OBJECT_DATA)
+                out.defined.push_back(import->symbol);
+            return out;
+        }
+        default: {
+            ArMemberSymbols out;
+            out.kind = kind;
+            return out;
+        }
+    }
+}
+
+} // namespace
+
+std::vector<std::expected<ArMemberSymbols, Error>> analyze_members(const ArArchive& archive, std::size_t threads) {
+    const auto members = archive.members();
+    std::vector<std::expected<ArMemberSymbols, Error>> results(members.size());
+    parallel_for(members.size(), [&](std::size_t i) {
+        results[i] = analyze_member(members[i].data);
+    }, threads, 8);
+    return results;
+}
+
+std::vector<ArSymbol> build_symbol_index(std::span<const std::expected<ArMemberSymbols, Error>> analysis) {
+    std::size_t total = 0;
+    for (const auto& a : analysis)
+        total += a ? a->defined.size() : 0;
+
+    std::vector<ArSymbol> index;
+    index.reserve(total);
+    for (std::size_t member = 0; member < analysis.size(); ++member) {
+        if (!analysis[member])
+            continue;
+        for (auto name : analysis[member]->defined)
+            index.push_back(ArSymbol{name, static_cast<std::uint32_t>(member)});
+    }
+    std::ranges::sort(index, [](const ArSymbol& a, const ArSymbol& b) {
+        return a.name != b.name ? a.name < b.name : a.member < b.member;
+    });
+    return index;
+}
+
+} // namespace peelf
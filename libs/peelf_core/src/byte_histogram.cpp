@@ -0,0 +1,174 @@
+#include "peelf/byte_histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "peelf/cpu_features.hpp"
+#include "peelf/parallel.hpp"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define PEELF_HIST_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define PEELF_HIST_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(PEELF_HIST_X86) && (defined(__GNUC__) || defined(__clang__))
+#define PEELF_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define PEELF_TARGET_AVX2
+#endif
+
+namespace peelf {
+
+namespace {
+
+constexpr std::size_t TABLES = 4;
+constexpr std::size_t BLOCK = 32;
+
+// 32-bit counters keep the four tables within 4 KB of L1; they are folded
+// into the 64-bit result before any of them can wrap
+using PartialTables = std::array<std::array<std::uint32_t, 256>, TABLES>;
+constexpr std::size_t FOLD_BYTES = std::size_t{1} << 30;
+
+// Regions above this are split across threads
+constexpr std::size_t CHUNK = std::size_t{1} << 20;
+
+inline void count_scalar(const std::uint8_t* p, std::size_t n, PartialTables& t) {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        std::uint64_t w;
+        std::memcpy(&w, p + i, sizeof(w));
+        ++t[0][w & 0xFF];
+        ++t[1][(w >> 8) & 0xFF];
+        ++t[2][(w >> 16) & 0xFF];
+        ++t[3][(w >> 24) & 0xFF];
+        ++t[0][(w >> 32) & 0xFF];
+        ++t[1][(w >> 40) & 0xFF];
+        ++t[2][(w >> 48) & 0xFF];
+        ++t[3][w >> 56];
+    }
+    for (; i < n; ++i)
+        ++t[i & (TABLES - 1)][p[i]];
+}
+
+// Each kernel counts whole BLOCK-byte blocks and returns how many bytes it
+// handled; the caller counts the tail in scalar code.
+
+#if defined(PEELF_HIST_X86)
+
+PEELF_TARGET_AVX2
+std::size_t count_avx2(const std::uint8_t* p, std::size_t n, PartialTables& t) {
+    std::size_t i = 0;
+    for (; i + BLOCK <= n; i += BLOCK) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        const __m256i first = _mm256_set1_epi8(static_cast<char>(p[i]));
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, first)) == -1)
+            t[0][p[i]] += BLOCK;
+        else
+            count_scalar(p + i, BLOCK, t);
+    }
+    return i;
+}
+
+#elif defined(PEELF_HIST_NEON)
+
+std::size_t count_neon(const std::uint8_t* p, std::size_t n, PartialTables& t) {
+    std::size_t i = 0;
+    for (; i + BLOCK <= n; i += BLOCK) {
+        const uint8x16_t first = vdupq_n_u8(p[i]);
+        const uint8x16_t eq = vandq_u8(vceqq_u8(vld1q_u8(p + i), first), vceqq_u8(vld1q_u8(p + i + 16), first));
+        if (vminvq_u8(eq) == 0xFF)
+            t[0][p[i]] += BLOCK;
+        else
+            count_scalar(p + i, BLOCK, t);
+    }
+    return i;
+}
+
+#endif
+
+void count_block(const std::uint8_t* p, std::size_t n, PartialTables& t) {
+    std::size_t done = 0;
+#if defined(PEELF_HIST_X86)
+    if (cpu_features().avx2)
+        done = count_avx2(p, n, t);
+#elif defined(PEELF_HIST_NEON)
+    done = count_neon(p, n, t);
+#endif
+    count_scalar(p + done, n - done, t);
+}
+
+struct Job {
+    std::size_t region = 0;
+    std::span<const std::uint8_t> data;
+    std::size_t partial = SIZE_MAX;     // slot in partials, for split regions
+};
+
+} // namespace
+
+void accumulate_histogram(std::span<const std::uint8_t> data, ByteHistogram& out) {
+    PartialTables tables;
+    for (std::size_t off = 0; off < data.size(); off += FOLD_BYTES) {
+        for (auto& table : tables)
+            table.fill(0);
+        count_block(data.data() + off, std::min(FOLD_BYTES, data.size() - off), tables);
+        for (std::size_t b = 0; b < 256; ++b)
+            out[b] += std::uint64_t{tables[0][b]} + tables[1][b] + tables[2][b] + tables[3][b];
+    }
+}
+
+std::vector<ByteHistogram> byte_histograms(std::span<const std::span<const std::uint8_t>> regions,
+                                           std::size_t threads) {
+    std::vector<ByteHistogram> out(regions.size(), ByteHistogram{});
+
+    // A region that fits one chunk is counted straight into its result;
+    // only chunks of split regions need a slot of their own
+    std::vector<Job> jobs;
+    std::size_t partial_count = 0;
+    for (std::size_t r = 0; r < regions.size(); ++r) {
+        const auto region = regions[r];
+        if (region.size() <= CHUNK) {
+            jobs.push_back(Job{r, region});
+            continue;
+        }
+        for (std::size_t off = 0; off < region.size(); off += CHUNK)
+            jobs.push_back(Job{r, region.subspan(off, std::min(CHUNK, region.size() - off)), partial_count++});
+    }
+
+    std::vector<ByteHistogram> partials(partial_count, ByteHistogram{});
+    parallel_for(jobs.size(), [&](std::size_t i) {
+        const Job& job = jobs[i];
+        accumulate_histogram(job.data, job.partial == SIZE_MAX ? out[job.region] : partials[job.partial]);
+    }, threads);
+
+    for (const Job& job : jobs) {
+        if (job.partial == SIZE_MAX)
+            continue;
+        for (std::size_t b = 0; b < 256; ++b)
+            out[job.region][b] += partials[job.partial][b];
+    }
+    return out;
+}
+
+double shannon_entropy(const ByteHistogram& histogram) {
+    std::uint64_t total = 0;
+    for (const auto c : histogram)
+        total += c;
+    if (total == 0)
+        return 0.0;
+
+    const auto n = static_cast<double>(total);
+    double entropy = 0.0;
+    for (const auto c : histogram) {
+        if (c == 0)
+            continue;
+        const double p = static_cast<double>(c) / n;
+        entropy -= p * std::log2(p);
+    }
+    return entropy;
+}
+
+} // namespace peelf
@@ -0,0 +1,168 @@
+#include "peelf/byte_pyramid.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "peelf/parallel.hpp"
+
+namespace peelf {
+
+namespace {
+
+// Windows per parallel task
+constexpr std::size_t WINDOWS_PER_TASK = 256;
+
+constexpr std::uint8_t CLASS_ZERO = 1;
+constexpr std::uint8_t CLASS_ASCII = 2;
+constexpr std::uint8_t CLASS_HIGH = 4;
+
+constexpr std::array<std::uint8_t, 256> byte_classes = [] {
+    std::array<std::uint8_t, 256> t{};
+    t[0] = CLASS_ZERO;
+    for (std::size_t b = 0x20; b < 0x7F; ++b)
+        t[b] = CLASS_ASCII;
+    t['\t'] = t['\n'] = t['\r'] = CLASS_ASCII;
+    for (std::size_t b = 0x80; b < 0x100; ++b)
+        t[b] = CLASS_HIGH;
+    return t;
+}();
+
+// c * log2(c) for every count a window can reach
+const std::vector<double>& count_log_table() {
+    static const std::vector<double> table = [] {
+        std::vector<double> t(BytePyramid::max_window + 1);
+        for (std::size_t c = 1; c < t.size(); ++c)
+            t[c] = static_cast<double>(c) * std::log2(static_cast<double>(c));
+        return t;
+    }();
+    return table;
+}
+
+std::uint16_t fixed(double value, float scale) {
+    return static_cast<std::uint16_t>(std::lround(std::clamp(value * scale, 0.0, 65535.0)));
+}
+
+// histogram must be all zero on entry and is left all zero. The second
+// pass walks the window rather than all 256 bins, so it only visits the
+// values present and clears them as it goes.
+ByteWindowStats window_stats(std::span<const std::uint8_t> bytes, std::array<std::uint32_t, 256>& histogram) {
+    ByteWindowStats out;
+    if (bytes.empty())
+        return out;
+
+    for (const std::uint8_t b : bytes)
+        ++histogram[b];
+
+    const auto& clog = count_log_table();
+    double sum = 0.0;
+    std::size_t classes[8] = {};
+    for (const std::uint8_t b : bytes) {
+        const std::uint32_t c = histogram[b];
+        if (c == 0)
+            continue;
+        sum += clog[c];
+        classes[byte_classes[b]] += c;
+        histogram[b] = 0;
+    }
+
+    // H = log2(n) - sum(c log2 c) / n
+    const auto n = static_cast<double>(bytes.size());
+    out.entropy = fixed(std::log2(n) - sum / n, ByteWindowStats::entropy_scale);
+    out.entropy_max = out.entropy;
+    out.zero = fixed(static_cast<double>(classes[CLASS_ZERO]) / n, ByteWindowStats::ratio_scale);
+    out.ascii = fixed(static_cast<double>(classes[CLASS_ASCII]) / n, ByteWindowStats::ratio_scale);
+    out.high = fixed(static_cast<double>(classes[CLASS_HIGH]) / n, ByteWindowStats::ratio_scale);
+    return out;
+}
+
+std::uint16_t mean(std::uint16_t a, std::uint16_t b) {
+    return static_cast<std::uint16_t>((std::uint32_t{a} + b + 1) / 2);
+}
+
+} // namespace
+
+BytePyramid BytePyramid::build(std::span<const std::uint8_t> data, std::size_t window, std::size_t threads) {
+    BytePyramid out;
+    out.window_ = std::clamp<std::size_t>(window, 16, max_window);
+    out.data_size_ = data.size();
+    if (data.empty())
+        return out;
+
+    std::size_t cells = (data.size() + out.window_ - 1) / out.window_;
+    out.levels_.emplace_back(cells);
+    while (cells > 1) {
+        cells = (cells + 1) / 2;
+        out.levels_.emplace_back(cells);
+    }
+
+    out.compute_windows(data, 0, out.levels_[0].size(), threads);
+    for (std::size_t level = 1; level < out.levels_.size(); ++level)
+        out.compute_parents(level, 0, out.levels_[level].size());
+    return out;
+}
+
+void BytePyramid::update(std::span<const std::uint8_t> data, std::uint64_t offset, std::uint64_t size,
+                         std::size_t threads) {
+    if (data.size() != data_size_) {
+        *this = build(data, window_, threads);
+        return;
+    }
+    if (empty() || size == 0 || offset >= data_size_)
+        return;
+
+    std::size_t first = static_cast<std::size_t>(offset / window_);
+    std::size_t last = static_cast<std::size_t>((std::min(offset + size, data_size_) - 1) / window_) + 1;
+    compute_windows(data, first, last, threads);
+    for (std::size_t level = 1; level < levels_.size(); ++level) {
+        first /= 2;
+        last = (last + 1) / 2;
+        compute_parents(level, first, last);
+    }
+}
+
+std::size_t BytePyramid::level_for(std::size_t max_cells) const {
+    for (std::size_t level = 0; level < levels_.size(); ++level) {
+        if (levels_[level].size() <= max_cells)
+            return level;
+    }
+    return levels_.empty() ? 0 : levels_.size() - 1;
+}
+
+void BytePyramid::compute_windows(std::span<const std::uint8_t> data, std::size_t first, std::size_t last,
+                                  std::size_t threads) {
+    auto& cells = levels_[0];
+    const std::size_t tasks = (last - first + WINDOWS_PER_TASK - 1) / WINDOWS_PER_TASK;
+    parallel_for(tasks, [&](std::size_t task) {
+        std::array<std::uint32_t, 256> histogram{};
+        const std::size_t begin = first + task * WINDOWS_PER_TASK;
+        const std::size_t end = std::min(last, begin + WINDOWS_PER_TASK);
+        for (std::size_t w = begin; w < end; ++w) {
+            const std::size_t offset = w * window_;
+            cells[w] = window_stats(data.subspan(offset, std::min(window_, data.size() - offset)), histogram);
+        }
+    }, threads);
+}
+
+void BytePyramid::compute_parents(std::size_t level, std::size_t first, std::size_t last) {
+    const auto& children = levels_[level - 1];
+    auto& cells = levels_[level];
+    for (std::size_t i = first; i < last; ++i) {
+        const ByteWindowStats& a = children[2 * i];
+        // An odd last child has no sibling and passes through unchanged
+        if (2 * i + 1 >= children.size()) {
+            cells[i] = a;
+            continue;
+        }
+        const ByteWindowStats& b = children[2 * i + 1];
+        cells[i] = ByteWindowStats{
+            .entropy = mean(a.entropy, b.entropy),
+            .entropy_max = std::max(a.entropy_max, b.entropy_max),
+            .zero = mean(a.zero, b.zero),
+            .ascii = mean(a.ascii, b.ascii),
+            .high = mean(a.high, b.high),
+        };
+    }
+}
+
+} // namespace peelf
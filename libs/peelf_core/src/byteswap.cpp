@@ -0,0 +1,163 @@
+#include "peelf/byteswap.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+#include "peelf/cpu_features.hpp"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define PEELF_BSWAP_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define PEELF_BSWAP_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(PEELF_BSWAP_X86) && (defined(__GNUC__) || defined(__clang__))
+#define PEELF_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define PEELF_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define PEELF_TARGET_SSSE3
+#define PEELF_TARGET_AVX2
+#endif
+
+namespace peelf {
+
+namespace {
+
+constexpr std::size_t LANE = 16;
+
+#if defined(PEELF_BSWAP_X86)
+
+// Each kernel shuffles `lanes` 16-byte lanes starting at lane 0 and returns
+// how many it handled; the caller finishes the rest in scalar code.
+
+PEELF_TARGET_SSSE3
+std::size_t swap_lanes_ssse3(const std::uint8_t* src, std::uint8_t* dst, std::size_t lanes,
+                             const std::uint8_t* masks, std::size_t period) {
+    std::size_t m = 0;
+    for (std::size_t i = 0; i < lanes; ++i) {
+        const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(masks + m * LANE));
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * LANE));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * LANE), _mm_shuffle_epi8(v, mask));
+        if (++m == period)
+            m = 0;
+    }
+    return lanes;
+}
+
+PEELF_TARGET_AVX2
+std::size_t swap_lanes_avx2(const std::uint8_t* src, std::uint8_t* dst, std::size_t lanes,
+                            const std::uint8_t* masks, std::size_t period) {
+    // VPSHUFB shuffles within each 128-bit half, which is exactly what the
+    // per-lane masks describe; masks_ holds two periods so the 32-byte mask
+    // load at lane m never runs off the end.
+    std::size_t m = 0;
+    std::size_t i = 0;
+    for (; i + 2 <= lanes; i += 2) {
+        const __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(masks + m * LANE));
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * LANE));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * LANE), _mm256_shuffle_epi8(v, mask));
+        m += 2;
+        while (m >= period)
+            m -= period;
+    }
+    return i;
+}
+
+#elif defined(PEELF_BSWAP_NEON)
+
+std::size_t swap_lanes_neon(const std::uint8_t* src, std::uint8_t* dst, std::size_t lanes,
+                            const std::uint8_t* masks, std::size_t period) {
+    std::size_t m = 0;
+    for (std::size_t i = 0; i < lanes; ++i) {
+        const uint8x16_t mask = vld1q_u8(masks + m * LANE);
+        vst1q_u8(dst + i * LANE, vqtbl1q_u8(vld1q_u8(src + i * LANE), mask));
+        if (++m == period)
+            m = 0;
+    }
+    return lanes;
+}
+
+#endif
+
+} // namespace
+
+RecordSwapper::RecordSwapper(std::span<const std::uint8_t> field_widths) {
+    std::size_t max_width = 1;
+    bool aligned = true;
+    for (auto w : field_widths) {
+        for (std::size_t k = 0; k < w; ++k)
+            perm_.push_back(static_cast<std::uint8_t>(record_size_ + w - 1 - k));
+        aligned = aligned && (record_size_ % w) == 0;
+        max_width = std::max<std::size_t>(max_width, w);
+        record_size_ += w;
+    }
+    if (record_size_ == 0)
+        return;
+
+    // A naturally aligned field in a record whose size is a multiple of the
+    // widest field can never straddle a 16-byte boundary of the stream, so
+    // every lane can be permuted on its own.
+    vectorizable_ = aligned && (record_size_ % max_width) == 0;
+    if (!vectorizable_)
+        return;
+
+    period_ = std::lcm(record_size_, LANE) / LANE;
+    masks_.resize(2 * period_ * LANE);
+    for (std::size_t lane = 0; lane < 2 * period_; ++lane) {
+        for (std::size_t b = 0; b < LANE; ++b) {
+            const std::size_t pos = (lane % period_) * LANE + b;    // byte within the period
+            const std::size_t rec = pos - pos % record_size_;
+            const std::size_t from = rec + perm_[pos % record_size_];
+            masks_[lane * LANE + b] = static_cast<std::uint8_t>(from - (lane % period_) * LANE);
+        }
+    }
+}
+
+void RecordSwapper::swap(std::span<const std::uint8_t> src, std::span<std::uint8_t> dst) const {
+    if (dst.size() < src.size())
+        return;
+    if (record_size_ == 0) {
+        std::memmove(dst.data(), src.data(), src.size());
+        return;
+    }
+
+    const std::size_t whole = src.size() - src.size() % record_size_;
+    std::size_t done = 0;
+
+    if (vectorizable_) {
+        const std::size_t lanes = whole / LANE;
+#if defined(PEELF_BSWAP_X86)
+        if (cpu_features().avx2)
+            done = swap_lanes_avx2(src.data(), dst.data(), lanes, masks_.data(), period_) * LANE;
+        else if (cpu_features().ssse3)
+            done = swap_lanes_ssse3(src.data(), dst.data(), lanes, masks_.data(), period_) * LANE;
+#elif defined(PEELF_BSWAP_NEON)
+        done = swap_lanes_neon(src.data(), dst.data(), lanes, masks_.data(), period_) * LANE;
+#endif
+    }
+
+    swap_scalar(src.data(), dst.data(), done, whole);
+    if (whole != src.size())
+        std::memmove(dst.data() + whole, src.data() + whole, src.size() - whole);
+}
+
+void RecordSwapper::swap_scalar(const std::uint8_t* src, std::uint8_t* dst,
+                                std::size_t begin, std::size_t end) const {
+    // begin is either record aligned or a lane boundary no field crosses, so
+    // every source byte of [begin, stop) lies inside [begin, stop) as well;
+    // staging through tmp makes src == dst safe.
+    std::uint8_t tmp[256];
+    while (begin < end) {
+        const std::size_t rec = begin - begin % record_size_;
+        const std::size_t stop = std::min(end, rec + record_size_);
+        std::memcpy(tmp + (begin - rec), src + begin, stop - begin);
+        for (std::size_t i = begin; i < stop; ++i)
+            dst[i] = tmp[perm_[i - rec]];
+        begin = stop;
+    }
+}
+
+} // namespace peelf
@@ -0,0 +1,76 @@
+#include "peelf/cpu_features.hpp"
+
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define PEELF_X86 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#define PEELF_X86 1
+#endif
+
+namespace peelf {
+
+namespace {
+
+#if defined(PEELF_X86)
+void cpuid(std::uint32_t leaf, std::uint32_t subleaf, std::uint32_t (&regs)[4]) {
+#if defined(_MSC_VER)
+    int r[4];
+    __cpuidex(r, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; ++i)
+        regs[i] = static_cast<std::uint32_t>(r[i]);
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+std::uint64_t xgetbv0() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    std::uint32_t lo = 0, hi = 0;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return (std::uint64_t{hi} << 32) | lo;
+#endif
+}
+#endif
+
+CpuFeatures detect() {
+    CpuFeatures f;
+#if defined(PEELF_X86)
+    std::uint32_t r[4]{};
+    cpuid(0, 0, r);
+    const std::uint32_t max_leaf = r[0];
+    if (max_leaf < 1)
+        return f;
+
+    cpuid(1, 0, r);
+    f.pclmul = (r[2] >> 1) & 1;
+    f.ssse3 = (r[2] >> 9) & 1;
+    f.sse41 = (r[2] >> 19) & 1;
+    const bool osxsave = (r[2] >> 27) & 1;
+    const bool avx = (r[2] >> 28) & 1;
+    // YMM state must be enabled by the OS before AVX2 can be used
+    const bool ymm_enabled = osxsave && (xgetbv0() & 0x6) == 0x6;
+
+    if (max_leaf >= 7) {
+        cpuid(7, 0, r);
+        f.avx2 = avx && ymm_enabled && ((r[1] >> 5) & 1);
+        f.sha = (r[1] >> 29) & 1;
+    }
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    f.neon = true;
+#endif
+    return f;
+}
+
+} // namespace
+
+const CpuFeatures& cpu_features() {
+    static const CpuFeatures features = detect();
+    return features;
+}
+
+} // namespace peelf
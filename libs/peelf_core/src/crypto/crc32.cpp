@@ -0,0 +1,91 @@
+#include "crypto/crc32.hpp"
+
+#include <array>
+#include <bit>
+#include <cstring>
+
+#include "peelf/cpu_features.hpp"
+#include "crc32_kernels.hpp"
+
+namespace peelf {
+
+namespace detail {
+
+namespace {
+
+constexpr std::uint32_t crc32_polynomial = 0xEDB88320;     // reflected 0x04C11DB7
+
+// table[k][b]: CRC of byte b followed by k zero bytes, so eight bytes can
+// be looked up independently and XORed together
+constexpr std::array<std::array<std::uint32_t, 256>, 8> make_tables() {
+    std::array<std::array<std::uint32_t, 256>, 8> t{};
+    for (std::uint32_t b = 0; b < 256; ++b) {
+        std::uint32_t c = b;
+        for (int i = 0; i < 8; ++i)
+            c = (c >> 1) ^ ((c & 1) ? crc32_polynomial : 0);
+        t[0][b] = c;
+    }
+    for (std::size_t k = 1; k < 8; ++k) {
+        for (std::size_t b = 0; b < 256; ++b)
+            t[k][b] = (t[k - 1][b] >> 8) ^ t[0][t[k - 1][b] & 0xFF];
+    }
+    return t;
+}
+
+constexpr auto tables = make_tables();
+
+} // namespace
+
+std::uint32_t crc32_slice8(std::uint32_t state, const std::uint8_t* data, std::size_t size) {
+    std::uint32_t c = state;
+    while (size >= 8) {
+        std::uint32_t lo;
+        std::uint32_t hi;
+        std::memcpy(&lo, data, 4);
+        std::memcpy(&hi, data + 4, 4);
+        if constexpr (std::endian::native == std::endian::big) {
+            lo = std::byteswap(lo);
+            hi = std::byteswap(hi);
+        }
+        lo ^= c;
+        c = tables[7][lo & 0xFF] ^ tables[6][(lo >> 8) & 0xFF] ^
+            tables[5][(lo >> 16) & 0xFF] ^ tables[4][lo >> 24] ^
+            tables[3][hi & 0xFF] ^ tables[2][(hi >> 8) & 0xFF] ^
+            tables[1][(hi >> 16) & 0xFF] ^ tables[0][hi >> 24];
+        data += 8;
+        size -= 8;
+    }
+    while (size-- > 0)
+        c = (c >> 8) ^ tables[0][(c ^ *data++) & 0xFF];
+    return c;
+}
+
+} // namespace detail
+
+namespace {
+
+// Below this the folding set-up costs more than it saves
+constexpr std::size_t fold_threshold = 256;
+
+detail::crc32_fn select_fold() {
+    if (detail::crc32_fold_pclmul && cpu_features().pclmul && cpu_features().sse41)
+        return detail::crc32_fold_pclmul;
+    return nullptr;
+}
+
+} // namespace
+
+void Crc32::update(std::span<const std::uint8_t> data) {
+    static const detail::crc32_fn fold = select_fold();
+    const std::uint8_t* p = data.data();
+    std::size_t n = data.size();
+    if (fold && n >= fold_threshold) {
+        const std::size_t blocks = n & ~std::size_t{15};
+        state_ = fold(state_, p, blocks);
+        p += blocks;
+        n -= blocks;
+    }
+    state_ = detail::crc32_slice8(state_, p, n);
+}
+
+} // namespace peelf
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Kernels behind Crc32. They take and return the running (inverted) state.
+
+namespace peelf::detail {
+
+using crc32_fn = std::uint32_t (*)(std::uint32_t state, const std::uint8_t* data, std::size_t size);
+
+std::uint32_t crc32_slice8(std::uint32_t state, const std::uint8_t* data, std::size_t size);
+
+// Folds whole 16-byte blocks; size must be a multiple of 16 and at least
+// 64. nullptr when not compiled in (non-x86 targets).
+extern const crc32_fn crc32_fold_pclmul;
+
+} // namespace peelf::detail
@@ -0,0 +1,105 @@
+#include "crc32_kernels.hpp"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define PEELF_HAVE_PCLMUL 1
+#include <immintrin.h>
+#endif
+
+// CRC-32 by carry-less multiplication folding (Intel, "Fast CRC Computation
+// for Generic Polynomials Using PCLMULQDQ Instruction", 2009), with the
+// bit-reflected constants for 0x04C11DB7. Built without global -mpclmul;
+// the target attribute enables the instructions here only and Crc32
+// dispatches on cpu_features().
+
+#if defined(PEELF_HAVE_PCLMUL)
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PEELF_TARGET_PCLMUL __attribute__((target("pclmul,sse4.1")))
+#else
+#define PEELF_TARGET_PCLMUL
+#endif
+
+namespace peelf::detail {
+
+namespace {
+
+// x^(k) mod P for the fold distances, then the Barrett constants
+alignas(16) constexpr std::uint64_t k1k2[2] = {0x0154442BD4, 0x01C6E41596};     // 512-bit fold
+alignas(16) constexpr std::uint64_t k3k4[2] = {0x01751997D0, 0x00CCAA009E};     // 128-bit fold
+alignas(16) constexpr std::uint64_t k5k0[2] = {0x0163CD6124, 0x0000000000};     // 64 -> 32
+alignas(16) constexpr std::uint64_t poly[2] = {0x01DB710641, 0x01F7011641};     // P', mu
+
+PEELF_TARGET_PCLMUL
+__m128i fold(__m128i acc, __m128i k, __m128i next) {
+    const __m128i lo = _mm_clmulepi64_si128(acc, k, 0x00);
+    const __m128i hi = _mm_clmulepi64_si128(acc, k, 0x11);
+    return _mm_xor_si128(_mm_xor_si128(hi, lo), next);
+}
+
+PEELF_TARGET_PCLMUL
+std::uint32_t crc32_pclmul(std::uint32_t state, const std::uint8_t* data, std::size_t size) {
+    auto load = [](const std::uint8_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); };
+
+    // Four independent 128-bit lanes hide the multiplier latency
+    __m128i x1 = _mm_xor_si128(load(data), _mm_cvtsi32_si128(static_cast<int>(state)));
+    __m128i x2 = load(data + 16);
+    __m128i x3 = load(data + 32);
+    __m128i x4 = load(data + 48);
+    data += 64;
+    size -= 64;
+
+    __m128i k = _mm_load_si128(reinterpret_cast<const __m128i*>(k1k2));
+    while (size >= 64) {
+        x1 = fold(x1, k, load(data));
+        x2 = fold(x2, k, load(data + 16));
+        x3 = fold(x3, k, load(data + 32));
+        x4 = fold(x4, k, load(data + 48));
+        data += 64;
+        size -= 64;
+    }
+
+    // Lanes into one, then any 16-byte blocks left
+    k = _mm_load_si128(reinterpret_cast<const __m128i*>(k3k4));
+    x1 = fold(x1, k, x2);
+    x1 = fold(x1, k, x3);
+    x1 = fold(x1, k, x4);
+    while (size >= 16) {
+        x1 = fold(x1, k, load(data));
+        data += 16;
+        size -= 16;
+    }
+
+    // 128 -> 64 bits
+    const __m128i mask32 = _mm_setr_epi32(-1, 0, -1, 0);
+    x2 = _mm_clmulepi64_si128(x1, k, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+    // 64 -> 32 bits
+    k = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(k5k0));
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // Barrett reduction
+    k = _mm_load_si128(reinterpret_cast<const __m128i*>(poly));
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k, 0x10);
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask32), k, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    return static_cast<std::uint32_t>(_mm_extract_epi32(x1, 1));
+}
+
+} // namespace
+
+const crc32_fn crc32_fold_pclmul = &crc32_pclmul;
+
+} // namespace peelf::detail
+
+#else
+
+namespace peelf::detail {
+
+const crc32_fn crc32_fold_pclmul = nullptr;
+
+} // namespace peelf::detail
+
+#endif
@@ -0,0 +1,123 @@
+#include "crypto/sha.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#include "peelf/cpu_features.hpp"
+#include "sha_kernels.hpp"
+
+namespace peelf {
+
+namespace detail {
+
+void sha1_blocks_scalar(std::uint32_t* state, const std::uint8_t* data, std::size_t blocks) {
+    for (; blocks != 0; --blocks, data += 64) {
+        std::uint32_t w[80];
+        for (int i = 0; i < 16; ++i) {
+            const std::uint8_t* p = data + i * 4;
+            w[i] = (std::uint32_t{p[0]} << 24) | (std::uint32_t{p[1]} << 16) |
+                   (std::uint32_t{p[2]} << 8) | std::uint32_t{p[3]};
+        }
+        for (int i = 16; i < 80; ++i)
+            w[i] = std::rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+        std::uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+        for (int i = 0; i < 80; ++i) {
+            std::uint32_t f, k;
+            if (i < 20) {
+                f = (b & c) | (~b & d);
+                k = 0x5a827999;
+            } else if (i < 40) {
+                f = b ^ c ^ d;
+                k = 0x6ed9eba1;
+            } else if (i < 60) {
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8f1bbcdc;
+            } else {
+                f = b ^ c ^ d;
+                k = 0xca62c1d6;
+            }
+            const std::uint32_t t = std::rotl(a, 5) + f + e + k + w[i];
+            e = d; d = c; c = std::rotl(b, 30); b = a; a = t;
+        }
+
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d; state[4] += e;
+    }
+}
+
+} // namespace detail
+
+namespace {
+
+detail::sha_block_fn select_sha1() {
+    if (detail::sha1_blocks_shani && cpu_features().sha && cpu_features().sse41)
+        return detail::sha1_blocks_shani;
+    return detail::sha1_blocks_scalar;
+}
+
+void sha1_blocks(std::uint32_t* state, const std::uint8_t* data, std::size_t blocks) {
+    static const detail::sha_block_fn fn = select_sha1();
+    fn(state, data, blocks);
+}
+
+} // namespace
+
+void Sha1::reset() {
+    state_ = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
+    buffered_ = 0;
+    total_ = 0;
+}
+
+void Sha1::update(std::span<const std::uint8_t> data) {
+    total_ += data.size();
+
+    if (buffered_ != 0) {
+        const std::size_t take = std::min(data.size(), buffer_.size() - buffered_);
+        std::memcpy(buffer_.data() + buffered_, data.data(), take);
+        buffered_ += take;
+        data = data.subspan(take);
+        if (buffered_ < buffer_.size())
+            return;
+        sha1_blocks(state_.data(), buffer_.data(), 1);
+        buffered_ = 0;
+    }
+
+    const std::size_t blocks = data.size() / 64;
+    if (blocks != 0) {
+        sha1_blocks(state_.data(), data.data(), blocks);
+        data = data.subspan(blocks * 64);
+    }
+
+    if (!data.empty()) {
+        std::memcpy(buffer_.data(), data.data(), data.size());
+        buffered_ = data.size();
+    }
+}
+
+Sha1::digest_type Sha1::finish() {
+    const std::uint64_t bits = total_ * 8;
+
+    buffer_[buffered_++] = 0x80;
+    if (buffered_ > 56) {
+        std::memset(buffer_.data() + buffered_, 0, buffer_.size() - buffered_);
+        sha1_blocks(state_.data(), buffer_.data(), 1);
+        buffered_ = 0;
+    }
+    std::memset(buffer_.data() + buffered_, 0, 56 - buffered_);
+    for (std::size_t i = 0; i < 8; ++i)
+        buffer_[56 + i] = static_cast<std::uint8_t>(bits >> (56 - 8 * i));
+    sha1_blocks(state_.data(), buffer_.data(), 1);
+
+    digest_type out{};
+    for (std::size_t i = 0; i < state_.size(); ++i) {
+        out[i * 4 + 0] = static_cast<std::uint8_t>(state_[i] >> 24);
+        out[i * 4 + 1] = static_cast<std::uint8_t>(state_[i] >> 16);
+        out[i * 4 + 2] = static_cast<std::uint8_t>(state_[i] >> 8);
+        out[i * 4 + 3] = static_cast<std::uint8_t>(state_[i]);
+    }
+    reset();
+    return out;
+}
+
+} // namespace peelf
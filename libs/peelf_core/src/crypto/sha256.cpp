@@ -0,0 +1,138 @@
+#include "crypto/sha.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#include "peelf/cpu_features.hpp"
+#include "sha_kernels.hpp"
+
+namespace peelf {
+
+namespace detail {
+
+namespace {
+
+constexpr std::uint32_t K256[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+std::uint32_t load_be32(const std::uint8_t* p) {
+    return (std::uint32_t{p[0]} << 24) | (std::uint32_t{p[1]} << 16) |
+           (std::uint32_t{p[2]} << 8) | std::uint32_t{p[3]};
+}
+
+} // namespace
+
+void sha256_blocks_scalar(std::uint32_t* state, const std::uint8_t* data, std::size_t blocks) {
+    for (; blocks != 0; --blocks, data += 64) {
+        std::uint32_t w[64];
+        for (int i = 0; i < 16; ++i)
+            w[i] = load_be32(data + i * 4);
+        for (int i = 16; i < 64; ++i) {
+            const std::uint32_t s0 = std::rotr(w[i - 15], 7) ^ std::rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            const std::uint32_t s1 = std::rotr(w[i - 2], 17) ^ std::rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        std::uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        std::uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (int i = 0; i < 64; ++i) {
+            const std::uint32_t S1 = std::rotr(e, 6) ^ std::rotr(e, 11) ^ std::rotr(e, 25);
+            const std::uint32_t ch = (e & f) ^ (~e & g);
+            const std::uint32_t t1 = h + S1 + ch + K256[i] + w[i];
+            const std::uint32_t S0 = std::rotr(a, 2) ^ std::rotr(a, 13) ^ std::rotr(a, 22);
+            const std::uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+            const std::uint32_t t2 = S0 + maj;
+            h = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+    }
+}
+
+} // namespace detail
+
+namespace {
+
+detail::sha_block_fn select_sha256() {
+    if (detail::sha256_blocks_shani && cpu_features().sha && cpu_features().sse41)
+        return detail::sha256_blocks_shani;
+    return detail::sha256_blocks_scalar;
+}
+
+void sha256_blocks(std::uint32_t* state, const std::uint8_t* data, std::size_t blocks) {
+    static const detail::sha_block_fn fn = select_sha256();
+    fn(state, data, blocks);
+}
+
+} // namespace
+
+void Sha256::reset() {
+    state_ = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+              0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+    buffered_ = 0;
+    total_ = 0;
+}
+
+void Sha256::update(std::span<const std::uint8_t> data) {
+    total_ += data.size();
+
+    if (buffered_ != 0) {
+        const std::size_t take = std::min(data.size(), buffer_.size() - buffered_);
+        std::memcpy(buffer_.data() + buffered_, data.data(), take);
+        buffered_ += take;
+        data = data.subspan(take);
+        if (buffered_ < buffer_.size())
+            return;
+        sha256_blocks(state_.data(), buffer_.data(), 1);
+        buffered_ = 0;
+    }
+
+    const std::size_t blocks = data.size() / 64;
+    if (blocks != 0) {
+        sha256_blocks(state_.data(), data.data(), blocks);
+        data = data.subspan(blocks * 64);
+    }
+
+    if (!data.empty()) {
+        std::memcpy(buffer_.data(), data.data(), data.size());
+        buffered_ = data.size();
+    }
+}
+
+Sha256::digest_type Sha256::finish() {
+    const std::uint64_t bits = total_ * 8;
+
+    buffer_[buffered_++] = 0x80;
+    if (buffered_ > 56) {
+        std::memset(buffer_.data() + buffered_, 0, buffer_.size() - buffered_);
+        sha256_blocks(state_.data(), buffer_.data(), 1);
+        buffered_ = 0;
+    }
+    std::memset(buffer_.data() + buffered_, 0, 56 - buffered_);
+    for (std::size_t i = 0; i < 8; ++i)
+        buffer_[56 + i] = static_cast<std::uint8_t>(bits >> (56 - 8 * i));
+    sha256_blocks(state_.data(), buffer_.data(), 1);
+
+    digest_type out{};
+    for (std::size_t i = 0; i < state_.size(); ++i) {
+        out[i * 4 + 0] = static_cast<std::uint8_t>(state_[i] >> 24);
+        out[i * 4 + 1] = static_cast<std::uint8_t>(state_[i] >> 16);
+        out[i * 4 + 2] = static_cast<std::uint8_t>(state_[i] >> 8);
+        out[i * 4 + 3] = static_cast<std::uint8_t>(state_[i]);
+    }
+    reset();
+    return out;
+}
+
+} // namespace peelf
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Block compression functions behind Sha1 / Sha256. Each processes `blocks`
+// consecutive 64-byte blocks and updates `state` in place.
+
+namespace peelf::detail {
+
+using sha_block_fn = void (*)(std::uint32_t* state, const std::uint8_t* data, std::size_t blocks);
+
+void sha1_blocks_scalar(std::uint32_t* state, const std::uint8_t* data, std::size_t blocks);
+void sha256_blocks_scalar(std::uint32_t* state, const std::uint8_t* data, std::size_t blocks);
+
+// nullptr when the SHA-NI kernels were not compiled in (non-x86 targets)
+extern const sha_block_fn sha1_blocks_shani;
+extern const sha_block_fn sha256_blocks_shani;
+
+} // namespace peelf::detail
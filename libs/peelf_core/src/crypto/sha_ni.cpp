@@ -0,0 +1,174 @@
+#include "sha_kernels.hpp"
+
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define PEELF_HAVE_SHA_NI 1
+#include <immintrin.h>
+#endif
+
+// SHA-NI block functions. Built without global -msha so the library still
+// runs on older CPUs; the target attribute enables the instructions for
+// these functions only and the callers dispatch on cpu_features().
+
+#if defined(PEELF_HAVE_SHA_NI)
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PEELF_TARGET_SHA __attribute__((target("sha,sse4.1,ssse3")))
+#define PEELF_INLINE_SHA __attribute__((target("sha,sse4.1,ssse3"), always_inline)) inline
+#else
+#define PEELF_TARGET_SHA
+#define PEELF_INLINE_SHA __forceinline
+#endif
+
+namespace peelf::detail {
+
+namespace {
+
+// -------------------------------------------------------------------------
+// SHA-256
+// -------------------------------------------------------------------------
+
+alignas(16) constexpr std::uint32_t K256[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+// Four rounds plus the message-schedule work that overlaps them. G is the
+// round group (0..15); msg[G % 4] holds W[4G .. 4G+3].
+template<int G>
+PEELF_INLINE_SHA void sha256_quad(__m128i& abef, __m128i& cdgh, __m128i (&msg)[4]) {
+    constexpr int cur = G % 4, next = (G + 1) % 4, prev = (G + 3) % 4;
+
+    __m128i wk = _mm_add_epi32(msg[cur], _mm_load_si128(reinterpret_cast<const __m128i*>(K256 + 4 * G)));
+    cdgh = _mm_sha256rnds2_epu32(cdgh, abef, wk);
+    if constexpr (G >= 3 && G <= 14) {
+        const __m128i tmp = _mm_alignr_epi8(msg[cur], msg[prev], 4);
+        msg[next] = _mm_add_epi32(msg[next], tmp);
+        msg[next] = _mm_sha256msg2_epu32(msg[next], msg[cur]);
+    }
+    wk = _mm_shuffle_epi32(wk, 0x0E);
+    abef = _mm_sha256rnds2_epu32(abef, cdgh, wk);
+    if constexpr (G >= 1 && G <= 12)
+        msg[prev] = _mm_sha256msg1_epu32(msg[prev], msg[cur]);
+}
+
+template<std::size_t... G>
+PEELF_INLINE_SHA void sha256_rounds(__m128i& abef, __m128i& cdgh, __m128i (&msg)[4],
+                                    std::index_sequence<G...>) {
+    (sha256_quad<static_cast<int>(G)>(abef, cdgh, msg), ...);
+}
+
+PEELF_TARGET_SHA
+void sha256_shani(std::uint32_t* state, const std::uint8_t* data, std::size_t blocks) {
+    const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+
+    // state is A..H; the instructions want ABEF / CDGH
+    __m128i tmp = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state));
+    __m128i cdgh = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4));
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);
+    cdgh = _mm_shuffle_epi32(cdgh, 0x1B);
+    __m128i abef = _mm_alignr_epi8(tmp, cdgh, 8);
+    cdgh = _mm_blend_epi16(cdgh, tmp, 0xF0);
+
+    for (; blocks != 0; --blocks, data += 64) {
+        const __m128i abef_save = abef;
+        const __m128i cdgh_save = cdgh;
+
+        __m128i msg[4];
+        for (int i = 0; i < 4; ++i) {
+            msg[i] = _mm_shuffle_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * i)), bswap);
+        }
+        sha256_rounds(abef, cdgh, msg, std::make_index_sequence<16>{});
+
+        abef = _mm_add_epi32(abef, abef_save);
+        cdgh = _mm_add_epi32(cdgh, cdgh_save);
+    }
+
+    tmp = _mm_shuffle_epi32(abef, 0x1B);
+    cdgh = _mm_shuffle_epi32(cdgh, 0xB1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_blend_epi16(tmp, cdgh, 0xF0));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), _mm_alignr_epi8(cdgh, tmp, 8));
+}
+
+// -------------------------------------------------------------------------
+// SHA-1
+// -------------------------------------------------------------------------
+
+// Four rounds of group G (0..19). e[G % 2] carries the E term into this
+// group and e[(G + 1) % 2] receives the one for the next.
+template<int G>
+PEELF_INLINE_SHA void sha1_quad(__m128i& abcd, __m128i (&e)[2], __m128i (&msg)[4]) {
+    constexpr int cur = G % 4;
+
+    if constexpr (G == 0)
+        e[0] = _mm_add_epi32(e[0], msg[0]);
+    else
+        e[G % 2] = _mm_sha1nexte_epu32(e[G % 2], msg[cur]);
+    e[(G + 1) % 2] = abcd;
+    if constexpr (G >= 3 && G <= 18)
+        msg[(G + 1) % 4] = _mm_sha1msg2_epu32(msg[(G + 1) % 4], msg[cur]);
+    abcd = _mm_sha1rnds4_epu32(abcd, e[G % 2], G / 5);
+    if constexpr (G >= 1 && G <= 16)
+        msg[(G + 3) % 4] = _mm_sha1msg1_epu32(msg[(G + 3) % 4], msg[cur]);
+    if constexpr (G >= 2 && G <= 17)
+        msg[(G + 2) % 4] = _mm_xor_si128(msg[(G + 2) % 4], msg[cur]);
+}
+
+template<std::size_t... G>
+PEELF_INLINE_SHA void sha1_rounds(__m128i& abcd, __m128i (&e)[2], __m128i (&msg)[4],
+                                  std::index_sequence<G...>) {
+    (sha1_quad<static_cast<int>(G)>(abcd, e, msg), ...);
+}
+
+PEELF_TARGET_SHA
+void sha1_shani(std::uint32_t* state, const std::uint8_t* data, std::size_t blocks) {
+    const __m128i bswap = _mm_set_epi64x(0x0001020304050607LL, 0x08090a0b0c0d0e0fLL);
+
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0x1B);
+    __m128i e0 = _mm_set_epi32(static_cast<int>(state[4]), 0, 0, 0);
+
+    for (; blocks != 0; --blocks, data += 64) {
+        const __m128i abcd_save = abcd;
+        const __m128i e0_save = e0;
+
+        __m128i msg[4];
+        for (int i = 0; i < 4; ++i) {
+            msg[i] = _mm_shuffle_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * i)), bswap);
+        }
+        __m128i e[2] = {e0, _mm_setzero_si128()};
+        sha1_rounds(abcd, e, msg, std::make_index_sequence<20>{});
+
+        e0 = _mm_sha1nexte_epu32(e[0], e0_save);
+        abcd = _mm_add_epi32(abcd, abcd_save);
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi32(abcd, 0x1B));
+    state[4] = static_cast<std::uint32_t>(_mm_extract_epi32(e0, 3));
+}
+
+} // namespace
+
+const sha_block_fn sha1_blocks_shani = &sha1_shani;
+const sha_block_fn sha256_blocks_shani = &sha256_shani;
+
+} // namespace peelf::detail
+
+#else
+
+namespace peelf::detail {
+
+const sha_block_fn sha1_blocks_shani = nullptr;
+const sha_block_fn sha256_blocks_shani = nullptr;
+
+} // namespace peelf::detail
+
+#endif
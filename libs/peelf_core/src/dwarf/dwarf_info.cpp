@@ -0,0 +1,310 @@
+#include "dwarf/dwarf_info.hpp"
+
+#include <algorithm>
+
+#include "peelf/parallel.hpp"
+
+namespace peelf {
+
+namespace {
+
+std::optional<std::uint64_t> reference_offset(const DwarfUnit& unit, const DwarfFormValue& v) {
+    switch (v.form) {
+        case DW_FORM_ref1:
+        case DW_FORM_ref2:
+        case DW_FORM_ref4:
+        case DW_FORM_ref8:
+        case DW_FORM_ref_udata:
+            return unit.offset + v.value;
+        case DW_FORM_ref_addr:
+            return v.value;
+        default:
+            return std::nullopt;
+    }
+}
+
+ByteReader unit_reader(const DwarfSections& s, const DwarfUnit& unit, std::uint64_t pos) {
+    return ByteReader(s.info.first(static_cast<std::size_t>(unit.end)), s.big_endian, static_cast<std::size_t>(pos));
+}
+
+// Consumes one DIE's attributes, noting its DW_AT_sibling
+bool skip_attributes(ByteReader& r, const DwarfAbbrevTable& abbrevs, const DwarfAbbrev& abbrev,
+                     const DwarfUnit& unit, std::optional<std::uint64_t>& sibling) {
+    for (const auto& spec : abbrevs.attributes(abbrev)) {
+        DwarfFormValue v;
+        if (!read_form(r, spec.form, spec.implicit_const, unit, v))
+            return false;
+        if (spec.attribute == DW_AT_sibling)
+            sibling = reference_offset(unit, v);
+    }
+    return true;
+}
+
+// Consumes the children of a DIE whose attributes have been read, up to
+// and including the null entry that closes them
+bool skip_subtree(ByteReader& r, const DwarfAbbrevTable& abbrevs, const DwarfUnit& unit) {
+    std::size_t depth = 1;
+    while (depth > 0) {
+        const std::uint64_t code = r.uleb128();
+        if (!r.ok())
+            return false;
+        if (code == 0) {
+            --depth;
+            continue;
+        }
+        const DwarfAbbrev* abbrev = abbrevs.find(code);
+        std::optional<std::uint64_t> sibling;
+        if (!abbrev || !skip_attributes(r, abbrevs, *abbrev, unit, sibling))
+            return false;
+        if (!abbrev->has_children)
+            continue;
+        // A sibling pointer skips the whole subtree, its null entry included
+        if (sibling && *sibling > r.pos() && *sibling <= r.data().size())
+            r.seek(static_cast<std::size_t>(*sibling));
+        else
+            ++depth;
+    }
+    return true;
+}
+
+} // namespace
+
+std::expected<DwarfInfo, Error> DwarfInfo::load(const DwarfSections& s, std::size_t max_units) {
+    DwarfInfo out;
+    out.sections_ = s;
+    auto units = read_units(s, max_units);
+    if (!units)
+        return std::unexpected(units.error());
+    out.units_ = std::move(*units);
+
+    // Producers either share one table between all units or give each its
+    // own; parse every distinct one once
+    std::vector<std::uint64_t> offsets;
+    offsets.reserve(out.units_.size());
+    for (const auto& unit : out.units_)
+        offsets.push_back(unit.abbrev_offset);
+    std::sort(offsets.begin(), offsets.end());
+    offsets.erase(std::unique(offsets.begin(), offsets.end()), offsets.end());
+
+    out.abbrev_tables_.resize(offsets.size());
+    std::vector<std::optional<Error>> errors(offsets.size());
+    parallel_for(offsets.size(), [&](std::size_t i) {
+        auto table = DwarfAbbrevTable::parse(s.abbrev, offsets[i]);
+        if (table)
+            out.abbrev_tables_[i] = std::move(*table);
+        else
+            errors[i] = std::move(table.error());
+    }, 0, 16);
+    for (auto& error : errors) {
+        if (error)
+            return std::unexpected(std::move(*error));
+    }
+
+    out.unit_abbrevs_.resize(out.units_.size());
+    for (std::size_t i = 0; i < out.units_.size(); ++i) {
+        const auto it = std::lower_bound(offsets.begin(), offsets.end(), out.units_[i].abbrev_offset);
+        out.unit_abbrevs_[i] = static_cast<std::uint32_t>(it - offsets.begin());
+    }
+
+    // strx / addrx / rnglistx need the bases from each root DIE. A unit
+    // whose root cannot be read keeps zero bases and fails on its own later.
+    parallel_for(out.units_.size(), [&](std::size_t i) {
+        (void)read_unit_root(s, out.units_[i], out.abbrevs(i));
+    }, 0, 64);
+    return out;
+}
+
+std::optional<std::size_t> DwarfInfo::unit_at(std::uint64_t info_offset) const {
+    auto it = std::upper_bound(units_.begin(), units_.end(), info_offset,
+                               [](std::uint64_t off, const DwarfUnit& u) { return off < u.offset; });
+    if (it == units_.begin())
+        return std::nullopt;
+    --it;
+    if (!it->contains(info_offset))
+        return std::nullopt;
+    return static_cast<std::size_t>(it - units_.begin());
+}
+
+std::expected<DwarfDie, Error> DwarfInfo::die_at(std::uint64_t info_offset) const {
+    const auto index = unit_at(info_offset);
+    if (!index || info_offset < units_[*index].die_offset)
+        return std::unexpected(Error{"DIE offset is not inside a unit"});
+
+    auto r = unit_reader(sections_, units_[*index], info_offset);
+    const std::uint64_t code = r.uleb128();
+    if (!r.ok() || code == 0)
+        return std::unexpected(Error{"No DIE at offset"});
+    const DwarfAbbrev* abbrev = abbrevs(*index).find(code);
+    if (!abbrev)
+        return std::unexpected(Error{"Unknown abbreviation code"});
+    return DwarfDie{info_offset, static_cast<std::uint32_t>(*index), abbrev, r.pos()};
+}
+
+std::expected<DwarfDie, Error> DwarfInfo::root(std::size_t unit) const {
+    if (unit >= units_.size())
+        return std::unexpected(Error{"Unit index out of range"});
+    return die_at(units_[unit].die_offset);
+}
+
+std::expected<std::vector<DwarfAttribute>, Error> DwarfInfo::attributes(const DwarfDie& die) const {
+    const auto& unit = units_[die.unit];
+    auto r = unit_reader(sections_, unit, die.attributes_offset);
+    const auto& table = abbrevs(die.unit);
+    std::vector<DwarfAttribute> out;
+    out.reserve(die.abbrev->spec_count);
+    for (const auto& spec : table.attributes(*die.abbrev)) {
+        DwarfAttribute a;
+        a.attribute = spec.attribute;
+        if (!read_form(r, spec.form, spec.implicit_const, unit, a.value))
+            return std::unexpected(Error{"Unsupported or truncated attribute"});
+        out.push_back(a);
+    }
+    return out;
+}
+
+std::optional<DwarfFormValue> DwarfInfo::attribute(const DwarfDie& die, std::uint16_t attribute) const {
+    const auto& unit = units_[die.unit];
+    auto r = unit_reader(sections_, unit, die.attributes_offset);
+    for (const auto& spec : abbrevs(die.unit).attributes(*die.abbrev)) {
+        DwarfFormValue v;
+        if (!read_form(r, spec.form, spec.implicit_const, unit, v))
+            return std::nullopt;
+        if (spec.attribute == attribute)
+            return v;
+    }
+    return std::nullopt;
+}
+
+std::string_view DwarfInfo::name(const DwarfDie& die) const {
+    const auto v = attribute(die, DW_AT_name);
+    return v ? string(die, *v) : std::string_view{};
+}
+
+std::string_view DwarfInfo::linkage_name(const DwarfDie& die) const {
+    const auto& unit = units_[die.unit];
+    auto r = unit_reader(sections_, unit, die.attributes_offset);
+    for (const auto& spec : abbrevs(die.unit).attributes(*die.abbrev)) {
+        DwarfFormValue v;
+        if (!read_form(r, spec.form, spec.implicit_const, unit, v))
+            break;
+        if (spec.attribute == DW_AT_linkage_name || spec.attribute == DW_AT_MIPS_linkage_name)
+            return string(die, v);
+    }
+    return {};
+}
+
+std::optional<std::uint64_t> DwarfInfo::reference(const DwarfDie& die, const DwarfFormValue& v) const {
+    return reference_offset(units_[die.unit], v);
+}
+
+std::expected<std::vector<DwarfDie>, Error> DwarfInfo::children(const DwarfDie& die) const {
+    std::vector<DwarfDie> out;
+    if (!die.has_children())
+        return out;
+
+    const auto& unit = units_[die.unit];
+    const auto& table = abbrevs(die.unit);
+    auto r = unit_reader(sections_, unit, die.attributes_offset);
+    std::optional<std::uint64_t> sibling;
+    if (!skip_attributes(r, table, *die.abbrev, unit, sibling))
+        return std::unexpected(Error{"Unsupported or truncated attribute"});
+    for (;;) {
+        const std::uint64_t offset = r.pos();
+        const std::uint64_t code = r.uleb128();
+        if (!r.ok())
+            return std::unexpected(Error{"Children run past the unit"});
+        if (code == 0)
+            return out;
+        const DwarfAbbrev* abbrev = table.find(code);
+        if (!abbrev)
+            return std::unexpected(Error{"Unknown abbreviation code"});
+        out.push_back(DwarfDie{offset, die.unit, abbrev, r.pos()});
+
+        sibling.reset();
+        if (!skip_attributes(r, table, *abbrev, unit, sibling))
+            return std::unexpected(Error{"Unsupported or truncated attribute"});
+        if (!abbrev->has_children)
+            continue;
+        if (sibling && *sibling > r.pos() && *sibling <= r.data().size())
+            r.seek(static_cast<std::size_t>(*sibling));
+        else if (!skip_subtree(r, table, unit))
+            return std::unexpected(Error{"Malformed DIE tree"});
+    }
+}
+
+DwarfUnitCursor::DwarfUnitCursor(const DwarfInfo& info, std::size_t unit)
+    : unit_(&info.units()[unit]),
+      abbrevs_(&info.abbrevs(unit)),
+      reader_(unit_reader(info.sections(), info.units()[unit], info.units()[unit].die_offset)),
+      unit_index_(static_cast<std::uint32_t>(unit)) {}
+
+bool DwarfUnitCursor::finish_attributes() {
+    if (attributes_read_ || !current_)
+        return ok();
+    attributes_read_ = true;
+    attributes_.clear();
+    sibling_.reset();
+    for (const auto& spec : abbrevs_->attributes(*current_->abbrev)) {
+        DwarfAttribute a;
+        a.attribute = spec.attribute;
+        if (!read_form(reader_, spec.form, spec.implicit_const, *unit_, a.value)) {
+            ok_ = false;
+            return false;
+        }
+        if (spec.attribute == DW_AT_sibling)
+            sibling_ = reference_offset(*unit_, a.value);
+        attributes_.push_back(a);
+    }
+    return true;
+}
+
+std::optional<DwarfDie> DwarfUnitCursor::next() {
+    if (!finish_attributes())
+        return std::nullopt;
+    current_.reset();
+    while (!reader_.at_end()) {
+        const std::uint64_t offset = reader_.pos();
+        const std::uint64_t code = reader_.uleb128();
+        if (!reader_.ok())
+            break;
+        if (code == 0) {
+            // Closes a sibling chain; trailing padding past the root's
+            // chain is tolerated
+            if (level_ > 0)
+                --level_;
+            continue;
+        }
+        const DwarfAbbrev* abbrev = abbrevs_->find(code);
+        if (!abbrev) {
+            ok_ = false;
+            return std::nullopt;
+        }
+        depth_ = level_;
+        if (abbrev->has_children)
+            ++level_;
+        current_ = DwarfDie{offset, unit_index_, abbrev, reader_.pos()};
+        attributes_read_ = false;
+        return current_;
+    }
+    if (!reader_.ok())
+        ok_ = false;
+    return std::nullopt;
+}
+
+std::span<const DwarfAttribute> DwarfUnitCursor::attributes() {
+    finish_attributes();
+    return attributes_;
+}
+
+void DwarfUnitCursor::skip_children() {
+    if (!current_ || !current_->has_children() || !finish_attributes())
+        return;
+    if (sibling_ && *sibling_ > reader_.pos() && *sibling_ <= reader_.data().size())
+        reader_.seek(static_cast<std::size_t>(*sibling_));
+    else if (!skip_subtree(reader_, *abbrevs_, *unit_))
+        ok_ = false;
+    --level_;
+    current_.reset();
+}
+
+} // namespace peelf
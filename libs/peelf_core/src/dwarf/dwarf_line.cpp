@@ -0,0 +1,465 @@
+#include "dwarf/dwarf_line.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include "peelf/byte_reader.hpp"
+#include "peelf/parallel.hpp"
+
+namespace peelf {
+
+namespace {
+
+bool is_absolute(std::string_view path) {
+    return path.starts_with('/') || path.starts_with('\\')
+        || (path.size() > 2 && path[1] == ':' && (path[2] == '\\' || path[2] == '/'));
+}
+
+void append_path(std::string& out, std::string_view part) {
+    if (part.empty())
+        return;
+    if (is_absolute(part)) {
+        out.assign(part);
+        return;
+    }
+    if (!out.empty() && out.back() != '/' && out.back() != '\\')
+        out += '/';
+    out += part;
+}
+
+// Lines and columns are stored narrower than the registers; programs that
+// overflow them are broken anyway, so saturate rather than fail
+template<typename T>
+T saturate(std::uint64_t v) {
+    return v > std::numeric_limits<T>::max() ? std::numeric_limits<T>::max() : static_cast<T>(v);
+}
+
+struct Sequence {
+    std::size_t first;
+    std::size_t last;                   // one past the end_sequence row
+};
+
+} // namespace
+
+std::expected<DwarfLineTable, Error> DwarfLineTable::parse(const DwarfSections& s, std::uint64_t offset,
+                                                           std::string_view comp_dir, std::size_t max_rows) {
+    if (offset >= s.line.size())
+        return std::unexpected(Error{"Line table offset out of range"});
+
+    ByteReader r(s.line, s.big_endian, static_cast<std::size_t>(offset));
+    DwarfUnit unit;                     // sizes for read_form() in the DWARF 5 header
+    unit.address_size = s.address_size;
+    std::uint64_t length = r.u32();
+    if (length == 0xFFFFFFFFu) {
+        length = r.u64();
+        unit.offset_size = 8;
+    }
+    if (!r.ok() || length > r.remaining())
+        return std::unexpected(Error{"Line table runs past .debug_line"});
+    const std::size_t end = r.pos() + static_cast<std::size_t>(length);
+    r = ByteReader(s.line.first(end), s.big_endian, r.pos());
+
+    DwarfLineTable out;
+    out.comp_dir_ = comp_dir;
+    out.version_ = r.u16();
+    unit.version = out.version_;
+    if (out.version_ < 2 || out.version_ > 5)
+        return std::unexpected(Error{"Unsupported line table version " + std::to_string(out.version_)});
+    if (out.version_ >= 5) {
+        unit.address_size = r.u8();
+        (void)r.u8();                   // segment selector size
+    }
+    const std::uint64_t header_length = r.unsigned_of(unit.offset_size);
+    if (!r.ok() || header_length > r.remaining())
+        return std::unexpected(Error{"Line table header truncated"});
+    const std::size_t program = r.pos() + static_cast<std::size_t>(header_length);
+
+    const std::uint8_t min_inst_length = r.u8();
+    const std::uint8_t max_ops = out.version_ >= 4 ? r.u8() : 1;
+    const bool default_is_stmt = r.u8() != 0;
+    const auto line_base = static_cast<std::int8_t>(r.u8());
+    const std::uint8_t line_range = r.u8();
+    const std::uint8_t opcode_base = r.u8();
+    const auto standard_lengths = r.bytes(opcode_base > 0 ? opcode_base - 1u : 0u);
+    if (!r.ok() || line_range == 0 || opcode_base == 0 || max_ops == 0)
+        return std::unexpected(Error{"Invalid line table header"});
+
+    if (out.version_ < 5) {
+        for (;;) {
+            const auto dir = r.cstring();
+            if (!r.ok() || dir.empty())
+                break;
+            out.dirs_.push_back(dir);
+        }
+        for (;;) {
+            const auto name = r.cstring();
+            if (!r.ok() || name.empty())
+                break;
+            FileEntry f{name, r.uleb128()};
+            (void)r.uleb128();          // mtime
+            (void)r.uleb128();          // length
+            out.files_.push_back(f);
+        }
+    } else {
+        // Directory and file entries are described by (content, form) lists
+        const auto read_entries = [&](auto&& store) -> bool {
+            const std::uint8_t format_count = r.u8();
+            std::vector<std::pair<std::uint64_t, std::uint16_t>> format(format_count);
+            for (auto& [content, form] : format) {
+                content = r.uleb128();
+                form = static_cast<std::uint16_t>(r.uleb128());
+            }
+            const std::uint64_t count = r.uleb128();
+            if (!r.ok() || count > r.remaining())
+                return false;
+            for (std::uint64_t i = 0; i < count; ++i) {
+                FileEntry e;
+                for (const auto& [content, form] : format) {
+                    DwarfFormValue v;
+                    if (!read_form(r, form, 0, unit, v))
+                        return false;
+                    if (content == DW_LNCT_path)
+                        e.name = form_string(s, unit, v);
+                    else if (content == DW_LNCT_directory_index)
+                        e.dir = v.value;
+                }
+                store(e);
+            }
+            return true;
+        };
+        if (!read_entries([&](const FileEntry& e) { out.dirs_.push_back(e.name); })
+            || !read_entries([&](const FileEntry& e) { out.files_.push_back(e); }))
+            return std::unexpected(Error{"Line table header entries truncated"});
+    }
+    r.seek(program);
+    if (!r.ok())
+        return std::unexpected(Error{"Line table header truncated"});
+
+    // The state machine. Rows are appended in program order; sequences
+    // are recorded so they can be sorted by start address afterwards.
+    std::uint64_t address = 0;
+    std::uint64_t op_index = 0;
+    std::uint64_t file = 1;
+    std::int64_t line = 1;
+    std::uint64_t column = 0;
+    bool is_stmt = default_is_stmt;
+    bool prologue_end = false;
+    bool epilogue_begin = false;
+    std::vector<Sequence> sequences;
+    std::size_t sequence_start = 0;
+
+    const auto reset = [&] {
+        address = 0;
+        op_index = 0;
+        file = 1;
+        line = 1;
+        column = 0;
+        is_stmt = default_is_stmt;
+        prologue_end = false;
+        epilogue_begin = false;
+    };
+    const auto advance = [&](std::uint64_t operation_advance) {
+        if (max_ops == 1) {
+            address += min_inst_length * operation_advance;
+        } else {
+            address += min_inst_length * ((op_index + operation_advance) / max_ops);
+            op_index = (op_index + operation_advance) % max_ops;
+        }
+    };
+    const auto emit = [&](bool end_sequence) {
+        std::uint8_t flags = 0;
+        if (is_stmt)        flags |= flag_is_stmt;
+        if (end_sequence)   flags |= flag_end_sequence;
+        if (prologue_end)   flags |= flag_prologue_end;
+        if (epilogue_begin) flags |= flag_epilogue_begin;
+        out.addresses_.push_back(unit.address_size == 4 ? address & 0xFFFFFFFFu : address);
+        out.rows_.push_back(Row{saturate<std::uint32_t>(file), saturate<std::uint32_t>(static_cast<std::uint64_t>(std::max<std::int64_t>(line, 0))),
+                                saturate<std::uint16_t>(column), flags});
+        prologue_end = false;
+        epilogue_begin = false;
+    };
+
+    while (!r.at_end()) {
+        if (out.rows_.size() >= max_rows)
+            return std::unexpected(Error{"Line table exceeds row budget"});
+        const std::uint8_t op = r.u8();
+        if (op >= opcode_base) {
+            const std::uint8_t adjusted = static_cast<std::uint8_t>(op - opcode_base);
+            advance(adjusted / line_range);
+            line += line_base + adjusted % line_range;
+            emit(false);
+            continue;
+        }
+        switch (op) {
+            case 0: {
+                const std::uint64_t len = r.uleb128();
+                if (!r.ok() || len == 0 || len > r.remaining())
+                    return std::unexpected(Error{"Extended line opcode truncated"});
+                const std::size_t next = r.pos() + static_cast<std::size_t>(len);
+                switch (r.u8()) {
+                    case DW_LNE_end_sequence:
+                        emit(true);
+                        sequences.push_back(Sequence{sequence_start, out.rows_.size()});
+                        sequence_start = out.rows_.size();
+                        reset();
+                        break;
+                    case DW_LNE_set_address:
+                        address = r.unsigned_of(static_cast<std::size_t>(len - 1));
+                        op_index = 0;
+                        break;
+                    case DW_LNE_define_file: {
+                        FileEntry f{r.cstring(), r.uleb128()};
+                        out.files_.push_back(f);
+                        break;
+                    }
+                    default:                // set_discriminator, vendor extensions
+                        break;
+                }
+                r.seek(next);
+                break;
+            }
+            case DW_LNS_copy:               emit(false); break;
+            case DW_LNS_advance_pc:         advance(r.uleb128()); break;
+            case DW_LNS_advance_line:       line += r.sleb128(); break;
+            case DW_LNS_set_file:           file = r.uleb128(); break;
+            case DW_LNS_set_column:         column = r.uleb128(); break;
+            case DW_LNS_negate_stmt:        is_stmt = !is_stmt; break;
+            case DW_LNS_set_basic_block:    break;
+            case DW_LNS_const_add_pc:       advance((255u - opcode_base) / line_range); break;
+            case DW_LNS_fixed_advance_pc:   address += r.u16(); op_index = 0; break;
+            case DW_LNS_set_prologue_end:   prologue_end = true; break;
+            case DW_LNS_set_epilogue_begin: epilogue_begin = true; break;
+            case DW_LNS_set_isa:            (void)r.uleb128(); break;
+            default:
+                // Unknown standard opcode: its operand count is in the header
+                for (std::uint8_t i = 0; i < standard_lengths[op - 1u]; ++i)
+                    (void)r.uleb128();
+                break;
+        }
+        if (!r.ok())
+            return std::unexpected(Error{"Line number program truncated"});
+    }
+
+    // Drop rows after the last end_sequence and sequences the linker
+    // tombstoned (functions discarded by --gc-sections or COMDAT folding)
+    const std::uint64_t tombstone = unit.address_size == 4 ? 0xFFFFFFFEu : 0xFFFFFFFFFFFFFFFEu;
+    const std::size_t sequence_count = sequences.size();
+    std::erase_if(sequences, [&](const Sequence& q) { return out.addresses_[q.first] >= tombstone; });
+    const auto by_start = [&](const Sequence& a, const Sequence& b) {
+        return out.addresses_[a.first] < out.addresses_[b.first];
+    };
+    const bool complete = sequences.size() == sequence_count && sequence_start == out.rows_.size();
+    if (!complete || !std::is_sorted(sequences.begin(), sequences.end(), by_start)) {
+        std::stable_sort(sequences.begin(), sequences.end(), by_start);
+        std::vector<std::uint64_t> addresses;
+        std::vector<Row> rows;
+        for (const auto& q : sequences) {
+            addresses.insert(addresses.end(), out.addresses_.begin() + static_cast<std::ptrdiff_t>(q.first),
+                             out.addresses_.begin() + static_cast<std::ptrdiff_t>(q.last));
+            rows.insert(rows.end(), out.rows_.begin() + static_cast<std::ptrdiff_t>(q.first),
+                        out.rows_.begin() + static_cast<std::ptrdiff_t>(q.last));
+        }
+        out.addresses_ = std::move(addresses);
+        out.rows_ = std::move(rows);
+    }
+    out.addresses_.shrink_to_fit();
+    out.rows_.shrink_to_fit();
+    return out;
+}
+
+DwarfLineRow DwarfLineTable::row(std::size_t i) const {
+    const Row& r = rows_[i];
+    return DwarfLineRow{
+        .address = addresses_[i],
+        .file = r.file,
+        .line = r.line,
+        .column = r.column,
+        .is_stmt = (r.flags & flag_is_stmt) != 0,
+        .end_sequence = (r.flags & flag_end_sequence) != 0,
+        .prologue_end = (r.flags & flag_prologue_end) != 0,
+        .epilogue_begin = (r.flags & flag_epilogue_begin) != 0,
+    };
+}
+
+std::optional<DwarfLineRow> DwarfLineTable::find(std::uint64_t address) const {
+    auto it = std::upper_bound(addresses_.begin(), addresses_.end(), address);
+    if (it == addresses_.begin())
+        return std::nullopt;
+    const auto i = static_cast<std::size_t>(it - addresses_.begin()) - 1;
+    if (rows_[i].flags & flag_end_sequence)
+        return std::nullopt;            // in a gap between sequences
+    return row(i);
+}
+
+const DwarfLineTable::FileEntry* DwarfLineTable::file_entry(std::uint32_t file) const {
+    // File numbers are 1-based before DWARF 5
+    const std::size_t index = version_ >= 5 ? file : file - std::size_t{1};
+    if (version_ < 5 && file == 0)
+        return nullptr;
+    return index < files_.size() ? &files_[index] : nullptr;
+}
+
+std::string_view DwarfLineTable::file_name(std::uint32_t file) const {
+    const FileEntry* f = file_entry(file);
+    return f ? f->name : std::string_view{};
+}
+
+std::string DwarfLineTable::file_path(std::uint32_t file) const {
+    const FileEntry* f = file_entry(file);
+    if (!f)
+        return {};
+    std::string path(comp_dir_);
+    if (version_ >= 5) {
+        if (f->dir < dirs_.size())
+            append_path(path, dirs_[f->dir]);
+    } else if (f->dir != 0 && f->dir <= dirs_.size()) {
+        append_path(path, dirs_[f->dir - 1]);
+    }
+    append_path(path, f->name);
+    return path;
+}
+
+std::size_t DwarfLineTable::memory_usage() const {
+    return sizeof(*this) + addresses_.capacity() * sizeof(std::uint64_t) + rows_.capacity() * sizeof(Row)
+         + dirs_.capacity() * sizeof(std::string_view) + files_.capacity() * sizeof(FileEntry);
+}
+
+std::expected<DwarfLineIndex, Error> DwarfLineIndex::build(const DwarfSections& s, std::size_t cache_bytes) {
+    DwarfLineIndex out;
+    out.sections_ = s;
+    out.cache_ = std::make_unique<LruCache<std::uint64_t, DwarfLineTable>>(cache_bytes);
+
+    auto units = read_units(s);
+    if (!units)
+        return std::unexpected(units.error());
+    out.units_ = std::move(*units);
+
+    std::vector<bool> covered(out.units_.size(), false);
+    if (auto ok = out.read_aranges(covered); !ok)
+        return std::unexpected(ok.error());
+
+    // Units .debug_aranges left out (clang does not emit it by default):
+    // ranges from the root DIE, one unit per task
+    std::vector<std::size_t> missing;
+    for (std::size_t i = 0; i < out.units_.size(); ++i) {
+        const auto type = out.units_[i].unit_type;
+        if (!covered[i] && (type == DW_UT_compile || type == DW_UT_partial || type == DW_UT_skeleton))
+            missing.push_back(i);
+    }
+    std::vector<std::vector<DwarfRange>> found(missing.size());
+    parallel_for(missing.size(), [&](std::size_t k) {
+        DwarfUnit unit = out.units_[missing[k]];
+        auto abbrevs = DwarfAbbrevTable::parse(s.abbrev, unit.abbrev_offset);
+        if (!abbrevs)
+            return;
+        // A unit that cannot be read only loses its own lookups
+        if (auto root = read_unit_root(s, unit, *abbrevs))
+            found[k] = std::move(root->ranges);
+    }, 0, 64);
+    for (std::size_t k = 0; k < missing.size(); ++k) {
+        for (const auto& range : found[k])
+            out.ranges_.push_back(UnitRange{range.begin, range.end, missing[k]});
+    }
+
+    std::sort(out.ranges_.begin(), out.ranges_.end(),
+              [](const UnitRange& a, const UnitRange& b) { return a.begin < b.begin; });
+    return out;
+}
+
+std::expected<void, Error> DwarfLineIndex::read_aranges(std::vector<bool>& covered) {
+    const auto& s = sections_;
+    std::size_t pos = 0;
+    while (pos < s.aranges.size()) {
+        ByteReader r(s.aranges, s.big_endian, pos);
+        std::size_t offset_size = 4;
+        std::uint64_t length = r.u32();
+        if (length == 0xFFFFFFFFu) {
+            length = r.u64();
+            offset_size = 8;
+        }
+        if (!r.ok() || length > r.remaining())
+            return std::unexpected(Error{"Address range set runs past .debug_aranges"});
+        const std::size_t end = r.pos() + static_cast<std::size_t>(length);
+        r = ByteReader(s.aranges.first(end), s.big_endian, r.pos());
+
+        (void)r.u16();                  // version
+        const std::uint64_t info_offset = r.unsigned_of(offset_size);
+        const std::uint8_t address_size = r.u8();
+        const std::uint8_t segment_size = r.u8();
+        if (!r.ok() || (address_size != 4 && address_size != 8) || segment_size != 0)
+            return std::unexpected(Error{"Unsupported address range set"});
+
+        // Tuples start at a multiple of their own size from the set start
+        const std::size_t tuple = 2u * address_size;
+        r.seek(pos + (r.pos() - pos + tuple - 1) / tuple * tuple);
+
+        auto unit = std::lower_bound(units_.begin(), units_.end(), info_offset,
+                                     [](const DwarfUnit& u, std::uint64_t off) { return u.offset < off; });
+        const bool known = unit != units_.end() && unit->offset == info_offset;
+        const auto index = static_cast<std::size_t>(unit - units_.begin());
+        while (r.remaining() >= tuple) {
+            const std::uint64_t begin = r.unsigned_of(address_size);
+            const std::uint64_t size = r.unsigned_of(address_size);
+            if (begin == 0 && size == 0)
+                break;
+            if (known && size != 0)
+                ranges_.push_back(UnitRange{begin, begin + size, index});
+        }
+        if (known)
+            covered[index] = true;
+        pos = end;
+    }
+    return {};
+}
+
+std::optional<std::size_t> DwarfLineIndex::unit_for_address(std::uint64_t address) const {
+    auto it = std::upper_bound(ranges_.begin(), ranges_.end(), address,
+                               [](std::uint64_t a, const UnitRange& r) { return a < r.begin; });
+    if (it == ranges_.begin())
+        return std::nullopt;
+    --it;
+    if (address >= it->end)
+        return std::nullopt;
+    return it->unit;
+}
+
+std::expected<std::shared_ptr<const DwarfLineTable>, Error> DwarfLineIndex::line_table(std::size_t unit) const {
+    if (unit >= units_.size())
+        return std::unexpected(Error{"Unit index out of range"});
+    if (auto cached = cache_->get(unit))
+        return cached;
+
+    // Decoded outside the cache lock; two threads missing on the same
+    // unit both decode it and the second put() wins
+    DwarfUnit u = units_[unit];
+    auto abbrevs = DwarfAbbrevTable::parse(sections_.abbrev, u.abbrev_offset);
+    if (!abbrevs)
+        return std::unexpected(abbrevs.error());
+    auto root = read_unit_root(sections_, u, *abbrevs);
+    if (!root)
+        return std::unexpected(root.error());
+    if (!root->stmt_list)
+        return std::shared_ptr<const DwarfLineTable>();
+
+    auto table = DwarfLineTable::parse(sections_, *root->stmt_list, root->comp_dir);
+    if (!table)
+        return std::unexpected(table.error());
+    auto shared = std::make_shared<const DwarfLineTable>(std::move(*table));
+    cache_->put(unit, shared, shared->memory_usage());
+    return shared;
+}
+
+std::optional<DwarfSourceLocation> DwarfLineIndex::lookup(std::uint64_t address) const {
+    const auto unit = unit_for_address(address);
+    if (!unit)
+        return std::nullopt;
+    auto table = line_table(*unit);
+    if (!table || !*table)
+        return std::nullopt;
+    const auto row = (*table)->find(address);
+    if (!row)
+        return std::nullopt;
+    return DwarfSourceLocation{(*table)->file_path(row->file), row->line, row->column};
+}
+
+} // namespace peelf
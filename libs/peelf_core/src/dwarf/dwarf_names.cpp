@@ -0,0 +1,605 @@
+#include "dwarf/dwarf_names.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <optional>
+#include <string>
+
+#include "elf/elf_view.hpp"
+#include "peelf/parallel.hpp"
+
+namespace peelf {
+
+namespace {
+
+struct DieNames {
+    std::string_view name;
+    std::string_view linkage;
+    bool declaration = false;
+    std::optional<std::uint64_t> origin;    // DW_AT_specification / DW_AT_abstract_origin
+};
+
+// Names of a DIE. Out-of-line definitions and concrete instances carry
+// at most a linkage name themselves and borrow the rest through
+// DW_AT_specification or DW_AT_abstract_origin; a few hops cover every
+// producer in practice.
+DieNames die_names(const DwarfInfo& info, const DwarfDie& die, std::span<const DwarfAttribute> attributes) {
+    DieNames out;
+    for (const auto& a : attributes) {
+        switch (a.attribute) {
+            case DW_AT_name:
+                out.name = info.string(die, a.value);
+                break;
+            case DW_AT_linkage_name:
+            case DW_AT_MIPS_linkage_name:
+                out.linkage = info.string(die, a.value);
+                break;
+            case DW_AT_declaration:
+                out.declaration = a.value.value != 0;
+                break;
+            case DW_AT_specification:
+            case DW_AT_abstract_origin:
+                out.origin = info.reference(die, a.value);
+                break;
+            default:
+                break;
+        }
+    }
+
+    // A plain offset and flag rather than a copy of the optional: GCC
+    // reports the copy as maybe-uninitialized at -O2
+    bool follow = out.origin.has_value();
+    std::uint64_t origin = out.origin.value_or(0);
+    for (int hops = 0; hops < 4 && follow && out.name.empty(); ++hops) {
+        auto target = info.die_at(origin);
+        if (!target)
+            break;
+        auto attrs = info.attributes(*target);
+        if (!attrs)
+            break;
+        follow = false;
+        for (const auto& a : *attrs) {
+            if (a.attribute == DW_AT_name) {
+                out.name = info.string(*target, a.value);
+            } else if ((a.attribute == DW_AT_linkage_name || a.attribute == DW_AT_MIPS_linkage_name) && out.linkage.empty()) {
+                out.linkage = info.string(*target, a.value);
+            } else if (a.attribute == DW_AT_specification || a.attribute == DW_AT_abstract_origin) {
+                const auto ref = info.reference(*target, a.value);
+                follow = ref.has_value();
+                origin = ref.value_or(0);
+            }
+        }
+    }
+    return out;
+}
+
+bool is_named_entity(std::uint16_t tag) {
+    switch (tag) {
+        case DW_TAG_subprogram:
+        case DW_TAG_variable:
+        case DW_TAG_base_type:
+        case DW_TAG_class_type:
+        case DW_TAG_structure_type:
+        case DW_TAG_union_type:
+        case DW_TAG_enumeration_type:
+        case DW_TAG_enumerator:
+        case DW_TAG_typedef:
+        case DW_TAG_namespace:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// DIEs whose children can hold more global names; everything else
+// (function bodies in particular) is skipped wholesale
+bool is_scope(std::uint16_t tag) {
+    switch (tag) {
+        case DW_TAG_compile_unit:
+        case DW_TAG_partial_unit:
+        case DW_TAG_type_unit:
+        case DW_TAG_skeleton_unit:
+        case DW_TAG_namespace:
+        case DW_TAG_class_type:
+        case DW_TAG_structure_type:
+        case DW_TAG_union_type:
+        case DW_TAG_enumeration_type:
+            return true;
+        default:
+            return false;
+    }
+}
+
+std::uint64_t scan_hash(std::string_view name) {
+    return std::hash<std::string_view>{}(name);
+}
+
+// Walks one unit, calling f(die, names, scope) for every named entity,
+// declarations included. scope holds the enclosing namespace and type
+// names, outermost first.
+template<typename F>
+bool walk_named(const DwarfInfo& info, std::size_t unit, F&& f) {
+    DwarfUnitCursor cursor(info, unit);
+    std::vector<std::string_view> scope;
+    while (auto die = cursor.next()) {
+        const std::uint16_t tag = die->tag();
+        const bool named = is_named_entity(tag);
+        const bool nested = die->has_children() && is_scope(tag);
+        if (!named && !nested) {
+            cursor.skip_children();
+            continue;
+        }
+
+        scope.resize(std::min(scope.size(), cursor.depth()));
+        const auto names = die_names(info, *die, cursor.attributes());
+        if (named && (!names.name.empty() || !names.linkage.empty()))
+            f(*die, names, std::span<const std::string_view>(scope));
+        if (nested) {
+            scope.resize(cursor.depth());
+            scope.push_back(tag == DW_TAG_compile_unit || tag == DW_TAG_partial_unit ||
+                            tag == DW_TAG_type_unit || tag == DW_TAG_skeleton_unit ? std::string_view{} : names.name);
+        } else {
+            cursor.skip_children();
+        }
+    }
+    return cursor.ok();
+}
+
+std::string qualified_name(std::span<const std::string_view> scope, std::string_view name) {
+    std::string out;
+    for (const auto& part : scope) {
+        if (part.empty())
+            continue;
+        out += part;
+        out += "::";
+    }
+    out += name;
+    return out;
+}
+
+} // namespace
+
+std::uint32_t DwarfNameIndex::debug_names_hash(std::string_view name) {
+    std::uint32_t h = 5381;
+    for (const char c : name) {
+        auto u = static_cast<std::uint8_t>(c);
+        if (u >= 'A' && u <= 'Z')
+            u = static_cast<std::uint8_t>(u - 'A' + 'a');
+        h = h * 33 + u;
+    }
+    return h;
+}
+
+std::uint32_t DwarfNameIndex::gdb_index_hash(std::string_view name) {
+    std::uint32_t h = 0;
+    for (const char c : name) {
+        auto u = static_cast<std::uint8_t>(c);
+        if (u >= 'A' && u <= 'Z')
+            u = static_cast<std::uint8_t>(u - 'A' + 'a');
+        h = h * 67 + u - 113;
+    }
+    return h;
+}
+
+std::expected<DwarfNameIndex, Error> DwarfNameIndex::build(const DwarfInfo& info, std::size_t threads) {
+    DwarfNameIndex out;
+    out.info_ = &info;
+    const auto& s = info.sections();
+    std::vector<bool> covered(info.units().size(), false);
+
+    // A malformed accelerator table costs speed, not answers: the scan
+    // below then covers the units it would have
+    if (!s.names.empty()) {
+        if (out.load_debug_names(covered)) {
+            out.source_ = DwarfNameSource::DebugNames;
+        } else {
+            out.names_tables_.clear();
+            covered.assign(covered.size(), false);
+        }
+    }
+    if (out.source_ == DwarfNameSource::Scan && !s.gdb_index.empty()) {
+        if (out.load_gdb_index(covered)) {
+            out.source_ = DwarfNameSource::GdbIndex;
+        } else {
+            out.gdb_ = GdbIndex{};
+            covered.assign(covered.size(), false);
+        }
+    }
+
+    std::vector<std::size_t> todo;
+    std::vector<std::size_t> deferred;
+    for (std::size_t i = 0; i < covered.size(); ++i)
+        (covered[i] ? deferred : todo).push_back(i);
+    out.scanned_units_ = todo.size();
+    out.entries_ = scan(info, todo, threads);
+    if (out.source_ == DwarfNameSource::GdbIndex && !deferred.empty()) {
+        out.deferred_ = std::make_shared<DeferredScan>();
+        out.deferred_->units = std::move(deferred);
+        out.deferred_->threads = threads;
+    }
+    return out;
+}
+
+std::size_t DwarfNameIndex::name_count() const {
+    std::size_t n = entries_.size() + gdb_.used_slots;
+    for (const auto& t : names_tables_)
+        n += t.name_count;
+    return n;
+}
+
+std::expected<void, Error> DwarfNameIndex::load_debug_names(std::vector<bool>& covered) {
+    const auto& s = info_->sections();
+    std::size_t pos = 0;
+    while (pos < s.names.size()) {
+        ByteReader r(s.names, s.big_endian, pos);
+        NamesTable t;
+        std::uint64_t length = r.u32();
+        if (length == 0xFFFFFFFFu) {
+            length = r.u64();
+            t.offset_size = 8;
+        }
+        if (!r.ok() || length > r.remaining())
+            return std::unexpected(Error{"Name index runs past .debug_names"});
+        t.end = r.pos() + static_cast<std::size_t>(length);
+        r = ByteReader(s.names.first(t.end), s.big_endian, r.pos());
+
+        if (r.u16() != 5)
+            return std::unexpected(Error{"Unsupported .debug_names version"});
+        (void)r.u16();                  // padding
+        t.cu_count = r.u32();
+        t.local_tu_count = r.u32();
+        const std::uint32_t foreign_tu_count = r.u32();
+        t.bucket_count = r.u32();
+        t.name_count = r.u32();
+        const std::uint32_t abbrev_size = r.u32();
+        r.skip(r.u32());                // augmentation string, already padded
+
+        // Every array is sized by the header; check each against what is left
+        const auto take = [&r](std::uint64_t count, std::size_t size) {
+            const std::size_t at = r.pos();
+            if (count > r.remaining() / size)
+                r.fail();
+            else
+                r.skip(static_cast<std::size_t>(count) * size);
+            return at;
+        };
+        t.cu_list = take(t.cu_count, t.offset_size);
+        t.local_tu_list = take(t.local_tu_count, t.offset_size);
+        (void)take(foreign_tu_count, 8);
+        t.buckets = take(t.bucket_count, 4);
+        t.hashes = take(t.bucket_count ? t.name_count : 0, 4);
+        t.string_offsets = take(t.name_count, t.offset_size);
+        t.entry_offsets = take(t.name_count, t.offset_size);
+
+        ByteReader a(r.bytes(abbrev_size), s.big_endian);
+        t.entry_pool = r.pos();
+        if (!r.ok())
+            return std::unexpected(Error{"Name index header truncated"});
+        for (;;) {
+            NamesAbbrev abbrev;
+            abbrev.code = a.uleb128();
+            if (!a.ok())
+                return std::unexpected(Error{"Name index abbreviations truncated"});
+            if (abbrev.code == 0)
+                break;
+            abbrev.tag = static_cast<std::uint16_t>(a.uleb128());
+            abbrev.first_attr = static_cast<std::uint32_t>(t.attrs.size());
+            for (;;) {
+                const auto index = static_cast<std::uint16_t>(a.uleb128());
+                const auto form = static_cast<std::uint16_t>(a.uleb128());
+                if (!a.ok())
+                    return std::unexpected(Error{"Name index abbreviations truncated"});
+                if (index == 0 && form == 0)
+                    break;
+                t.attrs.push_back(NamesAttr{index, form});
+            }
+            abbrev.attr_count = static_cast<std::uint32_t>(t.attrs.size() - abbrev.first_attr);
+            t.abbrevs.push_back(abbrev);
+        }
+        std::sort(t.abbrevs.begin(), t.abbrevs.end(),
+                  [](const NamesAbbrev& x, const NamesAbbrev& y) { return x.code < y.code; });
+
+        const auto mark = [&](std::size_t list, std::uint32_t count) {
+            ByteReader units(s.names.first(t.end), s.big_endian, list);
+            for (std::uint32_t i = 0; i < count; ++i) {
+                const std::uint64_t offset = units.unsigned_of(t.offset_size);
+                const auto unit = info_->unit_at(offset);
+                if (unit && info_->units()[*unit].offset == offset)
+                    covered[*unit] = true;
+            }
+        };
+        mark(t.cu_list, t.cu_count);
+        mark(t.local_tu_list, t.local_tu_count);
+
+        names_tables_.push_back(std::move(t));
+        pos = names_tables_.back().end;
+    }
+    return {};
+}
+
+std::expected<void, Error> DwarfNameIndex::load_gdb_index(std::vector<bool>& covered) {
+    const auto data = info_->sections().gdb_index;
+    // Always little-endian, whatever the target
+    ByteReader r(data, false);
+    const std::uint32_t version = r.u32();
+    if (version < 7 || version > 9)
+        return std::unexpected(Error{"Unsupported .gdb_index version " + std::to_string(version)});
+    const std::uint32_t cu_list = r.u32();
+    const std::uint32_t types_list = r.u32();
+    const std::uint32_t address_area = r.u32();
+    const std::uint32_t symbols = r.u32();
+    const std::uint32_t symbols_end = r.u32();      // shortcut table from 9, else the constant pool
+    const std::uint32_t constant_pool = version >= 9 ? r.u32() : symbols_end;
+    if (!r.ok() || cu_list > types_list || types_list > address_area || address_area > symbols ||
+        symbols > symbols_end || symbols_end > constant_pool || constant_pool > data.size())
+        return std::unexpected(Error{"Malformed .gdb_index header"});
+
+    const std::uint32_t slot_count = (symbols_end - symbols) / 8;
+    if (slot_count & (slot_count - 1))
+        return std::unexpected(Error{".gdb_index symbol table size is not a power of two"});
+
+    gdb_.data = data;
+    gdb_.cu_list = cu_list;
+    gdb_.cu_count = (types_list - cu_list) / 16;
+    gdb_.symbols = symbols;
+    gdb_.slot_count = slot_count;
+    gdb_.constant_pool = constant_pool;
+
+    r.seek(cu_list);
+    for (std::uint32_t i = 0; i < gdb_.cu_count; ++i) {
+        const std::uint64_t offset = r.u64();
+        (void)r.u64();                  // length
+        const auto unit = info_->unit_at(offset);
+        if (unit && info_->units()[*unit].offset == offset)
+            covered[*unit] = true;
+    }
+    r.seek(symbols);
+    for (std::uint32_t i = 0; i < slot_count; ++i) {
+        if ((r.u32() | r.u32()) != 0)
+            ++gdb_.used_slots;
+    }
+    return {};
+}
+
+std::vector<DwarfNameIndex::ScanEntry> DwarfNameIndex::scan(const DwarfInfo& info, std::span<const std::size_t> units,
+                                                            std::size_t threads) {
+    // Units differ in size by orders of magnitude; one per task keeps the
+    // workers balanced. An unreadable unit contributes what it had so far.
+    std::vector<std::vector<ScanEntry>> found(units.size());
+    parallel_for(units.size(), [&](std::size_t k) {
+        auto& local = found[k];
+        (void)walk_named(info, units[k], [&](const DwarfDie& die, const DieNames& names, auto) {
+            if (names.declaration)
+                return;
+            if (!names.name.empty())
+                local.push_back(ScanEntry{scan_hash(names.name), die.offset});
+            if (!names.linkage.empty() && names.linkage != names.name)
+                local.push_back(ScanEntry{scan_hash(names.linkage), die.offset});
+        });
+    }, threads, 1);
+
+    std::size_t total = 0;
+    for (const auto& v : found)
+        total += v.size();
+    std::vector<ScanEntry> entries;
+    entries.reserve(total);
+    for (auto& v : found) {
+        entries.insert(entries.end(), v.begin(), v.end());
+        std::vector<ScanEntry>().swap(v);
+    }
+    std::sort(entries.begin(), entries.end(), [](const ScanEntry& a, const ScanEntry& b) {
+        return a.hash != b.hash ? a.hash < b.hash : a.die_offset < b.die_offset;
+    });
+    return entries;
+}
+
+std::expected<std::vector<DwarfDie>, Error> DwarfNameIndex::find(std::string_view name) const {
+    std::vector<DwarfDie> out;
+    for (const auto& t : names_tables_) {
+        if (auto ok = find_debug_names(t, name, out); !ok)
+            return std::unexpected(ok.error());
+    }
+
+    // .gdb_index holds qualified C++ names and no linkage names; anything
+    // else is looked up in its units the way the scan records them
+    const bool qualified = name.find("::") != std::string_view::npos;
+    if (gdb_.slot_count != 0 && qualified) {
+        if (auto ok = find_gdb_index(name, out); !ok)
+            return std::unexpected(ok.error());
+    }
+    find_scanned(entries_, name, out);
+    if (deferred_ && !qualified) {
+        std::call_once(deferred_->once, [this] {
+            deferred_->entries = scan(*info_, deferred_->units, deferred_->threads);
+        });
+        find_scanned(deferred_->entries, name, out);
+    }
+    return out;
+}
+
+void DwarfNameIndex::find_scanned(std::span<const ScanEntry> entries, std::string_view name,
+                                  std::vector<DwarfDie>& out) const {
+    const std::uint64_t h = scan_hash(name);
+    auto it = std::lower_bound(entries.begin(), entries.end(), h,
+                               [](const ScanEntry& e, std::uint64_t v) { return e.hash < v; });
+    std::uint64_t previous = UINT64_MAX;
+    for (; it != entries.end() && it->hash == h; ++it) {
+        if (it->die_offset == previous)
+            continue;
+        previous = it->die_offset;
+        auto die = info_->die_at(it->die_offset);
+        if (!die)
+            continue;
+        auto attrs = info_->attributes(*die);
+        if (!attrs)
+            continue;
+        const auto names = die_names(*info_, *die, *attrs);
+        if (names.name == name || names.linkage == name)
+            out.push_back(*die);
+    }
+}
+
+std::expected<void, Error> DwarfNameIndex::find_debug_names(const NamesTable& t, std::string_view name,
+                                                            std::vector<DwarfDie>& out) const {
+    const auto& s = info_->sections();
+    ByteReader r(s.names.first(t.end), s.big_endian);
+    const auto name_at = [&](std::uint32_t i) {
+        r.seek(t.string_offsets + std::size_t{i} * t.offset_size);
+        return ElfView::cstring_at(s.str, static_cast<std::size_t>(r.unsigned_of(t.offset_size)));
+    };
+
+    if (t.bucket_count == 0) {
+        // No hash table: the producer expects a linear search
+        for (std::uint32_t i = 0; i < t.name_count; ++i) {
+            if (name_at(i) == name)
+                return read_names_entries(t, i, out);
+        }
+        return {};
+    }
+
+    const std::uint32_t h = debug_names_hash(name);
+    const std::uint32_t bucket = h % t.bucket_count;
+    r.seek(t.buckets + std::size_t{bucket} * 4);
+    const std::uint32_t first = r.u32();        // 1-based; 0 = empty bucket
+    if (first == 0)
+        return {};
+    for (std::uint32_t i = first - 1; i < t.name_count; ++i) {
+        r.seek(t.hashes + std::size_t{i} * 4);
+        const std::uint32_t hash = r.u32();
+        if (hash % t.bucket_count != bucket)
+            break;
+        if (hash == h && name_at(i) == name)
+            return read_names_entries(t, i, out);
+    }
+    return {};
+}
+
+std::expected<void, Error> DwarfNameIndex::read_names_entries(const NamesTable& t, std::uint32_t name_index,
+                                                              std::vector<DwarfDie>& out) const {
+    const auto& s = info_->sections();
+    ByteReader r(s.names.first(t.end), s.big_endian, t.entry_offsets + std::size_t{name_index} * t.offset_size);
+    r.seek(t.entry_pool + static_cast<std::size_t>(r.unsigned_of(t.offset_size)));
+
+    // Entry attributes use the ordinary forms; a stand-in unit gives
+    // read_form the sizes it needs
+    DwarfUnit forms;
+    forms.version = 5;
+    forms.offset_size = t.offset_size;
+    forms.address_size = s.address_size;
+
+    const auto list_entry = [&](std::size_t list, std::uint64_t index) {
+        ByteReader l(s.names.first(t.end), s.big_endian, list + static_cast<std::size_t>(index) * t.offset_size);
+        return l.unsigned_of(t.offset_size);
+    };
+
+    for (;;) {
+        const std::uint64_t code = r.uleb128();
+        if (!r.ok())
+            return std::unexpected(Error{"Name index entry pool truncated"});
+        if (code == 0)
+            return {};
+        auto abbrev = std::lower_bound(t.abbrevs.begin(), t.abbrevs.end(), code,
+                                       [](const NamesAbbrev& a, std::uint64_t c) { return a.code < c; });
+        if (abbrev == t.abbrevs.end() || abbrev->code != code)
+            return std::unexpected(Error{"Unknown name index abbreviation"});
+
+        std::optional<std::uint64_t> cu, tu, die;
+        for (std::uint32_t k = 0; k < abbrev->attr_count; ++k) {
+            const auto& attr = t.attrs[abbrev->first_attr + k];
+            DwarfFormValue v;
+            if (!read_form(r, attr.form, 0, forms, v))
+                return std::unexpected(Error{"Unsupported name index entry form"});
+            switch (attr.index) {
+                case DW_IDX_compile_unit: cu = v.value; break;
+                case DW_IDX_type_unit:    tu = v.value; break;
+                case DW_IDX_die_offset:   die = v.value; break;
+                default: break;
+            }
+        }
+        if (!die)
+            continue;
+
+        std::uint64_t unit_offset = 0;
+        if (tu) {
+            if (*tu >= t.local_tu_count)
+                continue;               // foreign type unit, lives in a .dwo
+            unit_offset = list_entry(t.local_tu_list, *tu);
+        } else {
+            // The unit index may be left out when the table covers one unit
+            const std::uint64_t index = cu.value_or(0);
+            if ((!cu && t.cu_count != 1) || index >= t.cu_count)
+                continue;
+            unit_offset = list_entry(t.cu_list, index);
+        }
+        if (auto d = info_->die_at(unit_offset + *die))
+            out.push_back(*d);
+    }
+}
+
+std::expected<void, Error> DwarfNameIndex::find_gdb_index(std::string_view name, std::vector<DwarfDie>& out) const {
+    ByteReader r(gdb_.data, false);
+    const std::uint32_t h = gdb_index_hash(name);
+    const std::uint32_t mask = gdb_.slot_count - 1;
+    const std::uint32_t step = ((h * 17) & mask) | 1;
+
+    // The table only says which units define the name
+    std::vector<std::uint32_t> cus;
+    for (std::uint32_t n = 0, slot = h & mask; n < gdb_.slot_count; ++n, slot = (slot + step) & mask) {
+        r.seek(gdb_.symbols + std::size_t{slot} * 8);
+        const std::uint32_t name_offset = r.u32();
+        const std::uint32_t vector_offset = r.u32();
+        if (!r.ok())
+            return std::unexpected(Error{".gdb_index symbol table truncated"});
+        if (name_offset == 0 && vector_offset == 0)
+            break;
+        if (ElfView::cstring_at(gdb_.data, std::size_t{gdb_.constant_pool} + name_offset) != name)
+            continue;
+
+        r.seek(std::size_t{gdb_.constant_pool} + vector_offset);
+        const std::uint32_t count = r.u32();
+        if (count > r.remaining() / 4)
+            return std::unexpected(Error{".gdb_index CU vector truncated"});
+        for (std::uint32_t i = 0; i < count; ++i) {
+            const std::uint32_t cu = r.u32() & 0xFFFFFFu;      // high bits: symbol kind, static
+            if (cu < gdb_.cu_count)
+                cus.push_back(cu);
+        }
+        break;
+    }
+    std::sort(cus.begin(), cus.end());
+    cus.erase(std::unique(cus.begin(), cus.end()), cus.end());
+
+    // Only qualified names get here. Definitions are often placed at the
+    // unit's top level and point back at a declaration inside the class or
+    // namespace, so a qualified match on the declaration counts for them.
+    for (const std::uint32_t cu : cus) {
+        r.seek(gdb_.cu_list + std::size_t{cu} * 16);
+        const std::uint64_t offset = r.u64();
+        const auto unit = info_->unit_at(offset);
+        if (!unit)
+            continue;
+
+        std::vector<std::uint64_t> declarations;
+        std::vector<std::pair<DwarfDie, std::uint64_t>> definitions;    // with their origin
+        (void)walk_named(*info_, *unit, [&](const DwarfDie& die, const DieNames& names,
+                                            std::span<const std::string_view> scope) {
+            const bool match = name.ends_with(names.name) && qualified_name(scope, names.name) == name;
+            if (names.declaration) {
+                if (match)
+                    declarations.push_back(die.offset);
+            } else if (match) {
+                out.push_back(die);
+            } else if (names.origin) {
+                definitions.emplace_back(die, *names.origin);
+            }
+        });
+        std::sort(declarations.begin(), declarations.end());
+        for (const auto& [die, origin] : definitions) {
+            if (std::binary_search(declarations.begin(), declarations.end(), origin))
+                out.push_back(die);
+        }
+    }
+    return {};
+}
+
+} // namespace peelf
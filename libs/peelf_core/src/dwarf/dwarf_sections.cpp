@@ -0,0 +1,196 @@
+#include "dwarf/dwarf_sections.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "elf/elf_relocations.hpp"
+#include "elf/elf_section_cache.hpp"
+#include "elf/elf_symbols.hpp"
+
+namespace peelf {
+
+namespace {
+
+// Bytes patched by a relocation type that can appear in a debug section;
+// 0 for any other type
+std::size_t debug_relocation_width(std::uint16_t machine, std::uint32_t type) {
+    switch (machine) {
+        case EM_386:
+            return type == R_386_32 || type == R_386_TLS_LDO_32 ? 4 : 0;
+        case EM_X86_64:
+            if (type == R_X86_64_64 || type == R_X86_64_DTPOFF64)
+                return 8;
+            return type == R_X86_64_32 || type == R_X86_64_32S || type == R_X86_64_DTPOFF32 ? 4 : 0;
+        case EM_AARCH64:
+            if (type == R_AARCH64_ABS64 || type == R_AARCH64_TLS_DTPREL)
+                return 8;
+            return type == R_AARCH64_ABS32 ? 4 : 0;
+        case EM_ARM:
+            return type == R_ARM_ABS32 || type == R_ARM_TLS_LDO32 ? 4 : 0;
+        case EM_RISCV:
+            if (type == R_RISCV_64 || type == R_RISCV_TLS_DTPREL64)
+                return 8;
+            return type == R_RISCV_32 || type == R_RISCV_TLS_DTPREL32 ? 4 : 0;
+        case EM_PPC64:
+            if (type == R_PPC64_ADDR64 || type == R_PPC64_DTPREL64)
+                return 8;
+            return type == R_PPC64_ADDR32 ? 4 : 0;
+        default:
+            return 0;
+    }
+}
+
+template<std::integral T>
+void relocate_word(const ElfView& elf, std::uint8_t* place, std::uint64_t symbol, std::optional<std::int64_t> addend) {
+    T word = 0;
+    std::memcpy(&word, place, sizeof(T));
+    // REL keeps the addend in the word being patched
+    const std::uint64_t a = addend ? static_cast<std::uint64_t>(*addend) : elf.to_native(word);
+    word = elf.to_native(static_cast<T>(symbol + a));
+    std::memcpy(place, &word, sizeof(T));
+}
+
+// S + A for every relocation against one section, on a copy of its bytes.
+// Symbol values of an ET_REL file are offsets into their own section.
+std::expected<std::shared_ptr<const std::vector<std::uint8_t>>, Error>
+relocate_section(const ElfView& elf, std::span<const std::uint8_t> data, const ElfRelocationTable& relocations,
+                 std::pair<std::size_t, std::size_t> range, const ElfSymbolTable& symbols) {
+    auto out = std::make_shared<std::vector<std::uint8_t>>(data.begin(), data.end());
+    for (std::size_t i = range.first; i < range.second; ++i) {
+        const std::uint32_t type = relocations.type(i);
+        if (type == 0)
+            continue;                   // R_*_NONE
+        const std::size_t width = debug_relocation_width(elf.machine(), type);
+        if (width == 0)
+            return std::unexpected(Error{"Unsupported relocation type " + std::to_string(type) + " for machine " +
+                                         std::to_string(elf.machine())});
+        const std::uint64_t offset = relocations.offset(i);
+        if (offset > out->size() || out->size() - offset < width)
+            return std::unexpected(Error{"Relocation outside its section"});
+
+        std::uint64_t symbol = 0;
+        if (const std::uint32_t index = relocations.symbol(i); index != 0) {
+            if (index >= symbols.size())
+                return std::unexpected(Error{"Relocation symbol out of range"});
+            symbol = symbols.value(index);
+        }
+        std::optional<std::int64_t> addend;
+        if (relocations.format(i) == ElfRelocationFormat::Rela)
+            addend = relocations.addend(i);
+
+        std::uint8_t* place = out->data() + offset;
+        if (width == 8)
+            relocate_word<std::uint64_t>(elf, place, symbol, addend);
+        else
+            relocate_word<std::uint32_t>(elf, place, symbol, addend);
+    }
+    return out;
+}
+
+} // namespace
+
+std::expected<DwarfSections, Error> DwarfSections::from_elf(const ElfView& elf, const ElfSectionCache* cache) {
+    DwarfSections out;
+    out.big_endian = elf.is_big_endian();
+    out.address_size = elf.is_64() ? 8 : 4;
+
+    struct Slot {
+        std::string_view name;
+        std::span<const std::uint8_t> DwarfSections::* member;
+    };
+    static constexpr Slot slots[] = {
+        {".debug_info", &DwarfSections::info},
+        {".debug_abbrev", &DwarfSections::abbrev},
+        {".debug_line", &DwarfSections::line},
+        {".debug_line_str", &DwarfSections::line_str},
+        {".debug_str", &DwarfSections::str},
+        {".debug_str_offsets", &DwarfSections::str_offsets},
+        {".debug_addr", &DwarfSections::addr},
+        {".debug_aranges", &DwarfSections::aranges},
+        {".debug_ranges", &DwarfSections::ranges},
+        {".debug_rnglists", &DwarfSections::rnglists},
+        {".debug_names", &DwarfSections::names},
+        {".gdb_index", &DwarfSections::gdb_index},
+    };
+
+    // One pass over the section headers rather than a name search per slot.
+    // Legacy .zdebug_X fills the .debug_X slot.
+    std::size_t found[std::size(slots)];
+    std::fill(std::begin(found), std::end(found), std::size_t{0});
+    for (std::size_t i = 1; i < elf.section_count(); ++i) {
+        auto name = elf.section_name(i);
+        std::string unzipped;
+        if (name.starts_with(".zdebug_")) {
+            unzipped = ".debug_" + std::string(name.substr(8));
+            name = unzipped;
+        } else if (!name.starts_with(".debug_") && name != ".gdb_index") {
+            continue;
+        }
+        for (std::size_t s = 0; s < std::size(slots); ++s) {
+            if (slots[s].name == name) {
+                if (found[s] == 0)
+                    found[s] = i;
+                break;
+            }
+        }
+    }
+
+    std::optional<ElfSectionCache> local;
+    if (!cache)
+        cache = &local.emplace(elf, SIZE_MAX);
+
+    std::vector<std::size_t> indices;
+    for (const std::size_t i : found) {
+        if (i != 0)
+            indices.push_back(i);
+    }
+    cache->prefetch(indices);
+
+    // Only unlinked objects carry relocations against their debug sections
+    std::optional<ElfRelocationTable> relocations;
+    std::optional<ElfSymbolTable> symbols;
+    if (elf.type() == ET_REL && !indices.empty()) {
+        auto table = ElfRelocationTable::load(elf, ElfDynamicInfo{});
+        if (!table)
+            return std::unexpected(table.error());
+        relocations = std::move(*table);
+    }
+
+    for (std::size_t s = 0; s < std::size(slots); ++s) {
+        if (found[s] == 0)
+            continue;
+        auto data = cache->data(found[s]);
+        if (!data)
+            return std::unexpected(Error{std::string(elf.section_name(found[s])) + ": " + data.error().message});
+        out.*slots[s].member = data->bytes;
+        if (data->storage) {
+            out.compressed = true;
+            out.storage.push_back(std::move(data->storage));
+        }
+
+        const auto range = relocations ? relocations->section_range(static_cast<std::uint32_t>(found[s]))
+                                       : std::pair<std::size_t, std::size_t>{};
+        if (range.first == range.second)
+            continue;
+        if (!symbols) {
+            auto table = read_symtab(elf);
+            if (!table)
+                return std::unexpected(table.error());
+            symbols = std::move(*table);
+        }
+        auto patched = relocate_section(elf, data->bytes, *relocations, range, *symbols);
+        if (!patched)
+            return std::unexpected(Error{std::string(elf.section_name(found[s])) + ": " + patched.error().message});
+        out.*slots[s].member = **patched;
+        out.storage.push_back(std::move(*patched));
+        out.relocated = true;
+    }
+    return out;
+}
+
+} // namespace peelf
@@ -0,0 +1,421 @@
+#include "dwarf/dwarf_unit.hpp"
+
+#include <algorithm>
+
+#include "elf/elf_view.hpp"
+
+namespace peelf {
+
+namespace {
+
+std::optional<std::uint64_t> indexed_address(const DwarfSections& s, const DwarfUnit& unit, std::uint64_t index) {
+    const std::uint64_t off = unit.addr_base + index * unit.address_size;
+    if (off > s.addr.size())
+        return std::nullopt;
+    ByteReader r(s.addr, s.big_endian, static_cast<std::size_t>(off));
+    const std::uint64_t v = r.unsigned_of(unit.address_size);
+    return r.ok() ? std::optional<std::uint64_t>(v) : std::nullopt;
+}
+
+bool is_strx(std::uint16_t form) {
+    switch (form) {
+        case DW_FORM_strx:
+        case DW_FORM_strx1:
+        case DW_FORM_strx2:
+        case DW_FORM_strx3:
+        case DW_FORM_strx4:
+        case DW_FORM_GNU_str_index:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool is_addrx(std::uint16_t form) {
+    switch (form) {
+        case DW_FORM_addrx:
+        case DW_FORM_addrx1:
+        case DW_FORM_addrx2:
+        case DW_FORM_addrx3:
+        case DW_FORM_addrx4:
+        case DW_FORM_GNU_addr_index:
+            return true;
+        default:
+            return false;
+    }
+}
+
+std::expected<void, Error> read_rnglist(const DwarfSections& s, const DwarfUnit& unit, std::uint64_t offset,
+                                        std::uint64_t base, std::vector<DwarfRange>& out) {
+    ByteReader r(s.rnglists, s.big_endian, static_cast<std::size_t>(std::min<std::uint64_t>(offset, s.rnglists.size())));
+    if (offset > s.rnglists.size())
+        return std::unexpected(Error{"Range list offset out of range"});
+
+    const auto addrx = [&](std::uint64_t index) {
+        auto a = indexed_address(s, unit, index);
+        if (!a)
+            r.fail();
+        return a.value_or(0);
+    };
+    while (r.ok()) {
+        std::uint64_t b = 0;
+        std::uint64_t e = 0;
+        switch (r.u8()) {
+            case DW_RLE_end_of_list:   return {};
+            case DW_RLE_base_addressx: base = addrx(r.uleb128()); continue;
+            case DW_RLE_base_address:  base = r.unsigned_of(unit.address_size); continue;
+            case DW_RLE_startx_endx:   b = addrx(r.uleb128()); e = addrx(r.uleb128()); break;
+            case DW_RLE_startx_length: b = addrx(r.uleb128()); e = b + r.uleb128(); break;
+            case DW_RLE_offset_pair:   b = base + r.uleb128(); e = base + r.uleb128(); break;
+            case DW_RLE_start_end:     b = r.unsigned_of(unit.address_size); e = r.unsigned_of(unit.address_size); break;
+            case DW_RLE_start_length:  b = r.unsigned_of(unit.address_size); e = b + r.uleb128(); break;
+            default:
+                return std::unexpected(Error{"Unknown range list entry"});
+        }
+        if (r.ok() && b < e)
+            out.push_back(DwarfRange{b, e});
+    }
+    return std::unexpected(Error{"Range list truncated"});
+}
+
+std::expected<void, Error> read_ranges_v4(const DwarfSections& s, const DwarfUnit& unit, std::uint64_t offset,
+                                          std::uint64_t base, std::vector<DwarfRange>& out) {
+    if (offset > s.ranges.size())
+        return std::unexpected(Error{"Range list offset out of range"});
+    ByteReader r(s.ranges, s.big_endian, static_cast<std::size_t>(offset));
+    const std::uint64_t max_address = unit.address_size == 8 ? ~std::uint64_t{0} : (std::uint64_t{1} << (8 * unit.address_size)) - 1;
+    while (r.ok()) {
+        const std::uint64_t b = r.unsigned_of(unit.address_size);
+        const std::uint64_t e = r.unsigned_of(unit.address_size);
+        if (!r.ok())
+            break;
+        if (b == 0 && e == 0)
+            return {};
+        if (b == max_address) {
+            base = e;                       // base address selection entry
+            continue;
+        }
+        if (b < e)
+            out.push_back(DwarfRange{base + b, base + e});
+    }
+    return std::unexpected(Error{"Range list truncated"});
+}
+
+} // namespace
+
+std::expected<DwarfAbbrevTable, Error> DwarfAbbrevTable::parse(std::span<const std::uint8_t> abbrev, std::uint64_t offset) {
+    if (offset > abbrev.size())
+        return std::unexpected(Error{"Abbreviation offset out of range"});
+
+    // Only LEB128s and bytes: the byte order does not matter
+    ByteReader r(abbrev, false, static_cast<std::size_t>(offset));
+    DwarfAbbrevTable out;
+    for (;;) {
+        const std::uint64_t code = r.uleb128();
+        if (!r.ok())
+            return std::unexpected(Error{"Abbreviation table truncated"});
+        if (code == 0)
+            break;
+
+        DwarfAbbrev a;
+        a.code = code;
+        a.tag = static_cast<std::uint16_t>(r.uleb128());
+        a.has_children = r.u8() != 0;
+        a.first_spec = static_cast<std::uint32_t>(out.specs_.size());
+        for (;;) {
+            DwarfAttrSpec spec;
+            spec.attribute = static_cast<std::uint16_t>(r.uleb128());
+            spec.form = static_cast<std::uint16_t>(r.uleb128());
+            if (spec.form == DW_FORM_implicit_const)
+                spec.implicit_const = r.sleb128();
+            if (!r.ok())
+                return std::unexpected(Error{"Abbreviation table truncated"});
+            if (spec.attribute == 0 && spec.form == 0)
+                break;
+            out.specs_.push_back(spec);
+        }
+        a.spec_count = static_cast<std::uint32_t>(out.specs_.size() - a.first_spec);
+        out.dense_ = out.dense_ && code == out.abbrevs_.size() + 1;
+        out.abbrevs_.push_back(a);
+    }
+    if (!out.dense_) {
+        std::sort(out.abbrevs_.begin(), out.abbrevs_.end(),
+                  [](const DwarfAbbrev& x, const DwarfAbbrev& y) { return x.code < y.code; });
+    }
+    return out;
+}
+
+const DwarfAbbrev* DwarfAbbrevTable::find(std::uint64_t code) const {
+    if (dense_)
+        return code != 0 && code <= abbrevs_.size() ? &abbrevs_[code - 1] : nullptr;
+    auto it = std::lower_bound(abbrevs_.begin(), abbrevs_.end(), code,
+                               [](const DwarfAbbrev& a, std::uint64_t c) { return a.code < c; });
+    return it != abbrevs_.end() && it->code == code ? &*it : nullptr;
+}
+
+bool DwarfFormValue::is_constant() const {
+    switch (form) {
+        case DW_FORM_data1:
+        case DW_FORM_data2:
+        case DW_FORM_data4:
+        case DW_FORM_data8:
+        case DW_FORM_udata:
+        case DW_FORM_sdata:
+        case DW_FORM_implicit_const:
+            return true;
+        default:
+            return false;
+    }
+}
+
+std::expected<std::vector<DwarfUnit>, Error> read_units(const DwarfSections& s, std::size_t max_units) {
+    std::vector<DwarfUnit> out;
+    std::size_t pos = 0;
+    while (pos < s.info.size()) {
+        if (out.size() == max_units)
+            return std::unexpected(Error{".debug_info exceeds unit budget"});
+        ByteReader r(s.info, s.big_endian, pos);
+        DwarfUnit u;
+        u.offset = pos;
+        std::uint64_t length = r.u32();
+        if (length == 0xFFFFFFFFu) {
+            length = r.u64();
+            u.offset_size = 8;
+        } else if (length >= 0xFFFFFFF0u) {
+            return std::unexpected(Error{"Reserved unit length"});
+        }
+        if (!r.ok() || length > r.remaining())
+            return std::unexpected(Error{"Unit runs past .debug_info"});
+        u.end = r.pos() + length;
+
+        u.version = r.u16();
+        if (u.version < 2 || u.version > 5)
+            return std::unexpected(Error{"Unsupported DWARF version " + std::to_string(u.version)});
+        if (u.version >= 5) {
+            u.unit_type = r.u8();
+            u.address_size = r.u8();
+            u.abbrev_offset = r.unsigned_of(u.offset_size);
+            switch (u.unit_type) {
+                case DW_UT_skeleton:
+                case DW_UT_split_compile:
+                    u.id = r.u64();
+                    break;
+                case DW_UT_type:
+                case DW_UT_split_type:
+                    u.id = r.u64();
+                    (void)r.unsigned_of(u.offset_size);     // type_offset
+                    break;
+                default:
+                    break;
+            }
+        } else {
+            u.abbrev_offset = r.unsigned_of(u.offset_size);
+            u.address_size = r.u8();
+        }
+        u.die_offset = r.pos();
+        if (!r.ok() || u.die_offset > u.end)
+            return std::unexpected(Error{"Unit header truncated"});
+        if (u.address_size != 2 && u.address_size != 4 && u.address_size != 8)
+            return std::unexpected(Error{"Unsupported address size " + std::to_string(u.address_size)});
+        out.push_back(u);
+        pos = static_cast<std::size_t>(u.end);
+    }
+    return out;
+}
+
+bool read_form(ByteReader& r, std::uint16_t form, std::int64_t implicit_const,
+               const DwarfUnit& unit, DwarfFormValue& out) {
+    out.form = form;
+    switch (form) {
+        case DW_FORM_addr:
+            out.value = r.unsigned_of(unit.address_size);
+            break;
+        case DW_FORM_block1: out.block = r.bytes(r.u8()); break;
+        case DW_FORM_block2: out.block = r.bytes(r.u16()); break;
+        case DW_FORM_block4: out.block = r.bytes(r.u32()); break;
+        case DW_FORM_block:
+        case DW_FORM_exprloc:
+            out.block = r.bytes(static_cast<std::size_t>(r.uleb128()));
+            break;
+        case DW_FORM_data16:
+            out.block = r.bytes(16);
+            break;
+        case DW_FORM_data1:
+        case DW_FORM_ref1:
+        case DW_FORM_flag:
+        case DW_FORM_strx1:
+        case DW_FORM_addrx1:
+            out.value = r.u8();
+            break;
+        case DW_FORM_data2:
+        case DW_FORM_ref2:
+        case DW_FORM_strx2:
+        case DW_FORM_addrx2:
+            out.value = r.u16();
+            break;
+        case DW_FORM_strx3:
+        case DW_FORM_addrx3:
+            out.value = r.unsigned_of(3);
+            break;
+        case DW_FORM_data4:
+        case DW_FORM_ref4:
+        case DW_FORM_ref_sup4:
+        case DW_FORM_strx4:
+        case DW_FORM_addrx4:
+            out.value = r.u32();
+            break;
+        case DW_FORM_data8:
+        case DW_FORM_ref8:
+        case DW_FORM_ref_sig8:
+        case DW_FORM_ref_sup8:
+            out.value = r.u64();
+            break;
+        case DW_FORM_string:
+            out.string = r.cstring();
+            break;
+        case DW_FORM_sdata:
+            out.signed_value = r.sleb128();
+            out.value = static_cast<std::uint64_t>(out.signed_value);
+            break;
+        case DW_FORM_udata:
+        case DW_FORM_ref_udata:
+        case DW_FORM_strx:
+        case DW_FORM_addrx:
+        case DW_FORM_loclistx:
+        case DW_FORM_rnglistx:
+        case DW_FORM_GNU_addr_index:
+        case DW_FORM_GNU_str_index:
+            out.value = r.uleb128();
+            break;
+        case DW_FORM_strp:
+        case DW_FORM_line_strp:
+        case DW_FORM_sec_offset:
+        case DW_FORM_strp_sup:
+        case DW_FORM_GNU_ref_alt:
+        case DW_FORM_GNU_strp_alt:
+            out.value = r.unsigned_of(unit.offset_size);
+            break;
+        case DW_FORM_ref_addr:
+            out.value = r.unsigned_of(unit.version <= 2 ? unit.address_size : unit.offset_size);
+            break;
+        case DW_FORM_flag_present:
+            out.value = 1;
+            break;
+        case DW_FORM_implicit_const:
+            out.signed_value = implicit_const;
+            out.value = static_cast<std::uint64_t>(implicit_const);
+            break;
+        case DW_FORM_indirect: {
+            const auto actual = static_cast<std::uint16_t>(r.uleb128());
+            if (actual == DW_FORM_indirect || actual == DW_FORM_implicit_const)
+                return false;
+            return read_form(r, actual, implicit_const, unit, out);
+        }
+        default:
+            return false;
+    }
+    return r.ok();
+}
+
+std::string_view form_string(const DwarfSections& s, const DwarfUnit& unit, const DwarfFormValue& v) {
+    switch (v.form) {
+        case DW_FORM_string:    return v.string;
+        case DW_FORM_strp:      return ElfView::cstring_at(s.str, static_cast<std::size_t>(v.value));
+        case DW_FORM_line_strp: return ElfView::cstring_at(s.line_str, static_cast<std::size_t>(v.value));
+        default:                break;
+    }
+    if (!is_strx(v.form))
+        return {};
+    const std::uint64_t off = unit.str_offsets_base + v.value * unit.offset_size;
+    if (off > s.str_offsets.size())
+        return {};
+    ByteReader r(s.str_offsets, s.big_endian, static_cast<std::size_t>(off));
+    const std::uint64_t str = r.unsigned_of(unit.offset_size);
+    return r.ok() ? ElfView::cstring_at(s.str, static_cast<std::size_t>(str)) : std::string_view{};
+}
+
+std::optional<std::uint64_t> form_address(const DwarfSections& s, const DwarfUnit& unit, const DwarfFormValue& v) {
+    if (v.form == DW_FORM_addr)
+        return v.value;
+    if (is_addrx(v.form))
+        return indexed_address(s, unit, v.value);
+    return std::nullopt;
+}
+
+std::expected<void, Error> read_ranges(const DwarfSections& s, const DwarfUnit& unit, const DwarfFormValue& ranges,
+                                       std::uint64_t base_address, std::vector<DwarfRange>& out) {
+    if (unit.version < 5)
+        return read_ranges_v4(s, unit, ranges.value, base_address, out);
+
+    std::uint64_t offset = ranges.value;
+    if (ranges.form == DW_FORM_rnglistx) {
+        // The offset table after the header holds offsets relative to the base
+        const std::uint64_t entry = unit.rnglists_base + ranges.value * unit.offset_size;
+        if (entry > s.rnglists.size())
+            return std::unexpected(Error{"Range list index out of range"});
+        ByteReader r(s.rnglists, s.big_endian, static_cast<std::size_t>(entry));
+        offset = unit.rnglists_base + r.unsigned_of(unit.offset_size);
+        if (!r.ok())
+            return std::unexpected(Error{"Range list index out of range"});
+    }
+    return read_rnglist(s, unit, offset, base_address, out);
+}
+
+std::expected<DwarfUnitRoot, Error>
+read_unit_root(const DwarfSections& s, DwarfUnit& unit, const DwarfAbbrevTable& abbrevs) {
+    ByteReader r(s.info.first(static_cast<std::size_t>(unit.end)), s.big_endian, static_cast<std::size_t>(unit.die_offset));
+    const DwarfAbbrev* abbrev = abbrevs.find(r.uleb128());
+    if (!abbrev)
+        return std::unexpected(Error{"Unknown abbreviation code in root DIE"});
+
+    DwarfUnitRoot root;
+    root.tag = abbrev->tag;
+
+    // First pass collects raw values: strx and addrx depend on bases that
+    // may come later in the same DIE
+    std::optional<DwarfFormValue> name, comp_dir, producer, low_pc, high_pc, ranges;
+    for (const auto& spec : abbrevs.attributes(*abbrev)) {
+        DwarfFormValue v;
+        if (!read_form(r, spec.form, spec.implicit_const, unit, v))
+            return std::unexpected(Error{"Unsupported or truncated attribute in root DIE"});
+        switch (spec.attribute) {
+            case DW_AT_name:              name = v; break;
+            case DW_AT_comp_dir:          comp_dir = v; break;
+            case DW_AT_producer:          producer = v; break;
+            case DW_AT_stmt_list:         root.stmt_list = v.value; break;
+            case DW_AT_low_pc:            low_pc = v; break;
+            case DW_AT_high_pc:           high_pc = v; break;
+            case DW_AT_ranges:            ranges = v; break;
+            case DW_AT_str_offsets_base:  unit.str_offsets_base = v.value; break;
+            case DW_AT_addr_base:
+            case DW_AT_GNU_addr_base:     unit.addr_base = v.value; break;
+            case DW_AT_rnglists_base:     unit.rnglists_base = v.value; break;
+            default: break;
+        }
+    }
+
+    if (name)
+        root.name = form_string(s, unit, *name);
+    if (comp_dir)
+        root.comp_dir = form_string(s, unit, *comp_dir);
+    if (producer)
+        root.producer = form_string(s, unit, *producer);
+
+    std::optional<std::uint64_t> low;
+    if (low_pc)
+        low = form_address(s, unit, *low_pc);
+    if (low && high_pc) {
+        const std::uint64_t high = high_pc->is_constant() ? *low + high_pc->value
+                                                          : form_address(s, unit, *high_pc).value_or(0);
+        if (high > *low)
+            root.ranges.push_back(DwarfRange{*low, high});
+    }
+    if (ranges) {
+        auto ok = read_ranges(s, unit, *ranges, low.value_or(0), root.ranges);
+        if (!ok)
+            return std::unexpected(ok.error());
+    }
+    return root;
+}
+
+} // namespace peelf
@@ -0,0 +1,379 @@
+#include "elf/elf_core.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "elf/elf_notes.hpp"
+#include "elf/elf_traits.hpp"
+#include "peelf/byte_reader.hpp"
+#include "peelf/byteswap.hpp"
+
+namespace peelf {
+
+namespace {
+
+// user_regs_struct / elf_gregset_t orders from the kernel headers
+constexpr std::string_view x86_64_registers[] = {
+    "r15", "r14", "r13", "r12", "rbp", "rbx", "r11", "r10", "r9", "r8",
+    "rax", "rcx", "rdx", "rsi", "rdi", "orig_rax", "rip", "cs", "eflags", "rsp",
+    "ss", "fs_base", "gs_base", "ds", "es", "fs", "gs",
+};
+constexpr std::string_view i386_registers[] = {
+    "ebx", "ecx", "edx", "esi", "edi", "ebp", "eax", "ds", "es", "fs",
+    "gs", "orig_eax", "eip", "cs", "eflags", "esp", "ss",
+};
+constexpr std::string_view aarch64_registers[] = {
+    "x0", "x1", "x2", "x3", "x4", "x5", "x6", "x7", "x8", "x9",
+    "x10", "x11", "x12", "x13", "x14", "x15", "x16", "x17", "x18", "x19",
+    "x20", "x21", "x22", "x23", "x24", "x25", "x26", "x27", "x28", "x29",
+    "x30", "sp", "pc", "pstate",
+};
+constexpr std::string_view arm_registers[] = {
+    "r0", "r1", "r2", "r3", "r4", "r5", "r6", "r7", "r8", "r9",
+    "r10", "fp", "ip", "sp", "lr", "pc", "cpsr", "orig_r0",
+};
+
+struct RegisterRoles {
+    std::size_t pc;
+    std::size_t sp;
+};
+
+std::optional<RegisterRoles> register_roles(std::uint16_t machine) {
+    switch (machine) {
+        case EM_X86_64:  return RegisterRoles{16, 19};
+        case EM_386:     return RegisterRoles{12, 15};
+        case EM_AARCH64: return RegisterRoles{32, 31};
+        case EM_ARM:     return RegisterRoles{15, 13};
+        default:         return std::nullopt;
+    }
+}
+
+// Linux generic numbering; si_addr is only meaningful for these when the
+// kernel raised them (si_code > 0)
+constexpr std::int32_t sigill = 4;
+constexpr std::int32_t sigbus = 7;
+constexpr std::int32_t sigfpe = 8;
+constexpr std::int32_t sigsegv = 11;
+
+std::string fixed_string(std::span<const std::uint8_t> bytes) {
+    const auto* p = reinterpret_cast<const char*>(bytes.data());
+    return std::string(p, strnlen(p, bytes.size()));
+}
+
+} // namespace
+
+std::span<const std::string_view> core_register_names(std::uint16_t machine) {
+    switch (machine) {
+        case EM_X86_64:  return x86_64_registers;
+        case EM_386:     return i386_registers;
+        case EM_AARCH64: return aarch64_registers;
+        case EM_ARM:     return arm_registers;
+        default:         return {};
+    }
+}
+
+const char* auxv_type_name(std::uint64_t type) {
+    switch (type) {
+        case AT_NULL:          return "AT_NULL";
+        case AT_PHDR:          return "AT_PHDR";
+        case AT_PHENT:         return "AT_PHENT";
+        case AT_PHNUM:         return "AT_PHNUM";
+        case AT_PAGESZ:        return "AT_PAGESZ";
+        case AT_BASE:          return "AT_BASE";
+        case AT_FLAGS:         return "AT_FLAGS";
+        case AT_ENTRY:         return "AT_ENTRY";
+        case AT_UID:           return "AT_UID";
+        case AT_EUID:          return "AT_EUID";
+        case AT_GID:           return "AT_GID";
+        case AT_EGID:          return "AT_EGID";
+        case AT_PLATFORM:      return "AT_PLATFORM";
+        case AT_HWCAP:         return "AT_HWCAP";
+        case AT_CLKTCK:        return "AT_CLKTCK";
+        case AT_SECURE:        return "AT_SECURE";
+        case AT_BASE_PLATFORM: return "AT_BASE_PLATFORM";
+        case AT_RANDOM:        return "AT_RANDOM";
+        case AT_HWCAP2:        return "AT_HWCAP2";
+        case AT_EXECFN:        return "AT_EXECFN";
+        case AT_SYSINFO_EHDR:  return "AT_SYSINFO_EHDR";
+        case AT_MINSIGSTKSZ:   return "AT_MINSIGSTKSZ";
+        default:               return nullptr;
+    }
+}
+
+std::expected<ElfCore, Error> ElfCore::parse(std::span<const std::uint8_t> file) {
+    ElfCore core;
+    core.bytes_ = file;
+    core.file_size_ = file.size();
+    if (auto r = core.load(); !r)
+        return std::unexpected(r.error());
+    return core;
+}
+
+std::expected<ElfCore, Error> ElfCore::open(const std::filesystem::path& path, std::size_t window_size) {
+    ElfCore core;
+    core.mapping_ = std::make_shared<Mapping>();
+    if (auto ec = core.mapping_->open(path, window_size); ec)
+        return std::unexpected(Error{path.string() + ": " + ec.message()});
+    core.file_size_ = core.mapping_->size();
+    if (auto r = core.load(); !r)
+        return std::unexpected(r.error());
+    return core;
+}
+
+std::size_t ElfCore::read_file(std::uint64_t offset, std::span<std::uint8_t> out) const {
+    if (mapping_)
+        return mapping_->read(offset, out);
+    if (offset >= bytes_.size())
+        return 0;
+    const std::size_t n = static_cast<std::size_t>(std::min<std::uint64_t>(out.size(), bytes_.size() - offset));
+    std::memcpy(out.data(), bytes_.data() + offset, n);
+    return n;
+}
+
+template<typename T>
+bool ElfCore::read_record(std::uint64_t offset, T& out) const {
+    if (read_file(offset, {reinterpret_cast<std::uint8_t*>(&out), sizeof(T)}) != sizeof(T))
+        return false;
+    if (big_endian_ != (std::endian::native == std::endian::big)) {
+        const std::span<std::uint8_t> rec{reinterpret_cast<std::uint8_t*>(&out), sizeof(T)};
+        RecordSwapper::for_type<T>().swap(rec, rec);
+    }
+    return true;
+}
+
+std::expected<void, Error> ElfCore::load() {
+    std::uint8_t ident[EI_NIDENT];
+    if (read_file(0, ident) != EI_NIDENT || ident[0] != 0x7F || ident[1] != 'E' || ident[2] != 'L' || ident[3] != 'F')
+        return std::unexpected(Error{"Missing ELF magic"});
+    if (ident[EI_DATA] != ELFDATA2LSB && ident[EI_DATA] != ELFDATA2MSB)
+        return std::unexpected(Error{"Invalid ELF data encoding"});
+    big_endian_ = ident[EI_DATA] == ELFDATA2MSB;
+    switch (ident[EI_CLASS]) {
+        case ELFCLASS32: return load_headers<Elf32Traits>();
+        case ELFCLASS64: return load_headers<Elf64Traits>();
+        default:         return std::unexpected(Error{"Invalid ELF class"});
+    }
+}
+
+template<typename Traits>
+std::expected<void, Error> ElfCore::load_headers() {
+    using ehdr_t = typename Traits::ehdr;
+    using shdr_t = typename Traits::shdr;
+    using phdr_t = typename Traits::phdr;
+
+    ehdr_t eh{};
+    if (!read_record(0, eh))
+        return std::unexpected(Error{"ELF header truncated"});
+    if (eh.e_type != ET_CORE)
+        return std::unexpected(Error{"Not a core file"});
+    is_64_ = Traits::is_64;
+    machine_ = eh.e_machine;
+
+    // Cores with more than 65534 mappings keep the real count in section 0
+    std::uint64_t phnum = eh.e_phnum;
+    if (phnum == PN_XNUM) {
+        shdr_t sh0{};
+        if (!read_record(eh.e_shoff, sh0))
+            return std::unexpected(Error{"Section header table out of range"});
+        phnum = sh0.sh_info;
+    }
+    if (phnum != 0 && eh.e_phentsize != sizeof(phdr_t))
+        return std::unexpected(Error{"Unexpected e_phentsize"});
+    if (eh.e_phoff > file_size_ || phnum > (file_size_ - eh.e_phoff) / sizeof(phdr_t))
+        return std::unexpected(Error{"Program header table out of range"});
+
+    for (std::uint64_t i = 0; i < phnum; ++i) {
+        phdr_t ph{};
+        if (!read_record(eh.e_phoff + i * sizeof(phdr_t), ph))
+            return std::unexpected(Error{"Program header table out of range"});
+        if (ph.p_type == PT_LOAD) {
+            // Clamp what the file really holds; a truncated core keeps the
+            // segments it managed to write
+            const std::uint64_t available = ph.p_offset < file_size_ ? file_size_ - ph.p_offset : 0;
+            segments_.push_back(ElfCoreSegment{ph.p_vaddr, ph.p_memsz, ph.p_offset,
+                                               std::min<std::uint64_t>({ph.p_filesz, ph.p_memsz, available}),
+                                               ph.p_flags});
+        } else if (ph.p_type == PT_NOTE) {
+            if (ph.p_filesz > max_note_bytes)
+                return std::unexpected(Error{"Note segment too large"});
+            std::vector<std::uint8_t> notes(static_cast<std::size_t>(ph.p_filesz));
+            notes.resize(read_file(ph.p_offset, notes));
+            read_notes(notes);
+        }
+    }
+    std::stable_sort(segments_.begin(), segments_.end(),
+                     [](const ElfCoreSegment& a, const ElfCoreSegment& b) { return a.vaddr < b.vaddr; });
+    std::stable_sort(files_.begin(), files_.end(),
+                     [](const ElfCoreMappedFile& a, const ElfCoreMappedFile& b) { return a.start < b.start; });
+    return {};
+}
+
+void ElfCore::read_notes(std::span<const std::uint8_t> data) {
+    // The kernel pads core notes to 4 bytes whatever the class
+    for (const auto& n : parse_notes(data, 4, big_endian_)) {
+        if (n.name != "CORE")
+            continue;
+        switch (n.type) {
+            case NT_PRSTATUS: read_prstatus(n.desc); break;
+            case NT_PRPSINFO: read_prpsinfo(n.desc); break;
+            case NT_FILE:     read_file_note(n.desc); break;
+            case NT_AUXV:     read_auxv(n.desc); break;
+            case NT_SIGINFO:  read_siginfo(n.desc); break;
+            default: break;
+        }
+    }
+}
+
+void ElfCore::read_prstatus(std::span<const std::uint8_t> desc) {
+    // elf_prstatus: elf_siginfo (3 ints), pr_cursig, pr_sigpend and
+    // pr_sighold (longs), four pids, four timevals (two longs each), then
+    // pr_reg and pr_fpvalid. Only pr_reg's size depends on the machine.
+    const std::size_t word = is_64_ ? 8 : 4;
+    const std::size_t ids = 16 + 2 * word;
+    const std::size_t reg_offset = ids + 16 + 8 * word;
+    const std::size_t tail = is_64_ ? 8 : 4;    // pr_fpvalid, padded
+    if (desc.size() < reg_offset)
+        return;
+
+    ByteReader r(desc, big_endian_, 12);
+    ElfCoreThread t;
+    t.signal = r.u16();
+    r.seek(ids);
+    t.tid = r.u32();
+    t.ppid = r.u32();
+    t.pgrp = r.u32();
+    t.sid = r.u32();
+
+    if (desc.size() >= reg_offset + tail) {
+        const std::size_t count = (desc.size() - reg_offset - tail) / word;
+        r.seek(reg_offset);
+        t.registers.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+            t.registers.push_back(r.unsigned_of(word));
+        if (const auto roles = register_roles(machine_);
+            roles && core_register_names(machine_).size() == count) {
+            t.pc = t.registers[roles->pc];
+            t.sp = t.registers[roles->sp];
+        }
+    }
+    threads_.push_back(std::move(t));
+}
+
+void ElfCore::read_prpsinfo(std::span<const std::uint8_t> desc) {
+    // The layout ahead of the pids varies with the uid width, but every
+    // variant ends in pr_pid..pr_sid, pr_fname[16], pr_psargs[80]
+    constexpr std::size_t fname = 16;
+    constexpr std::size_t psargs = 80;
+    if (desc.size() < 16 + fname + psargs)
+        return;
+    const std::size_t fname_offset = desc.size() - psargs - fname;
+    ByteReader r(desc, big_endian_, fname_offset - 16);
+    ElfCoreProcess p;
+    p.pid = r.u32();
+    p.ppid = r.u32();
+    p.name = fixed_string(desc.subspan(fname_offset, fname));
+    p.args = fixed_string(desc.subspan(fname_offset + fname, psargs));
+    while (!p.args.empty() && p.args.back() == ' ')
+        p.args.pop_back();
+    process_ = std::move(p);
+}
+
+void ElfCore::read_file_note(std::span<const std::uint8_t> desc) {
+    // count, page_size, count x {start, end, page offset}, then count
+    // NUL-terminated paths
+    const std::size_t word = is_64_ ? 8 : 4;
+    ByteReader r(desc, big_endian_);
+    const std::uint64_t count = r.unsigned_of(word);
+    const std::uint64_t page_size = r.unsigned_of(word);
+    if (!r.ok() || count > r.remaining() / (3 * word))
+        return;
+
+    const std::size_t first = files_.size();
+    files_.resize(first + static_cast<std::size_t>(count));
+    for (std::size_t i = first; i < files_.size(); ++i) {
+        files_[i].start = r.unsigned_of(word);
+        files_[i].end = r.unsigned_of(word);
+        files_[i].file_offset = r.unsigned_of(word) * page_size;
+    }
+    for (std::size_t i = first; i < files_.size() && !r.at_end(); ++i)
+        files_[i].path = std::string(r.cstring());
+}
+
+void ElfCore::read_auxv(std::span<const std::uint8_t> desc) {
+    const std::size_t word = is_64_ ? 8 : 4;
+    ByteReader r(desc, big_endian_);
+    while (r.remaining() >= 2 * word) {
+        ElfAuxvEntry e;
+        e.type = r.unsigned_of(word);
+        e.value = r.unsigned_of(word);
+        if (e.type == AT_NULL)
+            break;
+        auxv_.push_back(e);
+    }
+}
+
+void ElfCore::read_siginfo(std::span<const std::uint8_t> desc) {
+    // siginfo_t: si_signo, si_errno, si_code, then a union aligned to the
+    // word size whose first member for fault signals is si_addr
+    const std::size_t word = is_64_ ? 8 : 4;
+    const std::size_t fields = is_64_ ? 16 : 12;
+    if (desc.size() < 12)
+        return;
+    ByteReader r(desc, big_endian_);
+    ElfCoreSignal s;
+    s.signo = static_cast<std::int32_t>(r.u32());
+    s.error = static_cast<std::int32_t>(r.u32());
+    s.code = static_cast<std::int32_t>(r.u32());
+    const bool fault = s.signo == sigsegv || s.signo == sigbus || s.signo == sigill || s.signo == sigfpe;
+    if (fault && s.code > 0 && desc.size() >= fields + word) {
+        r.seek(fields);
+        s.fault_address = r.unsigned_of(word);
+    }
+    signal_ = s;
+}
+
+std::optional<std::uint64_t> ElfCore::auxv_value(std::uint64_t type) const {
+    for (const auto& e : auxv_) {
+        if (e.type == type)
+            return e.value;
+    }
+    return std::nullopt;
+}
+
+const ElfCoreSegment* ElfCore::segment_at(std::uint64_t va) const {
+    auto it = std::upper_bound(segments_.begin(), segments_.end(), va,
+                               [](std::uint64_t v, const ElfCoreSegment& s) { return v < s.vaddr; });
+    if (it == segments_.begin())
+        return nullptr;
+    --it;
+    return va - it->vaddr < it->mem_size ? &*it : nullptr;
+}
+
+const ElfCoreMappedFile* ElfCore::mapped_file_at(std::uint64_t va) const {
+    auto it = std::upper_bound(files_.begin(), files_.end(), va,
+                               [](std::uint64_t v, const ElfCoreMappedFile& f) { return v < f.start; });
+    if (it == files_.begin())
+        return nullptr;
+    --it;
+    return va < it->end ? &*it : nullptr;
+}
+
+std::size_t ElfCore::read_memory(std::uint64_t va, std::span<std::uint8_t> out) const {
+    std::size_t done = 0;
+    while (done < out.size()) {
+        const ElfCoreSegment* s = segment_at(va + done);
+        if (!s)
+            break;
+        const std::uint64_t delta = va + done - s->vaddr;
+        if (delta >= s->file_size)
+            break;
+        const std::size_t want = static_cast<std::size_t>(std::min<std::uint64_t>(out.size() - done, s->file_size - delta));
+        const std::size_t got = read_file(s->offset + delta, out.subspan(done, want));
+        done += got;
+        if (got != want)
+            break;
+    }
+    return done;
+}
+
+} // namespace peelf
@@ -0,0 +1,149 @@
+#include "elf/elf_debuginfo.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "crypto/crc32.hpp"
+#include "elf/elf_notes.hpp"
+#include "mapping/file_mapping.hpp"
+
+namespace peelf {
+
+namespace {
+
+std::string hex(std::span<const std::uint8_t> bytes) {
+    static constexpr char digits[] = "0123456789abcdef";
+    std::string s;
+    s.reserve(bytes.size() * 2);
+    for (auto b : bytes) {
+        s += digits[b >> 4];
+        s += digits[b & 0xF];
+    }
+    return s;
+}
+
+bool exists_as_file(const std::filesystem::path& p) {
+    std::error_code ec;
+    return std::filesystem::is_regular_file(p, ec);
+}
+
+bool same_file(const std::filesystem::path& a, const std::filesystem::path& b) {
+    std::error_code ec;
+    return std::filesystem::equivalent(a, b, ec);
+}
+
+// The binary's real directory, symlinks resolved, as gdb uses it
+std::filesystem::path binary_directory(const std::filesystem::path& binary) {
+    std::error_code ec;
+    auto p = std::filesystem::weakly_canonical(binary, ec);
+    if (ec)
+        p = std::filesystem::absolute(binary, ec);
+    return p.parent_path();
+}
+
+} // namespace
+
+std::optional<ElfDebugLink> read_debuglink(const ElfView& elf) {
+    const auto index = elf.find_section(".gnu_debuglink");
+    if (!index)
+        return std::nullopt;
+    const auto data = elf.section_data(*index);
+    const auto* name = reinterpret_cast<const char*>(data.data());
+    const std::size_t length = strnlen(name, data.size());
+    // The CRC follows the name's NUL, 4-byte aligned, in the file's order
+    const std::size_t crc_offset = (length + 1 + 3) & ~std::size_t{3};
+    if (length == 0 || crc_offset + 4 > data.size())
+        return std::nullopt;
+
+    std::uint32_t crc;
+    std::memcpy(&crc, data.data() + crc_offset, sizeof(crc));
+    return ElfDebugLink{std::string(name, length), elf.to_native(crc)};
+}
+
+std::expected<std::uint32_t, Error> file_crc32(const std::filesystem::path& path) {
+    FileMapping<std::uint8_t, NativeFileMappingBackend> map;
+    if (auto ec = map.open(path.string()); ec)
+        return std::unexpected(Error{path.string() + ": " + ec.message()});
+    return Crc32::hash(map.view());
+}
+
+DebugFileResolver::DebugFileResolver(std::vector<std::filesystem::path> roots)
+    : roots_(std::move(roots)) {}
+
+std::optional<DebugFileMatch> DebugFileResolver::resolve(const std::filesystem::path& binary, const ElfView& elf) const {
+    std::vector<std::uint8_t> build_id;
+    if (auto info = read_build_info(elf.bytes()))
+        build_id = std::move(info->build_id);
+    return resolve(binary, build_id, read_debuglink(elf));
+}
+
+std::optional<DebugFileMatch> DebugFileResolver::resolve(const std::filesystem::path& binary,
+                                                         std::span<const std::uint8_t> build_id,
+                                                         const std::optional<ElfDebugLink>& link) const {
+    std::string key;
+    if (!build_id.empty()) {
+        key = hex(build_id);
+    } else if (link) {
+        char crc[9];
+        std::snprintf(crc, sizeof(crc), "%08x", link->crc);
+        key = "link:" + binary_directory(binary).string() + "/" + link->file + ":" + crc;
+    } else {
+        return std::nullopt;
+    }
+
+    {
+        std::lock_guard lock(mutex_);
+        if (auto it = cache_.find(key); it != cache_.end())
+            return it->second;
+    }
+    // Searched unlocked: CRC-checking a debug file reads all of it
+    auto found = search(binary, build_id, link);
+    std::lock_guard lock(mutex_);
+    cache_.emplace(std::move(key), found);
+    return found;
+}
+
+std::optional<DebugFileMatch> DebugFileResolver::search(const std::filesystem::path& binary,
+                                                        std::span<const std::uint8_t> build_id,
+                                                        const std::optional<ElfDebugLink>& link) const {
+    if (build_id.size() >= 2) {
+        const std::string id = hex(build_id);
+        const std::string leaf = id.substr(2) + ".debug";
+        for (const auto& root : roots_) {
+            const auto candidate = root / ".build-id" / id.substr(0, 2) / leaf;
+            if (!exists_as_file(candidate) || same_file(candidate, binary))
+                continue;
+            auto info = read_build_info(candidate);
+            if (info && std::ranges::equal(info->build_id, build_id))
+                return DebugFileMatch{candidate, DebugFileSource::BuildId};
+        }
+    }
+
+    if (link && !link->file.empty()) {
+        const auto dir = binary_directory(binary);
+        std::vector<std::filesystem::path> candidates = {dir / link->file, dir / ".debug" / link->file};
+        for (const auto& root : roots_)
+            candidates.push_back(root / dir.relative_path() / link->file);
+        for (const auto& candidate : candidates) {
+            if (!exists_as_file(candidate) || same_file(candidate, binary))
+                continue;
+            auto crc = file_crc32(candidate);
+            if (crc && *crc == link->crc)
+                return DebugFileMatch{candidate, DebugFileSource::DebugLink};
+        }
+    }
+    return std::nullopt;
+}
+
+std::size_t DebugFileResolver::cache_size() const {
+    std::lock_guard lock(mutex_);
+    return cache_.size();
+}
+
+void DebugFileResolver::clear_cache() {
+    std::lock_guard lock(mutex_);
+    cache_.clear();
+}
+
+} // namespace peelf
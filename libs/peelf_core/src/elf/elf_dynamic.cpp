@@ -0,0 +1,86 @@
+#include "elf/elf_dynamic.hpp"
+
+namespace peelf {
+
+namespace {
+
+std::span<const std::uint8_t> dynamic_bytes(const ElfView& elf) {
+    for (std::size_t i = 0; i < elf.segment_count(); ++i) {
+        if (elf.segment(i).type == PT_DYNAMIC)
+            return elf.segment_data(i);
+    }
+    if (auto index = elf.find_section_by_type(SHT_DYNAMIC))
+        return elf.section_data(*index);
+    return {};
+}
+
+template<typename Traits>
+std::expected<void, Error> read_entries(const ElfView& elf, std::span<const std::uint8_t> raw,
+                                        std::vector<ElfDynamicEntry>& out) {
+    const auto table = elf.table<typename Traits::dyn>(raw);
+    if (table.size() > elf.limits().max_table_entries)
+        return std::unexpected(Error{"Dynamic section exceeds entry budget"});
+    for (const auto& d : table) {
+        if (d.d_tag == DT_NULL)
+            break;
+        out.push_back(ElfDynamicEntry{d.d_tag, d.d_val});
+    }
+    return {};
+}
+
+} // namespace
+
+std::optional<std::uint64_t> ElfDynamicInfo::value(std::int64_t tag) const {
+    for (const auto& e : entries) {
+        if (e.tag == tag)
+            return e.value;
+    }
+    return std::nullopt;
+}
+
+std::expected<ElfDynamicInfo, Error> read_dynamic(const ElfView& elf) {
+    ElfDynamicInfo out;
+    const auto raw = dynamic_bytes(elf);
+    if (raw.empty())
+        return out;
+
+    auto ok = elf.dispatch([&](auto traits) {
+        return read_entries<decltype(traits)>(elf, raw, out.entries);
+    });
+    if (!ok)
+        return std::unexpected(ok.error());
+
+    // DT_STRTAB is an address; DT_STRSZ bounds it
+    std::span<const std::uint8_t> strtab;
+    const auto strtab_addr = out.value(DT_STRTAB);
+    const auto strsz = out.value(DT_STRSZ);
+    if (strtab_addr && strsz) {
+        if (auto off = elf.vaddr_to_offset(*strtab_addr))
+            strtab = elf.file_span(*off, *strsz);
+    }
+    if (strtab.empty()) {
+        if (auto index = elf.find_section(".dynstr"))
+            strtab = elf.section_data(*index);
+    }
+    const auto str = [&](std::uint64_t offset) {
+        return ElfView::cstring_at(strtab, static_cast<std::size_t>(offset));
+    };
+
+    for (const auto& e : out.entries) {
+        switch (e.tag) {
+            case DT_NEEDED:   out.needed.push_back(str(e.value)); break;
+            case DT_SONAME:   out.soname = str(e.value); break;
+            case DT_RPATH:    out.rpath = str(e.value); break;
+            case DT_RUNPATH:  out.runpath = str(e.value); break;
+            case DT_FLAGS:    out.flags = e.value; break;
+            case DT_FLAGS_1:  out.flags_1 = e.value; break;
+            case DT_BIND_NOW: out.bind_now = true; break;
+            default: break;
+        }
+    }
+    if ((out.flags & DF_BIND_NOW) || (out.flags_1 & DF_1_NOW))
+        out.bind_now = true;
+    return out;
+}
+
+} // namespace peelf
@@ -0,0 +1,228 @@
+#include "elf/elf_notes.hpp"
+
+#include <bit>
+#include <cstring>
+
+#include "elf/elf_traits.hpp"
+#include "mapping/file_mapping.hpp"
+#include "peelf/byteswap.hpp"
+#include "peelf/parallel.hpp"
+
+namespace peelf {
+
+namespace {
+
+// One record at offset, converted to host order when the file needs it
+template<typename T>
+bool load_record(std::span<const std::uint8_t> bytes, std::uint64_t offset, bool swap, T& out) {
+    if (offset > bytes.size() || bytes.size() - offset < sizeof(T))
+        return false;
+    std::memcpy(&out, bytes.data() + offset, sizeof(T));
+    if (swap) {
+        const std::span<std::uint8_t> rec{reinterpret_cast<std::uint8_t*>(&out), sizeof(T)};
+        RecordSwapper::for_type<T>().swap(rec, rec);
+    }
+    return true;
+}
+
+std::uint32_t load_u32(std::span<const std::uint8_t> bytes, std::size_t offset, bool swap) {
+    std::uint32_t v;
+    std::memcpy(&v, bytes.data() + offset, sizeof(v));
+    return swap ? std::byteswap(v) : v;
+}
+
+constexpr std::uint64_t align_up(std::uint64_t v, std::uint64_t a) {
+    return (v + a - 1) & ~(a - 1);
+}
+
+bool host_differs(bool big_endian) {
+    return big_endian != (std::endian::native == std::endian::big);
+}
+
+// pr_type / pr_datasz pairs; each payload is padded to the word size
+void read_gnu_properties(std::span<const std::uint8_t> desc, std::size_t word, bool swap, ElfBuildInfo& out) {
+    std::size_t pos = 0;
+    while (desc.size() - pos >= 8) {
+        const std::uint32_t type = load_u32(desc, pos, swap);
+        const std::uint32_t size = load_u32(desc, pos + 4, swap);
+        pos += 8;
+        if (size > desc.size() - pos)
+            return;
+        if (size >= 4) {
+            const std::uint32_t value = load_u32(desc, pos, swap);
+            switch (type) {
+                case GNU_PROPERTY_X86_FEATURE_1_AND:     out.x86_features = value; break;
+                case GNU_PROPERTY_AARCH64_FEATURE_1_AND: out.aarch64_features = value; break;
+                case GNU_PROPERTY_X86_ISA_1_NEEDED:      out.x86_isa_needed = value; break;
+                default: break;
+            }
+        }
+        pos = static_cast<std::size_t>(align_up(pos + size, word));
+        if (pos > desc.size())
+            return;
+    }
+}
+
+void collect_notes(std::span<const std::uint8_t> data, std::size_t align, bool big_endian, ElfBuildInfo& out) {
+    const bool swap = host_differs(big_endian);
+    for (const auto& n : parse_notes(data, align, big_endian)) {
+        if (n.name != "GNU")
+            continue;
+        switch (n.type) {
+            case NT_GNU_BUILD_ID:
+                out.build_id.assign(n.desc.begin(), n.desc.end());
+                break;
+            case NT_GNU_ABI_TAG:
+                if (n.desc.size() >= 16) {
+                    out.abi_tag = ElfAbiTag{load_u32(n.desc, 0, swap), load_u32(n.desc, 4, swap),
+                                            load_u32(n.desc, 8, swap), load_u32(n.desc, 12, swap)};
+                }
+                break;
+            case NT_GNU_PROPERTY_TYPE_0:
+                read_gnu_properties(n.desc, out.is_64 ? 8 : 4, swap, out);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+template<typename Traits>
+std::expected<ElfBuildInfo, Error> build_info(std::span<const std::uint8_t> file, bool big_endian) {
+    using ehdr_t = typename Traits::ehdr;
+    using shdr_t = typename Traits::shdr;
+    using phdr_t = typename Traits::phdr;
+    const bool swap = host_differs(big_endian);
+
+    ehdr_t eh{};
+    if (!load_record(file, 0, swap, eh))
+        return std::unexpected(Error{"ELF header truncated"});
+
+    ElfBuildInfo out;
+    out.is_64 = Traits::is_64;
+    out.machine = eh.e_machine;
+
+    std::size_t phnum = eh.e_phnum;
+    if (phnum == PN_XNUM) {
+        shdr_t sh0{};
+        if (!load_record(file, eh.e_shoff, swap, sh0))
+            return std::unexpected(Error{"Section header table out of range"});
+        phnum = sh0.sh_info;
+    }
+    if (phnum != 0 && eh.e_phentsize != sizeof(phdr_t))
+        return std::unexpected(Error{"Unexpected e_phentsize"});
+
+    bool found = false;
+    for (std::size_t i = 0; i < phnum; ++i) {
+        phdr_t ph{};
+        if (!load_record(file, eh.e_phoff + std::uint64_t{i} * sizeof(phdr_t), swap, ph))
+            return std::unexpected(Error{"Program header table out of range"});
+        if (ph.p_type != PT_NOTE)
+            continue;
+        found = true;
+        if (ph.p_offset <= file.size() && ph.p_filesz <= file.size() - ph.p_offset) {
+            collect_notes(file.subspan(static_cast<std::size_t>(ph.p_offset), static_cast<std::size_t>(ph.p_filesz)),
+                          static_cast<std::size_t>(ph.p_align), big_endian, out);
+        }
+    }
+    if (found || eh.e_shoff == 0)
+        return out;
+
+    // Relocatable objects have no program headers; their notes are sections
+    if (eh.e_shentsize != sizeof(shdr_t))
+        return std::unexpected(Error{"Unexpected e_shentsize"});
+    std::size_t shnum = eh.e_shnum;
+    if (shnum == 0) {
+        shdr_t sh0{};
+        if (!load_record(file, eh.e_shoff, swap, sh0))
+            return std::unexpected(Error{"Section header table out of range"});
+        shnum = static_cast<std::size_t>(sh0.sh_size);
+    }
+    for (std::size_t i = 1; i < shnum; ++i) {
+        shdr_t sh{};
+        if (!load_record(file, eh.e_shoff + std::uint64_t{i} * sizeof(shdr_t), swap, sh))
+            return std::unexpected(Error{"Section header table out of range"});
+        if (sh.sh_type != SHT_NOTE)
+            continue;
+        if (sh.sh_offset <= file.size() && sh.sh_size <= file.size() - sh.sh_offset) {
+            collect_notes(file.subspan(static_cast<std::size_t>(sh.sh_offset), static_cast<std::size_t>(sh.sh_size)),
+                          static_cast<std::size_t>(sh.sh_addralign), big_endian, out);
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+std::vector<ElfNote> parse_notes(std::span<const std::uint8_t> data, std::size_t align, bool big_endian) {
+    // Only 4 and 8 are meaningful; anything else is treated as 4
+    const std::uint64_t a = align == 8 ? 8 : 4;
+    const bool swap = host_differs(big_endian);
+
+    std::vector<ElfNote> out;
+    std::uint64_t pos = 0;
+    while (data.size() - pos >= sizeof(Elf_Nhdr_)) {
+        Elf_Nhdr_ nh{};
+        (void)load_record(data, pos, swap, nh);
+
+        const std::uint64_t name_off = pos + sizeof(Elf_Nhdr_);
+        const std::uint64_t desc_off = align_up(name_off + nh.n_namesz, a);
+        const std::uint64_t end = desc_off + nh.n_descsz;
+        if (name_off + nh.n_namesz > data.size() || end > data.size())
+            break;
+
+        std::string_view name(reinterpret_cast<const char*>(data.data() + name_off), nh.n_namesz);
+        while (!name.empty() && name.back() == '\0')
+            name.remove_suffix(1);
+        out.push_back(ElfNote{name, nh.n_type,
+                              data.subspan(static_cast<std::size_t>(desc_off), nh.n_descsz)});
+
+        pos = align_up(end, a);
+        if (pos > data.size())
+            break;
+    }
+    return out;
+}
+
+std::string ElfBuildInfo::build_id_hex() const {
+    static constexpr char digits[] = "0123456789abcdef";
+    std::string s;
+    s.reserve(build_id.size() * 2);
+    for (auto b : build_id) {
+        s += digits[b >> 4];
+        s += digits[b & 0xF];
+    }
+    return s;
+}
+
+std::expected<ElfBuildInfo, Error> read_build_info(std::span<const std::uint8_t> file) {
+    if (file.size() < EI_NIDENT || file[0] != 0x7F || file[1] != 'E' || file[2] != 'L' || file[3] != 'F')
+        return std::unexpected(Error{"Missing ELF magic"});
+    if (file[EI_DATA] != ELFDATA2LSB && file[EI_DATA] != ELFDATA2MSB)
+        return std::unexpected(Error{"Invalid ELF data encoding"});
+
+    const bool big_endian = file[EI_DATA] == ELFDATA2MSB;
+    switch (file[EI_CLASS]) {
+        case ELFCLASS32: return build_info<Elf32Traits>(file, big_endian);
+        case ELFCLASS64: return build_info<Elf64Traits>(file, big_endian);
+        default:         return std::unexpected(Error{"Invalid ELF class"});
+    }
+}
+
+std::expected<ElfBuildInfo, Error> read_build_info(const std::filesystem::path& path) {
+    FileMapping<std::uint8_t, NativeFileMappingBackend> map;
+    if (auto ec = map.open(path.string()); ec)
+        return std::unexpected(Error{path.string() + ": " + ec.message()});
+    return read_build_info(map.view());
+}
+
+std::vector<std::expected<ElfBuildInfo, Error>>
+read_build_info_batch(std::span<const std::filesystem::path> paths, std::size_t threads) {
+    std::vector<std::expected<ElfBuildInfo, Error>> results(paths.size());
+    parallel_for(paths.size(), [&](std::size_t i) {
+        results[i] = read_build_info(paths[i]);
+    }, threads, 16);
+    return results;
+}
+
+} // namespace peelf
@@ -2,32 +2,36 @@
 
 #include <cstdint>
 
-#include "elf/elf_definitions.h"
+#include "elf/elf_parser.h"
+#include "elf/elf_structures.hpp"
 
 namespace peelf {
 
-
-
-
-
-static std::uint16_t read_u16_le(std::span<const std::uint8_t> b, std::size_t off) {
+static std::uint16_t read_u16(std::span<const std::uint8_t> b, std::size_t off, bool big_endian) {
+    if (big_endian) {
+        return static_cast<std::uint16_t>((static_cast<std::uint16_t>(b[off]) << 8) | b[off + 1]);
+    }
     return static_cast<std::uint16_t>(b[off] | (static_cast<std::uint16_t>(b[off + 1]) << 8));
 }
 
+// Only the identification bytes and the header fields it reports are read,
+// whatever the rest of the file looks like; ElfView::parse is the strict
+// parser.
 std::expected<FileInfo, Error> parse_elf_bytes(std::span<const std::uint8_t> bytes) {
     if (bytes.size() < 0x20) {
         return std::unexpected(Error{"ELF file too small"});
     }
 
-    const std::uint8_t ei_class = bytes[4];
-    const std::uint8_t ei_data  = bytes[5];
+    const std::uint8_t ei_class = bytes[EI_CLASS];
+    const std::uint8_t ei_data  = bytes[EI_DATA];
 
-    if (ei_data != 1) {
-        return std::unexpected(Error{"ELF big-endian not supported yet"});
+    if (ei_data != ELFDATA2LSB && ei_data != ELFDATA2MSB) {
+        return std::unexpected(Error{"Invalid ELF data encoding"});
     }
+    const bool big_endian = ei_data == ELFDATA2MSB;
 
-    const std::uint16_t e_type = read_u16_le(bytes, 0x10);
-    const std::uint16_t e_machine = read_u16_le(bytes, 0x12);
+    const std::uint16_t e_type = read_u16(bytes, 0x10, big_endian);
+    const std::uint16_t e_machine = read_u16(bytes, 0x12, big_endian);
 
     FileInfo info;
     info.kind = FileKind::ELF;
@@ -0,0 +1,415 @@
+#include "elf/elf_relocations.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+
+#include "peelf/cpu_features.hpp"
+#include "relr_kernels.hpp"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define PEELF_RELR_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(PEELF_RELR_X86) && (defined(__GNUC__) || defined(__clang__))
+#define PEELF_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define PEELF_TARGET_AVX2
+#endif
+
+namespace peelf {
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// RELR expansion
+//
+// A RELR bitmap word marks, with bits 1..N-1, which of the next N-1 words
+// after the current base are relocated. Each byte of the bitmap expands
+// through a 256-entry table of set-bit positions: all eight candidate
+// offsets are written unconditionally and the output cursor advances by the
+// byte's popcount, so the hot loop has no per-bit branches. The output
+// buffer carries eight entries of slack for the overshoot.
+// ---------------------------------------------------------------------------
+
+struct BitPositions {
+    std::array<std::array<std::uint8_t, 8>, 256> index{};
+    std::array<std::uint8_t, 256> count{};
+};
+
+constexpr BitPositions make_bit_positions() {
+    BitPositions t;
+    for (std::size_t b = 0; b < 256; ++b) {
+        std::uint8_t n = 0;
+        for (std::uint8_t bit = 0; bit < 8; ++bit) {
+            if (b & (1u << bit))
+                t.index[b][n++] = bit;
+        }
+        t.count[b] = n;
+    }
+    return t;
+}
+
+constexpr BitPositions BIT_POSITIONS = make_bit_positions();
+constexpr std::size_t RELR_SLACK = 8;
+
+} // namespace
+
+namespace detail {
+
+std::size_t relr_expand_scalar(std::uint64_t bits, std::uint64_t base, unsigned shift,
+                               std::size_t bytes, std::uint64_t* dst) {
+    std::uint64_t* out = dst;
+    for (std::size_t k = 0; k < bytes; ++k, bits >>= 8) {
+        const auto b = static_cast<std::uint8_t>(bits);
+        if (b == 0)
+            continue;
+        const std::uint64_t chunk = base + (std::uint64_t{k * 8} << shift);
+        const auto& idx = BIT_POSITIONS.index[b];
+        for (std::size_t j = 0; j < 8; ++j)
+            out[j] = chunk + (std::uint64_t{idx[j]} << shift);
+        out += BIT_POSITIONS.count[b];
+    }
+    return static_cast<std::size_t>(out - dst);
+}
+
+#if defined(PEELF_RELR_X86)
+
+namespace {
+
+PEELF_TARGET_AVX2
+std::size_t expand_bitmap_avx2(std::uint64_t bits, std::uint64_t base, unsigned shift,
+                               std::size_t bytes, std::uint64_t* dst) {
+    std::uint64_t* out = dst;
+    const __m128i vshift = _mm_cvtsi32_si128(static_cast<int>(shift));
+    for (std::size_t k = 0; k < bytes; ++k, bits >>= 8) {
+        const auto b = static_cast<std::uint8_t>(bits);
+        if (b == 0)
+            continue;
+        const __m256i chunk = _mm256_set1_epi64x(static_cast<long long>(base + (std::uint64_t{k * 8} << shift)));
+        const __m128i idx = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(BIT_POSITIONS.index[b].data()));
+        const __m256i lo = _mm256_sll_epi64(_mm256_cvtepu8_epi64(idx), vshift);
+        const __m256i hi = _mm256_sll_epi64(_mm256_cvtepu8_epi64(_mm_srli_si128(idx, 4)), vshift);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_add_epi64(chunk, lo));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 4), _mm256_add_epi64(chunk, hi));
+        out += BIT_POSITIONS.count[b];
+    }
+    return static_cast<std::size_t>(out - dst);
+}
+
+} // namespace
+
+const relr_expand_fn relr_expand_avx2 = &expand_bitmap_avx2;
+
+#else
+
+const relr_expand_fn relr_expand_avx2 = nullptr;
+
+#endif
+
+} // namespace detail
+
+namespace {
+
+detail::relr_expand_fn select_expand() {
+#if defined(PEELF_RELR_X86)
+    if (cpu_features().avx2)
+        return detail::relr_expand_avx2;
+#endif
+    return &detail::relr_expand_scalar;
+}
+
+// ---------------------------------------------------------------------------
+// Table readers
+// ---------------------------------------------------------------------------
+
+struct PendingRelocation {
+    std::uint64_t offset = 0;
+    std::int64_t addend = 0;
+    std::uint32_t type = 0;
+    std::uint32_t symbol = 0;
+    std::uint32_t section = 0;
+    ElfRelocationFormat format = ElfRelocationFormat::Rel;
+};
+
+struct FileTable {
+    std::span<const std::uint8_t> bytes;
+    std::uint32_t target_section = 0;
+};
+
+template<typename Traits>
+void split_info(typename Traits::word_type info, std::uint32_t& sym, std::uint32_t& type) {
+    if constexpr (Traits::is_64) {
+        sym = static_cast<std::uint32_t>(info >> 32);
+        type = static_cast<std::uint32_t>(info);
+    } else {
+        sym = static_cast<std::uint32_t>(info >> 8);
+        type = static_cast<std::uint32_t>(info & 0xFF);
+    }
+}
+
+template<typename Traits>
+void read_rel(const ElfView& elf, const FileTable& t, std::vector<PendingRelocation>& out) {
+    for (const auto& r : elf.table<typename Traits::rel>(t.bytes)) {
+        PendingRelocation p{.offset = r.r_offset, .section = t.target_section, .format = ElfRelocationFormat::Rel};
+        split_info<Traits>(r.r_info, p.symbol, p.type);
+        out.push_back(p);
+    }
+}
+
+template<typename Traits>
+void read_rela(const ElfView& elf, const FileTable& t, std::vector<PendingRelocation>& out) {
+    for (const auto& r : elf.table<typename Traits::rela>(t.bytes)) {
+        PendingRelocation p{.offset = r.r_offset, .addend = r.r_addend, .section = t.target_section,
+                            .format = ElfRelocationFormat::Rela};
+        split_info<Traits>(r.r_info, p.symbol, p.type);
+        out.push_back(p);
+    }
+}
+
+template<typename Traits>
+std::expected<void, Error> read_relr(const ElfView& elf, const FileTable& t, std::vector<std::uint64_t>& out) {
+    using word_t = typename Traits::word_type;
+    std::vector<std::uint64_t> entries(t.bytes.size() / sizeof(word_t));
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        word_t w;
+        std::memcpy(&w, t.bytes.data() + i * sizeof(word_t), sizeof(w));
+        entries[i] = elf.to_native(w);
+    }
+    return ElfRelocationTable::decode_relr(entries, sizeof(word_t), elf.limits().max_table_entries, out);
+}
+
+// Table of a linked object described by an address / size tag pair
+FileTable dynamic_table(const ElfView& elf, const ElfDynamicInfo& dyn, std::int64_t addr_tag, std::int64_t size_tag) {
+    const auto addr = dyn.value(addr_tag);
+    const auto size = dyn.value(size_tag);
+    if (!addr || !size || *size == 0)
+        return {};
+    const auto off = elf.vaddr_to_offset(*addr);
+    if (!off)
+        return {};
+    return {elf.file_span(*off, *size), 0};
+}
+
+bool contains(std::span<const std::uint8_t> outer, std::span<const std::uint8_t> inner) {
+    return !outer.empty() && !inner.empty() && inner.data() >= outer.data() &&
+           inner.data() + inner.size() <= outer.data() + outer.size();
+}
+
+} // namespace
+
+std::expected<void, Error> ElfRelocationTable::decode_relr(std::span<const std::uint64_t> entries,
+                                                           std::size_t word_size, std::size_t max_relocations,
+                                                           std::vector<std::uint64_t>& out) {
+    if (word_size != 4 && word_size != 8)
+        return std::unexpected(Error{"Unsupported RELR word size"});
+    const unsigned shift = word_size == 8 ? 3 : 2;
+    const std::size_t bitmap_bits = word_size * 8 - 1;
+    const std::size_t bitmap_bytes = word_size;          // covers bits 1..N-1 after the shift
+
+    // Exact count first so the output is sized once
+    std::size_t total = 0;
+    for (auto e : entries)
+        total += (e & 1) ? static_cast<std::size_t>(std::popcount(e >> 1)) : 1;
+    if (total > max_relocations)
+        return std::unexpected(Error{"RELR table exceeds entry budget"});
+
+    static const detail::relr_expand_fn expand = select_expand();
+
+    const std::size_t start = out.size();
+    out.resize(start + total + RELR_SLACK);
+    std::uint64_t* dst = out.data() + start;
+    std::uint64_t base = 0;
+    bool have_base = false;
+    for (auto e : entries) {
+        if ((e & 1) == 0) {
+            *dst++ = e;
+            base = e + word_size;
+            have_base = true;
+        } else {
+            if (!have_base)
+                return std::unexpected(Error{"RELR bitmap without a preceding address"});
+            dst += expand(e >> 1, base, shift, bitmap_bytes, dst);
+            base += bitmap_bits * word_size;
+        }
+    }
+    out.resize(start + total);
+    return {};
+}
+
+std::expected<ElfRelocationTable, Error> ElfRelocationTable::load(const ElfView& elf, const ElfDynamicInfo& dyn) {
+    ElfRelocationTable out;
+    out.word_size_ = elf.is_64() ? 8 : 4;
+
+    std::vector<PendingRelocation> pending;
+    std::vector<std::uint64_t> relr;
+
+    auto ok = elf.dispatch([&](auto traits) -> std::expected<void, Error> {
+        using T = decltype(traits);
+
+        const auto budget_ok = [&] { return pending.size() <= elf.limits().max_table_entries; };
+
+        const bool linked = dyn.value(DT_RELA) || dyn.value(DT_REL) || dyn.value(DT_JMPREL) || dyn.value(DT_RELR);
+        if (linked) {
+            const auto rela = dynamic_table(elf, dyn, DT_RELA, DT_RELASZ);
+            const auto rel = dynamic_table(elf, dyn, DT_REL, DT_RELSZ);
+            const auto plt = dynamic_table(elf, dyn, DT_JMPREL, DT_PLTRELSZ);
+            const auto relr_table = dynamic_table(elf, dyn, DT_RELR, DT_RELRSZ);
+            read_rela<T>(elf, rela, pending);
+            read_rel<T>(elf, rel, pending);
+
+            // Some linkers let DT_RELASZ / DT_RELSZ cover the PLT relocations
+            // as well; read them only once.
+            if (!contains(rela.bytes, plt.bytes) && !contains(rel.bytes, plt.bytes)) {
+                if (dyn.value(DT_PLTREL).value_or(0) == static_cast<std::uint64_t>(DT_RELA))
+                    read_rela<T>(elf, plt, pending);
+                else
+                    read_rel<T>(elf, plt, pending);
+            }
+            if (!budget_ok())
+                return std::unexpected(Error{"Relocation tables exceed entry budget"});
+            return read_relr<T>(elf, relr_table, relr);
+        }
+
+        // Only ET_REL offsets are relative to the target section; static
+        // executables relocate addresses like linked objects do
+        const bool relocatable = elf.type() == ET_REL;
+        for (std::size_t i = 1; i < elf.section_count(); ++i) {
+            const auto s = elf.section(i);
+            const FileTable t{elf.section_data(s), relocatable ? s.info : 0};
+            if (s.type == SHT_RELA) {
+                read_rela<T>(elf, t, pending);
+            } else if (s.type == SHT_REL) {
+                read_rel<T>(elf, t, pending);
+            } else if (s.type == SHT_RELR) {
+                if (auto r = read_relr<T>(elf, t, relr); !r)
+                    return r;
+            }
+            if (!budget_ok())
+                return std::unexpected(Error{"Relocation tables exceed entry budget"});
+        }
+        return {};
+    });
+    if (!ok)
+        return std::unexpected(ok.error());
+
+    const std::uint32_t relative = relative_relocation_type(elf.machine());
+    out.relr_count_ = relr.size();
+    pending.reserve(pending.size() + relr.size());
+    for (auto off : relr)
+        pending.push_back({.offset = off, .type = relative, .format = ElfRelocationFormat::Relr});
+
+    // Offsets of different ET_REL target sections overlap; keep each
+    // section's relocations together
+    const auto by_offset = [](const PendingRelocation& a, const PendingRelocation& b) {
+        return a.section != b.section ? a.section < b.section : a.offset < b.offset;
+    };
+    if (!std::ranges::is_sorted(pending, by_offset))
+        std::ranges::stable_sort(pending, by_offset);
+
+    const std::size_t n = pending.size();
+    out.offsets_.resize(n);
+    out.addends_.resize(n);
+    out.types_.resize(n);
+    out.symbols_.resize(n);
+    out.target_sections_.resize(n);
+    out.formats_.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        out.offsets_[i] = pending[i].offset;
+        out.addends_[i] = pending[i].addend;
+        out.types_[i] = pending[i].type;
+        out.symbols_[i] = pending[i].symbol;
+        out.target_sections_[i] = pending[i].section;
+        out.formats_[i] = pending[i].format;
+    }
+    return out;
+}
+
+std::pair<std::size_t, std::size_t> ElfRelocationTable::section_range(std::uint32_t section) const {
+    const auto [first, last] = std::ranges::equal_range(target_sections_, section);
+    return {static_cast<std::size_t>(first - target_sections_.begin()),
+            static_cast<std::size_t>(last - target_sections_.begin())};
+}
+
+std::optional<std::size_t> ElfRelocationTable::find(std::uint64_t addr, std::uint32_t section) const {
+    const auto [lo, hi] = section_range(section);
+    const auto end = offsets_.begin() + static_cast<std::ptrdiff_t>(hi);
+    const auto it = std::lower_bound(offsets_.begin() + static_cast<std::ptrdiff_t>(lo), end, addr);
+    if (it == end || *it != addr)
+        return std::nullopt;
+    return static_cast<std::size_t>(it - offsets_.begin());
+}
+
+std::optional<std::size_t> ElfRelocationTable::covering(std::uint64_t addr, std::uint32_t section) const {
+    const auto [lo, hi] = section_range(section);
+    const auto begin = offsets_.begin() + static_cast<std::ptrdiff_t>(lo);
+    const auto it = std::upper_bound(begin, offsets_.begin() + static_cast<std::ptrdiff_t>(hi), addr);
+    if (it == begin || addr - *(it - 1) >= word_size_)
+        return std::nullopt;
+    return static_cast<std::size_t>(it - 1 - offsets_.begin());
+}
+
+std::pair<std::size_t, std::size_t> ElfRelocationTable::range(std::uint64_t lo, std::uint64_t hi,
+                                                              std::uint32_t section) const {
+    const auto [begin, end] = section_range(section);
+    const auto section_end = offsets_.begin() + static_cast<std::ptrdiff_t>(end);
+    const auto first = std::lower_bound(offsets_.begin() + static_cast<std::ptrdiff_t>(begin), section_end, lo);
+    const auto last = hi <= lo ? first : std::lower_bound(first, section_end, hi);
+    return {static_cast<std::size_t>(first - offsets_.begin()), static_cast<std::size_t>(last - offsets_.begin())};
+}
+
+std::uint32_t relative_relocation_type(std::uint16_t machine) {
+    switch (machine) {
+        case EM_386:     return R_386_RELATIVE;
+        case EM_X86_64:  return R_X86_64_RELATIVE;
+        case EM_AARCH64: return R_AARCH64_RELATIVE;
+        default:         return 0;
+    }
+}
+
+std::string_view relocation_type_name(std::uint16_t machine, std::uint32_t type) {
+    switch (machine) {
+        case EM_386:
+            switch (type) {
+                case R_386_32:        return "R_386_32";
+                case R_386_PC32:      return "R_386_PC32";
+                case R_386_GLOB_DAT:  return "R_386_GLOB_DAT";
+                case R_386_JMP_SLOT:  return "R_386_JMP_SLOT";
+                case R_386_RELATIVE:  return "R_386_RELATIVE";
+                case R_386_IRELATIVE: return "R_386_IRELATIVE";
+                default: return {};
+            }
+        case EM_X86_64:
+            switch (type) {
+                case R_X86_64_64:        return "R_X86_64_64";
+                case R_X86_64_PC32:      return "R_X86_64_PC32";
+                case R_X86_64_COPY:      return "R_X86_64_COPY";
+                case R_X86_64_GLOB_DAT:  return "R_X86_64_GLOB_DAT";
+                case R_X86_64_JUMP_SLOT: return "R_X86_64_JUMP_SLOT";
+                case R_X86_64_RELATIVE:  return "R_X86_64_RELATIVE";
+                case R_X86_64_DTPMOD64:  return "R_X86_64_DTPMOD64";
+                case R_X86_64_DTPOFF64:  return "R_X86_64_DTPOFF64";
+                case R_X86_64_TPOFF64:   return "R_X86_64_TPOFF64";
+                case R_X86_64_IRELATIVE: return "R_X86_64_IRELATIVE";
+                default: return {};
+            }
+        case EM_AARCH64:
+            switch (type) {
+                case R_AARCH64_ABS64:     return "R_AARCH64_ABS64";
+                case R_AARCH64_COPY:      return "R_AARCH64_COPY";
+                case R_AARCH64_GLOB_DAT:  return "R_AARCH64_GLOB_DAT";
+                case R_AARCH64_JUMP_SLOT: return "R_AARCH64_JUMP_SLOT";
+                case R_AARCH64_RELATIVE:  return "R_AARCH64_RELATIVE";
+                case R_AARCH64_TLS_TPREL: return "R_AARCH64_TLS_TPREL";
+                case R_AARCH64_TLSDESC:   return "R_AARCH64_TLSDESC";
+                case R_AARCH64_IRELATIVE: return "R_AARCH64_IRELATIVE";
+                default: return {};
+            }
+        default:
+            return {};
+    }
+}
+
+} // namespace peelf
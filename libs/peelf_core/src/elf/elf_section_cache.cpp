@@ -0,0 +1,251 @@
+#include "elf/elf_section_cache.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <string>
+
+#include "peelf/parallel.hpp"
+
+#if defined(PEELF_HAVE_ZLIB)
+#include <zlib.h>
+#endif
+#if defined(PEELF_HAVE_ZSTD)
+#include <zstd.h>
+#endif
+
+namespace peelf {
+
+namespace {
+
+// Output is grown this much at a time
+constexpr std::size_t decompress_chunk = 1u << 20;
+
+#if defined(PEELF_HAVE_ZLIB)
+std::expected<std::vector<std::uint8_t>, Error> inflate_zlib(std::span<const std::uint8_t> in, std::size_t size) {
+    z_stream zs{};
+    if (inflateInit(&zs) != Z_OK)
+        return std::unexpected(Error{"zlib initialisation failed"});
+    struct End {
+        z_stream* zs;
+        ~End() { inflateEnd(zs); }
+    } end{&zs};
+
+    std::vector<std::uint8_t> out;
+    std::size_t fed = 0;
+    std::uint8_t probe = 0;
+    for (;;) {
+        // avail_in is 32 bits wide: feed very large sections in slices
+        if (zs.avail_in == 0 && fed < in.size()) {
+            const std::size_t n = std::min<std::size_t>(in.size() - fed, UINT_MAX);
+            zs.next_in = const_cast<Bytef*>(in.data() + fed);
+            zs.avail_in = static_cast<uInt>(n);
+            fed += n;
+        }
+        // Once the declared size is reached only the end of the stream may
+        // follow; a one-byte probe catches data that goes on
+        const std::size_t produced = out.size();
+        const std::size_t room = produced < size ? std::min(decompress_chunk, size - produced) : 1;
+        if (produced < size) {
+            out.resize(produced + room);
+            zs.next_out = out.data() + produced;
+        } else {
+            zs.next_out = &probe;
+        }
+        zs.avail_out = static_cast<uInt>(room);
+
+        const int rc = inflate(&zs, Z_NO_FLUSH);
+        const std::size_t wrote = room - zs.avail_out;
+        if (produced < size)
+            out.resize(produced + wrote);
+        else if (wrote != 0)
+            return std::unexpected(Error{"Section decompresses past its declared size"});
+        if (rc == Z_STREAM_END)
+            break;
+        if (rc == Z_BUF_ERROR)
+            return std::unexpected(Error{"Compressed section is truncated"});
+        if (rc != Z_OK)
+            return std::unexpected(Error{std::string("zlib: ") + (zs.msg ? zs.msg : "inflate failed")});
+    }
+    if (out.size() != size)
+        return std::unexpected(Error{"Section is shorter than its declared size"});
+    return out;
+}
+#endif
+
+#if defined(PEELF_HAVE_ZSTD)
+std::expected<std::vector<std::uint8_t>, Error> decompress_zstd(std::span<const std::uint8_t> in, std::size_t size) {
+    ZSTD_DStream* ds = ZSTD_createDStream();
+    if (!ds)
+        return std::unexpected(Error{"zstd initialisation failed"});
+    struct Free {
+        ZSTD_DStream* ds;
+        ~Free() { ZSTD_freeDStream(ds); }
+    } free_stream{ds};
+    ZSTD_initDStream(ds);
+
+    std::vector<std::uint8_t> out;
+    ZSTD_inBuffer input{in.data(), in.size(), 0};
+    std::uint8_t probe = 0;
+    for (;;) {
+        const std::size_t produced = out.size();
+        const std::size_t room = produced < size ? std::min(decompress_chunk, size - produced) : 1;
+        ZSTD_outBuffer output{nullptr, room, 0};
+        if (produced < size) {
+            out.resize(produced + room);
+            output.dst = out.data() + produced;
+        } else {
+            output.dst = &probe;
+        }
+
+        const std::size_t rc = ZSTD_decompressStream(ds, &output, &input);
+        if (ZSTD_isError(rc))
+            return std::unexpected(Error{std::string("zstd: ") + ZSTD_getErrorName(rc)});
+        if (produced < size)
+            out.resize(produced + output.pos);
+        else if (output.pos != 0)
+            return std::unexpected(Error{"Section decompresses past its declared size"});
+        // rc == 0: a frame is complete; the payload may hold several
+        if (rc == 0 && input.pos == input.size)
+            break;
+        if (output.pos == 0 && input.pos == input.size)
+            return std::unexpected(Error{"Compressed section is truncated"});
+    }
+    if (out.size() != size)
+        return std::unexpected(Error{"Section is shorter than its declared size"});
+    return out;
+}
+#endif
+
+} // namespace
+
+std::expected<ElfCompressionInfo, Error> elf_compression_info(const ElfView& elf, std::size_t index) {
+    if (index >= elf.section_count())
+        return std::unexpected(Error{"Section index out of range"});
+    const ElfSection section = elf.section(index);
+    const auto raw = elf.section_data(section);
+
+    ElfCompressionInfo out;
+    out.size = raw.size();
+    out.alignment = section.addralign;
+    out.stream = raw;
+    if (raw.empty())
+        return out;
+
+    if (section.flags & SHF_COMPRESSED) {
+        return elf.dispatch([&](auto traits) -> std::expected<ElfCompressionInfo, Error> {
+            using chdr = typename decltype(traits)::chdr;
+            chdr header;
+            if (raw.size() < sizeof(chdr) || !elf.read_record(static_cast<std::size_t>(section.offset), header))
+                return std::unexpected(Error{"Compression header truncated"});
+            switch (header.ch_type) {
+                case ELFCOMPRESS_ZLIB: out.kind = ElfCompression::Zlib; break;
+                case ELFCOMPRESS_ZSTD: out.kind = ElfCompression::Zstd; break;
+                default:
+                    return std::unexpected(Error{"Unknown section compression " + std::to_string(header.ch_type)});
+            }
+            out.size = header.ch_size;
+            out.alignment = header.ch_addralign;
+            out.stream = raw.subspan(sizeof(chdr));
+            return out;
+        });
+    }
+
+    if (elf.section_name(index).starts_with(".zdebug_")) {
+        if (raw.size() < 12 || std::memcmp(raw.data(), "ZLIB", 4) != 0)
+            return std::unexpected(Error{"Malformed .zdebug section header"});
+        std::uint64_t size = 0;
+        for (std::size_t i = 4; i < 12; ++i)
+            size = (size << 8) | raw[i];
+        out.kind = ElfCompression::ZdebugZlib;
+        out.size = size;
+        out.stream = raw.subspan(12);
+    }
+    return out;
+}
+
+bool compression_supported(ElfCompression kind) {
+    switch (kind) {
+        case ElfCompression::None:
+            return true;
+        case ElfCompression::Zlib:
+        case ElfCompression::ZdebugZlib:
+#if defined(PEELF_HAVE_ZLIB)
+            return true;
+#else
+            return false;
+#endif
+        case ElfCompression::Zstd:
+#if defined(PEELF_HAVE_ZSTD)
+            return true;
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+std::expected<std::vector<std::uint8_t>, Error>
+decompress(ElfCompression kind, std::span<const std::uint8_t> stream, std::uint64_t size) {
+    if (size > SIZE_MAX)
+        return std::unexpected(Error{"Decompressed section does not fit in memory"});
+    const auto n = static_cast<std::size_t>(size);
+    switch (kind) {
+        case ElfCompression::None:
+            if (stream.size() != n)
+                return std::unexpected(Error{"Section size mismatch"});
+            return std::vector<std::uint8_t>(stream.begin(), stream.end());
+        case ElfCompression::Zlib:
+        case ElfCompression::ZdebugZlib:
+#if defined(PEELF_HAVE_ZLIB)
+            return inflate_zlib(stream, n);
+#else
+            return std::unexpected(Error{"zlib-compressed section: built without zlib"});
+#endif
+        case ElfCompression::Zstd:
+#if defined(PEELF_HAVE_ZSTD)
+            return decompress_zstd(stream, n);
+#else
+            return std::unexpected(Error{"zstd-compressed section: built without zstd"});
+#endif
+    }
+    return std::unexpected(Error{"Unknown section compression"});
+}
+
+ElfSectionCache::ElfSectionCache(const ElfView& elf, std::size_t capacity)
+    : elf_(&elf), cache_(std::make_unique<LruCache<std::size_t, std::vector<std::uint8_t>>>(capacity)) {}
+
+bool ElfSectionCache::is_compressed(std::size_t index) const {
+    const auto info = elf_compression_info(*elf_, index);
+    return info && info->kind != ElfCompression::None;
+}
+
+std::expected<ElfSectionData, Error> ElfSectionCache::data(std::size_t index) const {
+    auto info = elf_compression_info(*elf_, index);
+    if (!info)
+        return std::unexpected(info.error());
+    if (info->kind == ElfCompression::None)
+        return ElfSectionData{info->stream, nullptr};
+    if (auto cached = cache_->get(index))
+        return ElfSectionData{*cached, cached};
+
+    // Decoded outside the cache lock; concurrent misses on one section
+    // both decode it and the later put() wins
+    auto bytes = decompress(info->kind, info->stream, info->size);
+    if (!bytes)
+        return std::unexpected(bytes.error());
+    auto shared = std::make_shared<const std::vector<std::uint8_t>>(std::move(*bytes));
+    cache_->put(index, shared, shared->size());
+    return ElfSectionData{*shared, shared};
+}
+
+void ElfSectionCache::prefetch(std::span<const std::size_t> indices, std::size_t threads) const {
+    std::vector<std::size_t> todo;
+    for (const std::size_t index : indices) {
+        if (is_compressed(index))
+            todo.push_back(index);
+    }
+    parallel_for(todo.size(), [&](std::size_t k) { (void)data(todo[k]); }, threads, 1);
+}
+
+} // namespace peelf
@@ -0,0 +1,306 @@
+#include "elf/elf_symbols.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace peelf {
+
+namespace {
+
+bool is_address_symbol(std::uint8_t type) {
+    return type == STT_NOTYPE || type == STT_OBJECT || type == STT_FUNC || type == STT_GNU_IFUNC;
+}
+
+std::expected<ElfSymbolTable, Error> read_first_of_type(const ElfView& elf, std::uint32_t type) {
+    const auto index = elf.find_section_by_type(type);
+    if (!index)
+        return ElfSymbolTable{};
+    return ElfSymbolTable::load(elf, *index);
+}
+
+} // namespace
+
+std::uint32_t ElfSymbolTable::gnu_hash(std::string_view name) {
+    std::uint32_t h = 5381;
+    for (char c : name)
+        h = h * 33 + static_cast<unsigned char>(c);
+    return h;
+}
+
+std::uint32_t ElfSymbolTable::sysv_hash(std::string_view name) {
+    std::uint32_t h = 0;
+    for (char c : name) {
+        h = (h << 4) + static_cast<unsigned char>(c);
+        const std::uint32_t g = h & 0xF0000000u;
+        h ^= g >> 24;
+        h &= ~g;
+    }
+    return h;
+}
+
+std::expected<ElfSymbolTable, Error> ElfSymbolTable::load(const ElfView& elf, std::size_t section_index) {
+    const auto sec = elf.section(section_index);
+    if (sec.type != SHT_SYMTAB && sec.type != SHT_DYNSYM)
+        return std::unexpected(Error{"Section is not a symbol table"});
+
+    ElfSymbolTable out;
+    out.section_type_ = sec.type;
+    out.swap_ = elf.is_big_endian() != (std::endian::native == std::endian::big);
+    out.is_64_ = elf.is_64();
+
+    auto ok = elf.dispatch([&](auto traits) {
+        return out.decode<decltype(traits)>(elf, sec, section_index);
+    });
+    if (!ok)
+        return std::unexpected(ok.error());
+
+    if (sec.type == SHT_DYNSYM)
+        out.attach_hash_tables(elf, section_index);
+    if (!out.has_gnu_hash() && !out.has_sysv_hash())
+        out.build_name_index();
+    out.build_address_index();
+    return out;
+}
+
+template<typename Traits>
+std::expected<void, Error> ElfSymbolTable::decode(const ElfView& elf, const ElfSection& sec,
+                                                  std::size_t section_index) {
+    using sym_t = typename Traits::sym;
+
+    if (sec.entsize != sizeof(sym_t))
+        return std::unexpected(Error{"Unexpected symbol entry size"});
+    const auto raw = elf.section_data(sec);
+    if (raw.size() != sec.size)
+        return std::unexpected(Error{"Symbol table out of range"});
+    const std::size_t count = raw.size() / sizeof(sym_t);
+    if (count > elf.limits().max_table_entries)
+        return std::unexpected(Error{"Symbol table exceeds entry budget"});
+
+    const auto strtab = elf.section_data(sec.link);
+
+    // Extended section indices for symbols whose st_shndx is SHN_XINDEX
+    std::span<const std::uint8_t> xindex_raw;
+    for (std::size_t i = 1; i < elf.section_count(); ++i) {
+        const auto s = elf.section(i);
+        if (s.type == SHT_SYMTAB_SHNDX && s.link == section_index) {
+            xindex_raw = elf.section_data(s);
+            break;
+        }
+    }
+
+    const auto syms = elf.template table<sym_t>(raw);
+    names_.resize(count);
+    values_.resize(count);
+    sizes_.resize(count);
+    info_.resize(count);
+    other_.resize(count);
+    shndx_.resize(count);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& s = syms[i];
+        names_[i] = ElfView::cstring_at(strtab, s.st_name);
+        values_[i] = s.st_value;
+        sizes_[i] = s.st_size;
+        info_[i] = s.st_info;
+        other_[i] = s.st_other;
+        shndx_[i] = s.st_shndx;
+        if (s.st_shndx == SHN_XINDEX && (i + 1) * 4 <= xindex_raw.size())
+            shndx_[i] = word(xindex_raw, i);
+    }
+    return {};
+}
+
+void ElfSymbolTable::attach_hash_tables(const ElfView& elf, std::size_t section_index) {
+    const std::size_t nsyms = size();
+    const std::size_t bloom_word = is_64_ ? 8 : 4;
+
+    for (std::size_t i = 1; i < elf.section_count(); ++i) {
+        const auto s = elf.section(i);
+        if (s.link != section_index)
+            continue;
+        const auto data = elf.section_data(s);
+
+        if (s.type == SHT_GNU_HASH && data.size() >= 16) {
+            const std::size_t nbuckets = word(data, 0);
+            const std::size_t symoffset = word(data, 1);
+            const std::size_t bloom_size = word(data, 2);
+            const std::size_t header = 16 + bloom_size * bloom_word + nbuckets * 4;
+            if (nbuckets == 0 || bloom_size == 0 || !std::has_single_bit(bloom_size) ||
+                symoffset > nsyms || header > data.size())
+                continue;
+            gnu_hash_ = data;
+        } else if (s.type == SHT_HASH && data.size() >= 8) {
+            const std::size_t nbucket = word(data, 0);
+            const std::size_t nchain = word(data, 1);
+            if (nbucket == 0 || nchain > nsyms || (2 + nbucket + nchain) * 4 > data.size())
+                continue;
+            sysv_hash_ = data;
+        } else if (s.type == SHT_GNU_VERSYM && data.size() >= nsyms * 2) {
+            versym_ = data;
+        }
+    }
+}
+
+void ElfSymbolTable::build_name_index() {
+    // Globals win over locals of the same name; within a binding the
+    // lowest index wins, which matches how a linker would see them.
+    name_index_.reserve(size());
+    for (std::size_t pass = 0; pass < 2; ++pass) {
+        for (std::size_t i = 1; i < size(); ++i) {
+            if (!is_defined(i) || names_[i].empty())
+                continue;
+            if ((binding(i) == STB_LOCAL) != (pass == 1))
+                continue;
+            name_index_.try_emplace(names_[i], static_cast<std::uint32_t>(i));
+        }
+    }
+}
+
+void ElfSymbolTable::build_address_index() {
+    addr_index_.clear();
+    for (std::size_t i = 1; i < size(); ++i) {
+        if (!is_defined(i) || shndx_[i] == SHN_ABS || shndx_[i] == SHN_COMMON)
+            continue;
+        if (!is_address_symbol(type(i)))
+            continue;
+        addr_index_.push_back(static_cast<std::uint32_t>(i));
+    }
+
+    // Equal values: larger symbols first, so the backward walk in
+    // find_address() meets the smallest (most specific) candidate first.
+    std::ranges::sort(addr_index_, [&](std::uint32_t a, std::uint32_t b) {
+        if (values_[a] != values_[b])
+            return values_[a] < values_[b];
+        if (sizes_[a] != sizes_[b])
+            return sizes_[a] > sizes_[b];
+        return a < b;
+    });
+
+    addr_values_.resize(addr_index_.size());
+    for (std::size_t i = 0; i < addr_index_.size(); ++i)
+        addr_values_[i] = values_[addr_index_[i]];
+}
+
+std::uint32_t ElfSymbolTable::word(std::span<const std::uint8_t> table, std::size_t index) const {
+    std::uint32_t v = 0;
+    std::memcpy(&v, table.data() + index * 4, sizeof(v));
+    return swap_ ? std::byteswap(v) : v;
+}
+
+std::optional<std::size_t> ElfSymbolTable::find(std::string_view name) const {
+    if (has_gnu_hash())
+        return find_gnu(name);
+    if (has_sysv_hash())
+        return find_sysv(name);
+    if (auto it = name_index_.find(name); it != name_index_.end())
+        return it->second;
+    return std::nullopt;
+}
+
+std::optional<std::size_t> ElfSymbolTable::find_gnu(std::string_view name) const {
+    const std::size_t nbuckets = word(gnu_hash_, 0);
+    const std::size_t symoffset = word(gnu_hash_, 1);
+    const std::size_t bloom_size = word(gnu_hash_, 2);
+    const std::uint32_t shift = word(gnu_hash_, 3);
+    const std::uint32_t h = gnu_hash(name);
+
+    // Bloom filter: two bits per symbol in one word; a clear bit proves
+    // the name is absent without touching buckets or strings.
+    const std::size_t bloom_off = 16;
+    const std::size_t bits = is_64_ ? 64 : 32;
+    const std::size_t slot = (h / bits) & (bloom_size - 1);
+    std::uint64_t bloom = 0;
+    if (is_64_) {
+        std::memcpy(&bloom, gnu_hash_.data() + bloom_off + slot * 8, 8);
+        if (swap_)
+            bloom = std::byteswap(bloom);
+    } else {
+        bloom = word(gnu_hash_, 4 + slot);
+    }
+    const std::uint64_t mask = (std::uint64_t{1} << (h % bits)) | (std::uint64_t{1} << ((h >> (shift % 32)) % bits));
+    if ((bloom & mask) != mask)
+        return std::nullopt;
+
+    const std::size_t bucket_word = (bloom_off + bloom_size * (bits / 8)) / 4;
+    const std::size_t chain_word = bucket_word + nbuckets;
+    const std::size_t chain_words = gnu_hash_.size() / 4 - chain_word;
+
+    std::size_t sym = word(gnu_hash_, bucket_word + h % nbuckets);
+    if (sym < symoffset)
+        return std::nullopt;
+    // Versions of one name share a chain; keep walking past hidden ones
+    std::optional<std::size_t> hidden;
+    for (; sym < size() && sym - symoffset < chain_words; ++sym) {
+        const std::uint32_t h2 = word(gnu_hash_, chain_word + (sym - symoffset));
+        if ((h | 1) == (h2 | 1) && names_[sym] == name) {
+            if (!is_hidden_version(sym))
+                return sym;
+            if (!hidden)
+                hidden = sym;
+        }
+        if (h2 & 1)
+            break;
+    }
+    return hidden;
+}
+
+std::optional<std::size_t> ElfSymbolTable::find_sysv(std::string_view name) const {
+    const std::size_t nbucket = word(sysv_hash_, 0);
+    const std::size_t nchain = word(sysv_hash_, 1);
+    const std::uint32_t h = sysv_hash(name);
+
+    // nchain bounds the walk so a cyclic chain cannot loop forever
+    std::size_t sym = word(sysv_hash_, 2 + h % nbucket);
+    std::optional<std::size_t> hidden;
+    for (std::size_t steps = 0; sym != STN_UNDEF && sym < nchain && steps < nchain; ++steps) {
+        if (is_defined(sym) && names_[sym] == name) {
+            if (!is_hidden_version(sym))
+                return sym;
+            if (!hidden)
+                hidden = sym;
+        }
+        sym = word(sysv_hash_, 2 + nbucket + sym);
+    }
+    return hidden;
+}
+
+bool ElfSymbolTable::is_hidden_version(std::size_t i) const {
+    if (versym_.empty())
+        return false;
+    std::uint16_t v = 0;
+    std::memcpy(&v, versym_.data() + i * 2, sizeof(v));
+    if (swap_)
+        v = std::byteswap(v);
+    return (v & VERSYM_HIDDEN) != 0;
+}
+
+std::optional<ElfSymbolHit> ElfSymbolTable::find_address(std::uint64_t addr) const {
+    auto it = std::upper_bound(addr_values_.begin(), addr_values_.end(), addr);
+    if (it == addr_values_.begin())
+        return std::nullopt;
+
+    // Walk back over the symbols sharing the closest value, smallest first;
+    // a sized symbol containing addr beats a size-less label.
+    const std::uint64_t base = *(it - 1);
+    std::optional<ElfSymbolHit> hit;
+    for (auto pos = it; pos != addr_values_.begin() && *(pos - 1) == base; --pos) {
+        const std::size_t sym = addr_index_[static_cast<std::size_t>(pos - 1 - addr_values_.begin())];
+        const std::uint64_t off = addr - base;
+        if (off < sizes_[sym])
+            return ElfSymbolHit{sym, off};
+        if (sizes_[sym] == 0 && !hit)
+            hit = ElfSymbolHit{sym, off};
+    }
+    return hit;
+}
+
+std::expected<ElfSymbolTable, Error> read_symtab(const ElfView& elf) {
+    return read_first_of_type(elf, SHT_SYMTAB);
+}
+
+std::expected<ElfSymbolTable, Error> read_dynsym(const ElfView& elf) {
+    return read_first_of_type(elf, SHT_DYNSYM);
+}
+
+} // namespace peelf
@@ -0,0 +1,586 @@
+#include "elf/elf_unwind.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "peelf/byte_reader.hpp"
+
+namespace peelf {
+
+namespace {
+
+// .eh_frame bytes and the address they are loaded at (pcrel base)
+struct FrameData {
+    std::span<const std::uint8_t> bytes;
+    std::uint64_t address = 0;
+    bool big_endian = false;
+    std::uint8_t address_size = 8;
+};
+
+// Reads a DW_EH_PE_* encoded pointer. field_base is the address of
+// r.data()[0], used for pcrel and aligned; data_base is the datarel base.
+// DW_EH_PE_indirect is not followed: the result is then the address of
+// the pointer. textrel / funcrel have no meaning in a linked file and fail.
+std::uint64_t read_encoded(ByteReader& r, std::uint8_t encoding, std::uint64_t field_base,
+                           std::uint64_t data_base, std::uint8_t address_size) {
+    if (encoding == DW_EH_PE_omit)
+        return 0;
+
+    std::uint64_t field = field_base + r.pos();
+    if ((encoding & 0x70) == DW_EH_PE_aligned) {
+        const std::uint64_t aligned = (field + address_size - 1) & ~std::uint64_t{address_size - 1u};
+        r.skip(static_cast<std::size_t>(aligned - field));
+        field = aligned;
+        encoding = DW_EH_PE_absptr;
+    }
+
+    std::uint64_t v = 0;
+    switch (encoding & 0x0F) {
+        case DW_EH_PE_absptr:  v = r.unsigned_of(address_size); break;
+        case DW_EH_PE_uleb128: v = r.uleb128(); break;
+        case DW_EH_PE_udata2:  v = r.u16(); break;
+        case DW_EH_PE_udata4:  v = r.u32(); break;
+        case DW_EH_PE_udata8:  v = r.u64(); break;
+        case DW_EH_PE_sleb128: v = static_cast<std::uint64_t>(r.sleb128()); break;
+        case DW_EH_PE_sdata2:  v = static_cast<std::uint64_t>(static_cast<std::int64_t>(static_cast<std::int16_t>(r.u16()))); break;
+        case DW_EH_PE_sdata4:  v = static_cast<std::uint64_t>(static_cast<std::int64_t>(static_cast<std::int32_t>(r.u32()))); break;
+        case DW_EH_PE_sdata8:  v = r.u64(); break;
+        default:               r.fail(); return 0;
+    }
+
+    switch (encoding & 0x70) {
+        case DW_EH_PE_absptr:  break;
+        case DW_EH_PE_pcrel:   v += field; break;
+        case DW_EH_PE_datarel: v += data_base; break;
+        default:               r.fail(); return 0;
+    }
+    if (address_size == 4)
+        v &= 0xFFFFFFFFu;
+    return v;
+}
+
+// Size of one value in a fixed-width encoding; 0 for LEB128 and unknowns
+std::size_t encoded_size(std::uint8_t encoding, std::uint8_t address_size) {
+    switch (encoding & 0x0F) {
+        case DW_EH_PE_absptr: return address_size;
+        case DW_EH_PE_udata2:
+        case DW_EH_PE_sdata2: return 2;
+        case DW_EH_PE_udata4:
+        case DW_EH_PE_sdata4: return 4;
+        case DW_EH_PE_udata8:
+        case DW_EH_PE_sdata8: return 8;
+        default:              return 0;
+    }
+}
+
+// Length / id prologue shared by CIEs and FDEs
+struct RecordHeader {
+    std::uint64_t body = 0;             // first byte after the id field
+    std::uint64_t end = 0;              // one past the record
+    std::uint64_t id_pos = 0;
+    std::uint64_t id = 0;
+    bool terminator = false;
+};
+
+std::expected<RecordHeader, Error> read_header(const FrameData& fd, std::uint64_t offset) {
+    ByteReader r(fd.bytes, fd.big_endian, static_cast<std::size_t>(offset));
+    RecordHeader h;
+    std::uint64_t length = r.u32();
+    std::size_t offset_size = 4;
+    if (length == 0xFFFFFFFFu) {
+        length = r.u64();
+        offset_size = 8;
+    }
+    if (!r.ok())
+        return std::unexpected(Error{"Frame record truncated"});
+    if (length == 0) {
+        h.terminator = true;
+        h.end = r.pos();
+        return h;
+    }
+    if (length > r.remaining())
+        return std::unexpected(Error{"Frame record runs past .eh_frame"});
+    h.end = r.pos() + length;
+    h.id_pos = r.pos();
+    h.id = r.unsigned_of(offset_size);
+    h.body = r.pos();
+    if (!r.ok() || h.body > h.end)
+        return std::unexpected(Error{"Frame record truncated"});
+    return h;
+}
+
+std::expected<ElfCie, Error> parse_cie(const FrameData& fd, std::uint64_t offset) {
+    auto h = read_header(fd, offset);
+    if (!h)
+        return std::unexpected(h.error());
+    if (h->terminator || h->id != 0)
+        return std::unexpected(Error{"Not a CIE"});
+
+    ByteReader r(fd.bytes.first(static_cast<std::size_t>(h->end)), fd.big_endian, static_cast<std::size_t>(h->body));
+    ElfCie cie;
+    cie.offset = offset;
+    cie.version = r.u8();
+    if (cie.version != 1 && cie.version != 3)
+        return std::unexpected(Error{"Unsupported CIE version " + std::to_string(cie.version)});
+    cie.augmentation = r.cstring();
+    if (cie.augmentation.starts_with("eh"))
+        r.skip(fd.address_size);        // pre-"z" GCC: address of the exception table
+    cie.code_alignment = r.uleb128();
+    cie.data_alignment = r.sleb128();
+    cie.return_register = cie.version == 1 ? r.u8() : r.uleb128();
+
+    if (cie.augmentation.starts_with('z')) {
+        const std::uint64_t aug_length = r.uleb128();
+        if (aug_length > r.remaining())
+            return std::unexpected(Error{"CIE augmentation data truncated"});
+        const std::size_t aug_end = r.pos() + static_cast<std::size_t>(aug_length);
+        for (char c : cie.augmentation.substr(1)) {
+            switch (c) {
+                case 'L': cie.lsda_encoding = r.u8(); continue;
+                case 'R': cie.fde_encoding = r.u8(); continue;
+                case 'S': cie.signal_frame = true; continue;
+                case 'B':                       // AArch64 B-key pointer authentication
+                case 'G':                       // AArch64 MTE tagged frame
+                    continue;
+                case 'P':
+                    cie.personality_encoding = r.u8();
+                    cie.personality = read_encoded(r, cie.personality_encoding, fd.address, 0, fd.address_size);
+                    continue;
+                default:
+                    break;
+            }
+            break;                          // unknown letter: the length lets us skip the rest
+        }
+        r.seek(aug_end);
+    } else if (!cie.augmentation.empty() && cie.augmentation != "eh") {
+        return std::unexpected(Error{"Unsupported CIE augmentation \"" + std::string(cie.augmentation) + "\""});
+    }
+    if (!r.ok())
+        return std::unexpected(Error{"CIE truncated"});
+    cie.instructions = fd.bytes.subspan(r.pos(), static_cast<std::size_t>(h->end) - r.pos());
+    return cie;
+}
+
+// Parses the FDE at offset. cie may be passed in when the caller already
+// holds the one the FDE points at; otherwise it is parsed here.
+std::expected<ElfFde, Error> parse_fde(const FrameData& fd, std::uint64_t offset, const ElfCie* cie = nullptr) {
+    auto h = read_header(fd, offset);
+    if (!h)
+        return std::unexpected(h.error());
+    if (h->terminator || h->id == 0)
+        return std::unexpected(Error{"Not an FDE"});
+    if (h->id > h->id_pos)
+        return std::unexpected(Error{"FDE points before .eh_frame"});
+
+    ElfFde fde;
+    fde.offset = offset;
+    fde.cie_offset = h->id_pos - h->id;
+
+    std::expected<ElfCie, Error> parsed;
+    if (!cie || cie->offset != fde.cie_offset) {
+        parsed = parse_cie(fd, fde.cie_offset);
+        if (!parsed)
+            return std::unexpected(parsed.error());
+        cie = &*parsed;
+    }
+
+    ByteReader r(fd.bytes.first(static_cast<std::size_t>(h->end)), fd.big_endian, static_cast<std::size_t>(h->body));
+    fde.begin = read_encoded(r, cie->fde_encoding, fd.address, 0, fd.address_size);
+    const std::uint64_t range = read_encoded(r, cie->fde_encoding & 0x0F, fd.address, 0, fd.address_size);
+    fde.end = fde.begin + range;
+    if (fd.address_size == 4)
+        fde.end &= 0xFFFFFFFFu;
+
+    if (cie->augmentation.starts_with('z')) {
+        const std::uint64_t aug_length = r.uleb128();
+        if (aug_length > r.remaining())
+            return std::unexpected(Error{"FDE augmentation data truncated"});
+        const std::size_t aug_end = r.pos() + static_cast<std::size_t>(aug_length);
+        if (cie->lsda_encoding != DW_EH_PE_omit) {
+            // An all-zero LSDA field means "none" whatever the encoding
+            ByteReader probe = r;
+            const std::uint64_t raw = read_encoded(probe, cie->lsda_encoding & 0x0F, 0, 0, fd.address_size);
+            const std::uint64_t lsda = read_encoded(r, cie->lsda_encoding, fd.address, 0, fd.address_size);
+            if (raw != 0)
+                fde.lsda = lsda;
+        }
+        r.seek(aug_end);
+    }
+    if (!r.ok())
+        return std::unexpected(Error{"FDE truncated"});
+    fde.instructions = fd.bytes.subspan(r.pos(), static_cast<std::size_t>(h->end) - r.pos());
+    return fde;
+}
+
+// Calls f(fde) for every FDE in file order, parsing each CIE once
+template<typename F>
+std::expected<void, Error> walk_fdes(const FrameData& fd, std::size_t max_entries, F&& f) {
+    std::unordered_map<std::uint64_t, ElfCie> cies;
+    std::uint64_t offset = 0;
+    std::size_t budget = max_entries;
+    while (offset < fd.bytes.size()) {
+        if (budget-- == 0)
+            return std::unexpected(Error{".eh_frame exceeds entry budget"});
+        auto h = read_header(fd, offset);
+        if (!h)
+            return std::unexpected(h.error());
+        if (h->terminator)
+            break;
+        if (h->id != 0) {
+            if (h->id > h->id_pos)
+                return std::unexpected(Error{"FDE points before .eh_frame"});
+            const std::uint64_t cie_offset = h->id_pos - h->id;
+            auto it = cies.find(cie_offset);
+            if (it == cies.end()) {
+                auto cie = parse_cie(fd, cie_offset);
+                if (!cie)
+                    return std::unexpected(cie.error());
+                it = cies.emplace(cie_offset, *cie).first;
+            }
+            auto fde = parse_fde(fd, offset, &it->second);
+            if (!fde)
+                return std::unexpected(fde.error());
+            f(*fde);
+        }
+        offset = h->end;
+    }
+    return {};
+}
+
+// Runs the CIE's initial instructions, then the FDE's, calling
+// emit(instruction) for each; emit returns false to stop early.
+template<typename F>
+std::expected<void, Error> decode_instructions(const FrameData& fd, const ElfCie& cie, const ElfFde& fde, F&& emit) {
+    std::uint64_t loc = fde.begin;
+    const auto caf = static_cast<std::int64_t>(cie.code_alignment);
+    const std::int64_t daf = cie.data_alignment;
+
+    for (const auto stream : {cie.instructions, fde.instructions}) {
+        const std::uint64_t base = fd.address + static_cast<std::uint64_t>(stream.data() - fd.bytes.data());
+        ByteReader r(stream, fd.big_endian);
+        while (!r.at_end()) {
+            const std::uint8_t op = r.u8();
+            ElfCfaInstruction in;
+            in.opcode = (op & 0xC0) ? static_cast<std::uint8_t>(op & 0xC0) : op;
+            const auto advance = [&](std::uint64_t delta) {
+                loc += delta * static_cast<std::uint64_t>(caf);
+            };
+            switch (in.opcode) {
+                case DW_CFA_advance_loc:     advance(op & 0x3Fu); break;
+                case DW_CFA_offset:          in.reg = op & 0x3Fu;
+                                             in.offset = static_cast<std::int64_t>(r.uleb128()) * daf; break;
+                case DW_CFA_restore:         in.reg = op & 0x3Fu; break;
+                case DW_CFA_nop:
+                case DW_CFA_remember_state:
+                case DW_CFA_restore_state:
+                case DW_CFA_GNU_window_save: break;
+                case DW_CFA_set_loc:         loc = read_encoded(r, cie.fde_encoding, base, 0, fd.address_size); break;
+                case DW_CFA_advance_loc1:    advance(r.u8()); break;
+                case DW_CFA_advance_loc2:    advance(r.u16()); break;
+                case DW_CFA_advance_loc4:    advance(r.u32()); break;
+                case DW_CFA_offset_extended:
+                case DW_CFA_val_offset:      in.reg = r.uleb128();
+                                             in.offset = static_cast<std::int64_t>(r.uleb128()) * daf; break;
+                case DW_CFA_offset_extended_sf:
+                case DW_CFA_val_offset_sf:
+                case DW_CFA_def_cfa_sf:      in.reg = r.uleb128(); in.offset = r.sleb128() * daf; break;
+                case DW_CFA_restore_extended:
+                case DW_CFA_undefined:
+                case DW_CFA_same_value:
+                case DW_CFA_def_cfa_register: in.reg = r.uleb128(); break;
+                case DW_CFA_register:        in.reg = r.uleb128(); in.reg2 = r.uleb128(); break;
+                case DW_CFA_def_cfa:         in.reg = r.uleb128(); in.offset = static_cast<std::int64_t>(r.uleb128()); break;
+                case DW_CFA_def_cfa_offset:  in.offset = static_cast<std::int64_t>(r.uleb128()); break;
+                case DW_CFA_def_cfa_offset_sf: in.offset = r.sleb128() * daf; break;
+                case DW_CFA_def_cfa_expression: in.expression = r.bytes(static_cast<std::size_t>(r.uleb128())); break;
+                case DW_CFA_expression:
+                case DW_CFA_val_expression:  in.reg = r.uleb128();
+                                             in.expression = r.bytes(static_cast<std::size_t>(r.uleb128())); break;
+                case DW_CFA_GNU_args_size:   in.offset = static_cast<std::int64_t>(r.uleb128()); break;
+                case DW_CFA_GNU_negative_offset_extended:
+                                             in.reg = r.uleb128();
+                                             in.offset = -static_cast<std::int64_t>(r.uleb128()) * daf; break;
+                default:
+                    return std::unexpected(Error{"Unknown call frame instruction " + std::to_string(op)});
+            }
+            if (!r.ok())
+                return std::unexpected(Error{"Call frame instructions truncated"});
+            if (fd.address_size == 4)
+                loc &= 0xFFFFFFFFu;
+            in.location = loc;
+            if (!emit(in))
+                return {};
+        }
+    }
+    return {};
+}
+
+} // namespace
+
+std::string_view cfa_opcode_name(std::uint8_t opcode) {
+    switch ((opcode & 0xC0) ? opcode & 0xC0 : opcode) {
+        case DW_CFA_advance_loc:        return "DW_CFA_advance_loc";
+        case DW_CFA_offset:             return "DW_CFA_offset";
+        case DW_CFA_restore:            return "DW_CFA_restore";
+        case DW_CFA_nop:                return "DW_CFA_nop";
+        case DW_CFA_set_loc:            return "DW_CFA_set_loc";
+        case DW_CFA_advance_loc1:       return "DW_CFA_advance_loc1";
+        case DW_CFA_advance_loc2:       return "DW_CFA_advance_loc2";
+        case DW_CFA_advance_loc4:       return "DW_CFA_advance_loc4";
+        case DW_CFA_offset_extended:    return "DW_CFA_offset_extended";
+        case DW_CFA_restore_extended:   return "DW_CFA_restore_extended";
+        case DW_CFA_undefined:          return "DW_CFA_undefined";
+        case DW_CFA_same_value:         return "DW_CFA_same_value";
+        case DW_CFA_register:           return "DW_CFA_register";
+        case DW_CFA_remember_state:     return "DW_CFA_remember_state";
+        case DW_CFA_restore_state:      return "DW_CFA_restore_state";
+        case DW_CFA_def_cfa:            return "DW_CFA_def_cfa";
+        case DW_CFA_def_cfa_register:   return "DW_CFA_def_cfa_register";
+        case DW_CFA_def_cfa_offset:     return "DW_CFA_def_cfa_offset";
+        case DW_CFA_def_cfa_expression: return "DW_CFA_def_cfa_expression";
+        case DW_CFA_expression:         return "DW_CFA_expression";
+        case DW_CFA_offset_extended_sf: return "DW_CFA_offset_extended_sf";
+        case DW_CFA_def_cfa_sf:         return "DW_CFA_def_cfa_sf";
+        case DW_CFA_def_cfa_offset_sf:  return "DW_CFA_def_cfa_offset_sf";
+        case DW_CFA_val_offset:         return "DW_CFA_val_offset";
+        case DW_CFA_val_offset_sf:      return "DW_CFA_val_offset_sf";
+        case DW_CFA_val_expression:     return "DW_CFA_val_expression";
+        case DW_CFA_GNU_window_save:    return "DW_CFA_GNU_window_save";
+        case DW_CFA_GNU_args_size:      return "DW_CFA_GNU_args_size";
+        case DW_CFA_GNU_negative_offset_extended: return "DW_CFA_GNU_negative_offset_extended";
+        default:                        return "DW_CFA_unknown";
+    }
+}
+
+std::expected<ElfUnwindTable, Error> ElfUnwindTable::load(const ElfView& elf) {
+    ElfUnwindTable out;
+    out.big_endian_ = elf.is_big_endian();
+    out.address_size_ = elf.is_64() ? 8 : 4;
+    out.max_entries_ = elf.limits().max_table_entries;
+
+    // The header is found through PT_GNU_EH_FRAME, so it survives
+    // stripped section headers
+    std::span<const std::uint8_t> hdr;
+    for (std::size_t i = 0; i < elf.segment_count(); ++i) {
+        const auto p = elf.segment(i);
+        if (p.type == PT_GNU_EH_FRAME) {
+            hdr = elf.segment_data(i);
+            out.hdr_addr_ = p.vaddr;
+            break;
+        }
+    }
+    if (hdr.empty()) {
+        if (auto index = elf.find_section(".eh_frame_hdr")) {
+            hdr = elf.section_data(*index);
+            out.hdr_addr_ = elf.section(*index).addr;
+        }
+    }
+
+    std::optional<std::uint64_t> eh_frame_ptr;
+    std::uint64_t fde_count = 0;
+    if (hdr.size() >= 4 && hdr[0] == 1) {
+        ByteReader r(hdr, out.big_endian_, 4);
+        const std::uint8_t ptr_enc = hdr[1];
+        const std::uint8_t count_enc = hdr[2];
+        const std::uint8_t table_enc = hdr[3];
+        if (ptr_enc != DW_EH_PE_omit)
+            eh_frame_ptr = read_encoded(r, ptr_enc, out.hdr_addr_, out.hdr_addr_, out.address_size_);
+        if (count_enc != DW_EH_PE_omit)
+            fde_count = read_encoded(r, count_enc, out.hdr_addr_, out.hdr_addr_, out.address_size_);
+
+        // Binary search needs fixed-size entries with a usable base
+        const std::size_t half = encoded_size(table_enc, out.address_size_);
+        const std::uint8_t application = table_enc & 0x70;
+        if (r.ok() && eh_frame_ptr && half != 0 && count_enc != DW_EH_PE_omit
+            && (application == DW_EH_PE_absptr || application == DW_EH_PE_datarel)
+            && fde_count <= r.remaining() / (2 * half)) {
+            out.table_ = hdr.subspan(r.pos(), static_cast<std::size_t>(fde_count) * 2 * half);
+            out.table_count_ = static_cast<std::size_t>(fde_count);
+            out.table_entry_size_ = 2 * half;
+            out.table_encoding_ = table_enc;
+        }
+    }
+
+    if (auto index = elf.find_section(".eh_frame")) {
+        const auto s = elf.section(*index);
+        out.eh_frame_ = elf.section_data(s);
+        out.eh_frame_addr_ = s.addr;
+    } else if (eh_frame_ptr) {
+        // No section headers: .eh_frame runs to the end of its PT_LOAD at
+        // most; the zero terminator ends the walk before that
+        for (std::size_t i = 0; i < elf.segment_count(); ++i) {
+            const auto p = elf.segment(i);
+            if (p.type != PT_LOAD || *eh_frame_ptr < p.vaddr || *eh_frame_ptr - p.vaddr >= p.filesz)
+                continue;
+            const std::uint64_t delta = *eh_frame_ptr - p.vaddr;
+            out.eh_frame_ = elf.file_span(p.offset + delta, p.filesz - delta);
+            out.eh_frame_addr_ = *eh_frame_ptr;
+            break;
+        }
+    }
+
+    if (out.eh_frame_.empty()) {
+        out.table_count_ = 0;
+        return out;
+    }
+    if (!out.has_search_table()) {
+        if (auto ok = out.build_index(); !ok)
+            return std::unexpected(ok.error());
+    }
+    return out;
+}
+
+std::expected<void, Error> ElfUnwindTable::build_index() {
+    const FrameData fd{eh_frame_, eh_frame_addr_, big_endian_, address_size_};
+    auto ok = walk_fdes(fd, max_entries_, [&](const ElfFde& fde) {
+        index_.push_back(IndexEntry{fde.begin, fde.offset});
+    });
+    if (!ok)
+        return std::unexpected(ok.error());
+    std::stable_sort(index_.begin(), index_.end(),
+                     [](const IndexEntry& a, const IndexEntry& b) { return a.begin < b.begin; });
+    return {};
+}
+
+std::optional<std::uint64_t> ElfUnwindTable::table_offset_for(std::uint64_t address) const {
+    const std::size_t half = table_entry_size_ / 2;
+    const auto field = [&](std::size_t i, std::size_t which) {
+        ByteReader r(table_.subspan(i * table_entry_size_ + which * half, half), big_endian_);
+        return read_encoded(r, table_encoding_, 0, hdr_addr_, address_size_);
+    };
+
+    // Last entry whose initial location is <= address
+    std::size_t lo = 0;
+    std::size_t hi = table_count_;
+    while (lo < hi) {
+        const std::size_t mid = lo + (hi - lo) / 2;
+        if (field(mid, 0) <= address)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo == 0)
+        return std::nullopt;
+    const std::uint64_t fde_addr = field(lo - 1, 1);
+    if (fde_addr < eh_frame_addr_ || fde_addr - eh_frame_addr_ >= eh_frame_.size())
+        return std::nullopt;
+    return fde_addr - eh_frame_addr_;
+}
+
+std::optional<ElfFde> ElfUnwindTable::fde_for_address(std::uint64_t address) const {
+    std::optional<std::uint64_t> offset;
+    if (has_search_table()) {
+        offset = table_offset_for(address);
+    } else {
+        auto it = std::upper_bound(index_.begin(), index_.end(), address,
+                                   [](std::uint64_t a, const IndexEntry& e) { return a < e.begin; });
+        if (it != index_.begin())
+            offset = std::prev(it)->offset;
+    }
+    if (!offset)
+        return std::nullopt;
+    auto f = fde(*offset);
+    if (!f || !f->contains(address))
+        return std::nullopt;
+    return *f;
+}
+
+std::expected<ElfCie, Error> ElfUnwindTable::cie(std::uint64_t offset) const {
+    return parse_cie(FrameData{eh_frame_, eh_frame_addr_, big_endian_, address_size_}, offset);
+}
+
+std::expected<ElfFde, Error> ElfUnwindTable::fde(std::uint64_t offset) const {
+    return parse_fde(FrameData{eh_frame_, eh_frame_addr_, big_endian_, address_size_}, offset);
+}
+
+std::expected<std::vector<ElfFde>, Error> ElfUnwindTable::fdes() const {
+    std::vector<ElfFde> out;
+    out.reserve(fde_count());
+    auto ok = walk_fdes(FrameData{eh_frame_, eh_frame_addr_, big_endian_, address_size_}, max_entries_,
+                        [&](const ElfFde& fde) { out.push_back(fde); });
+    if (!ok)
+        return std::unexpected(ok.error());
+    return out;
+}
+
+std::expected<std::vector<ElfFunctionRange>, Error> ElfUnwindTable::function_ranges() const {
+    std::vector<ElfFunctionRange> out;
+    out.reserve(fde_count());
+    auto ok = walk_fdes(FrameData{eh_frame_, eh_frame_addr_, big_endian_, address_size_}, max_entries_,
+                        [&](const ElfFde& fde) {
+        if (fde.end > fde.begin)
+            out.push_back(ElfFunctionRange{fde.begin, fde.end});
+    });
+    if (!ok)
+        return std::unexpected(ok.error());
+    std::sort(out.begin(), out.end(),
+              [](const ElfFunctionRange& a, const ElfFunctionRange& b) { return a.begin < b.begin; });
+    return out;
+}
+
+std::expected<std::vector<ElfCfaInstruction>, Error> ElfUnwindTable::instructions(const ElfFde& fde) const {
+    const FrameData fd{eh_frame_, eh_frame_addr_, big_endian_, address_size_};
+    auto c = parse_cie(fd, fde.cie_offset);
+    if (!c)
+        return std::unexpected(c.error());
+    std::vector<ElfCfaInstruction> out;
+    auto ok = decode_instructions(fd, *c, fde, [&](const ElfCfaInstruction& in) {
+        out.push_back(in);
+        return true;
+    });
+    if (!ok)
+        return std::unexpected(ok.error());
+    return out;
+}
+
+std::expected<ElfCfaRule, Error> ElfUnwindTable::cfa_at(const ElfFde& fde, std::uint64_t address) const {
+    const FrameData fd{eh_frame_, eh_frame_addr_, big_endian_, address_size_};
+    auto c = parse_cie(fd, fde.cie_offset);
+    if (!c)
+        return std::unexpected(c.error());
+
+    ElfCfaRule rule;
+    std::vector<ElfCfaRule> stack;
+    auto ok = decode_instructions(fd, *c, fde, [&](const ElfCfaInstruction& in) {
+        switch (in.opcode) {
+            case DW_CFA_advance_loc:
+            case DW_CFA_advance_loc1:
+            case DW_CFA_advance_loc2:
+            case DW_CFA_advance_loc4:
+            case DW_CFA_set_loc:
+                return in.location <= address;
+            case DW_CFA_def_cfa:
+            case DW_CFA_def_cfa_sf:
+                rule = ElfCfaRule{in.reg, in.offset, {}};
+                break;
+            case DW_CFA_def_cfa_register:
+                rule.reg = in.reg;
+                rule.expression = {};
+                break;
+            case DW_CFA_def_cfa_offset:
+            case DW_CFA_def_cfa_offset_sf:
+                rule.offset = in.offset;
+                break;
+            case DW_CFA_def_cfa_expression:
+                rule.expression = in.expression;
+                break;
+            case DW_CFA_remember_state:
+                stack.push_back(rule);
+                break;
+            case DW_CFA_restore_state:
+                if (!stack.empty()) {
+                    rule = stack.back();
+                    stack.pop_back();
+                }
+                break;
+            default:
+                break;
+        }
+        return true;
+    });
+    if (!ok)
+        return std::unexpected(ok.error());
+    return rule;
+}
+
+} // namespace peelf
@@ -0,0 +1,246 @@
+#include "elf/elf_versions.hpp"
+
+#include <algorithm>
+#include <charconv>
+
+#include "elf/elf_dynamic.hpp"
+
+namespace peelf {
+
+namespace {
+
+// Where the three version sections live. Found through the section
+// headers; files stripped of those fall back to the dynamic tags, which
+// locate the definition and requirement chains but not .gnu.version
+// (its length is the dynsym count, which PT_DYNAMIC does not record).
+struct VersionTables {
+    std::span<const std::uint8_t> versym;
+    std::optional<std::size_t> verdef_offset;
+    std::size_t verdef_count = 0;
+    std::optional<std::size_t> verneed_offset;
+    std::size_t verneed_count = 0;
+    std::span<const std::uint8_t> strtab;
+};
+
+VersionTables locate_tables(const ElfView& elf) {
+    VersionTables t;
+    std::uint32_t strtab_link = 0;
+    for (std::size_t i = 1; i < elf.section_count(); ++i) {
+        const auto s = elf.section(i);
+        switch (s.type) {
+            case SHT_GNU_VERSYM:
+                t.versym = elf.section_data(s);
+                break;
+            case SHT_GNU_VERDEF:
+                t.verdef_offset = static_cast<std::size_t>(s.offset);
+                t.verdef_count = s.info;
+                strtab_link = s.link;
+                break;
+            case SHT_GNU_VERNEED:
+                t.verneed_offset = static_cast<std::size_t>(s.offset);
+                t.verneed_count = s.info;
+                strtab_link = s.link;
+                break;
+            default:
+                break;
+        }
+    }
+    if (strtab_link != 0) {
+        t.strtab = elf.section_data(strtab_link);
+        return t;
+    }
+    if (elf.section_count() != 0)
+        return t;
+
+    auto dyn = read_dynamic(elf);
+    if (!dyn)
+        return t;
+    const auto at = [&](std::int64_t tag) -> std::optional<std::size_t> {
+        const auto addr = dyn->value(tag);
+        return addr ? elf.vaddr_to_offset(*addr) : std::nullopt;
+    };
+    t.verdef_offset = at(DT_VERDEF);
+    t.verdef_count = static_cast<std::size_t>(dyn->value(DT_VERDEFNUM).value_or(0));
+    t.verneed_offset = at(DT_VERNEED);
+    t.verneed_count = static_cast<std::size_t>(dyn->value(DT_VERNEEDNUM).value_or(0));
+    if (auto off = at(DT_STRTAB))
+        t.strtab = elf.file_span(*off, dyn->value(DT_STRSZ).value_or(0));
+    return t;
+}
+
+// Calls f(file, vernaux) for every required version. Entries are linked
+// by forward offsets, so the walk cannot cycle; the entry budget bounds
+// its length.
+template<typename F>
+std::expected<void, Error> walk_verneed(const ElfView& elf, const VersionTables& t, F&& f) {
+    if (!t.verneed_offset)
+        return {};
+    std::size_t budget = elf.limits().max_table_entries;
+    std::size_t off = *t.verneed_offset;
+    for (std::size_t i = 0; i < t.verneed_count; ++i) {
+        Elf_Verneed_ vn{};
+        if (!elf.read_record(off, vn))
+            return std::unexpected(Error{"Version requirement out of range"});
+        const auto file = ElfView::cstring_at(t.strtab, vn.vn_file);
+
+        std::size_t aux = off + vn.vn_aux;
+        for (std::size_t j = 0; j < vn.vn_cnt; ++j) {
+            if (budget-- == 0)
+                return std::unexpected(Error{"Version requirements exceed entry budget"});
+            Elf_Vernaux_ va{};
+            if (!elf.read_record(aux, va))
+                return std::unexpected(Error{"Version requirement out of range"});
+            f(file, va);
+            if (va.vna_next == 0)
+                break;
+            aux += va.vna_next;
+        }
+        if (vn.vn_next == 0)
+            break;
+        off += vn.vn_next;
+    }
+    return {};
+}
+
+template<typename F>
+std::expected<void, Error> walk_verdef(const ElfView& elf, const VersionTables& t, F&& f) {
+    if (!t.verdef_offset)
+        return {};
+    std::size_t budget = elf.limits().max_table_entries;
+    std::size_t off = *t.verdef_offset;
+    for (std::size_t i = 0; i < t.verdef_count; ++i) {
+        if (budget-- == 0)
+            return std::unexpected(Error{"Version definitions exceed entry budget"});
+        Elf_Verdef_ vd{};
+        Elf_Verdaux_ vda{};
+        if (!elf.read_record(off, vd) || !elf.read_record(off + vd.vd_aux, vda))
+            return std::unexpected(Error{"Version definition out of range"});
+        f(vd, ElfView::cstring_at(t.strtab, vda.vda_name));
+        if (vd.vd_next == 0)
+            break;
+        off += vd.vd_next;
+    }
+    return {};
+}
+
+void keep_max(std::optional<ElfVersionNumber>& slot, const ElfVersionNumber& v) {
+    if (!slot || *slot < v)
+        slot = v;
+}
+
+} // namespace
+
+std::optional<ElfVersionNumber> ElfVersionNumber::parse(std::string_view name, std::string_view* prefix) {
+    const auto sep = name.rfind('_');
+    if (sep == std::string_view::npos || sep + 1 >= name.size())
+        return std::nullopt;
+
+    ElfVersionNumber v;
+    const char* p = name.data() + sep + 1;
+    const char* end = name.data() + name.size();
+    while (true) {
+        if (v.count == v.parts.size())
+            return std::nullopt;
+        auto [next, ec] = std::from_chars(p, end, v.parts[v.count]);
+        if (ec != std::errc{})
+            return std::nullopt;
+        ++v.count;
+        if (next == end)
+            break;
+        if (*next != '.')
+            return std::nullopt;
+        p = next + 1;
+    }
+    if (prefix)
+        *prefix = name.substr(0, sep);
+    return v;
+}
+
+std::string ElfVersionNumber::to_string() const {
+    std::string s;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (i != 0)
+            s += '.';
+        s += std::to_string(parts[i]);
+    }
+    return s;
+}
+
+std::expected<ElfSymbolVersions, Error> ElfSymbolVersions::load(const ElfView& elf) {
+    ElfSymbolVersions out;
+    const auto t = locate_tables(elf);
+
+    out.versym_.resize(t.versym.size() / 2);
+    for (std::size_t i = 0; i < out.versym_.size(); ++i) {
+        std::uint16_t v;
+        std::memcpy(&v, t.versym.data() + 2 * i, sizeof(v));
+        out.versym_[i] = elf.to_native(v);
+    }
+
+    auto ok = walk_verdef(elf, t, [&](const Elf_Verdef_& vd, std::string_view name) {
+        out.definitions_.push_back({vd.vd_ndx, vd.vd_flags, name});
+    });
+    if (!ok)
+        return std::unexpected(ok.error());
+    ok = walk_verneed(elf, t, [&](std::string_view file, const Elf_Vernaux_& va) {
+        out.requirements_.push_back({va.vna_other, va.vna_flags, file, ElfView::cstring_at(t.strtab, va.vna_name)});
+    });
+    if (!ok)
+        return std::unexpected(ok.error());
+
+    std::size_t slots = 0;
+    for (const auto& d : out.definitions_)
+        slots = std::max<std::size_t>(slots, (d.index & VERSYM_INDEX) + 1u);
+    for (const auto& r : out.requirements_)
+        slots = std::max<std::size_t>(slots, (r.index & VERSYM_INDEX) + 1u);
+    out.by_index_.resize(slots);
+    for (const auto& d : out.definitions_) {
+        // The base definition names the object itself, not a version
+        if (!(d.flags & VER_FLG_BASE))
+            out.by_index_[d.index & VERSYM_INDEX].name = d.name;
+    }
+    for (const auto& r : out.requirements_)
+        out.by_index_[r.index & VERSYM_INDEX] = Slot{r.name, r.file};
+    return out;
+}
+
+const ElfSymbolVersions::Slot* ElfSymbolVersions::slot(std::size_t sym) const {
+    if (sym >= versym_.size())
+        return nullptr;
+    const std::size_t idx = index(sym);
+    if (idx <= VER_NDX_GLOBAL || idx >= by_index_.size())
+        return nullptr;
+    return &by_index_[idx];
+}
+
+std::string_view ElfSymbolVersions::name(std::size_t sym) const {
+    const Slot* s = slot(sym);
+    return s ? s->name : std::string_view{};
+}
+
+std::string_view ElfSymbolVersions::file(std::size_t sym) const {
+    const Slot* s = slot(sym);
+    return s ? s->file : std::string_view{};
+}
+
+std::expected<ElfRequiredVersions, Error> read_required_versions(const ElfView& elf) {
+    ElfRequiredVersions out;
+    const auto t = locate_tables(elf);
+    auto ok = walk_verneed(elf, t, [&](std::string_view, const Elf_Vernaux_& va) {
+        std::string_view prefix;
+        const auto v = ElfVersionNumber::parse(ElfView::cstring_at(t.strtab, va.vna_name), &prefix);
+        if (!v)
+            return;
+        if (prefix == "GLIBC")
+            keep_max(out.glibc, *v);
+        else if (prefix == "GLIBCXX")
+            keep_max(out.glibcxx, *v);
+        else if (prefix == "CXXABI")
+            keep_max(out.cxxabi, *v);
+    });
+    if (!ok)
+        return std::unexpected(ok.error());
+    return out;
+}
+
+} // namespace peelf
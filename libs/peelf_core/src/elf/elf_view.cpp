@@ -0,0 +1,238 @@
+#include "elf/elf_view.hpp"
+
+#include <bit>
+
+namespace peelf {
+
+namespace {
+
+template<typename Traits>
+ElfSection normalize(const typename Traits::shdr& s) {
+    return ElfSection{
+        .name = s.sh_name,
+        .type = s.sh_type,
+        .flags = s.sh_flags,
+        .addr = s.sh_addr,
+        .offset = s.sh_offset,
+        .size = s.sh_size,
+        .link = s.sh_link,
+        .info = s.sh_info,
+        .addralign = s.sh_addralign,
+        .entsize = s.sh_entsize,
+    };
+}
+
+template<typename Traits>
+ElfSegment normalize(const typename Traits::phdr& p) {
+    return ElfSegment{
+        .type = p.p_type,
+        .flags = p.p_flags,
+        .offset = p.p_offset,
+        .vaddr = p.p_vaddr,
+        .paddr = p.p_paddr,
+        .filesz = p.p_filesz,
+        .memsz = p.p_memsz,
+        .align = p.p_align,
+    };
+}
+
+} // namespace
+
+std::expected<ElfView, Error> ElfView::parse(std::span<const std::uint8_t> bytes,
+                                             const ParseLimits& limits) {
+    ElfView elf(bytes);
+    elf.limits_ = limits;
+
+    if (bytes.size() < EI_NIDENT)
+        return std::unexpected(Error{"ELF file too small"});
+    if (bytes[0] != 0x7F || bytes[1] != 'E' || bytes[2] != 'L' || bytes[3] != 'F')
+        return std::unexpected(Error{"Missing ELF magic"});
+    if (bytes[EI_DATA] != ELFDATA2LSB && bytes[EI_DATA] != ELFDATA2MSB)
+        return std::unexpected(Error{"Invalid ELF data encoding"});
+
+    const auto file_order = bytes[EI_DATA] == ELFDATA2MSB ? std::endian::big : std::endian::little;
+    elf.swap_ = file_order != std::endian::native;
+
+    std::expected<void, Error> ok;
+    switch (bytes[EI_CLASS]) {
+        case ELFCLASS32: ok = elf.parse_headers<Elf32Traits>(); break;
+        case ELFCLASS64: ok = elf.parse_headers<Elf64Traits>(); break;
+        default:
+            return std::unexpected(Error{"Invalid ELF class"});
+    }
+    if (!ok)
+        return std::unexpected(ok.error());
+    return elf;
+}
+
+template<typename T>
+std::span<const std::uint8_t> ElfView::native_span(std::span<const std::uint8_t> raw) {
+    if (!swap_)
+        return raw;
+    auto buf = std::make_shared<std::vector<std::uint8_t>>(raw.size());
+    RecordSwapper::for_type<T>().swap(raw, *buf);
+    native_.push_back(buf);
+    return *buf;
+}
+
+template<typename Traits>
+std::expected<void, Error> ElfView::parse_headers() {
+    using ehdr_t = typename Traits::ehdr;
+    using shdr_t = typename Traits::shdr;
+    using phdr_t = typename Traits::phdr;
+
+    if (bytes_.size() < sizeof(ehdr_t))
+        return std::unexpected(Error{"ELF header truncated"});
+    ehdr_ = native_span<ehdr_t>(bytes_.first(sizeof(ehdr_t)));
+
+    ehdr_t eh{};
+    std::memcpy(&eh, ehdr_.data(), sizeof(eh));
+
+    is_64_ = Traits::is_64;
+    type_ = eh.e_type;
+    machine_ = eh.e_machine;
+    version_ = eh.e_version;
+    entry_ = eh.e_entry;
+    flags_ = eh.e_flags;
+
+    std::size_t shnum = eh.e_shnum;
+    std::size_t phnum = eh.e_phnum;
+    std::size_t shstrndx = eh.e_shstrndx;
+
+    // Section 0 carries the real counts when they do not fit in the header
+    if (eh.e_shoff != 0) {
+        if (eh.e_shentsize != sizeof(shdr_t))
+            return std::unexpected(Error{"Unexpected e_shentsize"});
+        const auto raw0 = file_span(eh.e_shoff, sizeof(shdr_t));
+        if (raw0.empty())
+            return std::unexpected(Error{"Section header table out of range"});
+        shdr_t sh0{};
+        std::memcpy(&sh0, raw0.data(), sizeof(sh0));
+        if (swap_) {
+            const std::span<std::uint8_t> rec{reinterpret_cast<std::uint8_t*>(&sh0), sizeof(sh0)};
+            RecordSwapper::for_type<shdr_t>().swap(rec, rec);
+        }
+        if (shnum == 0)
+            shnum = static_cast<std::size_t>(sh0.sh_size);
+        if (shstrndx == SHN_XINDEX)
+            shstrndx = sh0.sh_link;
+        if (phnum == PN_XNUM)
+            phnum = sh0.sh_info;
+    } else {
+        shnum = 0;
+    }
+
+    if (shnum > limits_.max_table_entries || phnum > limits_.max_table_entries)
+        return std::unexpected(Error{"ELF header table exceeds entry budget"});
+
+    if (shnum != 0) {
+        const auto raw = file_span(eh.e_shoff, std::uint64_t{shnum} * sizeof(shdr_t));
+        if (raw.empty())
+            return std::unexpected(Error{"Section header table out of range"});
+        shdrs_ = native_span<shdr_t>(raw);
+    }
+    if (phnum != 0) {
+        if (eh.e_phentsize != sizeof(phdr_t))
+            return std::unexpected(Error{"Unexpected e_phentsize"});
+        const auto raw = file_span(eh.e_phoff, std::uint64_t{phnum} * sizeof(phdr_t));
+        if (raw.empty())
+            return std::unexpected(Error{"Program header table out of range"});
+        phdrs_ = native_span<phdr_t>(raw);
+    }
+
+    section_count_ = shnum;
+    segment_count_ = phnum;
+    shstrndx_ = shstrndx < shnum ? shstrndx : 0;
+    return {};
+}
+
+ElfSection ElfView::section(std::size_t index) const {
+    if (index >= section_count_)
+        return {};
+    return dispatch([&](auto traits) {
+        using T = decltype(traits);
+        return normalize<T>(section_headers<T>()[index]);
+    });
+}
+
+std::string_view ElfView::section_name(std::size_t index) const {
+    if (index >= section_count_ || shstrndx_ == SHN_UNDEF)
+        return {};
+    return cstring_at(section_data(shstrndx_), section(index).name);
+}
+
+std::optional<std::size_t> ElfView::find_section(std::string_view name) const {
+    for (std::size_t i = 1; i < section_count_; ++i) {
+        if (section_name(i) == name)
+            return i;
+    }
+    return std::nullopt;
+}
+
+std::optional<std::size_t> ElfView::find_section_by_type(std::uint32_t type) const {
+    for (std::size_t i = 1; i < section_count_; ++i) {
+        if (section(i).type == type)
+            return i;
+    }
+    return std::nullopt;
+}
+
+std::span<const std::uint8_t> ElfView::section_data(std::size_t index) const {
+    if (index >= section_count_)
+        return {};
+    return section_data(section(index));
+}
+
+std::span<const std::uint8_t> ElfView::section_data(const ElfSection& s) const {
+    if (s.type == SHT_NOBITS || s.type == SHT_NULL)
+        return {};
+    return file_span(s.offset, s.size);
+}
+
+ElfSegment ElfView::segment(std::size_t index) const {
+    if (index >= segment_count_)
+        return {};
+    return dispatch([&](auto traits) {
+        using T = decltype(traits);
+        return normalize<T>(program_headers<T>()[index]);
+    });
+}
+
+std::span<const std::uint8_t> ElfView::segment_data(std::size_t index) const {
+    if (index >= segment_count_)
+        return {};
+    const auto seg = segment(index);
+    return file_span(seg.offset, seg.filesz);
+}
+
+std::optional<std::size_t> ElfView::vaddr_to_offset(std::uint64_t vaddr) const {
+    for (std::size_t i = 0; i < segment_count_; ++i) {
+        const auto seg = segment(i);
+        if (seg.type != PT_LOAD)
+            continue;
+        if (vaddr >= seg.vaddr && vaddr - seg.vaddr < seg.filesz) {
+            const std::uint64_t off = seg.offset + (vaddr - seg.vaddr);
+            if (off < bytes_.size())
+                return static_cast<std::size_t>(off);
+        }
+    }
+    return std::nullopt;
+}
+
+std::span<const std::uint8_t> ElfView::file_span(std::uint64_t offset, std::uint64_t size) const {
+    if (offset > bytes_.size() || size > bytes_.size() - offset)
+        return {};
+    return bytes_.subspan(static_cast<std::size_t>(offset), static_cast<std::size_t>(size));
+}
+
+std::string_view ElfView::cstring_at(std::span<const std::uint8_t> table, std::size_t offset) {
+    if (offset >= table.size())
+        return {};
+    const auto* start = reinterpret_cast<const char*>(table.data() + offset);
+    const auto* nul = static_cast<const char*>(std::memchr(start, 0, table.size() - offset));
+    if (!nul)
+        return {};
+    return {start, static_cast<std::size_t>(nul - start)};
+}
+
+} // namespace peelf
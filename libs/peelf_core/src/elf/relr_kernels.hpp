@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Bitmap expansion behind ElfRelocationTable::decode_relr. Each kernel
+// expands the low `bytes` bytes of a RELR bitmap (already shifted right by
+// one) into the offsets base + (bit << shift), writes them to dst and
+// returns how many it wrote. dst needs eight entries of slack past the last
+// offset, because every non-zero byte is stored as a full group of eight.
+
+namespace peelf::detail {
+
+using relr_expand_fn = std::size_t (*)(std::uint64_t bits, std::uint64_t base, unsigned shift,
+                                       std::size_t bytes, std::uint64_t* dst);
+
+std::size_t relr_expand_scalar(std::uint64_t bits, std::uint64_t base, unsigned shift,
+                               std::size_t bytes, std::uint64_t* dst);
+
+// nullptr when the AVX2 kernel was not compiled in (non-x86 targets)
+extern const relr_expand_fn relr_expand_avx2;
+
+} // namespace peelf::detail
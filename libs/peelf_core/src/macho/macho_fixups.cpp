@@ -0,0 +1,260 @@
+#include "macho/macho_fixups.hpp"
+
+#include "peelf/byte_reader.hpp"
+
+namespace peelf {
+
+namespace {
+
+std::int32_t library_ordinal(std::uint32_t raw, unsigned bits) {
+    // The top 15 values of the field are the negative special ordinals
+    const std::uint32_t max = (1u << bits) - 1;
+    return raw > max - 15 ? static_cast<std::int32_t>(raw) - static_cast<std::int32_t>(max + 1)
+                          : static_cast<std::int32_t>(raw);
+}
+
+std::int64_t sign_extend(std::uint64_t v, unsigned bits) {
+    const std::uint64_t sign = std::uint64_t{1} << (bits - 1);
+    return static_cast<std::int64_t>((v ^ sign) - sign);
+}
+
+std::expected<std::vector<MachOChainedImport>, Error>
+read_imports(const MachOView& macho, std::span<const std::uint8_t> blob, const dyld_chained_fixups_header_& h) {
+    std::size_t record = 0;
+    switch (h.imports_format) {
+        case DYLD_CHAINED_IMPORT:          record = 4; break;
+        case DYLD_CHAINED_IMPORT_ADDEND:   record = 8; break;
+        case DYLD_CHAINED_IMPORT_ADDEND64: record = 16; break;
+        default:
+            return std::unexpected(Error{"Unknown chained import format"});
+    }
+    if (h.imports_count > macho.limits().max_table_entries)
+        return std::unexpected(Error{"Chained imports exceed entry budget"});
+    if (h.imports_offset > blob.size() || (blob.size() - h.imports_offset) / record < h.imports_count)
+        return std::unexpected(Error{"Chained imports out of range"});
+    if (h.symbols_offset > blob.size())
+        return std::unexpected(Error{"Chained import names out of range"});
+    const auto symbols = blob.subspan(h.symbols_offset);
+
+    std::vector<MachOChainedImport> out;
+    out.reserve(h.imports_count);
+    ByteReader r(blob, false, h.imports_offset);
+    for (std::uint32_t i = 0; i < h.imports_count; ++i) {
+        MachOChainedImport import;
+        std::uint64_t name_offset = 0;
+        if (h.imports_format == DYLD_CHAINED_IMPORT_ADDEND64) {
+            const std::uint64_t v = r.u64();
+            import.library = library_ordinal(static_cast<std::uint32_t>(v & 0xFFFF), 16);
+            import.weak = (v >> 16) & 1;
+            name_offset = v >> 32;
+            import.addend = static_cast<std::int64_t>(r.u64());
+        } else {
+            const std::uint32_t v = r.u32();
+            import.library = library_ordinal(v & 0xFF, 8);
+            import.weak = (v >> 8) & 1;
+            name_offset = v >> 9;
+            if (h.imports_format == DYLD_CHAINED_IMPORT_ADDEND)
+                import.addend = static_cast<std::int32_t>(r.u32());
+        }
+        if (name_offset < symbols.size()) {
+            const auto* s = reinterpret_cast<const char*>(symbols.data() + name_offset);
+            import.name = {s, strnlen(s, symbols.size() - static_cast<std::size_t>(name_offset))};
+        }
+        out.push_back(import);
+    }
+    return out;
+}
+
+// Decodes one chained pointer; returns the distance to the next one in
+// strides, 0 at the end of the chain. Non-pointers of the 32-bit format
+// leave `fixup` unset.
+std::uint64_t decode_pointer(std::uint16_t format, std::uint64_t v, std::uint64_t base,
+                             std::uint32_t max_valid_pointer, std::optional<MachOFixup>& fixup) {
+    MachOFixup f;
+    switch (format) {
+        case DYLD_CHAINED_PTR_64:
+        case DYLD_CHAINED_PTR_64_OFFSET: {
+            f.bind = v >> 63;
+            if (f.bind) {
+                f.import = static_cast<std::uint32_t>(v & 0xFFFFFF);
+                f.addend = static_cast<std::int64_t>((v >> 24) & 0xFF);
+            } else {
+                const std::uint64_t target = v & 0xFFFFFFFFFull;
+                const std::uint64_t high8 = (v >> 36) & 0xFF;
+                f.target = (format == DYLD_CHAINED_PTR_64_OFFSET ? base + target : target) | (high8 << 56);
+            }
+            fixup = f;
+            return (v >> 51) & 0xFFF;
+        }
+        case DYLD_CHAINED_PTR_ARM64E:
+        case DYLD_CHAINED_PTR_ARM64E_USERLAND:
+        case DYLD_CHAINED_PTR_ARM64E_USERLAND24: {
+            f.auth = v >> 63;
+            f.bind = (v >> 62) & 1;
+            const std::uint64_t ordinal_mask = format == DYLD_CHAINED_PTR_ARM64E_USERLAND24 ? 0xFFFFFF : 0xFFFF;
+            if (f.bind) {
+                f.import = static_cast<std::uint32_t>(v & ordinal_mask);
+                if (!f.auth)
+                    f.addend = sign_extend((v >> 32) & 0x7FFFF, 19);
+            } else if (f.auth) {
+                // Authenticated rebases always hold an offset from the base
+                f.target = base + (v & 0xFFFFFFFF);
+            } else {
+                const std::uint64_t target = v & ((std::uint64_t{1} << 43) - 1);
+                const std::uint64_t high8 = (v >> 43) & 0xFF;
+                f.target = (format == DYLD_CHAINED_PTR_ARM64E ? target : base + target) | (high8 << 56);
+            }
+            fixup = f;
+            return (v >> 51) & 0x7FF;
+        }
+        case DYLD_CHAINED_PTR_32: {
+            f.bind = (v >> 31) & 1;
+            if (f.bind) {
+                f.import = static_cast<std::uint32_t>(v & 0xFFFFF);
+                f.addend = static_cast<std::int64_t>((v >> 20) & 0x3F);
+                fixup = f;
+            } else if ((v & 0x3FFFFFF) <= max_valid_pointer) {
+                f.target = v & 0x3FFFFFF;
+                fixup = f;
+            }
+            return (v >> 26) & 0x1F;
+        }
+        default:
+            return 0;
+    }
+}
+
+} // namespace
+
+std::expected<MachOChainedFixups, Error> read_chained_fixups(const MachOView& macho) {
+    MachOChainedFixups out;
+    if (!macho.find_command(LC_DYLD_CHAINED_FIXUPS))
+        return out;
+    const auto blob = macho.linkedit_data(LC_DYLD_CHAINED_FIXUPS);
+    if (blob.size() < sizeof(dyld_chained_fixups_header_))
+        return std::unexpected(Error{"Chained fixups out of range"});
+
+    dyld_chained_fixups_header_ h{};
+    std::memcpy(&h, blob.data(), sizeof(h));
+    if (h.fixups_version != 0)
+        return std::unexpected(Error{"Unknown chained fixups version"});
+    if (h.symbols_format != 0)
+        return std::unexpected(Error{"Compressed chained import names are not supported"});
+
+    auto imports = read_imports(macho, blob, h);
+    if (!imports)
+        return std::unexpected(imports.error());
+    out.imports = std::move(*imports);
+
+    ByteReader starts(blob, false, h.starts_offset);
+    const std::uint32_t seg_count = starts.u32();
+    if (!starts.ok() || seg_count > starts.remaining() / 4 || seg_count > macho.segment_count())
+        return std::unexpected(Error{"Chained fixup starts out of range"});
+
+    const std::uint64_t base = macho.image_base();
+    const auto bytes = macho.bytes();
+    for (std::uint32_t seg = 0; seg < seg_count; ++seg) {
+        const std::uint32_t info_offset = starts.u32();
+        if (info_offset == 0)
+            continue;
+
+        ByteReader info(blob, false, std::size_t{h.starts_offset} + info_offset);
+        const std::size_t info_start = info.pos();
+        const std::uint32_t info_size = info.u32();
+        const std::uint16_t page_size = info.u16();
+        const std::uint16_t format = info.u16();
+        info.skip(8);                               // segment_offset: the segment's own vmaddr - base
+        const std::uint32_t max_valid_pointer = info.u32();
+        const std::uint16_t page_count = info.u16();
+        const std::size_t page_starts = info.pos();
+        if (!info.ok() || info_size > blob.size() - info_start)
+            return std::unexpected(Error{"Chained fixup segment info out of range"});
+
+        std::size_t stride = 0;
+        std::size_t pointer_size = 8;
+        switch (format) {
+            case DYLD_CHAINED_PTR_ARM64E:
+            case DYLD_CHAINED_PTR_ARM64E_USERLAND:
+            case DYLD_CHAINED_PTR_ARM64E_USERLAND24: stride = 8; break;
+            case DYLD_CHAINED_PTR_64:
+            case DYLD_CHAINED_PTR_64_OFFSET:         stride = 4; break;
+            case DYLD_CHAINED_PTR_32:                stride = 4; pointer_size = 4; break;
+            default:
+                return std::unexpected(Error{"Unsupported chained pointer format"});
+        }
+        if (out.pointer_format == 0)
+            out.pointer_format = format;
+
+        // Overflow starts of the 32-bit formats sit after page_count entries,
+        // still inside the segment info
+        const auto page_start = [&](std::size_t k) -> std::optional<std::uint16_t> {
+            const std::size_t at = page_starts + k * 2;
+            if (at + 2 > info_start + info_size)
+                return std::nullopt;
+            ByteReader r(blob, false, at);
+            return r.u16();
+        };
+
+        const auto segment = macho.segment(seg);
+        const auto walk = [&](std::uint64_t in_segment) -> std::expected<void, Error> {
+            for (;;) {
+                if (in_segment + pointer_size > segment.filesize)
+                    return std::unexpected(Error{"Fixup chain leaves its segment"});
+                const std::uint64_t offset = segment.fileoff + in_segment;
+                if (offset > bytes.size() || bytes.size() - offset < pointer_size)
+                    return std::unexpected(Error{"Fixup chain out of range"});
+
+                std::uint64_t v = 0;
+                if (pointer_size == 8) {
+                    std::memcpy(&v, bytes.data() + offset, 8);
+                } else {
+                    std::uint32_t v32 = 0;
+                    std::memcpy(&v32, bytes.data() + offset, 4);
+                    v = v32;
+                }
+
+                std::optional<MachOFixup> fixup;
+                const std::uint64_t next = decode_pointer(format, v, base, max_valid_pointer, fixup);
+                if (fixup) {
+                    if (fixup->bind && fixup->import >= out.imports.size())
+                        return std::unexpected(Error{"Chained bind names a missing import"});
+                    if (out.fixups.size() >= macho.limits().max_table_entries)
+                        return std::unexpected(Error{"Chained fixups exceed entry budget"});
+                    fixup->offset = offset;
+                    fixup->vmaddr = segment.vmaddr + in_segment;
+                    out.fixups.push_back(*fixup);
+                }
+                if (next == 0)
+                    return {};
+                in_segment += next * stride;
+            }
+        };
+
+        for (std::uint16_t page = 0; page < page_count; ++page) {
+            const auto start = page_start(page);
+            if (!start)
+                return std::unexpected(Error{"Chained fixup page starts out of range"});
+            if (*start == DYLD_CHAINED_PTR_START_NONE)
+                continue;
+            const std::uint64_t page_offset = std::uint64_t{page} * page_size;
+
+            if (pointer_size == 4 && (*start & DYLD_CHAINED_PTR_START_MULTI)) {
+                for (std::size_t k = static_cast<std::uint16_t>(*start & ~DYLD_CHAINED_PTR_START_MULTI);; ++k) {
+                    const auto chain = page_start(k);
+                    if (!chain)
+                        return std::unexpected(Error{"Chained fixup page starts out of range"});
+                    if (auto ok = walk(page_offset + static_cast<std::uint16_t>(*chain & ~DYLD_CHAINED_PTR_START_LAST)); !ok)
+                        return std::unexpected(ok.error());
+                    if (*chain & DYLD_CHAINED_PTR_START_LAST)
+                        break;
+                }
+                continue;
+            }
+            if (auto ok = walk(page_offset + *start); !ok)
+                return std::unexpected(ok.error());
+        }
+    }
+    return out;
+}
+
+} // namespace peelf
@@ -0,0 +1,133 @@
+#include "macho/macho_symbols.hpp"
+
+#include "peelf/byte_reader.hpp"
+
+namespace peelf {
+
+namespace {
+
+template<typename Traits>
+std::expected<std::vector<MachOSymbol>, Error> decode_symbols(const MachOView& macho, const symtab_command_& cmd) {
+    using nlist_t = typename Traits::nlist;
+
+    const auto table = macho.file_span(cmd.symoff, std::uint64_t{cmd.nsyms} * sizeof(nlist_t));
+    if (table.empty() && cmd.nsyms != 0)
+        return std::unexpected(Error{"Mach-O symbol table out of range"});
+    const auto strings = macho.file_span(cmd.stroff, cmd.strsize);
+    if (strings.empty() && cmd.strsize != 0)
+        return std::unexpected(Error{"Mach-O string table out of range"});
+    if (cmd.nsyms > macho.limits().max_table_entries)
+        return std::unexpected(Error{"Mach-O symbol table exceeds entry budget"});
+
+    std::vector<MachOSymbol> out;
+    out.reserve(cmd.nsyms);
+    for (std::uint32_t i = 0; i < cmd.nsyms; ++i) {
+        nlist_t n{};
+        std::memcpy(&n, table.data() + std::size_t{i} * sizeof(n), sizeof(n));
+        std::string_view name;
+        if (n.n_strx < strings.size()) {
+            const auto* s = reinterpret_cast<const char*>(strings.data() + n.n_strx);
+            name = {s, strnlen(s, strings.size() - n.n_strx)};
+        }
+        out.push_back(MachOSymbol{
+            .name = name,
+            .value = n.n_value,
+            .type = n.n_type,
+            .section = n.n_sect,
+            .desc = n.n_desc,
+        });
+    }
+    return out;
+}
+
+} // namespace
+
+std::expected<std::vector<MachOSymbol>, Error> read_symbols(const MachOView& macho) {
+    const auto index = macho.find_command(LC_SYMTAB);
+    if (!index)
+        return std::vector<MachOSymbol>{};
+    const auto cmd = macho.command<symtab_command_>(*index);
+    if (!cmd)
+        return std::unexpected(Error{"LC_SYMTAB truncated"});
+    return macho.dispatch([&](auto traits) {
+        return decode_symbols<decltype(traits)>(macho, *cmd);
+    });
+}
+
+std::expected<std::vector<MachOExport>, Error> read_exports(const MachOView& macho) {
+    std::span<const std::uint8_t> trie = macho.linkedit_data(LC_DYLD_EXPORTS_TRIE);
+    if (trie.empty()) {
+        auto index = macho.find_command(LC_DYLD_INFO_ONLY);
+        if (!index)
+            index = macho.find_command(LC_DYLD_INFO);
+        if (const auto info = index ? macho.command<dyld_info_command_>(*index) : std::nullopt)
+            trie = macho.file_span(info->export_off, info->export_size);
+    }
+
+    std::vector<MachOExport> out;
+    if (trie.empty())
+        return out;
+
+    // Depth-first, children pushed in reverse so exports come out in trie
+    // order. Everything still on the stack below a node is an ancestor or
+    // an ancestor's sibling, so cutting `name` back to the parent's length
+    // restores the node's prefix.
+    struct Pending {
+        std::size_t node;
+        std::size_t parent_length;
+        std::string_view edge;
+    };
+    std::vector<Pending> stack{{0, 0, {}}};
+    std::vector<bool> visited(trie.size(), false);
+    std::vector<Pending> children;
+    std::string name;
+
+    while (!stack.empty()) {
+        const Pending p = stack.back();
+        stack.pop_back();
+        if (p.node >= trie.size())
+            return std::unexpected(Error{"Export trie node out of range"});
+        if (visited[p.node])
+            return std::unexpected(Error{"Export trie loops"});
+        visited[p.node] = true;
+        name.resize(p.parent_length);
+        name += p.edge;
+
+        ByteReader r(trie, false, p.node);
+        const std::uint64_t terminal_size = r.uleb128();
+        const std::size_t children_at = r.pos() + static_cast<std::size_t>(terminal_size);
+        if (terminal_size != 0) {
+            MachOExport e;
+            e.name = name;
+            e.flags = r.uleb128();
+            if (e.is_reexport()) {
+                e.library = r.uleb128();
+                e.import_name = r.cstring();
+            } else {
+                e.address = r.uleb128();
+                if (e.flags & EXPORT_SYMBOL_FLAGS_STUB_AND_RESOLVER)
+                    e.resolver = r.uleb128();
+            }
+            if (!r.ok() || r.pos() > children_at)
+                return std::unexpected(Error{"Export trie terminal out of range"});
+            if (out.size() >= macho.limits().max_exports)
+                return std::unexpected(Error{"Export trie exceeds export budget"});
+            out.push_back(std::move(e));
+        }
+
+        r.seek(children_at);
+        const std::uint8_t count = r.u8();
+        children.clear();
+        for (std::uint8_t i = 0; i < count; ++i) {
+            const auto edge = r.cstring();
+            const auto child = r.uleb128();
+            children.push_back(Pending{static_cast<std::size_t>(child), name.size(), edge});
+        }
+        if (!r.ok())
+            return std::unexpected(Error{"Export trie node truncated"});
+        stack.insert(stack.end(), children.rbegin(), children.rend());
+    }
+    return out;
+}
+
+} // namespace peelf
@@ -0,0 +1,358 @@
+#include "macho/macho_view.hpp"
+
+#include <algorithm>
+
+#include "peelf/byte_reader.hpp"
+#include "peelf/parallel.hpp"
+
+namespace peelf {
+
+namespace {
+
+// Section types without file contents
+constexpr std::uint8_t S_ZEROFILL = 0x1;
+constexpr std::uint8_t S_GB_ZEROFILL = 0xC;
+constexpr std::uint8_t S_THREAD_LOCAL_ZEROFILL = 0x12;
+
+std::uint32_t magic_of(std::span<const std::uint8_t> bytes) {
+    std::uint32_t magic = 0;
+    if (bytes.size() >= sizeof(magic))
+        std::memcpy(&magic, bytes.data(), sizeof(magic));
+    return magic;
+}
+
+// Fixed-size name fields are NUL-padded, not always NUL-terminated
+std::string_view fixed_name(const std::uint8_t* p, std::size_t n) {
+    const auto* s = reinterpret_cast<const char*>(p);
+    return {s, strnlen(s, n)};
+}
+
+bool is_dylib_command(std::uint32_t cmd) {
+    return cmd == LC_LOAD_DYLIB || cmd == LC_LOAD_WEAK_DYLIB || cmd == LC_REEXPORT_DYLIB ||
+           cmd == LC_LOAD_UPWARD_DYLIB || cmd == LC_LAZY_LOAD_DYLIB;
+}
+
+} // namespace
+
+std::expected<MachOView, Error> MachOView::parse(std::span<const std::uint8_t> bytes,
+                                                 const ParseLimits& limits) {
+    MachOView macho(bytes);
+    macho.limits_ = limits;
+
+    std::expected<void, Error> ok;
+    switch (magic_of(bytes)) {
+        case MH_MAGIC:    ok = macho.parse_commands<MachO32Traits>(); break;
+        case MH_MAGIC_64: ok = macho.parse_commands<MachO64Traits>(); break;
+        case MH_CIGAM:
+        case MH_CIGAM_64:
+            return std::unexpected(Error{"Big-endian Mach-O is not supported"});
+        default:
+            return std::unexpected(Error{"Not a Mach-O image"});
+    }
+    if (!ok)
+        return std::unexpected(ok.error());
+    return macho;
+}
+
+template<typename Traits>
+std::expected<void, Error> MachOView::parse_commands() {
+    using header_t = typename Traits::header;
+    using segment_t = typename Traits::segment;
+    using section_t = typename Traits::section;
+
+    if (bytes_.size() < sizeof(header_t))
+        return std::unexpected(Error{"Mach-O header truncated"});
+    header_t h{};
+    std::memcpy(&h, bytes_.data(), sizeof(h));
+
+    is_64_ = Traits::is_64;
+    cpu_type_ = h.cputype;
+    cpu_subtype_ = h.cpusubtype;
+    file_type_ = h.filetype;
+    flags_ = h.flags;
+
+    if (h.ncmds > limits_.max_table_entries)
+        return std::unexpected(Error{"Mach-O load commands exceed entry budget"});
+    if (h.sizeofcmds > bytes_.size() - sizeof(h))
+        return std::unexpected(Error{"Mach-O load commands out of range"});
+
+    // Headers only: cmd and cmdsize, plus the section count of segments so
+    // that section ordinals can be resolved without another walk
+    const std::size_t end = sizeof(h) + h.sizeofcmds;
+    std::size_t pos = sizeof(h);
+    commands_.reserve(h.ncmds);
+    for (std::uint32_t i = 0; i < h.ncmds; ++i) {
+        load_command_ lc{};
+        if (end - pos < sizeof(lc))
+            return std::unexpected(Error{"Mach-O load command truncated"});
+        std::memcpy(&lc, bytes_.data() + pos, sizeof(lc));
+        if (lc.cmdsize < sizeof(lc) || lc.cmdsize > end - pos)
+            return std::unexpected(Error{"Bad Mach-O load command size"});
+
+        if (lc.cmd == Traits::segment_cmd) {
+            if (lc.cmdsize < sizeof(segment_t))
+                return std::unexpected(Error{"Mach-O segment command truncated"});
+            segment_t seg{};
+            std::memcpy(&seg, bytes_.data() + pos, sizeof(seg));
+            if (seg.nsects > (lc.cmdsize - sizeof(segment_t)) / sizeof(section_t))
+                return std::unexpected(Error{"Mach-O section table out of range"});
+            if (seg.nsects > limits_.max_table_entries - section_count_)
+                return std::unexpected(Error{"Mach-O sections exceed entry budget"});
+            segment_commands_.push_back(static_cast<std::uint32_t>(commands_.size()));
+            first_section_.push_back(static_cast<std::uint32_t>(section_count_ + 1));
+            section_count_ += seg.nsects;
+        }
+
+        commands_.push_back(MachOLoadCommand{lc.cmd, lc.cmdsize, pos});
+        pos += lc.cmdsize;
+    }
+    return {};
+}
+
+std::optional<std::size_t> MachOView::find_command(std::uint32_t cmd) const {
+    for (std::size_t i = 0; i < commands_.size(); ++i) {
+        if (commands_[i].cmd == cmd)
+            return i;
+    }
+    return std::nullopt;
+}
+
+std::string_view MachOView::command_string(std::size_t index, std::uint32_t str_offset) const {
+    if (index >= commands_.size() || str_offset >= commands_[index].size)
+        return {};
+    const auto& c = commands_[index];
+    return fixed_name(bytes_.data() + c.offset + str_offset, c.size - str_offset);
+}
+
+MachOSegment MachOView::segment(std::size_t index) const {
+    if (index >= segment_commands_.size())
+        return {};
+    const auto& c = commands_[segment_commands_[index]];
+    return dispatch([&](auto traits) {
+        using segment_t = typename decltype(traits)::segment;
+        segment_t s{};
+        std::memcpy(&s, bytes_.data() + c.offset, sizeof(s));
+        return MachOSegment{
+            .name = fixed_name(bytes_.data() + c.offset + offsetof(segment_t, segname), sizeof(s.segname)),
+            .vmaddr = s.vmaddr,
+            .vmsize = s.vmsize,
+            .fileoff = s.fileoff,
+            .filesize = s.filesize,
+            .maxprot = s.maxprot,
+            .initprot = s.initprot,
+            .flags = s.flags,
+            .section_count = s.nsects,
+        };
+    });
+}
+
+std::optional<std::size_t> MachOView::find_segment(std::string_view name) const {
+    for (std::size_t i = 0; i < segment_commands_.size(); ++i) {
+        if (segment(i).name == name)
+            return i;
+    }
+    return std::nullopt;
+}
+
+std::span<const std::uint8_t> MachOView::segment_data(std::size_t index) const {
+    if (index >= segment_commands_.size())
+        return {};
+    const auto s = segment(index);
+    return file_span(s.fileoff, s.filesize);
+}
+
+MachOSection MachOView::section(std::size_t ordinal) const {
+    if (ordinal == 0 || ordinal > section_count_)
+        return {};
+    // Last segment whose first section is at or before the ordinal
+    const auto it = std::ranges::upper_bound(first_section_, ordinal);
+    const auto seg = static_cast<std::size_t>(it - first_section_.begin()) - 1;
+    const auto& c = commands_[segment_commands_[seg]];
+    const std::size_t within = ordinal - first_section_[seg];
+
+    return dispatch([&](auto traits) {
+        using T = decltype(traits);
+        using section_t = typename T::section;
+        const std::size_t at = c.offset + sizeof(typename T::segment) + within * sizeof(section_t);
+        section_t s{};
+        std::memcpy(&s, bytes_.data() + at, sizeof(s));
+        return MachOSection{
+            .segment_name = fixed_name(bytes_.data() + at + offsetof(section_t, segname), sizeof(s.segname)),
+            .name = fixed_name(bytes_.data() + at + offsetof(section_t, sectname), sizeof(s.sectname)),
+            .addr = s.addr,
+            .size = s.size,
+            .offset = s.offset,
+            .align = s.align,
+            .reloff = s.reloff,
+            .nreloc = s.nreloc,
+            .flags = s.flags,
+        };
+    });
+}
+
+std::optional<std::size_t> MachOView::find_section(std::string_view segment, std::string_view name) const {
+    for (std::size_t i = 1; i <= section_count_; ++i) {
+        const auto s = section(i);
+        if (s.name == name && s.segment_name == segment)
+            return i;
+    }
+    return std::nullopt;
+}
+
+std::span<const std::uint8_t> MachOView::section_data(std::size_t ordinal) const {
+    const auto s = section(ordinal);
+    const auto type = s.type();
+    if (s.offset == 0 || type == S_ZEROFILL || type == S_GB_ZEROFILL || type == S_THREAD_LOCAL_ZEROFILL)
+        return {};
+    return file_span(s.offset, s.size);
+}
+
+std::uint64_t MachOView::image_base() const {
+    const auto text = find_segment("__TEXT");
+    return text ? segment(*text).vmaddr : 0;
+}
+
+std::optional<std::size_t> MachOView::vmaddr_to_offset(std::uint64_t vmaddr) const {
+    for (std::size_t i = 0; i < segment_commands_.size(); ++i) {
+        const auto s = segment(i);
+        if (vmaddr >= s.vmaddr && vmaddr - s.vmaddr < s.filesize)
+            return static_cast<std::size_t>(s.fileoff + (vmaddr - s.vmaddr));
+    }
+    return std::nullopt;
+}
+
+std::optional<std::uint64_t> MachOView::offset_to_vmaddr(std::uint64_t offset) const {
+    for (std::size_t i = 0; i < segment_commands_.size(); ++i) {
+        const auto s = segment(i);
+        if (offset >= s.fileoff && offset - s.fileoff < s.filesize)
+            return s.vmaddr + (offset - s.fileoff);
+    }
+    return std::nullopt;
+}
+
+std::optional<std::uint64_t> MachOView::entry_point() const {
+    const auto index = find_command(LC_MAIN);
+    if (!index)
+        return std::nullopt;
+    const auto main = command<entry_point_command_>(*index);
+    return main ? offset_to_vmaddr(main->entryoff) : std::nullopt;
+}
+
+std::optional<std::array<std::uint8_t, 16>> MachOView::uuid() const {
+    const auto index = find_command(LC_UUID);
+    if (!index)
+        return std::nullopt;
+    const auto cmd = command<uuid_command_>(*index);
+    if (!cmd)
+        return std::nullopt;
+    std::array<std::uint8_t, 16> out{};
+    std::memcpy(out.data(), cmd->uuid, out.size());
+    return out;
+}
+
+std::string_view MachOView::install_name() const {
+    const auto index = find_command(LC_ID_DYLIB);
+    if (!index)
+        return {};
+    const auto cmd = command<dylib_command_>(*index);
+    return cmd ? command_string(*index, cmd->name_offset) : std::string_view{};
+}
+
+std::vector<MachODylib> MachOView::dylibs() const {
+    std::vector<MachODylib> out;
+    for (std::size_t i = 0; i < commands_.size(); ++i) {
+        if (!is_dylib_command(commands_[i].cmd))
+            continue;
+        // A malformed entry still takes its ordinal, so later ones keep theirs
+        MachODylib d;
+        d.cmd = commands_[i].cmd;
+        if (const auto cmd = command<dylib_command_>(i)) {
+            d.name = command_string(i, cmd->name_offset);
+            d.current_version = cmd->current_version;
+            d.compatibility_version = cmd->compatibility_version;
+        }
+        out.push_back(d);
+    }
+    return out;
+}
+
+std::vector<std::string_view> MachOView::rpaths() const {
+    std::vector<std::string_view> out;
+    for (std::size_t i = 0; i < commands_.size(); ++i) {
+        if (commands_[i].cmd != LC_RPATH)
+            continue;
+        if (const auto cmd = command<lc_str_command_>(i))
+            out.push_back(command_string(i, cmd->offset));
+    }
+    return out;
+}
+
+std::span<const std::uint8_t> MachOView::linkedit_data(std::uint32_t cmd) const {
+    const auto index = find_command(cmd);
+    if (!index)
+        return {};
+    const auto data = command<linkedit_data_command_>(*index);
+    return data ? file_span(data->dataoff, data->datasize) : std::span<const std::uint8_t>{};
+}
+
+std::span<const std::uint8_t> MachOView::file_span(std::uint64_t offset, std::uint64_t size) const {
+    if (offset > bytes_.size() || bytes_.size() - offset < size)
+        return {};
+    return bytes_.subspan(static_cast<std::size_t>(offset), static_cast<std::size_t>(size));
+}
+
+bool is_macho(std::span<const std::uint8_t> bytes) {
+    const auto magic = magic_of(bytes);
+    return magic == MH_MAGIC || magic == MH_MAGIC_64 || magic == MH_CIGAM || magic == MH_CIGAM_64 ||
+           is_fat_macho(bytes);
+}
+
+bool is_fat_macho(std::span<const std::uint8_t> bytes) {
+    ByteReader r(bytes, true);
+    const std::uint32_t magic = r.u32();
+    const std::uint32_t count = r.u32();
+    return r.ok() && (magic == FAT_MAGIC || magic == FAT_MAGIC_64) && count != 0 && count < 45;
+}
+
+std::expected<std::vector<MachOSlice>, Error>
+read_fat_slices(std::span<const std::uint8_t> bytes, const ParseLimits& limits) {
+    if (!is_fat_macho(bytes))
+        return std::unexpected(Error{"Not a fat Mach-O file"});
+
+    ByteReader r(bytes, true);
+    const bool wide = r.u32() == FAT_MAGIC_64;
+    const std::uint32_t count = r.u32();
+    if (count > limits.max_table_entries)
+        return std::unexpected(Error{"Fat header exceeds entry budget"});
+
+    std::vector<MachOSlice> slices;
+    slices.reserve(count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        MachOSlice s;
+        s.cpu_type = r.u32();
+        s.cpu_subtype = r.u32();
+        s.offset = wide ? r.u64() : r.u32();
+        const std::uint64_t size = wide ? r.u64() : r.u32();
+        s.align = r.u32();
+        if (wide)
+            r.skip(4);
+        if (!r.ok())
+            return std::unexpected(Error{"Fat arch table truncated"});
+        if (s.offset > bytes.size() || bytes.size() - s.offset < size)
+            return std::unexpected(Error{"Fat slice out of range"});
+        s.data = bytes.subspan(static_cast<std::size_t>(s.offset), static_cast<std::size_t>(size));
+        slices.push_back(s);
+    }
+    return slices;
+}
+
+std::vector<std::expected<MachOView, Error>>
+parse_slices(std::span<const MachOSlice> slices, const ParseLimits& limits, std::size_t threads) {
+    std::vector<std::expected<MachOView, Error>> results(slices.size(), std::unexpected(Error{"Not parsed"}));
+    parallel_for(slices.size(), [&](std::size_t i) {
+        results[i] = MachOView::parse(slices[i].data, limits);
+    }, threads);
+    return results;
+}
+
+} // namespace peelf
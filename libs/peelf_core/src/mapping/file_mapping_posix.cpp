@@ -1,6 +1,8 @@
 #ifndef _WIN32
 
 #include "mapping/file_mapping_posix.hpp"
+#include "mapping/file_mapping.hpp"
+#include "mapping/map_errors.hpp"
 
 #include <cerrno>
 #include <cstring>
@@ -81,6 +83,77 @@ std::error_code PosixFileMappingBackend::flush(PosixFileMappingBackend&,
     return {};
 }
 
+std::error_code PosixFileMappingBackend::open_file(PosixFileMappingBackend& self,
+                                                  const std::string& path,
+                                                  std::uint64_t* out_size) noexcept
+{
+    *out_size = 0;
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return make_error_code(MapErrc::open_failed);
+
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return make_error_code(MapErrc::stat_failed);
+    }
+    if (st.st_size <= 0) {
+        ::close(fd);
+        return make_error_code(MapErrc::size_zero);
+    }
+
+    self.fd = fd;
+    *out_size = static_cast<std::uint64_t>(st.st_size);
+    return {};
+}
+
+std::error_code PosixFileMappingBackend::map_view(PosixFileMappingBackend& self,
+                                                 std::uint64_t offset,
+                                                 std::size_t size,
+                                                 const void** out_ptr) noexcept
+{
+    *out_ptr = nullptr;
+    if (self.fd < 0 || size == 0) return make_error_code(MapErrc::map_failed);
+    if (offset % granularity() != 0) return make_error_code(MapErrc::invalid_alignment);
+
+    void* ptr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, self.fd, static_cast<off_t>(offset));
+    if (ptr == MAP_FAILED) return make_error_code(MapErrc::map_failed);
+    *out_ptr = ptr;
+    return {};
+}
+
+std::error_code PosixFileMappingBackend::unmap_view(const void* ptr, std::size_t size) noexcept
+{
+    if (!ptr || !size) return {};
+    if (::munmap(const_cast<void*>(ptr), size) != 0) return make_error_code(MapErrc::unmap_failed);
+    return {};
+}
+
+std::size_t PosixFileMappingBackend::granularity() noexcept
+{
+    static const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return page;
+}
+
+std::error_code PosixFileMappingBackend::map_anonymous(std::size_t size, void** out_ptr) noexcept
+{
+    *out_ptr = nullptr;
+    if (size == 0) return make_error_code(MapErrc::size_zero);
+
+    // MAP_NORESERVE: the image is mostly zero-fill that is never written
+    void* ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (ptr == MAP_FAILED) return make_error_code(MapErrc::map_failed);
+    *out_ptr = ptr;
+    return {};
+}
+
+std::error_code PosixFileMappingBackend::unmap_anonymous(void* ptr, std::size_t size) noexcept
+{
+    if (!ptr || !size) return {};
+    if (::munmap(ptr, size) != 0) return make_error_code(MapErrc::unmap_failed);
+    return {};
+}
+
 } // namespace ws::fs
 
 #endif
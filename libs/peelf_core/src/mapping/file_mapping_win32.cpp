@@ -108,6 +108,92 @@ std::error_code Win32FileMappingBackend::flush(Win32FileMappingBackend&,
     return {};
 }
 
+std::error_code Win32FileMappingBackend::open_file(Win32FileMappingBackend& self,
+                                                  const std::string& path,
+                                                  std::uint64_t* out_size) noexcept
+{
+    *out_size = 0;
+
+    HANDLE hFile = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                 OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE) return make_error_code(MapErrc::open_failed);
+
+    LARGE_INTEGER liSize{};
+    if (!::GetFileSizeEx(hFile, &liSize)) {
+        ::CloseHandle(hFile);
+        return make_error_code(MapErrc::stat_failed);
+    }
+    if (liSize.QuadPart <= 0) {
+        ::CloseHandle(hFile);
+        return make_error_code(MapErrc::size_zero);
+    }
+
+    HANDLE hMap = ::CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!hMap) {
+        ::CloseHandle(hFile);
+        return make_error_code(MapErrc::map_failed);
+    }
+
+    self.file = hFile;
+    self.mapping = hMap;
+    *out_size = static_cast<std::uint64_t>(liSize.QuadPart);
+    return {};
+}
+
+std::error_code Win32FileMappingBackend::map_view(Win32FileMappingBackend& self,
+                                                 std::uint64_t offset,
+                                                 std::size_t size,
+                                                 const void** out_ptr) noexcept
+{
+    *out_ptr = nullptr;
+    if (!self.mapping || size == 0) return make_error_code(MapErrc::map_failed);
+    if (offset % granularity() != 0) return make_error_code(MapErrc::invalid_alignment);
+
+    // A view keeps the mapping object alive after its handle is closed
+    void* ptr = ::MapViewOfFile(self.mapping, FILE_MAP_READ,
+                                static_cast<DWORD>(offset >> 32), static_cast<DWORD>(offset), size);
+    if (!ptr) return make_error_code(MapErrc::map_failed);
+    *out_ptr = ptr;
+    return {};
+}
+
+std::error_code Win32FileMappingBackend::unmap_view(const void* ptr, std::size_t) noexcept
+{
+    if (!ptr) return {};
+    if (!::UnmapViewOfFile(ptr)) return make_error_code(MapErrc::unmap_failed);
+    return {};
+}
+
+std::size_t Win32FileMappingBackend::granularity() noexcept
+{
+    static const std::size_t value = [] {
+        SYSTEM_INFO info{};
+        ::GetSystemInfo(&info);
+        return static_cast<std::size_t>(info.dwAllocationGranularity);
+    }();
+    return value;
+}
+
+std::error_code Win32FileMappingBackend::map_anonymous(std::size_t size, void** out_ptr) noexcept
+{
+    *out_ptr = nullptr;
+    if (size == 0) return make_error_code(MapErrc::size_zero);
+
+    // Committed pages are charged against the commit limit but only get
+    // physical memory when touched
+    void* ptr = ::VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (!ptr) return make_error_code(MapErrc::map_failed);
+    *out_ptr = ptr;
+    return {};
+}
+
+std::error_code Win32FileMappingBackend::unmap_anonymous(void* ptr, std::size_t) noexcept
+{
+    if (!ptr) return {};
+    if (!::VirtualFree(ptr, 0, MEM_RELEASE)) return make_error_code(MapErrc::unmap_failed);
+    return {};
+}
+
 } // namespace ws::fs
 
 #endif
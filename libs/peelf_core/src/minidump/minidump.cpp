@@ -0,0 +1,452 @@
+#include "minidump/minidump.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "peelf/utf16.hpp"
+
+namespace peelf {
+
+namespace {
+
+constexpr std::uint32_t VS_FFI_SIGNATURE = 0xFEEF04BDu;
+
+// MINIDUMP_STRING and CodeView records are short; anything longer is damage
+constexpr std::uint32_t max_string_bytes = 64u << 10;
+
+// A count followed by that many records. Some writers pad the count to
+// eight bytes; the stream size tells which.
+template<typename T>
+std::optional<std::vector<T>> read_list(std::span<const std::uint8_t> data) {
+    if (data.size() < 4)
+        return std::nullopt;
+    std::uint32_t count = 0;
+    std::memcpy(&count, data.data(), 4);
+
+    const std::size_t bytes = std::size_t{count} * sizeof(T);
+    std::size_t first = 4;
+    if (data.size() - 4 != bytes && data.size() >= 8 && data.size() - 8 == bytes)
+        first = 8;
+    if (count > (data.size() - first) / sizeof(T))
+        return std::nullopt;
+
+    std::vector<T> out(count);
+    if (count != 0)
+        std::memcpy(out.data(), data.data() + first, bytes);
+    return out;
+}
+
+} // namespace
+
+const char* minidump_stream_name(std::uint32_t type) {
+    switch (type) {
+        case ThreadListStream:          return "ThreadList";
+        case ModuleListStream:          return "ModuleList";
+        case MemoryListStream:          return "MemoryList";
+        case ExceptionStream:           return "Exception";
+        case SystemInfoStream:          return "SystemInfo";
+        case ThreadExListStream:        return "ThreadExList";
+        case Memory64ListStream:        return "Memory64List";
+        case CommentStreamA:            return "CommentA";
+        case CommentStreamW:            return "CommentW";
+        case HandleDataStream:          return "HandleData";
+        case FunctionTableStream:       return "FunctionTable";
+        case UnloadedModuleListStream:  return "UnloadedModuleList";
+        case MiscInfoStream:            return "MiscInfo";
+        case MemoryInfoListStream:      return "MemoryInfoList";
+        case ThreadInfoListStream:      return "ThreadInfoList";
+        case HandleOperationListStream: return "HandleOperationList";
+        case TokenStream:               return "Token";
+        case SystemMemoryInfoStream:    return "SystemMemoryInfo";
+        case ProcessVmCountersStream:   return "ProcessVmCounters";
+        default:                        return nullptr;
+    }
+}
+
+std::expected<Minidump, Error> Minidump::parse(std::span<const std::uint8_t> file) {
+    Minidump dump;
+    dump.bytes_ = file;
+    dump.file_size_ = file.size();
+    if (auto r = dump.load(); !r)
+        return std::unexpected(r.error());
+    return dump;
+}
+
+std::expected<Minidump, Error> Minidump::open(const std::filesystem::path& path, std::size_t window_size) {
+    Minidump dump;
+    dump.mapping_ = std::make_shared<Mapping>();
+    if (auto ec = dump.mapping_->open(path, window_size); ec)
+        return std::unexpected(Error{path.string() + ": " + ec.message()});
+    dump.file_size_ = dump.mapping_->size();
+    if (auto r = dump.load(); !r)
+        return std::unexpected(r.error());
+    return dump;
+}
+
+std::size_t Minidump::read_file(std::uint64_t offset, std::span<std::uint8_t> out) const {
+    if (mapping_)
+        return mapping_->read(offset, out);
+    if (offset >= bytes_.size())
+        return 0;
+    const std::size_t n = static_cast<std::size_t>(std::min<std::uint64_t>(out.size(), bytes_.size() - offset));
+    std::memcpy(out.data(), bytes_.data() + offset, n);
+    return n;
+}
+
+std::expected<void, Error> Minidump::load() {
+    MINIDUMP_HEADER_ h{};
+    if (read_file(0, {reinterpret_cast<std::uint8_t*>(&h), sizeof(h)}) != sizeof(h))
+        return std::unexpected(Error{"Minidump header truncated"});
+    if (h.Signature != MINIDUMP_SIGNATURE)
+        return std::unexpected(Error{"Missing MDMP signature"});
+    if ((h.Version & 0xFFFF) != MINIDUMP_VERSION)
+        return std::unexpected(Error{"Unsupported minidump version"});
+    timestamp_ = h.TimeDateStamp;
+    flags_ = h.Flags;
+
+    if (h.StreamDirectoryRva > file_size_ ||
+        h.NumberOfStreams > (file_size_ - h.StreamDirectoryRva) / sizeof(MINIDUMP_DIRECTORY_))
+        return std::unexpected(Error{"Stream directory out of range"});
+    std::vector<MINIDUMP_DIRECTORY_> directory(h.NumberOfStreams);
+    const std::span<std::uint8_t> raw{reinterpret_cast<std::uint8_t*>(directory.data()),
+                                      directory.size() * sizeof(MINIDUMP_DIRECTORY_)};
+    if (read_file(h.StreamDirectoryRva, raw) != raw.size())
+        return std::unexpected(Error{"Stream directory out of range"});
+    for (const auto& d : directory) {
+        if (d.StreamType != UnusedStream)
+            streams_.push_back(MinidumpStream{d.StreamType, d.Location.DataSize, d.Location.Rva});
+    }
+
+    // Thread contexts are decoded for the architecture named here, so it
+    // goes first
+    if (const auto* s = find_stream(SystemInfoStream)) {
+        auto data = read_stream(*s);
+        if (!data)
+            return std::unexpected(data.error());
+        if (auto r = load_system_info(*data); !r)
+            return r;
+    }
+
+    for (const auto& s : streams_) {
+        using Loader = std::expected<void, Error> (Minidump::*)(std::span<const std::uint8_t>);
+        Loader loader = nullptr;
+        switch (s.type) {
+            case ModuleListStream:   loader = &Minidump::load_modules; break;
+            case ThreadListStream:   loader = &Minidump::load_threads; break;
+            case ExceptionStream:    loader = &Minidump::load_exception; break;
+            case MemoryListStream:   loader = &Minidump::load_memory_list; break;
+            case Memory64ListStream: loader = &Minidump::load_memory64_list; break;
+            default: break;
+        }
+        if (!loader)
+            continue;
+        auto data = read_stream(s);
+        if (!data)
+            return std::unexpected(data.error());
+        if (auto r = (this->*loader)(*data); !r)
+            return r;
+    }
+
+    std::stable_sort(modules_.begin(), modules_.end(),
+                     [](const MinidumpModule& a, const MinidumpModule& b) { return a.base < b.base; });
+    std::stable_sort(ranges_.begin(), ranges_.end(),
+                     [](const MinidumpMemoryRange& a, const MinidumpMemoryRange& b) { return a.va < b.va; });
+    return {};
+}
+
+std::expected<std::vector<std::uint8_t>, Error> Minidump::read_stream(const MinidumpStream& s) const {
+    if (s.size > max_stream_bytes)
+        return std::unexpected(Error{"Minidump stream too large"});
+    std::vector<std::uint8_t> data(s.size);
+    if (read_file(s.offset, data) != data.size())
+        return std::unexpected(Error{"Minidump stream out of range"});
+    return data;
+}
+
+std::string Minidump::read_string(std::uint32_t offset) const {
+    std::uint32_t length = 0;
+    if (offset == 0 || read_file(offset, {reinterpret_cast<std::uint8_t*>(&length), 4}) != 4)
+        return {};
+    std::vector<std::uint8_t> chars(std::min(length, max_string_bytes));
+    chars.resize(read_file(std::uint64_t{offset} + 4, chars));
+    return utf16_to_utf8(chars);
+}
+
+std::optional<MinidumpCodeView> Minidump::read_codeview(const MINIDUMP_LOCATION_DESCRIPTOR_& loc) const {
+    // CV_INFO_PDB70: signature, GUID, age, then the NUL-terminated path
+    constexpr std::size_t fixed = 24;
+    if (loc.DataSize < fixed || loc.DataSize > max_string_bytes)
+        return std::nullopt;
+    std::vector<std::uint8_t> record(loc.DataSize);
+    if (read_file(loc.Rva, record) != record.size())
+        return std::nullopt;
+
+    std::uint32_t signature = 0;
+    std::memcpy(&signature, record.data(), 4);
+    if (signature != CV_SIGNATURE_RSDS)
+        return std::nullopt;
+
+    MinidumpCodeView cv;
+    std::memcpy(cv.guid.data(), record.data() + 4, cv.guid.size());
+    std::memcpy(&cv.age, record.data() + 20, 4);
+    const auto* path = reinterpret_cast<const char*>(record.data() + fixed);
+    cv.pdb_path.assign(path, strnlen(path, record.size() - fixed));
+    return cv;
+}
+
+void Minidump::read_context_pointers(MinidumpThread& t) const {
+    if (!system_)
+        return;
+    std::size_t pc = 0, sp = 0, word = 0;
+    switch (system_->architecture) {
+        case PROCESSOR_ARCHITECTURE_AMD64: pc = CONTEXT_AMD64_RIP; sp = CONTEXT_AMD64_RSP; word = 8; break;
+        case PROCESSOR_ARCHITECTURE_INTEL: pc = CONTEXT_X86_EIP;   sp = CONTEXT_X86_ESP;   word = 4; break;
+        case PROCESSOR_ARCHITECTURE_ARM64: pc = CONTEXT_ARM64_PC;  sp = CONTEXT_ARM64_SP;  word = 8; break;
+        case PROCESSOR_ARCHITECTURE_ARM:   pc = CONTEXT_ARM_PC;    sp = CONTEXT_ARM_SP;    word = 4; break;
+        default: return;
+    }
+
+    const auto read_word = [&](std::size_t at) -> std::optional<std::uint64_t> {
+        std::uint64_t v = 0;
+        if (at + word > t.context.DataSize ||
+            read_file(std::uint64_t{t.context.Rva} + at, {reinterpret_cast<std::uint8_t*>(&v), word}) != word)
+            return std::nullopt;
+        return v;
+    };
+    t.pc = read_word(pc);
+    t.sp = read_word(sp);
+}
+
+std::expected<void, Error> Minidump::load_system_info(std::span<const std::uint8_t> data) {
+    MINIDUMP_SYSTEM_INFO_ si{};
+    if (data.size() < sizeof(si))
+        return std::unexpected(Error{"System info stream truncated"});
+    std::memcpy(&si, data.data(), sizeof(si));
+
+    MinidumpSystemInfo out;
+    out.architecture = si.ProcessorArchitecture;
+    out.processor_level = si.ProcessorLevel;
+    out.processor_revision = si.ProcessorRevision;
+    out.processors = si.NumberOfProcessors;
+    out.product_type = si.ProductType;
+    out.major_version = si.MajorVersion;
+    out.minor_version = si.MinorVersion;
+    out.build_number = si.BuildNumber;
+    out.platform_id = si.PlatformId;
+    out.service_pack = read_string(si.CSDVersionRva);
+    system_ = std::move(out);
+    return {};
+}
+
+std::expected<void, Error> Minidump::load_modules(std::span<const std::uint8_t> data) {
+    auto list = read_list<MINIDUMP_MODULE_>(data);
+    if (!list)
+        return std::unexpected(Error{"Module list out of range"});
+
+    modules_.reserve(modules_.size() + list->size());
+    for (const auto& m : *list) {
+        MinidumpModule out;
+        out.base = m.BaseOfImage;
+        out.size = m.SizeOfImage;
+        out.checksum = m.CheckSum;
+        out.timestamp = m.TimeDateStamp;
+        out.path = read_string(m.ModuleNameRva);
+        if (m.VersionInfo.dwSignature == VS_FFI_SIGNATURE) {
+            const auto& v = m.VersionInfo;
+            out.version = PeFixedFileInfo{
+                .file_version_ms = v.dwFileVersionMS,
+                .file_version_ls = v.dwFileVersionLS,
+                .product_version_ms = v.dwProductVersionMS,
+                .product_version_ls = v.dwProductVersionLS,
+                .file_flags = v.dwFileFlags & v.dwFileFlagsMask,
+                .file_os = v.dwFileOS,
+                .file_type = v.dwFileType,
+                .file_subtype = v.dwFileSubtype,
+            };
+        }
+        out.codeview = read_codeview(m.CvRecord);
+        modules_.push_back(std::move(out));
+    }
+    return {};
+}
+
+std::expected<void, Error> Minidump::load_threads(std::span<const std::uint8_t> data) {
+    auto list = read_list<MINIDUMP_THREAD_>(data);
+    if (!list)
+        return std::unexpected(Error{"Thread list out of range"});
+
+    threads_.reserve(threads_.size() + list->size());
+    for (const auto& t : *list) {
+        MinidumpThread out;
+        out.tid = t.ThreadId;
+        out.suspend_count = t.SuspendCount;
+        out.priority_class = t.PriorityClass;
+        out.priority = t.Priority;
+        out.teb = t.Teb;
+        out.stack_start = t.Stack.StartOfMemoryRange;
+        out.stack_size = t.Stack.Memory.DataSize;
+        out.context = t.ThreadContext;
+        read_context_pointers(out);
+        threads_.push_back(out);
+    }
+    return {};
+}
+
+std::expected<void, Error> Minidump::load_exception(std::span<const std::uint8_t> data) {
+    MINIDUMP_EXCEPTION_STREAM_ es{};
+    if (data.size() < sizeof(es))
+        return std::unexpected(Error{"Exception stream truncated"});
+    std::memcpy(&es, data.data(), sizeof(es));
+
+    const auto& rec = es.ExceptionRecord;
+    MinidumpException out;
+    out.thread_id = es.ThreadId;
+    out.code = rec.ExceptionCode;
+    out.flags = rec.ExceptionFlags;
+    out.address = rec.ExceptionAddress;
+    out.chained_record = rec.ExceptionRecord;
+    out.parameters.assign(rec.ExceptionInformation,
+                          rec.ExceptionInformation + std::min<std::size_t>(rec.NumberParameters,
+                                                                           EXCEPTION_MAXIMUM_PARAMETERS));
+    out.context = es.ThreadContext;
+    exception_ = std::move(out);
+    return {};
+}
+
+std::expected<void, Error> Minidump::load_memory_list(std::span<const std::uint8_t> data) {
+    auto list = read_list<MINIDUMP_MEMORY_DESCRIPTOR_>(data);
+    if (!list)
+        return std::unexpected(Error{"Memory list out of range"});
+
+    ranges_.reserve(ranges_.size() + list->size());
+    for (const auto& d : *list) {
+        // Clamp what the file really holds, as for a truncated core
+        const std::uint64_t available = d.Memory.Rva < file_size_ ? file_size_ - d.Memory.Rva : 0;
+        const std::uint64_t size = std::min<std::uint64_t>(d.Memory.DataSize, available);
+        if (size != 0)
+            ranges_.push_back(MinidumpMemoryRange{d.StartOfMemoryRange, size, d.Memory.Rva});
+    }
+    return {};
+}
+
+std::expected<void, Error> Minidump::load_memory64_list(std::span<const std::uint8_t> data) {
+    MINIDUMP_MEMORY64_LIST_ h{};
+    if (data.size() < sizeof(h))
+        return std::unexpected(Error{"Memory64 list truncated"});
+    std::memcpy(&h, data.data(), sizeof(h));
+    if (h.NumberOfMemoryRanges > (data.size() - sizeof(h)) / sizeof(MINIDUMP_MEMORY_DESCRIPTOR64_))
+        return std::unexpected(Error{"Memory64 list out of range"});
+    full_memory_ = true;
+
+    ranges_.reserve(ranges_.size() + static_cast<std::size_t>(h.NumberOfMemoryRanges));
+    std::uint64_t offset = h.BaseRva;
+    for (std::uint64_t i = 0; i < h.NumberOfMemoryRanges; ++i) {
+        MINIDUMP_MEMORY_DESCRIPTOR64_ d{};
+        std::memcpy(&d, data.data() + sizeof(h) + i * sizeof(d), sizeof(d));
+        const std::uint64_t available = offset < file_size_ ? file_size_ - offset : 0;
+        const std::uint64_t size = std::min(d.DataSize, available);
+        if (size != 0)
+            ranges_.push_back(MinidumpMemoryRange{d.StartOfMemoryRange, size, offset});
+        if (d.DataSize > UINT64_MAX - offset)
+            break;
+        offset += d.DataSize;
+    }
+    return {};
+}
+
+const MinidumpStream* Minidump::find_stream(std::uint32_t type) const {
+    for (const auto& s : streams_) {
+        if (s.type == type)
+            return &s;
+    }
+    return nullptr;
+}
+
+const MinidumpMemoryRange* Minidump::range_at(std::uint64_t va) const {
+    auto it = std::upper_bound(ranges_.begin(), ranges_.end(), va,
+                               [](std::uint64_t v, const MinidumpMemoryRange& r) { return v < r.va; });
+    if (it == ranges_.begin())
+        return nullptr;
+    --it;
+    return va - it->va < it->size ? &*it : nullptr;
+}
+
+const MinidumpModule* Minidump::module_at(std::uint64_t va) const {
+    auto it = std::upper_bound(modules_.begin(), modules_.end(), va,
+                               [](std::uint64_t v, const MinidumpModule& m) { return v < m.base; });
+    if (it == modules_.begin())
+        return nullptr;
+    --it;
+    return va - it->base < it->size ? &*it : nullptr;
+}
+
+std::size_t Minidump::read_memory(std::uint64_t va, std::span<std::uint8_t> out) const {
+    std::size_t done = 0;
+    while (done < out.size()) {
+        const MinidumpMemoryRange* r = range_at(va + done);
+        if (!r)
+            break;
+        const std::uint64_t delta = va + done - r->va;
+        const std::size_t want = static_cast<std::size_t>(std::min<std::uint64_t>(out.size() - done, r->size - delta));
+        const std::size_t got = read_file(r->offset + delta, out.subspan(done, want));
+        done += got;
+        if (got != want)
+            break;
+    }
+    return done;
+}
+
+MappedBytes Minidump::memory_view(std::uint64_t va, std::size_t size) const {
+    const MinidumpMemoryRange* r = range_at(va);
+    if (!r || size == 0)
+        return {};
+    const std::uint64_t offset = r->offset + (va - r->va);
+
+    // Full-memory dumps write neighbouring regions back to back, so a
+    // module split over several regions is usually still one file run
+    std::uint64_t covered = r->size - (va - r->va);
+    const MinidumpMemoryRange* end = ranges_.data() + ranges_.size();
+    for (const MinidumpMemoryRange* next = r + 1; covered < size && next != end; ++next) {
+        const MinidumpMemoryRange* prev = next - 1;
+        if (next->va != prev->va + prev->size || next->offset != prev->offset + prev->size)
+            break;
+        covered += next->size;
+    }
+    if (covered < size)
+        return {};
+
+    if (mapping_) {
+        auto view = mapping_->view(offset, size);
+        return view.bytes.size() == size ? view : MappedBytes{};
+    }
+    return MappedBytes{bytes_.subspan(static_cast<std::size_t>(offset), size), nullptr};
+}
+
+MappedBytes Minidump::module_image(const MinidumpModule& module) const {
+    if (module.size == 0 || !range_at(module.base))
+        return {};
+    if (auto view = memory_view(module.base, module.size); !view.bytes.empty())
+        return view;
+
+    // Gathered from scattered ranges; refused past the stream cap, as
+    // SizeOfImage comes from the dump
+    if (module.size > max_stream_bytes)
+        return {};
+    auto copy = std::make_shared<std::vector<std::uint8_t>>(module.size);
+    const std::uint64_t end = module.base + module.size;
+    auto it = std::upper_bound(ranges_.begin(), ranges_.end(), module.base,
+                               [](std::uint64_t v, const MinidumpMemoryRange& r) { return v < r.va; });
+    if (it != ranges_.begin())
+        --it;
+    for (; it != ranges_.end() && it->va < end; ++it) {
+        const std::uint64_t lo = std::max(it->va, module.base);
+        const std::uint64_t hi = std::min(it->va + it->size, end);
+        if (lo >= hi)
+            continue;
+        read_file(it->offset + (lo - it->va),
+                  std::span<std::uint8_t>(copy->data() + (lo - module.base), static_cast<std::size_t>(hi - lo)));
+    }
+    return MappedBytes{*copy, copy};
+}
+
+} // namespace peelf
@@ -0,0 +1,145 @@
+#include "pe/coff_object.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace peelf {
+
+namespace {
+
+// Objects with more sections than this are written in /bigobj format
+constexpr std::size_t max_object_sections = 65279;
+
+std::string_view string_at(std::span<const std::uint8_t> strings, std::size_t offset) {
+    if (offset < 4 || offset >= strings.size())
+        return {};
+    const auto* start = reinterpret_cast<const char*>(strings.data() + offset);
+    return {start, strnlen(start, strings.size() - offset)};
+}
+
+} // namespace
+
+std::expected<CoffObject, Error> CoffObject::parse(std::span<const std::uint8_t> bytes) {
+    CoffObject obj(bytes);
+    if (bytes.size() < sizeof(IMAGE_FILE_HEADER_))
+        return std::unexpected(Error{"File too small for a COFF header"});
+    std::memcpy(&obj.header_, bytes.data(), sizeof(obj.header_));
+
+    const auto& h = obj.header_;
+    if (h.Machine == IMAGE_FILE_MACHINE_UNKNOWN && h.NumberOfSections == IMPORT_OBJECT_HDR_SIG2)
+        return std::unexpected(Error{"Import object or /bigobj file, not a regular COFF object"});
+    if (h.NumberOfSections > max_object_sections)
+        return std::unexpected(Error{"Too many COFF sections"});
+
+    const std::size_t section_table = sizeof(IMAGE_FILE_HEADER_) + h.SizeOfOptionalHeader;
+    const std::size_t section_bytes = std::size_t{h.NumberOfSections} * sizeof(IMAGE_SECTION_HEADER_);
+    if (section_table > bytes.size() || bytes.size() - section_table < section_bytes)
+        return std::unexpected(Error{"COFF section table out of range"});
+    obj.sections_ = {reinterpret_cast<const IMAGE_SECTION_HEADER_*>(bytes.data() + section_table),
+                     h.NumberOfSections};
+
+    if (h.PointerToSymbolTable != 0) {
+        const std::size_t offset = h.PointerToSymbolTable;
+        const std::size_t size = std::size_t{h.NumberOfSymbols} * sizeof(IMAGE_SYMBOL_);
+        if (offset > bytes.size() || bytes.size() - offset < size)
+            return std::unexpected(Error{"COFF symbol table out of range"});
+        obj.symbols_ = {reinterpret_cast<const IMAGE_SYMBOL_*>(bytes.data() + offset), h.NumberOfSymbols};
+
+        // The string table follows the symbols and counts its own size field
+        const std::size_t strings = offset + size;
+        std::uint32_t strings_size = 0;
+        if (bytes.size() - strings >= sizeof(strings_size)) {
+            std::memcpy(&strings_size, bytes.data() + strings, sizeof(strings_size));
+            if (strings_size < 4 || strings_size > bytes.size() - strings)
+                return std::unexpected(Error{"COFF string table out of range"});
+            obj.strings_ = bytes.subspan(strings, strings_size);
+        }
+    }
+    return obj;
+}
+
+std::string_view CoffObject::section_name(std::size_t index) const {
+    if (index >= sections_.size())
+        return {};
+    const char* name = sections_[index].Name;
+    const std::string_view short_name(name, strnlen(name, sizeof(sections_[index].Name)));
+    if (short_name.size() < 2 || short_name[0] != '/')
+        return short_name;
+
+    std::size_t offset = 0;
+    for (char c : short_name.substr(1)) {
+        if (c < '0' || c > '9')
+            return short_name;
+        offset = offset * 10 + static_cast<std::size_t>(c - '0');
+    }
+    const auto resolved = string_at(strings_, offset);
+    return resolved.empty() ? short_name : resolved;
+}
+
+std::span<const std::uint8_t> CoffObject::section_data(std::size_t index) const {
+    if (index >= sections_.size())
+        return {};
+    const auto& s = sections_[index];
+    if (s.PointerToRawData == 0 || s.PointerToRawData > bytes_.size())
+        return {};
+    return bytes_.subspan(s.PointerToRawData, std::min<std::size_t>(s.SizeOfRawData, bytes_.size() - s.PointerToRawData));
+}
+
+CoffSymbol CoffObject::symbol(std::size_t index) const {
+    const auto& s = symbols_[index];
+    CoffSymbol out{
+        .name = {},
+        .value = s.Value,
+        .section_number = s.SectionNumber,
+        .type = s.Type,
+        .storage_class = s.StorageClass,
+        .aux_count = s.NumberOfAuxSymbols,
+    };
+
+    // First four bytes zero: the last four are a string table offset
+    std::uint32_t zeroes = 0;
+    std::memcpy(&zeroes, s.Name, sizeof(zeroes));
+    if (zeroes == 0) {
+        std::uint32_t offset = 0;
+        std::memcpy(&offset, s.Name + 4, sizeof(offset));
+        out.name = string_at(strings_, offset);
+    } else {
+        out.name = {s.Name, strnlen(s.Name, sizeof(s.Name))};
+    }
+    return out;
+}
+
+bool is_import_object(std::span<const std::uint8_t> bytes) {
+    IMPORT_OBJECT_HEADER_ h{};
+    if (bytes.size() < sizeof(h))
+        return false;
+    std::memcpy(&h, bytes.data(), sizeof(h));
+    return h.Sig1 == IMAGE_FILE_MACHINE_UNKNOWN && h.Sig2 == IMPORT_OBJECT_HDR_SIG2 && h.Version == 0;
+}
+
+std::expected<CoffImportObject, Error> parse_import_object(std::span<const std::uint8_t> bytes) {
+    if (!is_import_object(bytes))
+        return std::unexpected(Error{"Not an import object"});
+    IMPORT_OBJECT_HEADER_ h{};
+    std::memcpy(&h, bytes.data(), sizeof(h));
+    if (h.SizeOfData > bytes.size() - sizeof(h))
+        return std::unexpected(Error{"Import object data out of range"});
+
+    const auto* names = reinterpret_cast<const char*>(bytes.data() + sizeof(h));
+    const std::size_t symbol_len = strnlen(names, h.SizeOfData);
+    if (symbol_len == h.SizeOfData)
+        return std::unexpected(Error{"Unterminated import object name"});
+    const char* dll = names + symbol_len + 1;
+    const std::size_t dll_len = strnlen(dll, h.SizeOfData - symbol_len - 1);
+
+    return CoffImportObject{
+        .machine = h.Machine,
+        .type = static_cast<std::uint16_t>(h.NameType & 3),
+        .name_type = static_cast<std::uint16_t>((h.NameType >> 2) & 7),
+        .ordinal_or_hint = h.OrdinalOrHint,
+        .symbol = {names, symbol_len},
+        .dll = {dll, dll_len},
+    };
+}
+
+} // namespace peelf
@@ -0,0 +1,291 @@
+#include "pe/pe_authenticode.hpp"
+
+#include <algorithm>
+#include <array>
+#include <optional>
+
+#include "crypto/sha.hpp"
+
+namespace peelf {
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Minimal DER reader: just enough to walk PKCS#7 down to the Authenticode
+// digest. Indefinite lengths (BER) are rejected.
+// ---------------------------------------------------------------------------
+
+constexpr std::uint8_t DER_INTEGER = 0x02;
+constexpr std::uint8_t DER_OCTET_STRING = 0x04;
+constexpr std::uint8_t DER_OID = 0x06;
+constexpr std::uint8_t DER_SEQUENCE = 0x30;
+constexpr std::uint8_t DER_SET = 0x31;
+constexpr std::uint8_t DER_CONTEXT_0 = 0xA0;
+
+struct DerItem {
+    std::uint8_t tag = 0;
+    std::span<const std::uint8_t> content;
+};
+
+class DerReader {
+public:
+    explicit DerReader(std::span<const std::uint8_t> data) : data_(data) {}
+
+    [[nodiscard]] bool empty() const { return data_.empty(); }
+
+    std::optional<DerItem> next() {
+        if (data_.size() < 2)
+            return std::nullopt;
+        const std::uint8_t tag = data_[0];
+        std::size_t len = data_[1];
+        std::size_t header = 2;
+        if (len & 0x80) {
+            const std::size_t n = len & 0x7F;
+            if (n == 0 || n > 4 || data_.size() < 2 + n)
+                return std::nullopt;
+            len = 0;
+            for (std::size_t i = 0; i < n; ++i)
+                len = (len << 8) | data_[2 + i];
+            header += n;
+        }
+        if (len > data_.size() - header)
+            return std::nullopt;
+
+        DerItem item{tag, data_.subspan(header, len)};
+        data_ = data_.subspan(header + len);
+        return item;
+    }
+
+    std::optional<DerItem> expect(std::uint8_t tag) {
+        auto item = next();
+        if (!item || item->tag != tag)
+            return std::nullopt;
+        return item;
+    }
+
+private:
+    std::span<const std::uint8_t> data_;
+};
+
+bool oid_equals(std::span<const std::uint8_t> oid, std::span<const std::uint8_t> expected) {
+    return std::ranges::equal(oid, expected);
+}
+
+// OID content octets
+constexpr std::array<std::uint8_t, 9> OID_PKCS7_SIGNED_DATA = {0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x07, 0x02};
+constexpr std::array<std::uint8_t, 10> OID_SPC_INDIRECT_DATA = {0x2B, 0x06, 0x01, 0x04, 0x01, 0x82, 0x37, 0x02, 0x01, 0x04};
+constexpr std::array<std::uint8_t, 8> OID_MD5 = {0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x02, 0x05};
+constexpr std::array<std::uint8_t, 5> OID_SHA1 = {0x2B, 0x0E, 0x03, 0x02, 0x1A};
+constexpr std::array<std::uint8_t, 9> OID_SHA256 = {0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x01};
+constexpr std::array<std::uint8_t, 9> OID_SHA384 = {0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x02};
+constexpr std::array<std::uint8_t, 9> OID_SHA512 = {0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x03};
+
+DigestAlgorithm algorithm_from_oid(std::span<const std::uint8_t> oid) {
+    if (oid_equals(oid, OID_SHA256)) return DigestAlgorithm::Sha256;
+    if (oid_equals(oid, OID_SHA1))   return DigestAlgorithm::Sha1;
+    if (oid_equals(oid, OID_SHA384)) return DigestAlgorithm::Sha384;
+    if (oid_equals(oid, OID_SHA512)) return DigestAlgorithm::Sha512;
+    if (oid_equals(oid, OID_MD5))    return DigestAlgorithm::Md5;
+    return DigestAlgorithm::Unknown;
+}
+
+// File offset and size of the certificate table; nullopt when unsigned
+std::expected<std::optional<FileRange>, Error> certificate_table(const PeView& pe) {
+    const auto* dir = pe.directory(IMAGE_DIRECTORY_ENTRY_SECURITY);
+    if (!dir)
+        return std::optional<FileRange>{};
+    // The loader never maps the certificate table, and the hash covers file bytes
+    if (pe.is_mapped_image())
+        return std::unexpected(Error{"Certificate table is not present in a mapped image"});
+
+    const std::size_t file_size = pe.bytes().size();
+    const std::size_t off = dir->VirtualAddress;
+    const std::size_t size = dir->Size;
+    if (off > file_size || size > file_size - off)
+        return std::unexpected(Error{"Certificate table out of range"});
+    if (off < pe.data_directory_offset(IMAGE_DIRECTORY_ENTRY_SECURITY) + sizeof(IMAGE_DATA_DIRECTORY_))
+        return std::unexpected(Error{"Certificate table overlaps the headers"});
+    return std::optional<FileRange>{FileRange{off, size}};
+}
+
+template<typename Hasher>
+std::vector<std::uint8_t> hash_ranges(const PeView& pe, const std::vector<FileRange>& ranges) {
+    Hasher h;
+    for (const auto& r : ranges)
+        h.update(pe.bytes().subspan(r.offset, r.size));
+    const auto digest = h.finish();
+    return {digest.begin(), digest.end()};
+}
+
+} // namespace
+
+std::string_view to_string(DigestAlgorithm alg) {
+    switch (alg) {
+        case DigestAlgorithm::Md5:    return "MD5";
+        case DigestAlgorithm::Sha1:   return "SHA-1";
+        case DigestAlgorithm::Sha256: return "SHA-256";
+        case DigestAlgorithm::Sha384: return "SHA-384";
+        case DigestAlgorithm::Sha512: return "SHA-512";
+        default:                      return "Unknown";
+    }
+}
+
+std::expected<std::vector<FileRange>, Error> authenticode_ranges(const PeView& pe) {
+    auto table = certificate_table(pe);
+    if (!table)
+        return std::unexpected(table.error());
+
+    const std::size_t file_size = pe.bytes().size();
+    const std::size_t checksum_off = pe.checksum_offset();
+
+    // Images with fewer than five data directories have no security entry
+    // to skip; the hash then runs straight on after the checksum.
+    std::optional<std::size_t> secdir_off;
+    if (pe.data_directories().size() > IMAGE_DIRECTORY_ENTRY_SECURITY)
+        secdir_off = pe.data_directory_offset(IMAGE_DIRECTORY_ENTRY_SECURITY);
+
+    // Holes to leave out, in file order
+    std::vector<FileRange> holes;
+    holes.push_back({checksum_off, 4});
+    if (secdir_off)
+        holes.push_back({*secdir_off, sizeof(IMAGE_DATA_DIRECTORY_)});
+    if (*table)
+        holes.push_back(**table);
+
+    std::vector<FileRange> ranges;
+    std::size_t pos = 0;
+    for (const auto& hole : holes) {
+        const std::size_t start = std::min(hole.offset, file_size);
+        if (start < pos)
+            return std::unexpected(Error{"Authenticode exclusions overlap"});
+        if (start > pos)
+            ranges.push_back({pos, start - pos});
+        pos = std::min(start + hole.size, file_size);
+    }
+    if (pos < file_size)
+        ranges.push_back({pos, file_size - pos});
+    return ranges;
+}
+
+std::expected<AuthenticodeDigest, Error> compute_authenticode_digest(const PeView& pe, DigestAlgorithm alg) {
+    auto ranges = authenticode_ranges(pe);
+    if (!ranges)
+        return std::unexpected(ranges.error());
+
+    AuthenticodeDigest out;
+    out.algorithm = alg;
+    switch (alg) {
+        case DigestAlgorithm::Sha1:
+            out.digest = hash_ranges<Sha1>(pe, *ranges);
+            break;
+        case DigestAlgorithm::Sha256:
+            out.digest = hash_ranges<Sha256>(pe, *ranges);
+            break;
+        default:
+            return std::unexpected(Error{"Unsupported Authenticode digest algorithm"});
+    }
+    return out;
+}
+
+std::expected<std::vector<PeCertificate>, Error> read_certificates(const PeView& pe) {
+    auto table = certificate_table(pe);
+    if (!table)
+        return std::unexpected(table.error());
+
+    std::vector<PeCertificate> out;
+    if (!*table)
+        return out;
+
+    const std::size_t end = (*table)->offset + (*table)->size;
+    for (std::size_t off = (*table)->offset; end - off >= sizeof(WIN_CERTIFICATE_);) {
+        if (out.size() >= pe.limits().max_table_entries)
+            return std::unexpected(Error{"Certificate walk exceeded entry budget"});
+
+        WIN_CERTIFICATE_ wc{};
+        if (!pe.read(off, wc))
+            break;
+        if (wc.dwLength < sizeof(WIN_CERTIFICATE_) || wc.dwLength > end - off)
+            return std::unexpected(Error{"Malformed WIN_CERTIFICATE entry"});
+
+        out.push_back(PeCertificate{
+            .offset = off,
+            .revision = wc.wRevision,
+            .type = wc.wCertificateType,
+            .data = pe.bytes().subspan(off + sizeof(WIN_CERTIFICATE_), wc.dwLength - sizeof(WIN_CERTIFICATE_)),
+        });
+
+        // Entries are quadword aligned
+        const std::size_t advance = (std::size_t{wc.dwLength} + 7) & ~std::size_t{7};
+        if (advance > end - off)
+            break;
+        off += advance;
+    }
+    return out;
+}
+
+std::expected<AuthenticodeDigest, Error> read_embedded_digest(const PeCertificate& cert) {
+    if (cert.type != WIN_CERT_TYPE_PKCS_SIGNED_DATA)
+        return std::unexpected(Error{"Certificate is not PKCS#7 SignedData"});
+
+    const auto malformed = [] { return std::unexpected(Error{"Malformed Authenticode signature"}); };
+
+    // ContentInfo ::= SEQUENCE { contentType OID, content [0] EXPLICIT SignedData }
+    auto content_info = DerReader(cert.data).expect(DER_SEQUENCE);
+    if (!content_info)
+        return malformed();
+    DerReader ci(content_info->content);
+    auto ci_type = ci.expect(DER_OID);
+    if (!ci_type || !oid_equals(ci_type->content, OID_PKCS7_SIGNED_DATA))
+        return malformed();
+    auto ci_content = ci.expect(DER_CONTEXT_0);
+    if (!ci_content)
+        return malformed();
+
+    // SignedData ::= SEQUENCE { version, digestAlgorithms SET, contentInfo, ... }
+    auto signed_data = DerReader(ci_content->content).expect(DER_SEQUENCE);
+    if (!signed_data)
+        return malformed();
+    DerReader sd(signed_data->content);
+    if (!sd.expect(DER_INTEGER) || !sd.expect(DER_SET))
+        return malformed();
+    auto encap = sd.expect(DER_SEQUENCE);
+    if (!encap)
+        return malformed();
+
+    // contentInfo ::= SEQUENCE { SPC_INDIRECT_DATA_OBJID, [0] EXPLICIT SpcIndirectDataContent }
+    DerReader ec(encap->content);
+    auto ec_type = ec.expect(DER_OID);
+    if (!ec_type || !oid_equals(ec_type->content, OID_SPC_INDIRECT_DATA))
+        return std::unexpected(Error{"Signature does not carry SpcIndirectDataContent"});
+    auto ec_content = ec.expect(DER_CONTEXT_0);
+    if (!ec_content)
+        return malformed();
+
+    // SpcIndirectDataContent ::= SEQUENCE { data SEQUENCE, messageDigest DigestInfo }
+    auto indirect = DerReader(ec_content->content).expect(DER_SEQUENCE);
+    if (!indirect)
+        return malformed();
+    DerReader id(indirect->content);
+    if (!id.expect(DER_SEQUENCE))
+        return malformed();
+    auto digest_info = id.expect(DER_SEQUENCE);
+    if (!digest_info)
+        return malformed();
+
+    // DigestInfo ::= SEQUENCE { AlgorithmIdentifier, digest OCTET STRING }
+    DerReader di(digest_info->content);
+    auto alg_id = di.expect(DER_SEQUENCE);
+    if (!alg_id)
+        return malformed();
+    auto alg_oid = DerReader(alg_id->content).expect(DER_OID);
+    auto digest = di.expect(DER_OCTET_STRING);
+    if (!alg_oid || !digest)
+        return malformed();
+
+    AuthenticodeDigest out;
+    out.algorithm = algorithm_from_oid(alg_oid->content);
+    out.digest.assign(digest->content.begin(), digest->content.end());
+    return out;
+}
+
+} // namespace peelf
@@ -0,0 +1,59 @@
+#include "pe/pe_byte_stats.hpp"
+
+#include <algorithm>
+#include <span>
+
+#include "pe/pe_section_layout.hpp"
+
+namespace peelf {
+
+namespace {
+
+PeRegionStats clipped_region(std::uint64_t offset, std::uint64_t size, std::uint64_t file_size) {
+    PeRegionStats r;
+    r.offset = std::min(offset, file_size);
+    r.size = std::min(size, file_size - r.offset);
+    return r;
+}
+
+} // namespace
+
+PeByteStats compute_byte_stats(const PeView& pe, std::size_t threads) {
+    PeByteStats out;
+    const auto bytes = pe.bytes();
+    const std::uint64_t file_size = bytes.size();
+
+    out.headers = clipped_region(0, pe.size_of_headers(), file_size);
+    out.sections.reserve(pe.sections().size());
+    for (const auto& s : pe.sections()) {
+        if (pe.is_mapped_image()) {
+            const std::uint64_t size = s.VirtualSize ? s.VirtualSize : s.SizeOfRawData;
+            out.sections.push_back(clipped_region(s.VirtualAddress, size, file_size));
+        } else {
+            out.sections.push_back(clipped_region(s.PointerToRawData, s.SizeOfRawData, file_size));
+        }
+    }
+    const std::uint64_t overlay = raw_data_end(pe);
+    out.overlay = clipped_region(overlay, file_size - overlay, file_size);
+
+    std::vector<PeRegionStats*> regions;
+    regions.reserve(out.sections.size() + 2);
+    regions.push_back(&out.headers);
+    for (auto& s : out.sections)
+        regions.push_back(&s);
+    regions.push_back(&out.overlay);
+
+    std::vector<std::span<const std::uint8_t>> spans;
+    spans.reserve(regions.size());
+    for (const auto* r : regions)
+        spans.push_back(bytes.subspan(static_cast<std::size_t>(r->offset), static_cast<std::size_t>(r->size)));
+
+    const auto histograms = byte_histograms(spans, threads);
+    for (std::size_t i = 0; i < regions.size(); ++i) {
+        regions[i]->histogram = histograms[i];
+        regions[i]->entropy = shannon_entropy(histograms[i]);
+    }
+    return out;
+}
+
+} // namespace peelf
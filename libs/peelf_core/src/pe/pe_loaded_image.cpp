@@ -0,0 +1,338 @@
+#include "pe/pe_loaded_image.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mapping/file_mapping.hpp"
+#include "pe/pe_relocations.hpp"
+#include "peelf/parallel.hpp"
+
+namespace peelf {
+
+namespace {
+
+using Backend = NativeFileMappingBackend;
+
+constexpr std::size_t page_size = 0x1000;
+
+// Copies are split into pieces of this size so that one large section
+// still spreads over every worker
+constexpr std::size_t copy_piece_size = std::size_t{1} << 20;
+
+struct CopyPiece {
+    std::size_t dst = 0;            // offset in the image
+    std::size_t src = 0;            // offset in the file
+    std::size_t size = 0;
+};
+
+std::uint64_t align_up(std::uint64_t value, std::uint64_t alignment) {
+    return alignment ? (value + alignment - 1) / alignment * alignment : value;
+}
+
+void split_copy(std::vector<CopyPiece>& out, std::size_t dst, std::size_t src, std::size_t size) {
+    for (std::size_t done = 0; done < size; done += copy_piece_size)
+        out.push_back(CopyPiece{dst + done, src + done, std::min(copy_piece_size, size - done)});
+}
+
+// OR-reduction without an early exit, which compilers vectorize
+bool all_zero(const std::uint8_t* p, std::size_t n) {
+    std::uint8_t acc = 0;
+    for (std::size_t i = 0; i < n; ++i)
+        acc |= p[i];
+    return acc == 0;
+}
+
+// Page by page, leaving image pages that would only receive zeros
+// untouched. Only valid when nothing else writes to the same pages.
+void copy_skipping_zero_pages(std::uint8_t* image, const std::uint8_t* file, const CopyPiece& piece) {
+    for (std::size_t done = 0; done < piece.size;) {
+        const std::size_t n = std::min(piece.size - done, page_size - (piece.dst + done) % page_size);
+        const std::uint8_t* src = file + piece.src + done;
+        if (!all_zero(src, n))
+            std::memcpy(image + piece.dst + done, src, n);
+        done += n;
+    }
+}
+
+// Raw data the loader maps for a section: SizeOfRawData, capped at the
+// aligned VirtualSize and clipped to the file and the image
+std::size_t section_copy_size(const PeView& pe, const IMAGE_SECTION_HEADER_& s, std::size_t image_size) {
+    std::uint64_t size = s.SizeOfRawData;
+    if (s.VirtualSize != 0)
+        size = std::min(size, align_up(s.VirtualSize, pe.section_alignment()));
+    const std::size_t file_size = pe.bytes().size();
+    if (s.PointerToRawData >= file_size || s.VirtualAddress >= image_size)
+        return 0;
+    size = std::min<std::uint64_t>(size, file_size - s.PointerToRawData);
+    size = std::min<std::uint64_t>(size, image_size - s.VirtualAddress);
+    return static_cast<std::size_t>(size);
+}
+
+template<typename T, typename F>
+bool patch(std::span<std::uint8_t> image, std::uint64_t offset, F&& f) {
+    if (offset > image.size() || image.size() - offset < sizeof(T))
+        return false;
+    T value;
+    std::memcpy(&value, image.data() + offset, sizeof(T));
+    value = f(value);
+    std::memcpy(image.data() + offset, &value, sizeof(T));
+    return true;
+}
+
+// Pointer-sized fixups of one block: a gather of the targets, an add and
+// a scatter back. AVX2 and NEON have no scatter, and entries may alias or
+// straddle each other, so this stays a scalar loop in entry order.
+template<typename T>
+void fixup_block(std::uint8_t* page, const PeRelocationBlock& block, std::size_t n, T delta) {
+    for (std::size_t i = 0; i < n; ++i) {
+        std::uint8_t* p = page + (block.entry(i) & 0x0FFFu);
+        T value;
+        std::memcpy(&value, p, sizeof(T));
+        value = static_cast<T>(value + delta);
+        std::memcpy(p, &value, sizeof(T));
+    }
+}
+
+// MOVW / MOVT immediates (imm4:imm12 in ARM, imm4:i:imm3:imm8 in Thumb-2)
+std::uint32_t arm_mov_imm(std::uint32_t insn) {
+    return ((insn >> 4) & 0xF000u) | (insn & 0x0FFFu);
+}
+
+std::uint32_t arm_mov_set(std::uint32_t insn, std::uint32_t imm) {
+    return (insn & 0xFFF0F000u) | ((imm & 0xF000u) << 4) | (imm & 0x0FFFu);
+}
+
+// A Thumb-2 instruction read as one little-endian word: first halfword low
+std::uint32_t thumb_mov_imm(std::uint32_t insn) {
+    const std::uint32_t hw1 = insn & 0xFFFFu;
+    const std::uint32_t hw2 = insn >> 16;
+    return ((hw1 & 0xFu) << 12) | (((hw1 >> 10) & 1u) << 11) | (((hw2 >> 12) & 7u) << 8) | (hw2 & 0xFFu);
+}
+
+std::uint32_t thumb_mov_set(std::uint32_t insn, std::uint32_t imm) {
+    const std::uint32_t hw1 = (insn & 0xFBF0u) | (imm >> 12) | (((imm >> 11) & 1u) << 10);
+    const std::uint32_t hw2 = ((insn >> 16) & 0x8F00u) | (((imm >> 8) & 7u) << 12) | (imm & 0xFFu);
+    return hw1 | (hw2 << 16);
+}
+
+template<typename Decode, typename Encode>
+bool patch_mov32(std::span<std::uint8_t> image, std::uint64_t offset, std::uint32_t delta, Decode decode, Encode encode) {
+    return patch<std::uint64_t>(image, offset, [&](std::uint64_t pair) {
+        const auto movw = static_cast<std::uint32_t>(pair);
+        const auto movt = static_cast<std::uint32_t>(pair >> 32);
+        const std::uint32_t value = ((decode(movt) << 16) | decode(movw)) + delta;
+        return std::uint64_t{encode(movw, value & 0xFFFFu)} | (std::uint64_t{encode(movt, value >> 16)} << 32);
+    });
+}
+
+// Entry-by-entry path for mixed blocks and pages near the end of the image
+std::expected<std::size_t, Error> apply_block_slow(std::span<std::uint8_t> image, const PeRelocationBlock& block,
+                                                   std::uint64_t delta, std::uint16_t machine) {
+    const auto delta32 = static_cast<std::uint32_t>(delta);
+    const bool arm = machine == IMAGE_FILE_MACHINE_ARMNT;
+    const std::size_t n = block.count();
+    std::size_t applied = 0;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::uint16_t e = block.entry(i);
+        const auto type = static_cast<std::uint8_t>(e >> 12);
+        const std::uint64_t off = std::uint64_t{block.page_rva} + (e & 0x0FFFu);
+        bool ok = true;
+
+        switch (type) {
+            case IMAGE_REL_BASED_ABSOLUTE:
+                continue;
+            case IMAGE_REL_BASED_HIGH:
+                ok = patch<std::uint16_t>(image, off, [&](std::uint16_t v) {
+                    return static_cast<std::uint16_t>(v + (delta32 >> 16));
+                });
+                break;
+            case IMAGE_REL_BASED_LOW:
+                ok = patch<std::uint16_t>(image, off, [&](std::uint16_t v) {
+                    return static_cast<std::uint16_t>(v + delta32);
+                });
+                break;
+            case IMAGE_REL_BASED_HIGHLOW:
+                ok = patch<std::uint32_t>(image, off, [&](std::uint32_t v) { return v + delta32; });
+                break;
+            case IMAGE_REL_BASED_HIGHADJ: {
+                if (i + 1 >= n)
+                    return std::unexpected(Error{"Truncated HIGHADJ base relocation"});
+                const auto low = static_cast<std::int16_t>(block.entry(++i));
+                ok = patch<std::uint16_t>(image, off, [&](std::uint16_t v) {
+                    const std::uint32_t full = (std::uint32_t{v} << 16) + static_cast<std::uint32_t>(low) + delta32;
+                    return static_cast<std::uint16_t>((full + 0x8000u) >> 16);
+                });
+                break;
+            }
+            case IMAGE_REL_BASED_ARM_MOV32:
+                if (!arm)
+                    return std::unexpected(Error{"Unsupported base relocation type 5"});
+                ok = patch_mov32(image, off, delta32, arm_mov_imm, arm_mov_set);
+                break;
+            case IMAGE_REL_BASED_THUMB_MOV32:
+                if (!arm)
+                    return std::unexpected(Error{"Unsupported base relocation type 7"});
+                ok = patch_mov32(image, off, delta32, thumb_mov_imm, thumb_mov_set);
+                break;
+            case IMAGE_REL_BASED_DIR64:
+                ok = patch<std::uint64_t>(image, off, [&](std::uint64_t v) { return v + delta; });
+                break;
+            default:
+                return std::unexpected(Error{"Unsupported base relocation type " + std::to_string(type)});
+        }
+        if (!ok)
+            return std::unexpected(Error{"Base relocation target out of range"});
+        ++applied;
+    }
+    return applied;
+}
+
+std::expected<std::size_t, Error> apply_relocations(std::span<std::uint8_t> image, const PeView& pe,
+                                                    std::uint64_t delta) {
+    auto blocks = read_base_relocation_blocks(pe);
+    if (!blocks)
+        return std::unexpected(blocks.error());
+
+    std::size_t applied = 0;
+    for (const auto& block : *blocks) {
+        // MSVC pads almost every block to a multiple of four bytes with an
+        // ABSOLUTE entry. It patches nothing, so it is dropped before the
+        // uniformity check rather than sending the block down the slow path.
+        // The slow path still walks the whole block, HIGHADJ operands too.
+        std::size_t n = block.count();
+        while (n > 0 && (block.entry(n - 1) >> 12) == IMAGE_REL_BASED_ABSOLUTE)
+            --n;
+        if (n == 0)
+            continue;
+
+        // Linkers emit one type per block in practice. When every entry
+        // has the same pointer-sized type and no target can leave the
+        // image, the block needs neither per-entry dispatch nor bounds
+        // checks.
+        const std::uint16_t first = block.entry(0);
+        std::uint16_t mixed = 0;
+        for (std::size_t i = 1; i < n; ++i)
+            mixed |= static_cast<std::uint16_t>(block.entry(i) ^ first);
+        const auto type = static_cast<std::uint8_t>(first >> 12);
+        const bool uniform = (mixed & 0xF000u) == 0;
+        const std::uint64_t page_end = std::uint64_t{block.page_rva} + page_size + sizeof(std::uint64_t);
+
+        if (uniform && page_end <= image.size() && type == IMAGE_REL_BASED_DIR64) {
+            fixup_block<std::uint64_t>(image.data() + block.page_rva, block, n, delta);
+            applied += n;
+        } else if (uniform && page_end <= image.size() && type == IMAGE_REL_BASED_HIGHLOW) {
+            fixup_block<std::uint32_t>(image.data() + block.page_rva, block, n, static_cast<std::uint32_t>(delta));
+            applied += n;
+        } else {
+            auto done = apply_block_slow(image, block, delta, pe.machine());
+            if (!done)
+                return std::unexpected(done.error());
+            applied += *done;
+        }
+    }
+    return applied;
+}
+
+} // namespace
+
+PeLoadedImage::~PeLoadedImage() {
+    release();
+}
+
+PeLoadedImage::PeLoadedImage(PeLoadedImage&& other) noexcept {
+    *this = std::move(other);
+}
+
+PeLoadedImage& PeLoadedImage::operator=(PeLoadedImage&& other) noexcept {
+    if (this != &other) {
+        release();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        base_ = other.base_;
+        delta_ = other.delta_;
+        relocations_ = other.relocations_;
+    }
+    return *this;
+}
+
+void PeLoadedImage::release() noexcept {
+    if (data_)
+        (void)Backend::unmap_anonymous(data_, size_);
+    data_ = nullptr;
+    size_ = 0;
+}
+
+std::expected<PeLoadedImage, Error> PeLoadedImage::build(const PeView& pe, std::uint64_t base, std::size_t threads) {
+    const std::size_t image_size = pe.size_of_image();
+    if (image_size == 0)
+        return std::unexpected(Error{"SizeOfImage is zero"});
+    if (!pe.is_pe32_plus() && base > 0xFFFFFFFFu)
+        return std::unexpected(Error{"Base does not fit a PE32 image"});
+
+    const std::uint64_t delta = base - pe.image_base();
+    if (delta != 0 && (pe.characteristics() & IMAGE_FILE_RELOCS_STRIPPED))
+        return std::unexpected(Error{"Relocations are stripped; the image only loads at its preferred base"});
+
+    PeLoadedImage out;
+    void* memory = nullptr;
+    if (auto ec = Backend::map_anonymous(image_size, &memory); ec)
+        return std::unexpected(Error{"Cannot reserve image memory: " + ec.message()});
+    out.data_ = static_cast<std::uint8_t*>(memory);
+    out.size_ = image_size;
+    out.base_ = base;
+    out.delta_ = static_cast<std::int64_t>(delta);
+
+    const auto file = pe.bytes();
+    std::vector<CopyPiece> pieces;
+    bool disjoint = true;
+
+    if (pe.is_mapped_image()) {
+        split_copy(pieces, 0, 0, std::min(file.size(), image_size));
+    } else {
+        const std::size_t headers = std::min({std::size_t{pe.size_of_headers()}, file.size(), image_size});
+        split_copy(pieces, 0, 0, headers);
+        for (const auto& s : pe.sections()) {
+            if (s.VirtualAddress < headers)
+                disjoint = false;
+            split_copy(pieces, s.VirtualAddress, s.PointerToRawData, section_copy_size(pe, s, image_size));
+        }
+        disjoint = disjoint && pe.sections_disjoint();
+    }
+
+    // Pieces of overlapping sections must land in table order, and zero
+    // pages may overwrite an earlier section, so they are copied whole
+    if (disjoint) {
+        parallel_for(pieces.size(), [&](std::size_t i) {
+            copy_skipping_zero_pages(out.data_, file.data(), pieces[i]);
+        }, threads);
+    } else {
+        for (const auto& piece : pieces)
+            std::memcpy(out.data_ + piece.dst, file.data() + piece.src, piece.size);
+    }
+
+    const std::span<std::uint8_t> image{out.data_, out.size_};
+    if (delta != 0) {
+        auto applied = apply_relocations(image, pe, delta);
+        if (!applied)
+            return std::unexpected(applied.error());
+        out.relocations_ = *applied;
+    }
+
+    // The loader records the actual base in the mapped header
+    pe.dispatch([&](auto traits) {
+        using Traits = decltype(traits);
+        using opt_t = typename Traits::optional_header;
+        const auto value = static_cast<typename Traits::pointer_type>(base);
+        const std::size_t off = pe.optional_header_offset() + offsetof(opt_t, ImageBase);
+        if (off + sizeof(value) <= std::min(std::size_t{pe.size_of_headers()}, image.size()))
+            std::memcpy(image.data() + off, &value, sizeof(value));
+    });
+
+    return out;
+}
+
+} // namespace peelf
@@ -2,6 +2,8 @@
 
 #include <cstdint>
 
+#include "pe/pe_parser.h"
+
 namespace peelf {
 
 static std::uint16_t read_u16_le(std::span<const std::uint8_t> b, std::size_t off) {
@@ -16,6 +18,9 @@ static std::uint32_t read_u32_le(std::span<const std::uint8_t> b, std::size_t of
         (static_cast<std::uint32_t>(b[off + 3]) << 24));
 }
 
+// Only the signatures and the headers it reports are checked, and the
+// optional header magic is passed through whatever it is; PeView::parse is
+// the strict parser.
 std::expected<FileInfo, Error> parse_pe_bytes(std::span<const std::uint8_t> bytes) {
     if (bytes.size() < 0x40) {
         return std::unexpected(Error{"PE file too small for DOS header"});
@@ -24,7 +29,7 @@ std::expected<FileInfo, Error> parse_pe_bytes(std::span<const std::uint8_t> byte
         return std::unexpected(Error{"Missing MZ header"});
     }
 
-    const std::uint32_t e_lfanew = read_u32_le(bytes, 0x3C);
+    const std::size_t e_lfanew = read_u32_le(bytes, 0x3C);
     if (e_lfanew + 4 + 20 > bytes.size()) {
         return std::unexpected(Error{"Invalid e_lfanew (out of range)"});
     }
@@ -0,0 +1,67 @@
+#include "pe/pe_relocations.hpp"
+
+namespace peelf {
+
+std::expected<std::vector<PeRelocationBlock>, Error> read_base_relocation_blocks(const PeView& pe) {
+    std::vector<PeRelocationBlock> out;
+    const auto* dir = pe.directory(IMAGE_DIRECTORY_ENTRY_BASERELOC);
+    if (!dir)
+        return out;
+
+    const auto table = pe.rva_span(dir->VirtualAddress, dir->Size);
+    if (table.empty())
+        return std::unexpected(Error{"Base relocation directory is not backed by file data"});
+
+    Deadline deadline = pe.deadline();
+    std::size_t entries = 0;
+    for (std::size_t off = 0; table.size() - off >= sizeof(IMAGE_BASE_RELOCATION_);) {
+        if (deadline.expired())
+            return std::unexpected(Error{"Base relocation walk exceeded time budget"});
+
+        IMAGE_BASE_RELOCATION_ hdr{};
+        std::memcpy(&hdr, table.data() + off, sizeof(hdr));
+        if (hdr.SizeOfBlock == 0)
+            break;
+        if (hdr.SizeOfBlock < sizeof(hdr) || hdr.SizeOfBlock > table.size() - off)
+            return std::unexpected(Error{"Malformed base relocation block"});
+
+        PeRelocationBlock block;
+        block.page_rva = hdr.VirtualAddress;
+        block.entries = table.subspan(off + sizeof(hdr), (hdr.SizeOfBlock - sizeof(hdr)) & ~std::size_t{1});
+        entries += block.count();
+        if (entries > pe.limits().max_table_entries)
+            return std::unexpected(Error{"Base relocation walk exceeded entry budget"});
+        out.push_back(block);
+        off += hdr.SizeOfBlock;
+    }
+    return out;
+}
+
+std::expected<std::vector<PeBaseRelocation>, Error> read_base_relocations(const PeView& pe) {
+    auto blocks = read_base_relocation_blocks(pe);
+    if (!blocks)
+        return std::unexpected(blocks.error());
+
+    std::size_t total = 0;
+    for (const auto& b : *blocks)
+        total += b.count();
+
+    std::vector<PeBaseRelocation> out;
+    out.reserve(total);
+    for (const auto& b : *blocks) {
+        for (std::size_t i = 0; i < b.count(); ++i) {
+            const std::uint16_t e = b.entry(i);
+            PeBaseRelocation r;
+            r.rva = b.page_rva + (e & 0x0FFFu);
+            r.type = static_cast<std::uint8_t>(e >> 12);
+            if (r.type == IMAGE_REL_BASED_ABSOLUTE)
+                continue;
+            if (r.type == IMAGE_REL_BASED_HIGHADJ && i + 1 < b.count())
+                r.param = b.entry(++i);
+            out.push_back(r);
+        }
+    }
+    return out;
+}
+
+} // namespace peelf
@@ -0,0 +1,148 @@
+#include "pe/pe_section_layout.hpp"
+
+#include <algorithm>
+
+#include "peelf/interval_tree.hpp"
+
+namespace peelf {
+
+namespace {
+
+using SectionTree = IntervalTree<std::uint32_t>;
+
+std::uint64_t align_up(std::uint64_t value, std::uint64_t alignment) {
+    return alignment ? (value + alignment - 1) / alignment * alignment : value;
+}
+
+// What the loader maps: VirtualSize, or SizeOfRawData when VirtualSize is
+// zero, rounded up to SectionAlignment
+SectionTree::Interval virtual_range(const PeView& pe, const IMAGE_SECTION_HEADER_& s, std::uint32_t index) {
+    const std::uint64_t size = s.VirtualSize ? s.VirtualSize : s.SizeOfRawData;
+    return {s.VirtualAddress, s.VirtualAddress + align_up(size, pe.section_alignment()), index};
+}
+
+SectionTree::Interval raw_range(const IMAGE_SECTION_HEADER_& s, std::uint32_t index) {
+    return {s.PointerToRawData, std::uint64_t{s.PointerToRawData} + s.SizeOfRawData, index};
+}
+
+// First overlapping interval other than the section's own
+void report_overlap(const SectionTree& tree, const SectionTree::Interval& range, PeSectionIssueKind kind,
+                    std::vector<PeSectionIssue>& out) {
+    tree.overlapping(range.begin, range.end, [&](const SectionTree::Interval& other) {
+        if (other.value == range.value)
+            return true;
+        out.push_back(PeSectionIssue{kind, range.value, other.value, std::max(range.begin, other.begin),
+                                     std::min(range.end, other.end)});
+        return false;
+    });
+}
+
+void report_gaps(const SectionTree& tree, std::uint64_t cursor, PeSectionIssueKind kind,
+                 std::vector<PeSectionIssue>& out) {
+    for (const auto& range : tree.intervals()) {
+        if (range.begin == range.end)
+            continue;
+        if (range.begin > cursor)
+            out.push_back(PeSectionIssue{kind, range.value, std::nullopt, cursor, range.begin});
+        cursor = std::max(cursor, range.end);
+    }
+}
+
+} // namespace
+
+std::string_view to_string(PeSectionIssueKind kind) {
+    switch (kind) {
+        case PeSectionIssueKind::VirtualOverlap:    return "Overlaps another section in memory";
+        case PeSectionIssueKind::RawOverlap:        return "Shares raw data with another section";
+        case PeSectionIssueKind::VirtualGap:        return "Unmapped gap before the section";
+        case PeSectionIssueKind::RawGap:            return "Unreferenced file bytes before the section";
+        case PeSectionIssueKind::VirtualInHeaders:  return "Mapped over the headers";
+        case PeSectionIssueKind::RawInHeaders:      return "Raw data inside the headers";
+        case PeSectionIssueKind::PastSizeOfImage:   return "Extends past SizeOfImage";
+        case PeSectionIssueKind::PastEndOfFile:     return "Raw data past the end of the file";
+        case PeSectionIssueKind::VirtualMisaligned: return "VirtualAddress not SectionAlignment-aligned";
+        case PeSectionIssueKind::RawMisaligned:     return "Raw data not FileAlignment-aligned";
+    }
+    return "Unknown";
+}
+
+std::uint64_t raw_data_end(const PeView& pe) {
+    const std::uint64_t file_size = pe.bytes().size();
+    if (pe.is_mapped_image())
+        return file_size;
+    std::uint64_t end = pe.size_of_headers();
+    for (const auto& s : pe.sections()) {
+        if (s.SizeOfRawData != 0)
+            end = std::max(end, std::uint64_t{s.PointerToRawData} + s.SizeOfRawData);
+    }
+    return std::min(end, file_size);
+}
+
+PeSectionLayout analyze_section_layout(const PeView& pe) {
+    PeSectionLayout out;
+    const auto sections = pe.sections();
+    const bool file_layout = !pe.is_mapped_image();
+    const std::uint64_t file_size = pe.bytes().size();
+    const std::uint64_t headers = pe.size_of_headers();
+    const std::uint32_t section_alignment = pe.section_alignment();
+    const std::uint32_t file_alignment = pe.file_alignment();
+
+    std::vector<SectionTree::Interval> virtual_ranges;
+    std::vector<SectionTree::Interval> raw_ranges;
+    virtual_ranges.reserve(sections.size());
+    if (file_layout)
+        raw_ranges.reserve(sections.size());
+    for (std::uint32_t i = 0; i < sections.size(); ++i) {
+        virtual_ranges.push_back(virtual_range(pe, sections[i], i));
+        if (file_layout)
+            raw_ranges.push_back(raw_range(sections[i], i));
+    }
+    const SectionTree virtual_tree(virtual_ranges);
+    const SectionTree raw_tree(raw_ranges);
+
+    for (std::uint32_t i = 0; i < sections.size(); ++i) {
+        const auto& s = sections[i];
+        const auto& v = virtual_ranges[i];
+
+        report_overlap(virtual_tree, v, PeSectionIssueKind::VirtualOverlap, out.issues);
+        if (v.begin < headers && v.begin < v.end)
+            out.issues.push_back({PeSectionIssueKind::VirtualInHeaders, i, std::nullopt, v.begin,
+                                  std::min(v.end, headers)});
+        if (v.end > pe.size_of_image())
+            out.issues.push_back({PeSectionIssueKind::PastSizeOfImage, i, std::nullopt,
+                                  std::max<std::uint64_t>(v.begin, pe.size_of_image()), v.end});
+        if (section_alignment && s.VirtualAddress % section_alignment)
+            out.issues.push_back({PeSectionIssueKind::VirtualMisaligned, i, std::nullopt, v.begin, v.end});
+
+        if (!file_layout || s.SizeOfRawData == 0)
+            continue;
+        const auto& r = raw_ranges[i];
+
+        report_overlap(raw_tree, r, PeSectionIssueKind::RawOverlap, out.issues);
+        if (r.begin < headers)
+            out.issues.push_back({PeSectionIssueKind::RawInHeaders, i, std::nullopt, r.begin,
+                                  std::min(r.end, headers)});
+        if (r.end > file_size)
+            out.issues.push_back({PeSectionIssueKind::PastEndOfFile, i, std::nullopt,
+                                  std::max(r.begin, file_size), r.end});
+        if (file_alignment && (s.PointerToRawData % file_alignment || s.SizeOfRawData % file_alignment))
+            out.issues.push_back({PeSectionIssueKind::RawMisaligned, i, std::nullopt, r.begin, r.end});
+    }
+
+    // Sections must follow the headers and each other without holes in
+    // memory; holes in the file are where appended code and data hide
+    report_gaps(virtual_tree, align_up(headers, section_alignment), PeSectionIssueKind::VirtualGap, out.issues);
+    if (file_layout)
+        report_gaps(raw_tree, headers, PeSectionIssueKind::RawGap, out.issues);
+
+    std::stable_sort(out.issues.begin(), out.issues.end(), [](const PeSectionIssue& a, const PeSectionIssue& b) {
+        return a.section != b.section ? a.section < b.section : a.kind < b.kind;
+    });
+
+    out.raw_end = raw_data_end(pe);
+    out.overlay_offset = out.raw_end;
+    out.overlay_size = file_size - out.raw_end;
+    return out;
+}
+
+} // namespace peelf
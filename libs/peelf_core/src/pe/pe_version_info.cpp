@@ -0,0 +1,202 @@
+#include "pe/pe_version_info.hpp"
+
+#include <cstring>
+#include <string>
+
+#include "peelf/utf16.hpp"
+
+namespace peelf {
+
+namespace {
+
+constexpr std::uint32_t RT_VERSION = 16;
+constexpr std::uint32_t RESOURCE_SUBDIR_FLAG = 0x80000000u;
+constexpr std::uint32_t VS_FFI_SIGNATURE = 0xFEEF04BDu;
+constexpr std::size_t MAX_RESOURCE_ENTRIES = 4096;
+
+constexpr std::size_t align4(std::size_t v) { return (v + 3) & ~std::size_t{3}; }
+
+std::uint16_t load_u16(std::span<const std::uint8_t> b, std::size_t off) {
+    std::uint16_t v = 0;
+    std::memcpy(&v, b.data() + off, sizeof(v));
+    return v;
+}
+
+// Finds the entry with the given integer ID, or the first entry when id is
+// empty, in the resource directory at dir_off (relative to the section base).
+std::optional<std::uint32_t> find_resource_entry(const PeView& pe, std::uint32_t base_rva,
+                                                 std::uint32_t dir_off,
+                                                 std::optional<std::uint32_t> id) {
+    IMAGE_RESOURCE_DIRECTORY_ dir{};
+    if (!pe.read_rva(base_rva + dir_off, dir))
+        return std::nullopt;
+
+    const std::size_t named = dir.NumberOfNamedEntries;
+    const std::size_t total = std::min(named + dir.NumberOfIdEntries, MAX_RESOURCE_ENTRIES);
+    const std::uint32_t entries_rva = base_rva + dir_off + sizeof(IMAGE_RESOURCE_DIRECTORY_);
+
+    for (std::size_t i = id ? named : 0; i < total; ++i) {
+        IMAGE_RESOURCE_DIRECTORY_ENTRY_ e{};
+        if (!pe.read_rva(entries_rva + static_cast<std::uint32_t>(i * sizeof(e)), e))
+            return std::nullopt;
+        if (!id || e.Name == *id)
+            return e.OffsetToData;
+    }
+    return std::nullopt;
+}
+
+// One node of the VS_VERSIONINFO tree:
+//   WORD wLength; WORD wValueLength; WORD wType; WCHAR szKey[]; pad; Value; pad; Children
+struct VersionBlock {
+    std::span<const std::uint8_t> key;      // UTF-16LE, no terminator
+    std::span<const std::uint8_t> value;
+    std::span<const std::uint8_t> value_to_end;   // value start .. end of block
+    std::span<const std::uint8_t> children;
+    std::size_t length = 0;                 // wLength
+};
+
+std::optional<VersionBlock> parse_block(std::span<const std::uint8_t> buf, std::size_t off) {
+    if (off > buf.size() || buf.size() - off < 6)
+        return std::nullopt;
+    const std::size_t length = load_u16(buf, off);
+    if (length < 6 || length > buf.size() - off)
+        return std::nullopt;
+
+    const auto block = buf.subspan(off, length);
+    const std::size_t value_len = load_u16(block, 2);
+    const bool is_text = load_u16(block, 4) == 1;
+
+    std::size_t key_end = 6;
+    while (key_end + 2 <= block.size() && load_u16(block, key_end) != 0)
+        key_end += 2;
+    if (key_end + 2 > block.size())
+        return std::nullopt;
+
+    VersionBlock vb{};
+    vb.length = length;
+    vb.key = block.subspan(6, key_end - 6);
+
+    const std::size_t value_off = std::min(align4(key_end + 2), block.size());
+    const std::size_t value_bytes = std::min(is_text ? value_len * 2 : value_len, block.size() - value_off);
+    vb.value = block.subspan(value_off, value_bytes);
+    vb.value_to_end = block.subspan(value_off);
+
+    const std::size_t children_off = std::min(align4(value_off + value_bytes), block.size());
+    vb.children = block.subspan(children_off);
+    return vb;
+}
+
+template<typename F>
+void for_each_child(std::span<const std::uint8_t> children, F&& f) {
+    for (std::size_t off = 0; off < children.size();) {
+        auto child = parse_block(children, off);
+        if (!child)
+            break;
+        f(*child);
+        off = align4(off + child->length);
+    }
+}
+
+bool key_equals(std::span<const std::uint8_t> key, std::string_view ascii) {
+    if (key.size() != ascii.size() * 2)
+        return false;
+    for (std::size_t i = 0; i < ascii.size(); ++i) {
+        if (load_u16(key, i * 2) != static_cast<unsigned char>(ascii[i]))
+            return false;
+    }
+    return true;
+}
+
+std::string format_version(std::uint32_t ms, std::uint32_t ls) {
+    return std::to_string(ms >> 16) + '.' + std::to_string(ms & 0xFFFF) + '.' +
+           std::to_string(ls >> 16) + '.' + std::to_string(ls & 0xFFFF);
+}
+
+} // namespace
+
+std::string PeFixedFileInfo::file_version() const {
+    return format_version(file_version_ms, file_version_ls);
+}
+
+std::string PeFixedFileInfo::product_version() const {
+    return format_version(product_version_ms, product_version_ls);
+}
+
+std::string_view PeVersionInfo::get(std::string_view key) const {
+    for (const auto& s : strings) {
+        if (s.key == key)
+            return s.value;
+    }
+    return {};
+}
+
+std::expected<PeVersionInfo, Error> read_version_info(const PeView& pe) {
+    const auto* dir = pe.directory(IMAGE_DIRECTORY_ENTRY_RESOURCE);
+    if (!dir)
+        return std::unexpected(Error{"No resource directory"});
+    const std::uint32_t base = dir->VirtualAddress;
+
+    // root -> RT_VERSION -> first name -> first language
+    auto type = find_resource_entry(pe, base, 0, RT_VERSION);
+    if (!type || !(*type & RESOURCE_SUBDIR_FLAG))
+        return std::unexpected(Error{"No RT_VERSION resource"});
+    auto name = find_resource_entry(pe, base, *type & ~RESOURCE_SUBDIR_FLAG, std::nullopt);
+    if (!name || !(*name & RESOURCE_SUBDIR_FLAG))
+        return std::unexpected(Error{"Malformed RT_VERSION directory"});
+    auto lang = find_resource_entry(pe, base, *name & ~RESOURCE_SUBDIR_FLAG, std::nullopt);
+    if (!lang || (*lang & RESOURCE_SUBDIR_FLAG))
+        return std::unexpected(Error{"Malformed RT_VERSION directory"});
+
+    IMAGE_RESOURCE_DATA_ENTRY_ data{};
+    if (!pe.read_rva(base + *lang, data))
+        return std::unexpected(Error{"RT_VERSION data entry out of range"});
+
+    const auto bytes = pe.rva_span(data.OffsetToData, data.Size);
+    if (bytes.empty())
+        return std::unexpected(Error{"RT_VERSION data out of range"});
+
+    auto root = parse_block(bytes, 0);
+    if (!root || !key_equals(root->key, "VS_VERSION_INFO"))
+        return std::unexpected(Error{"Malformed VS_VERSIONINFO"});
+
+    PeVersionInfo info;
+
+    VS_FIXEDFILEINFO_ ffi{};
+    if (root->value.size() >= sizeof(ffi)) {
+        std::memcpy(&ffi, root->value.data(), sizeof(ffi));
+        if (ffi.dwSignature == VS_FFI_SIGNATURE) {
+            info.fixed = PeFixedFileInfo{
+                .file_version_ms = ffi.dwFileVersionMS,
+                .file_version_ls = ffi.dwFileVersionLS,
+                .product_version_ms = ffi.dwProductVersionMS,
+                .product_version_ls = ffi.dwProductVersionLS,
+                .file_flags = ffi.dwFileFlags & ffi.dwFileFlagsMask,
+                .file_os = ffi.dwFileOS,
+                .file_type = ffi.dwFileType,
+                .file_subtype = ffi.dwFileSubtype,
+            };
+        }
+    }
+
+    // StringFileInfo -> StringTable(s) -> String
+    for_each_child(root->children, [&](const VersionBlock& sfi) {
+        if (!key_equals(sfi.key, "StringFileInfo"))
+            return;
+        for_each_child(sfi.children, [&](const VersionBlock& table) {
+            if (info.string_table.empty())
+                info.string_table = utf16_to_utf8(table.key);
+            for_each_child(table.children, [&](const VersionBlock& str) {
+                // wValueLength is unreliable across resource compilers;
+                // the value runs to its NUL or the end of the block.
+                info.strings.push_back(PeVersionString{
+                    .key = utf16_to_utf8(str.key),
+                    .value = utf16_to_utf8(str.value_to_end),
+                });
+            });
+        });
+    });
+
+    return info;
+}
+
+} // namespace peelf
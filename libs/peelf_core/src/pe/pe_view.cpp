@@ -0,0 +1,431 @@
+#include "pe/pe_view.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <unordered_map>
+#include <utility>
+
+namespace peelf {
+
+namespace {
+
+std::uint64_t section_extent(const IMAGE_SECTION_HEADER_& s) {
+    return std::max(s.VirtualSize, s.SizeOfRawData);
+}
+
+template<typename Traits>
+std::expected<std::vector<PeImport>, Error> collect_imports(const PeView& pe,
+                                                            const IMAGE_DATA_DIRECTORY_& dir) {
+    using thunk_t = typename Traits::thunk_type;
+
+    const ParseLimits& limits = pe.limits();
+    Deadline deadline = pe.deadline();
+    std::vector<PeImport> out;
+
+    auto desc_offset = pe.rva_to_offset(dir.VirtualAddress);
+    if (!desc_offset)
+        return std::unexpected(Error{"Import directory is not backed by file data"});
+
+    // Crafted images point many descriptors at the same thunk table to
+    // multiply the work; each table is walked at most once, and a later
+    // descriptor sharing it gets copies of the entries read the first time.
+    // Value: [first, last) in out.
+    std::unordered_map<std::uint32_t, std::pair<std::size_t, std::size_t>> seen_tables;
+
+    for (std::size_t n = 0, off = *desc_offset;; ++n, off += sizeof(IMAGE_IMPORT_DESCRIPTOR_)) {
+        if (n >= limits.max_import_descriptors)
+            return std::unexpected(Error{"Import walk exceeded descriptor budget"});
+
+        IMAGE_IMPORT_DESCRIPTOR_ desc{};
+        if (!pe.read(off, desc))
+            return std::unexpected(Error{"Import descriptor out of range"});
+        if (desc.OriginalFirstThunk == 0 && desc.FirstThunk == 0)
+            break;
+
+        const std::string_view dll = pe.cstring_at_rva(desc.Name);
+        if (dll.empty())
+            break;
+
+        // Prefer the INT; bound or INT-less images only carry the IAT
+        const std::uint32_t table_rva = desc.OriginalFirstThunk ? desc.OriginalFirstThunk
+                                                                : desc.FirstThunk;
+        auto table_off = pe.rva_to_offset(table_rva);
+        if (!table_off)
+            break;
+        if (const auto seen = seen_tables.find(table_rva); seen != seen_tables.end()) {
+            const auto [first, last] = seen->second;
+            if (out.size() + (last - first) > limits.max_total_imports)
+                return std::unexpected(Error{"Import walk exceeded total import budget"});
+            for (std::size_t i = first; i < last; ++i) {
+                PeImport imp = out[i];
+                imp.dll = dll;
+                imp.iat_rva = desc.FirstThunk + static_cast<std::uint32_t>((i - first) * sizeof(thunk_t));
+                out.push_back(imp);
+            }
+            continue;
+        }
+        const std::size_t first = out.size();
+
+        for (std::size_t i = 0;; ++i) {
+            if (i >= limits.max_thunks_per_descriptor)
+                return std::unexpected(Error{"Import walk exceeded thunk budget"});
+            if (out.size() >= limits.max_total_imports)
+                return std::unexpected(Error{"Import walk exceeded total import budget"});
+            if (deadline.expired())
+                return std::unexpected(Error{"Import walk exceeded time budget"});
+
+            thunk_t thunk = 0;
+            if (!pe.read(*table_off + i * sizeof(thunk_t), thunk))
+                return std::unexpected(Error{"Import thunk out of range"});
+            if (thunk == 0)
+                break;
+
+            PeImport imp{};
+            imp.dll = dll;
+            imp.iat_rva = desc.FirstThunk + static_cast<std::uint32_t>(i * sizeof(thunk_t));
+
+            if (thunk_is_ordinal<Traits>(thunk)) {
+                imp.by_ordinal = true;
+                imp.ordinal = static_cast<std::uint16_t>(thunk & 0xFFFF);
+            } else {
+                const std::uint32_t hn_rva = thunk_hint_name_rva<Traits>(thunk);
+                if (!pe.read_rva(hn_rva, imp.hint))
+                    break;
+                imp.name = pe.cstring_at_rva(hn_rva + 2);
+            }
+            out.push_back(imp);
+        }
+        seen_tables.emplace(table_rva, std::pair{first, out.size()});
+    }
+
+    return out;
+}
+
+} // namespace
+
+std::expected<PeView, Error> PeView::parse(std::span<const std::uint8_t> bytes,
+                                           const ParseLimits& limits,
+                                           PeLayout layout) {
+    PeView pe(bytes);
+    pe.limits_ = limits;
+
+    IMAGE_DOS_HEADER_& dos = pe.dos_header_;
+    if (!pe.read(0, dos))
+        return std::unexpected(Error{"PE file too small for DOS header"});
+    if (dos.e_magic != IMAGE_DOS_SIGNATURE)
+        return std::unexpected(Error{"Missing MZ header"});
+    if (dos.e_lfanew < 0)
+        return std::unexpected(Error{"Invalid e_lfanew (negative)"});
+
+    pe.nt_offset_ = static_cast<std::size_t>(dos.e_lfanew);
+
+    std::uint32_t signature = 0;
+    IMAGE_FILE_HEADER_& file_hdr = pe.file_header_;
+    if (!pe.read(pe.nt_offset_, signature) || !pe.read(pe.nt_offset_ + 4, file_hdr))
+        return std::unexpected(Error{"Invalid e_lfanew (out of range)"});
+    if (signature != IMAGE_NT_SIGNATURE)
+        return std::unexpected(Error{"Missing PE signature"});
+
+    pe.opt_offset_ = pe.nt_offset_ + 4 + sizeof(IMAGE_FILE_HEADER_);
+    const std::size_t nt_end = std::min(bytes.size(), pe.opt_offset_ + sizeof(IMAGE_OPTIONAL_HEADER64_));
+    pe.nt_headers_ = pe.aligned_span(bytes.subspan(pe.nt_offset_, nt_end - pe.nt_offset_), 8);
+
+    std::uint16_t magic = 0;
+    if (!pe.read(pe.opt_offset_, magic))
+        return std::unexpected(Error{"Invalid optional header size"});
+
+    bool ok = false;
+    switch (magic) {
+        case Pe32Traits::magic: ok = pe.parse_optional_header<Pe32Traits>(); break;
+        case Pe64Traits::magic: ok = pe.parse_optional_header<Pe64Traits>(); break;
+        default:
+            return std::unexpected(Error{"Unsupported optional header magic"});
+    }
+    if (!ok)
+        return std::unexpected(Error{"Optional header truncated"});
+
+    const std::size_t table_off = pe.opt_offset_ + file_hdr.SizeOfOptionalHeader;
+    const std::size_t table_len = std::size_t{file_hdr.NumberOfSections} * sizeof(IMAGE_SECTION_HEADER_);
+    if (table_off > bytes.size() || bytes.size() - table_off < table_len)
+        return std::unexpected(Error{"Section table out of range"});
+
+    const auto table = pe.aligned_span(bytes.subspan(table_off, table_len), 4);
+    pe.sections_ = {reinterpret_cast<const IMAGE_SECTION_HEADER_*>(table.data()), file_hdr.NumberOfSections};
+    pe.build_section_index();
+    pe.layout_ = layout == PeLayout::Auto ? pe.detect_layout() : layout;
+    return pe;
+}
+
+PeLayout PeView::detect_layout() const {
+    // Sections already sitting at their RVA read the same either way
+    const IMAGE_SECTION_HEADER_* first = nullptr;
+    for (std::uint32_t idx : va_order_) {
+        const auto& s = sections_[idx];
+        if (s.SizeOfRawData == 0 || s.PointerToRawData == s.VirtualAddress)
+            continue;
+        first = &s;
+        break;
+    }
+    if (!first)
+        return PeLayout::File;
+
+    // Up to one page of the first section's raw data, where a dump has the
+    // zero fill that follows the headers
+    constexpr std::size_t probe_limit = 0x1000;
+    const std::size_t begin = std::max<std::size_t>(first->PointerToRawData, size_of_headers_);
+    const std::size_t end = std::min({std::size_t{first->VirtualAddress},
+                                      std::size_t{first->PointerToRawData} + first->SizeOfRawData,
+                                      begin + probe_limit, bytes_.size()});
+    if (begin < end) {
+        const auto probe = bytes_.subspan(begin, end - begin);
+        if (std::any_of(probe.begin(), probe.end(), [](std::uint8_t b) { return b != 0; }))
+            return PeLayout::File;
+    }
+
+    return size_of_image_ != 0 && bytes_.size() >= size_of_image_ ? PeLayout::Image : PeLayout::File;
+}
+
+void PeView::build_section_index() {
+    va_order_.resize(sections_.size());
+    for (std::uint32_t i = 0; i < va_order_.size(); ++i)
+        va_order_[i] = i;
+
+    std::stable_sort(va_order_.begin(), va_order_.end(), [&](std::uint32_t a, std::uint32_t b) {
+        return sections_[a].VirtualAddress < sections_[b].VirtualAddress;
+    });
+
+    sections_disjoint_ = true;
+    for (std::size_t i = 1; i < va_order_.size(); ++i) {
+        const auto& prev = sections_[va_order_[i - 1]];
+        const auto& cur = sections_[va_order_[i]];
+        if (std::uint64_t{prev.VirtualAddress} + section_extent(prev) > cur.VirtualAddress) {
+            sections_disjoint_ = false;
+            break;
+        }
+    }
+}
+
+template<typename Traits>
+bool PeView::parse_optional_header() {
+    using opt_t = typename Traits::optional_header;
+
+    // Older linkers emit fewer than 16 directories; only the fixed part
+    // of the header has to be present.
+    constexpr std::size_t fixed_size = offsetof(opt_t, DataDirectory);
+    if (opt_offset_ > bytes_.size() || bytes_.size() - opt_offset_ < fixed_size)
+        return false;
+
+    opt_t opt{};
+    std::memcpy(&opt, bytes_.data() + opt_offset_,
+                std::min(sizeof(opt_t), bytes_.size() - opt_offset_));
+
+    pe32_plus_ = Traits::is_64;
+    image_base_ = opt.ImageBase;
+    entry_point_rva_ = opt.AddressOfEntryPoint;
+    size_of_image_ = opt.SizeOfImage;
+    size_of_headers_ = opt.SizeOfHeaders;
+    section_alignment_ = opt.SectionAlignment;
+    file_alignment_ = opt.FileAlignment;
+    subsystem_ = opt.Subsystem;
+    dll_characteristics_ = opt.DllCharacteristics;
+    checksum_ = opt.CheckSum;
+
+    const std::size_t dir_off = opt_offset_ + fixed_size - nt_offset_;
+    std::size_t count = std::min<std::size_t>(opt.NumberOfRvaAndSizes, IMAGE_NUMBEROF_DIRECTORY_ENTRIES);
+    count = std::min(count, (nt_headers_.size() - dir_off) / sizeof(IMAGE_DATA_DIRECTORY_));
+    directories_ = {reinterpret_cast<const IMAGE_DATA_DIRECTORY_*>(nt_headers_.data() + dir_off), count};
+    return true;
+}
+
+std::span<const std::uint8_t> PeView::aligned_span(std::span<const std::uint8_t> raw, std::size_t align) {
+    if (raw.empty() || reinterpret_cast<std::uintptr_t>(raw.data()) % align == 0)
+        return raw;
+    auto words = std::make_shared<std::vector<std::uint64_t>>((raw.size() + 7) / 8);
+    std::memcpy(words->data(), raw.data(), raw.size());
+    aligned_.push_back(words);
+    return {reinterpret_cast<const std::uint8_t*>(words->data()), raw.size()};
+}
+
+std::size_t PeView::checksum_offset() const {
+    // CheckSum sits at the same offset in both optional header flavours
+    return opt_offset_ + offsetof(IMAGE_OPTIONAL_HEADER32_, CheckSum);
+}
+
+std::size_t PeView::data_directory_offset(std::size_t index) const {
+    const std::size_t dir_base = pe32_plus_ ? offsetof(IMAGE_OPTIONAL_HEADER64_, DataDirectory)
+                                            : offsetof(IMAGE_OPTIONAL_HEADER32_, DataDirectory);
+    return opt_offset_ + dir_base + index * sizeof(IMAGE_DATA_DIRECTORY_);
+}
+
+const IMAGE_DATA_DIRECTORY_* PeView::directory(std::size_t index) const {
+    if (index >= directories_.size())
+        return nullptr;
+    const auto& dir = directories_[index];
+    if (dir.VirtualAddress == 0 || dir.Size == 0)
+        return nullptr;
+    return &dir;
+}
+
+std::string_view PeView::section_name(const IMAGE_SECTION_HEADER_& s) {
+    return {s.Name, strnlen(s.Name, sizeof(s.Name))};
+}
+
+const IMAGE_SECTION_HEADER_* PeView::section_from_rva(std::uint32_t rva) const {
+    if (sections_disjoint_) {
+        // Last section starting at or below rva
+        auto it = std::upper_bound(va_order_.begin(), va_order_.end(), rva,
+                                   [&](std::uint32_t v, std::uint32_t idx) {
+                                       return v < sections_[idx].VirtualAddress;
+                                   });
+        if (it == va_order_.begin())
+            return nullptr;
+        const auto& s = sections_[*std::prev(it)];
+        return rva < std::uint64_t{s.VirtualAddress} + section_extent(s) ? &s : nullptr;
+    }
+
+    // Overlapping layout: first match in table order, like the loader
+    for (const auto& s : sections_) {
+        if (rva >= s.VirtualAddress && rva < std::uint64_t{s.VirtualAddress} + section_extent(s))
+            return &s;
+    }
+    return nullptr;
+}
+
+std::optional<std::size_t> PeView::rva_to_offset(std::uint32_t rva) const {
+    if (layout_ == PeLayout::Image) {
+        if (rva < bytes_.size())
+            return static_cast<std::size_t>(rva);
+        return std::nullopt;
+    }
+
+    if (const auto* s = section_from_rva(rva)) {
+        const std::uint32_t delta = rva - s->VirtualAddress;
+        if (delta < s->SizeOfRawData)
+            return std::size_t{s->PointerToRawData} + delta;
+        return std::nullopt;  // virtual padding (uninitialised data)
+    }
+
+    // Headers live before the first section and are mapped 1:1
+    if (rva < size_of_headers_ && rva < bytes_.size())
+        return static_cast<std::size_t>(rva);
+
+    return std::nullopt;
+}
+
+std::span<const std::uint8_t> PeView::rva_span(std::uint32_t rva, std::size_t size) const {
+    auto off = rva_to_offset(rva);
+    if (!off || *off > bytes_.size() || bytes_.size() - *off < size)
+        return {};
+    return bytes_.subspan(*off, size);
+}
+
+std::string_view PeView::cstring_at_offset(std::size_t offset, std::size_t max_len) const {
+    if (offset >= bytes_.size())
+        return {};
+    const auto* p = reinterpret_cast<const char*>(bytes_.data() + offset);
+    return {p, strnlen(p, std::min(max_len, bytes_.size() - offset))};
+}
+
+std::string_view PeView::cstring_at_rva(std::uint32_t rva, std::size_t max_len) const {
+    auto off = rva_to_offset(rva);
+    if (!off)
+        return {};
+    return cstring_at_offset(*off, max_len);
+}
+
+std::expected<std::vector<PeImport>, Error> PeView::imports() const {
+    const auto* dir = directory(IMAGE_DIRECTORY_ENTRY_IMPORT);
+    if (!dir)
+        return std::vector<PeImport>{};
+
+    return dispatch([&](auto traits) {
+        return collect_imports<decltype(traits)>(*this, *dir);
+    });
+}
+
+std::expected<std::vector<PeExport>, Error> PeView::exports() const {
+    std::vector<PeExport> out;
+
+    const auto* dir = directory(IMAGE_DIRECTORY_ENTRY_EXPORT);
+    if (!dir)
+        return out;
+
+    IMAGE_EXPORT_DIRECTORY_ ed{};
+    if (!read_rva(dir->VirtualAddress, ed))
+        return std::unexpected(Error{"Export directory is not backed by file data"});
+
+    auto functions = rva_span(ed.AddressOfFunctions, std::size_t{ed.NumberOfFunctions} * 4);
+    if (functions.empty() && ed.NumberOfFunctions != 0)
+        return std::unexpected(Error{"Export address table out of range"});
+
+    auto names = rva_span(ed.AddressOfNames, std::size_t{ed.NumberOfNames} * 4);
+    auto ordinals = rva_span(ed.AddressOfNameOrdinals, std::size_t{ed.NumberOfNames} * 2);
+    if ((names.empty() || ordinals.empty()) && ed.NumberOfNames != 0)
+        return std::unexpected(Error{"Export name tables out of range"});
+
+    if (ed.NumberOfFunctions > limits_.max_exports || ed.NumberOfNames > limits_.max_exports)
+        return std::unexpected(Error{"Export table exceeds export budget"});
+
+    Deadline deadline = this->deadline();
+
+    // Name table is indexed by name; invert it to attach names to functions
+    std::vector<std::string_view> name_of(ed.NumberOfFunctions);
+    for (std::uint32_t i = 0; i < ed.NumberOfNames; ++i) {
+        if (deadline.expired())
+            return std::unexpected(Error{"Export walk exceeded time budget"});
+
+        std::uint32_t name_rva = 0;
+        std::uint16_t index = 0;
+        std::memcpy(&name_rva, names.data() + i * 4, 4);
+        std::memcpy(&index, ordinals.data() + i * 2, 2);
+        if (index < name_of.size())
+            name_of[index] = cstring_at_rva(name_rva);
+    }
+
+    const std::uint64_t dir_end = std::uint64_t{dir->VirtualAddress} + dir->Size;
+    out.reserve(ed.NumberOfFunctions);
+    for (std::uint32_t i = 0; i < ed.NumberOfFunctions; ++i) {
+        std::uint32_t func_rva = 0;
+        std::memcpy(&func_rva, functions.data() + i * 4, 4);
+        if (func_rva == 0)
+            continue;
+
+        PeExport e{};
+        e.name = name_of[i];
+        e.ordinal = ed.Base + i;
+        e.rva = func_rva;
+        // An EAT entry pointing inside the export directory is a forwarder string
+        if (func_rva >= dir->VirtualAddress && func_rva < dir_end)
+            e.forwarder = cstring_at_rva(func_rva);
+        out.push_back(e);
+    }
+
+    return out;
+}
+
+std::uint32_t PeView::compute_checksum() const {
+    const std::size_t size = bytes_.size();
+    const std::size_t skip = checksum_offset();
+    std::uint64_t sum = 0;
+
+    // Sum all 16-bit words, skipping the 4-byte checksum field itself
+    for (std::size_t i = 0; i < size; i += 2) {
+        if (i == skip || i == skip + 2)
+            continue;
+        std::uint16_t word = bytes_[i];
+        if (i + 1 < size)
+            word = static_cast<std::uint16_t>(word | (bytes_[i + 1] << 8));
+        sum += word;
+        sum = (sum & 0xFFFF) + (sum >> 16);
+    }
+    sum = (sum & 0xFFFF) + (sum >> 16);
+
+    return static_cast<std::uint32_t>(sum + size);
+}
+
+bool PeView::checksum_valid() const {
+    // Zero checksum means "not set"
+    return checksum_ == 0 || compute_checksum() == checksum_;
+}
+
+} // namespace peelf
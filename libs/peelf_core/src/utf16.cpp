@@ -0,0 +1,50 @@
+#include "peelf/utf16.hpp"
+
+#include <cstring>
+
+namespace peelf {
+
+namespace {
+
+std::uint32_t load_u16(const std::uint8_t* p) {
+    std::uint16_t v = 0;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+} // namespace
+
+std::string utf16_to_utf8(std::span<const std::uint8_t> s) {
+    std::string out;
+    out.reserve(s.size() / 2);
+    for (std::size_t i = 0; i + 2 <= s.size(); i += 2) {
+        std::uint32_t cp = load_u16(s.data() + i);
+        if (cp == 0)
+            break;
+        if (cp >= 0xD800 && cp < 0xDC00 && i + 4 <= s.size()) {
+            const std::uint32_t lo = load_u16(s.data() + i + 2);
+            if (lo >= 0xDC00 && lo < 0xE000) {
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                i += 2;
+            }
+        }
+        if (cp < 0x80) {
+            out.push_back(static_cast<char>(cp));
+        } else if (cp < 0x800) {
+            out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else if (cp < 0x10000) {
+            out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else {
+            out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        }
+    }
+    return out;
+}
+
+} // namespace peelf
@@ -0,0 +1,60 @@
+#include "elf/elf_parser.h"
+#include "elf/elf_view.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <variant>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const char* what) {
+    if (!ok) {
+        std::fprintf(stderr, "FAIL: %s\n", what);
+        ++failures;
+    }
+}
+
+// Just an ELF64 header, whose section table lies past the end of the file
+// and whose e_shentsize is wrong: too broken for ElfView, but its
+// identification and type are still readable
+std::vector<std::uint8_t> truncated_elf(std::uint8_t data) {
+    using namespace peelf;
+    std::vector<std::uint8_t> bytes(sizeof(Elf64_Ehdr_));
+    std::memcpy(bytes.data(), "\x7F" "ELF", 4);
+    bytes[EI_CLASS] = ELFCLASS64;
+    bytes[EI_DATA] = data;
+    bytes[EI_VERSION] = 1;
+    const bool big = data == ELFDATA2MSB;
+    bytes[big ? 0x11 : 0x10] = 3;       // e_type = ET_DYN
+    bytes[big ? 0x13 : 0x12] = 0x3E;    // e_machine = EM_X86_64
+    bytes[0x28] = 0xFF;                 // e_shoff
+    bytes[big ? 0x3B : 0x3A] = 1;       // e_shentsize
+    bytes[big ? 0x3D : 0x3C] = 4;       // e_shnum
+    return bytes;
+}
+
+} // namespace
+
+int main() {
+    using namespace peelf;
+    for (const std::uint8_t data : {ELFDATA2LSB, ELFDATA2MSB}) {
+        const auto bytes = truncated_elf(data);
+        check(!ElfView::parse(bytes).has_value(), "ElfView rejects the truncated file");
+
+        const auto info = parse_elf_bytes(bytes);
+        check(info.has_value(), "parse_elf_bytes accepts the truncated file");
+        if (!info)
+            continue;
+        const auto* summary = std::get_if<ElfSummary>(&info->summary);
+        check(info->kind == FileKind::ELF && summary != nullptr, "parse_elf_bytes reports an ELF summary");
+        if (summary) {
+            check(summary->ei_class == ELFCLASS64 && summary->ei_data == data, "identification bytes");
+            check(summary->e_type == 3 && summary->e_machine == 0x3E, "e_type and e_machine in file byte order");
+        }
+    }
+    check(!parse_elf_bytes(std::vector<std::uint8_t>(16)).has_value(), "a 16-byte file is too small");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,62 @@
+#include "elf/elf_view.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const char* what) {
+    if (!ok) {
+        std::fprintf(stderr, "FAIL: %s\n", what);
+        ++failures;
+    }
+}
+
+// A host-order ELF64 whose section count, string table index and program
+// header count all overflow into section 0
+std::vector<std::uint8_t> extended_count_elf() {
+    using namespace peelf;
+    constexpr std::uint32_t phnum = 3;
+
+    std::vector<std::uint8_t> bytes(sizeof(Elf64_Ehdr_) + sizeof(Elf64_Shdr_) + phnum * sizeof(Elf64_Phdr_));
+
+    Elf64_Ehdr_ eh{};
+    std::memcpy(eh.e_ident, "\x7F" "ELF", 4);
+    eh.e_ident[EI_CLASS] = ELFCLASS64;
+    eh.e_ident[EI_DATA] = std::endian::native == std::endian::little ? ELFDATA2LSB : ELFDATA2MSB;
+    eh.e_ident[EI_VERSION] = 1;
+    eh.e_type = 2;
+    eh.e_version = 1;
+    eh.e_ehsize = sizeof(Elf64_Ehdr_);
+    eh.e_shoff = sizeof(Elf64_Ehdr_);
+    eh.e_shentsize = sizeof(Elf64_Shdr_);
+    eh.e_shnum = 0;
+    eh.e_shstrndx = SHN_XINDEX;
+    eh.e_phoff = sizeof(Elf64_Ehdr_) + sizeof(Elf64_Shdr_);
+    eh.e_phentsize = sizeof(Elf64_Phdr_);
+    eh.e_phnum = PN_XNUM;
+    std::memcpy(bytes.data(), &eh, sizeof(eh));
+
+    Elf64_Shdr_ sh0{};
+    sh0.sh_size = 1;        // section count
+    sh0.sh_link = 0;        // string table index
+    sh0.sh_info = phnum;    // program header count
+    std::memcpy(bytes.data() + eh.e_shoff, &sh0, sizeof(sh0));
+    return bytes;
+}
+
+} // namespace
+
+int main() {
+    const auto bytes = extended_count_elf();
+    const auto elf = peelf::ElfView::parse(bytes);
+    check(elf.has_value(), "native-endian ELF with extended counts parses");
+    if (elf) {
+        check(elf->section_count() == 1, "section count comes from section 0");
+        check(elf->segment_count() == 3, "program header count comes from section 0");
+    }
+    return failures == 0 ? 0 : 1;
+}
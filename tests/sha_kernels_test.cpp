@@ -0,0 +1,132 @@
+#include "crypto/sha.hpp"
+#include "crypto/sha_kernels.hpp"
+#include "peelf/cpu_features.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const char* what, std::size_t size) {
+    if (!ok) {
+        std::fprintf(stderr, "FAIL: %s (%zu bytes)\n", what, size);
+        ++failures;
+    }
+}
+
+constexpr std::array<std::uint32_t, 5> sha1_init = {
+    0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0,
+};
+constexpr std::array<std::uint32_t, 8> sha256_init = {
+    0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A, 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19,
+};
+
+std::vector<std::uint8_t> pseudo_random(std::size_t size) {
+    std::vector<std::uint8_t> out(size);
+    std::uint64_t x = 0x9E3779B97F4A7C15;
+    for (auto& b : out) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        b = static_cast<std::uint8_t>(x);
+    }
+    return out;
+}
+
+// Pads the message as SHA-1 and SHA-256 both do and runs it through one
+// block function, so the digest does not depend on the dispatch in Sha1 /
+// Sha256. The blocks start one byte into the buffer, as the classes hand
+// the kernels unaligned caller data.
+template<std::size_t N>
+std::array<std::uint8_t, N * 4> digest(peelf::detail::sha_block_fn blocks, std::array<std::uint32_t, N> state,
+                                       std::span<const std::uint8_t> message) {
+    std::vector<std::uint8_t> padded(1, 0);
+    padded.insert(padded.end(), message.begin(), message.end());
+    padded.push_back(0x80);
+    while ((padded.size() - 1) % 64 != 56)
+        padded.push_back(0);
+    const std::uint64_t bits = std::uint64_t{message.size()} * 8;
+    for (int i = 7; i >= 0; --i)
+        padded.push_back(static_cast<std::uint8_t>(bits >> (i * 8)));
+
+    blocks(state.data(), padded.data() + 1, (padded.size() - 1) / 64);
+    std::array<std::uint8_t, N * 4> out{};
+    for (std::size_t i = 0; i < N; ++i) {
+        for (std::size_t j = 0; j < 4; ++j)
+            out[i * 4 + j] = static_cast<std::uint8_t>(state[i] >> (24 - j * 8));
+    }
+    return out;
+}
+
+template<typename Digest>
+bool equals_hex(const Digest& d, std::string_view hex) {
+    static constexpr char digits[] = "0123456789abcdef";
+    if (hex.size() != d.size() * 2)
+        return false;
+    for (std::size_t i = 0; i < d.size(); ++i) {
+        if (hex[i * 2] != digits[d[i] >> 4] || hex[i * 2 + 1] != digits[d[i] & 15])
+            return false;
+    }
+    return true;
+}
+
+// Both block functions and the streaming class over the same message
+template<typename Hash, std::size_t N>
+void compare(peelf::detail::sha_block_fn scalar, peelf::detail::sha_block_fn accelerated,
+             const std::array<std::uint32_t, N>& init, std::span<const std::uint8_t> message, const char* name) {
+    const auto expected = digest(scalar, init, message);
+    if (accelerated)
+        check(digest(accelerated, init, message) == expected, name, message.size());
+
+    const auto one_shot = Hash::hash(message);
+    check(std::ranges::equal(one_shot, expected), name, message.size());
+
+    // Odd-sized updates leave a partial block buffered between calls
+    Hash streamed;
+    for (std::size_t at = 0; at < message.size(); at += 37)
+        streamed.update(message.subspan(at, std::min<std::size_t>(37, message.size() - at)));
+    const auto chunked = streamed.finish();
+    check(std::ranges::equal(chunked, expected), name, message.size());
+}
+
+} // namespace
+
+int main() {
+    using namespace peelf;
+    const auto& cpu = cpu_features();
+    const detail::sha_block_fn sha1_accelerated =
+        cpu.sha && cpu.sse41 ? detail::sha1_blocks_shani : nullptr;
+    const detail::sha_block_fn sha256_accelerated =
+        cpu.sha && cpu.sse41 ? detail::sha256_blocks_shani : nullptr;
+    if (!sha1_accelerated)
+        std::printf("SHA-NI not available; checking the scalar kernels only\n");
+
+    const std::string_view abc = "abc";
+    const std::span<const std::uint8_t> abc_bytes(reinterpret_cast<const std::uint8_t*>(abc.data()), abc.size());
+    check(equals_hex(digest(detail::sha1_blocks_scalar, sha1_init, abc_bytes),
+                     "a9993e364706816aba3e25717850c26c9cd0d89d"), "SHA-1 scalar known answer", 3);
+    check(equals_hex(digest(detail::sha256_blocks_scalar, sha256_init, abc_bytes),
+                     "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"),
+          "SHA-256 scalar known answer", 3);
+
+    // Every length up to four blocks, then a few longer runs
+    const auto data = pseudo_random(4099);
+    std::vector<std::size_t> sizes;
+    for (std::size_t n = 0; n <= 4 * 64 + 1; ++n)
+        sizes.push_back(n);
+    sizes.insert(sizes.end(), {1000, 1023, 4096, 4099});
+
+    for (const std::size_t n : sizes) {
+        const auto message = std::span<const std::uint8_t>(data).first(n);
+        compare<Sha1>(detail::sha1_blocks_scalar, sha1_accelerated, sha1_init, message, "SHA-1");
+        compare<Sha256>(detail::sha256_blocks_scalar, sha256_accelerated, sha256_init, message, "SHA-256");
+    }
+    return failures == 0 ? 0 : 1;
+}